@@ -25,6 +25,171 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "cl_local.h"
 
 
+/*
+ =================
+ CL_WriteDemoFrame
+
+ Writes a frame as if it came from the server, delta compressed from
+ another frame or from the baselines
+ =================
+*/
+static void CL_WriteDemoFrame (msg_t *msg, frame_t *from, frame_t *to){
+
+	entity_state_t	*oldState, *newState, state;
+	int				oldIndex, newIndex;
+	int				oldNum, newNum;
+	int				fromNumEntities;
+	int				bits;
+
+	MSG_WriteByte(msg, SVC_FRAME);
+	MSG_WriteLong(msg, to->serverFrame);
+	MSG_WriteLong(msg, (from) ? from->serverFrame : -1);
+	MSG_WriteByte(msg, 0);
+
+	MSG_WriteByte(msg, sizeof(to->areaBits));
+	MSG_Write(msg, to->areaBits, sizeof(to->areaBits));
+
+	MSG_WriteByte(msg, SVC_PLAYERINFO);
+
+	if (!from)
+		MSG_WriteDeltaPlayerState(msg, NULL, &to->playerState);
+	else
+		MSG_WriteDeltaPlayerState(msg, &from->playerState, &to->playerState);
+
+	MSG_WriteByte(msg, SVC_PACKETENTITIES);
+
+	if (!from)
+		fromNumEntities = 0;
+	else
+		fromNumEntities = from->numEntities;
+
+	newIndex = 0;
+	oldIndex = 0;
+	while (newIndex < to->numEntities || oldIndex < fromNumEntities){
+		// Like the server, drop what doesn't fit in a message
+		if (msg->curSize > MAX_MSGLEN - 64)
+			break;
+
+		if (newIndex >= to->numEntities)
+			newNum = 9999;
+		else {
+			newState = &cl.parseEntities[(to->parseEntitiesIndex+newIndex) & (MAX_PARSE_ENTITIES-1)];
+			newNum = newState->number;
+
+			// Events already happened, don't play them again
+			state = *newState;
+			state.event = 0;
+		}
+
+		if (oldIndex >= fromNumEntities)
+			oldNum = 9999;
+		else {
+			oldState = &cl.parseEntities[(from->parseEntitiesIndex+oldIndex) & (MAX_PARSE_ENTITIES-1)];
+			oldNum = oldState->number;
+		}
+
+		if (newNum == oldNum){
+			MSG_WriteDeltaEntity(msg, oldState, &state, false, false);
+
+			oldIndex++;
+			newIndex++;
+			continue;
+		}
+
+		if (newNum < oldNum){
+			MSG_WriteDeltaEntity(msg, &cl.entities[newNum].baseline, &state, true, true);
+
+			newIndex++;
+			continue;
+		}
+
+		if (newNum > oldNum){
+			bits = U_REMOVE;
+			if (oldNum >= 256)
+				bits |= U_NUMBER16 | U_MOREBITS1;
+
+			MSG_WriteByte(msg, bits&255);
+			if (bits & 0x0000ff00)
+				MSG_WriteByte(msg, (bits>>8)&255);
+
+			if (bits & U_NUMBER16)
+				MSG_WriteShort(msg, oldNum);
+			else
+				MSG_WriteByte(msg, oldNum);
+
+			oldIndex++;
+			continue;
+		}
+	}
+
+	MSG_WriteShort(msg, 0);	// End of packet entities
+}
+
+/*
+ =================
+ CL_WriteDemoKeyframe
+
+ Writes the configstrings and the frames the server may still delta
+ the next frames from, so playback can start right after this point
+ =================
+*/
+static void CL_WriteDemoKeyframe (void){
+
+	char		data[MAX_MSGLEN*2];
+	msg_t		msg;
+	frame_t		*frame, *prevFrame;
+	int			i;
+
+	Com_BeginDemoKeyframe(cls.demoFile, cl.frame.serverFrame);
+
+	MSG_Init(&msg, data, sizeof(data), false);
+
+	// Configstrings
+	for (i = 0; i < MAX_CONFIGSTRINGS; i++){
+		if (!cl.configStrings[i][0])
+			continue;
+
+		if (msg.curSize + strlen(cl.configStrings[i]) + 32 > MAX_MSGLEN){
+			// Write it out
+			Com_WriteDemoMessage(cls.demoFile, cl.frame.serverFrame, msg.data, msg.curSize);
+
+			msg.curSize = 0;
+		}
+
+		MSG_WriteByte(&msg, SVC_CONFIGSTRING);
+		MSG_WriteShort(&msg, i);
+		MSG_WriteString(&msg, cl.configStrings[i]);
+	}
+
+	Com_WriteDemoMessage(cls.demoFile, cl.frame.serverFrame, msg.data, msg.curSize);
+
+	// The server only deltas from frames that are recent enough, so
+	// write all of those as a chain ending with the current frame
+	prevFrame = NULL;
+
+	for (i = cl.frame.serverFrame - (UPDATE_BACKUP - 3); i <= cl.frame.serverFrame; i++){
+		if (i <= 0)
+			continue;
+
+		frame = &cl.frames[i & UPDATE_MASK];
+		if (!frame->valid || frame->serverFrame != i)
+			continue;
+
+		if (cl.parseEntitiesIndex - frame->parseEntitiesIndex > MAX_PARSE_ENTITIES-128)
+			continue;
+
+		MSG_Clear(&msg);
+
+		CL_WriteDemoFrame(&msg, prevFrame, frame);
+
+		Com_WriteDemoMessage(cls.demoFile, frame->serverFrame, msg.data, msg.curSize);
+
+		prevFrame = frame;
+	}
+
+	Com_EndDemoKeyframe(cls.demoFile);
+}
+
 /*
  =================
  CL_Record_f
@@ -37,7 +202,8 @@ void CL_Record_f (void){
 	char			name[MAX_QPATH];
 	char			data[MAX_MSGLEN];
 	msg_t			msg;
-	int				i, len;
+	fileHandle_t	f;
+	int				i;
 	entity_state_t	*ent, nullState;
 
 	if (Cmd_Argc() > 2){
@@ -74,12 +240,14 @@ void CL_Record_f (void){
 	}
 
 	// Open the demo file
-	FS_FOpenFile(name, &cls.demoFile, FS_WRITE);
-	if (!cls.demoFile){
+	FS_FOpenFile(name, &f, FS_WRITE);
+	if (!f){
 		Com_Printf("Couldn't open %s\n", name);
 		return;
 	}
 
+	cls.demoFile = Com_RecordDemo(f);
+
 	Com_Printf("Recording to %s\n", name);
 
 	Q_strncpyz(cls.demoName, name, sizeof(cls.demoName));
@@ -107,9 +275,7 @@ void CL_Record_f (void){
 
 		if (msg.curSize + strlen(cl.configStrings[i]) + 32 > msg.maxSize){
 			// Write it out
-			len = LittleLong(msg.curSize);
-			FS_Write(&len, sizeof(len), cls.demoFile);
-			FS_Write(msg.data, msg.curSize, cls.demoFile);
+			Com_WriteDemoMessage(cls.demoFile, cl.frame.serverFrame, msg.data, msg.curSize);
 
 			msg.curSize = 0;
 		}
@@ -128,9 +294,7 @@ void CL_Record_f (void){
 
 		if (msg.curSize + sizeof(entity_state_t) + 32 > msg.maxSize){
 			// Write it out
-			len = LittleLong(msg.curSize);
-			FS_Write(&len, sizeof(len), cls.demoFile);
-			FS_Write(msg.data, msg.curSize, cls.demoFile);
+			Com_WriteDemoMessage(cls.demoFile, cl.frame.serverFrame, msg.data, msg.curSize);
 
 			msg.curSize = 0;
 		}
@@ -143,9 +307,7 @@ void CL_Record_f (void){
 	MSG_WriteString(&msg, "precache\n");
 
 	// Write it to the demo file
-	len = LittleLong(msg.curSize);
-	FS_Write(&len, sizeof(len), cls.demoFile);
-	FS_Write(msg.data, msg.curSize, cls.demoFile);
+	Com_WriteDemoMessage(cls.demoFile, cl.frame.serverFrame, msg.data, msg.curSize);
 
 	// The rest of the demo file will be individual frames
 }
@@ -159,19 +321,14 @@ void CL_Record_f (void){
 */
 void CL_StopRecord_f (void){
 
-	int		end;
-
 	if (!cls.demoFile){
 		Com_Printf("Not recording a demo\n");
 		return;
 	}
 
 	// Finish up
-	end = LittleLong(-1);
-
-	FS_Write(&end, sizeof(end), cls.demoFile);
-	FS_FCloseFile(cls.demoFile);
-	cls.demoFile = 0;
+	Com_CloseDemo(cls.demoFile);
+	cls.demoFile = NULL;
 
 	Com_Printf("Stopped recording\n");
 }
@@ -185,18 +342,21 @@ void CL_StopRecord_f (void){
 */
 void CL_WriteDemoMessage (void){
 
-	int		len, swLen;
+	int		len;
 
 	if (!cls.demoFile || cls.demoWaiting)
 		return;
 
 	// The first eight bytes are just packet sequencing stuff
 	len = net_message.curSize-8;
-	swLen = LittleLong(len);
 
-	if (!swLen)
+	if (!len)
 		return;
 
-	FS_Write(&swLen, sizeof(swLen), cls.demoFile);
-	FS_Write(net_message.data+8, len, cls.demoFile);
+	Com_WriteDemoMessage(cls.demoFile, cl.frame.serverFrame, net_message.data+8, len);
+
+	// Playback continues with the next message after a seek, so the
+	// keyframe goes after this one
+	if (cl.frame.valid && Com_DemoKeyframeDue(cls.demoFile, cl.frame.serverFrame))
+		CL_WriteDemoKeyframe();
 }
@@ -444,7 +444,7 @@ typedef struct {
 	char			downloadTempName[MAX_QPATH];
 
 	// Demo recording information
-	fileHandle_t	demoFile;
+	demo_t			*demoFile;
 	qboolean		demoWaiting;
 	char			demoName[MAX_QPATH];
 
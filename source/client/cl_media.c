@@ -721,6 +721,79 @@ void CL_LoadClientInfo (clientInfo_t *ci, const char *string){
 	ci->valid = true;
 }
 
+/*
+ =================
+ CL_QueueMedia
+
+ Hands the files this level needs to the loader threads, so they are
+ read while the map is being loaded
+ =================
+*/
+static void CL_QueueMedia (void){
+
+	char	name[MAX_QPATH], model[MAX_QPATH];
+	char	*string, *ch;
+	int		i;
+
+	// Models
+	for (i = 2; i < MAX_MODELS; i++){
+		string = cl.configStrings[CS_MODELS+i];
+		if (!string[0])
+			break;
+
+		if (string[0] == '*' || string[0] == '#')
+			continue;
+
+		Com_QueueLoad(string, LOAD_PRIORITY_MODEL, NULL, NULL);
+	}
+
+	// Sounds
+	for (i = 1; i < MAX_SOUNDS; i++){
+		string = cl.configStrings[CS_SOUNDS+i];
+		if (!string[0])
+			break;
+
+		if (string[0] == '*')
+			continue;
+
+		if (string[0] == '#')
+			Q_snprintfz(name, sizeof(name), "%s", string+1);
+		else
+			Q_snprintfz(name, sizeof(name), "sound/%s", string);
+
+		Com_QueueLoad(name, LOAD_PRIORITY_SOUND, NULL, NULL);
+	}
+
+	// Player models and skins
+	if (cl_noSkins->integer)
+		return;
+
+	for (i = 0; i < MAX_CLIENTS; i++){
+		string = cl.configStrings[CS_PLAYERSKINS+i];
+		if (!string[0])
+			continue;
+
+		ch = strchr(string, '\\');
+		if (ch)
+			string = ch+1;
+
+		Q_strncpyz(model, string, sizeof(model));
+		ch = strchr(model, '/');
+		if (!ch)
+			ch = strchr(model, '\\');
+		if (!ch)
+			continue;
+
+		*ch++ = 0;
+
+		Q_snprintfz(name, sizeof(name), "players/%s/tris.md2", model);
+		Com_QueueLoad(name, LOAD_PRIORITY_MODEL, NULL, NULL);
+
+		Q_snprintfz(name, sizeof(name), "players/%s/%s", model, ch);
+		R_QueueTexture(name, LOAD_PRIORITY_SKIN);
+	}
+}
+
 /*
  =================
  CL_LoadGameMedia
@@ -769,6 +842,8 @@ void CL_LoadGameMedia (void){
 		cl.media.loadingPercent[i] = R_RegisterShaderNoMip(va("ui/loading/percent/load_%i", n));
 
 	// Register all the files for this level
+	CL_QueueMedia();
+
 	CL_LoadMap ();
 	CL_SoundMediaInit ();
 	CL_ModelMediaInit ();
@@ -780,6 +855,9 @@ void CL_LoadGameMedia (void){
 	CL_RegisterGraphics();
 	CL_RegisterClients();
 
+	// Anything that wasn't used is no longer needed
+	Com_FlushLoads();
+
 	// Start the background track
 	CL_PlayBackgroundTrack();
 
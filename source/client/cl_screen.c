@@ -1673,7 +1673,7 @@ static void CL_DrawRecording (void){
 	if (!cls.demoFile)
 		return;
 
-	Q_snprintfz(str, sizeof(str), "Recording: %s (%i KB)", cls.demoName, FS_Tell(cls.demoFile) / 1024);
+	Q_snprintfz(str, sizeof(str), "Recording: %s (%i KB)", cls.demoName, Com_DemoLength(cls.demoFile) / 1024);
 	CL_DrawString(0, 120, 10, 10, 0, 0, 640, str, colorWhite, clMedia.charsetMaterial, true, DSF_FORCECOLOR|DSF_DROPSHADOW|DSF_CENTER);
 }
 
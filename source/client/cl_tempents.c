@@ -360,23 +360,27 @@ static void CL_FindTrailPlane (const vec3_t start, const vec3_t end, vec3_t dir)
 static void CL_FindExplosionPlane (const vec3_t org, float radius, vec3_t dir){
 
 	static vec3_t	planes[6] = {{0, 0, 1}, {0, 1, 0}, {1, 0, 0}, {0, 0, -1}, {0, -1, 0}, {-1, 0, 0}};
-	trace_t			trace;
-	vec3_t			point;
+	trace_t			traces[6];
+	vec3_t			starts[6], points[6];
 	float			best = 1.0;
 	int				i;
 
 	VectorClear(dir);
 
 	for (i = 0; i < 6; i++){
-		VectorMA(org, radius, planes[i], point);
+		VectorCopy(org, starts[i]);
+		VectorMA(org, radius, planes[i], points[i]);
+	}
+
+	CM_BoxTraceMany(starts, points, 6, vec3_origin, vec3_origin, 0, MASK_SOLID, traces);
 
-		trace = CM_BoxTrace(org, point, vec3_origin, vec3_origin, 0, MASK_SOLID);
-		if (trace.allsolid || trace.fraction == 1.0)
+	for (i = 0; i < 6; i++){
+		if (traces[i].allsolid || traces[i].fraction == 1.0)
 			continue;
 
-		if (trace.fraction < best){
-			best = trace.fraction;
-			VectorCopy(trace.plane.normal, dir);
+		if (traces[i].fraction < best){
+			best = traces[i].fraction;
+			VectorCopy(traces[i].plane.normal, dir);
 		}
 	}
 }
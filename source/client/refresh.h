@@ -182,6 +182,29 @@ typedef struct {
 	int					maxRectangleTextureSize;
 } glConfig_t;
 
+// Counted from R_BeginFrame to R_EndFrame
+typedef struct {
+	int				numShaders;
+	int				numStages;
+	int				numMeshes;
+	int				numLeafs;
+	int				numVertices;
+	int				numIndices;
+	int				totalIndices;
+
+	int				numEntities;
+	int				numDLights;
+	int				numParticles;
+	int				numPolys;
+
+	// Microseconds spent in each part of R_RenderView
+	unsigned		timeWorld;
+	unsigned		timeEntities;
+	unsigned		timeParticles;
+	unsigned		timeSort;
+	unsigned		timeBackEnd;
+} refStats_t;
+
 // =====================================================================
 
 void			R_LoadWorldMap (const char *mapName, const char *skyName, float skyRotate, const vec3_t skyAxis);
@@ -191,6 +214,8 @@ struct shader_s	*R_RegisterShader (const char *name);
 struct shader_s	*R_RegisterShaderSkin (const char *name);
 struct shader_s	*R_RegisterShaderNoMip (const char *name);
 
+void			R_QueueTexture (const char *name, int priority);
+
 void			R_GetPicSize (const char *pic, float *w, float *h);
 void			R_DrawStretchPic (float x, float y, float w, float h, float sl, float tl, float sh, float th, const color_t modulate, struct shader_s *shader);
 void			R_DrawRotatedPic (float x, float y, float w, float h, float sl, float tl, float sh, float th, float angle, const color_t modulate, struct shader_s *shader);
@@ -217,6 +242,7 @@ qboolean		R_LerpTag (tag_t *tag, struct model_s *model, int curFrame, int oldFra
 int				R_MarkFragments (const vec3_t origin, const vec3_t axis[3], float radius, int maxVerts, vec3_t *verts, int maxFragments, markFragment_t *fragments);
 
 void			R_GetGLConfig (glConfig_t *config);
+void			R_GetStats (refStats_t *stats);
 
 void			R_BeginFrame (int realTime, float stereoSeparation);
 void			R_EndFrame (void);
@@ -547,12 +547,19 @@ T_RadiusDamage
 void T_RadiusDamage (edict_t *inflictor, edict_t *attacker, float damage, edict_t *ignore, float radius, int mod)
 {
 	float	points;
-	edict_t	*ent = NULL;
+	edict_t	*ent;
+	edict_t	*list[MAX_EDICTS];
 	vec3_t	v;
 	vec3_t	dir;
+	int		i, num;
 
-	while ((ent = findradius(ent, inflictor->s.origin, radius)) != NULL)
+	num = G_RadiusEdicts (inflictor->s.origin, radius, list, MAX_EDICTS);
+
+	for (i=0 ; i<num ; i++)
 	{
+		ent = list[i];
+		if (!ent->inuse)
+			continue;		// freed by an earlier T_Damage
 		if (ent == ignore)
 			continue;
 		if (!ent->takedamage)
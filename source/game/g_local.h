@@ -528,6 +528,7 @@ extern	gamecvar_t *password;
 extern	gamecvar_t *spectator_password;
 extern	gamecvar_t *needpass;
 extern	gamecvar_t *g_select_empty;
+extern	gamecvar_t *g_savecompress;
 extern	gamecvar_t *dedicated;
 
 extern	gamecvar_t *filterban;
@@ -632,7 +633,12 @@ void Touch_Item (edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *surf
 qboolean	KillBox (edict_t *ent);
 void	G_ProjectSource (vec3_t point, vec3_t distance, vec3_t forward, vec3_t right, vec3_t result);
 edict_t *G_Find (edict_t *from, int fieldofs, char *match);
+void	G_InitEdictIndex (void);
+void	G_ClearEdictIndex (void);
+void	G_IndexEdict (edict_t *ent);
+void	G_SyncEdictIndex (void);
 edict_t *findradius (edict_t *from, vec3_t org, float rad);
+int		G_RadiusEdicts (vec3_t org, float rad, edict_t **list, int maxcount);
 edict_t *G_PickTarget (char *targetname);
 void	G_UseTargets (edict_t *ent, edict_t *activator);
 void	G_SetMovedir (vec3_t angles, vec3_t movedir);
@@ -49,6 +49,7 @@ gamecvar_t *maxclients;
 gamecvar_t *maxspectators;
 gamecvar_t *maxentities;
 gamecvar_t *g_select_empty;
+gamecvar_t *g_savecompress;
 gamecvar_t *dedicated;
 
 gamecvar_t *filterban;
@@ -387,6 +388,9 @@ void G_RunFrame (void)
 	level.framenum++;
 	level.time = level.framenum*FRAMETIME;
 
+	// catch up with the fields that were assigned directly
+	G_SyncEdictIndex ();
+
 	// choose a client for monsters to target this frame
 	AI_SetSightClient ();
 
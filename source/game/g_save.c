@@ -20,6 +20,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "g_local.h"
 
+#include "../qcommon/include/zlib.h"
+
 #define Function(f) {#f, f}
 
 mmove_t mmove_reloc;
@@ -190,6 +192,7 @@ void InitGame (void)
 	filterban = gi.cvar ("filterban", "1", 0);
 
 	g_select_empty = gi.cvar ("g_select_empty", "0", CVAR_ARCHIVE);
+	g_savecompress = gi.cvar ("g_savecompress", "1", CVAR_ARCHIVE);
 
 	run_pitch = gi.cvar ("run_pitch", "0.002", 0);
 	run_roll = gi.cvar ("run_roll", "0.005", 0);
@@ -218,410 +221,582 @@ void InitGame (void)
 	globals.edicts = g_edicts;
 	globals.max_edicts = game.maxentities;
 
+	G_InitEdictIndex ();
+
 	// initialize all clients for this game
 	game.maxclients = maxclients->value;
 	game.clients = gi.TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME);
 	globals.num_edicts = game.maxclients+1;
 }
 
-//=========================================================
+/*
+==============================================================================
 
-void WriteField1 (FILE *f, field_t *field, byte *base)
-{
-	void		*p;
-	int			len;
-	int			index;
+SAVE FILES
 
-	if (field->flags & FFL_SPAWNTEMP)
-		return;
+Games and levels are serialized into memory and written to disk with a
+single fwrite, deflated if g_savecompress is set.  Structures are stored
+the way they are in memory, except that the pointers listed in the field
+tables are replaced by indexes or string lengths, and the strings follow
+the structure.
 
-	p = (void *)(base + field->ofs);
-	switch (field->type)
-	{
-	case F_INT:
-	case F_FLOAT:
-	case F_ANGLEHACK:
-	case F_VECTOR:
-	case F_IGNORE:
-		break;
-
-	case F_LSTRING:
-	case F_GSTRING:
-		if ( *(char **)p )
-			len = strlen(*(char **)p) + 1;
-		else
-			len = 0;
-		*(int *)p = len;
-		break;
-	case F_EDICT:
-		if ( *(edict_t **)p == NULL)
-			index = -1;
-		else
-			index = *(edict_t **)p - g_edicts;
-		*(int *)p = index;
-		break;
-	case F_CLIENT:
-		if ( *(gclient_t **)p == NULL)
-			index = -1;
-		else
-			index = *(gclient_t **)p - game.clients;
-		*(int *)p = index;
-		break;
-	case F_ITEM:
-		if ( *(edict_t **)p == NULL)
-			index = -1;
-		else
-			index = *(gitem_t **)p - itemlist;
-		*(int *)p = index;
-		break;
+==============================================================================
+*/
 
-	//relative to code segment
-	case F_FUNCTION:
-		if (*(byte **)p == NULL)
-			index = 0;
-		else
-			index = *(byte **)p - ((byte *)InitGame);
-		*(int *)p = index;
-		break;
+#define	SAVE_IDENT		(('V'<<24)+('S'<<16)+('2'<<8)+'Q')	// little-endian "Q2SV"
+#define	SAVE_VERSION	1
 
-	//relative to data segment
-	case F_MMOVE:
-		if (*(byte **)p == NULL)
-			index = 0;
-		else
-			index = *(byte **)p - (byte *)&mmove_reloc;
-		*(int *)p = index;
-		break;
+#define	SAVE_GAME		0
+#define	SAVE_LEVEL		1
 
-	default:
-		gi.error ("WriteEdict: unknown field type");
-	}
-}
+#define	SAVE_DEFLATED	1
 
+#define	MAX_SAVE_FIELDS	64
 
-void WriteField2 (FILE *f, field_t *field, byte *base)
+typedef struct
+{
+	int		ident;
+	int		version;
+	int		type;
+	int		flags;
+	int		localsSize;		// game_locals_t or level_locals_t
+	int		clientSize;
+	int		edictSize;
+	int		dataSize;		// after inflating
+	int		storedSize;
+} saveHeader_t;
+
+// the fields of a structure that have to be converted, built once from
+// the field tables above
+typedef struct
 {
-	int			len;
-	void		*p;
+	int			numfields;
+	int			ofs[MAX_SAVE_FIELDS];
+	fieldtype_t	type[MAX_SAVE_FIELDS];
+} saveTable_t;
 
-	if (field->flags & FFL_SPAWNTEMP)
-		return;
+typedef struct
+{
+	byte	*data;
+	int		size;
+	int		maxsize;
+	int		readcount;
+} saveBuffer_t;
+
+static saveTable_t	save_edict;
+static saveTable_t	save_client;
+static saveTable_t	save_level;
+static qboolean		save_compiled;
 
-	p = (void *)(base + field->ofs);
-	switch (field->type)
-	{
-	case F_LSTRING:
-		if ( *(char **)p )
-		{
-			len = strlen(*(char **)p) + 1;
-			fwrite (*(char **)p, len, 1, f);
-		}
-		break;
-	}
-}
 
-void ReadField (FILE *f, field_t *field, byte *base)
+static void CompileSaveTable (saveTable_t *table, field_t *fieldlist)
 {
-	void		*p;
-	int			len;
-	int			index;
+	field_t		*field;
 
-	if (field->flags & FFL_SPAWNTEMP)
-		return;
+	table->numfields = 0;
 
-	p = (void *)(base + field->ofs);
-	switch (field->type)
+	for (field=fieldlist ; field->name ; field++)
 	{
-	case F_INT:
-	case F_FLOAT:
-	case F_ANGLEHACK:
-	case F_VECTOR:
-	case F_IGNORE:
-		break;
-
-	case F_LSTRING:
-		len = *(int *)p;
-		if (!len)
-			*(char **)p = NULL;
-		else
+		if (field->flags & FFL_SPAWNTEMP)
+			continue;
+
+		switch (field->type)
 		{
-			*(char **)p = gi.TagMalloc (len, TAG_LEVEL);
-			fread (*(char **)p, len, 1, f);
+		case F_INT:
+		case F_FLOAT:
+		case F_ANGLEHACK:
+		case F_VECTOR:
+		case F_IGNORE:
+			continue;		// stored as they are
+		default:
+			break;
 		}
-		break;
-	case F_EDICT:
-		index = *(int *)p;
-		if ( index == -1 )
-			*(edict_t **)p = NULL;
-		else
-			*(edict_t **)p = &g_edicts[index];
-		break;
-	case F_CLIENT:
-		index = *(int *)p;
-		if ( index == -1 )
-			*(gclient_t **)p = NULL;
-		else
-			*(gclient_t **)p = &game.clients[index];
-		break;
-	case F_ITEM:
-		index = *(int *)p;
-		if ( index == -1 )
-			*(gitem_t **)p = NULL;
-		else
-			*(gitem_t **)p = &itemlist[index];
-		break;
-
-	//relative to code segment
-	case F_FUNCTION:
-		index = *(int *)p;
-		if ( index == 0 )
-			*(byte **)p = NULL;
-		else
-			*(byte **)p = ((byte *)InitGame) + index;
-		break;
 
-	//relative to data segment
-	case F_MMOVE:
-		index = *(int *)p;
-		if (index == 0)
-			*(byte **)p = NULL;
-		else
-			*(byte **)p = (byte *)&mmove_reloc + index;
-		break;
+		if (table->numfields == MAX_SAVE_FIELDS)
+			gi.error ("CompileSaveTable: MAX_SAVE_FIELDS");
 
-	default:
-		gi.error ("ReadEdict: unknown field type");
+		table->ofs[table->numfields] = field->ofs;
+		table->type[table->numfields] = field->type;
+		table->numfields++;
 	}
 }
 
-//=========================================================
+static void CompileSaveTables (void)
+{
+	if (save_compiled)
+		return;
+
+	CompileSaveTable (&save_edict, fields);
+	CompileSaveTable (&save_client, clientfields);
+	CompileSaveTable (&save_level, levelfields);
+
+	save_compiled = true;
+}
 
 /*
 ==============
-WriteClient
+SaveError
 
-All pointer variables (except function pointers) must be handled specially.
+gi.error never returns, so the buffer has to be freed first
 ==============
 */
-void WriteClient (FILE *f, gclient_t *client)
+static void SaveError (saveBuffer_t *sb, char *fmt, ...)
 {
-	field_t		*field;
-	gclient_t	temp;
-	
-	// all of the ints, floats, and vectors stay as they are
-	temp = *client;
+	va_list		argptr;
+	char		text[1024];
 
-	// change the pointers to lengths or indexes
-	for (field=clientfields ; field->name ; field++)
-	{
-		WriteField1 (f, field, (byte *)&temp);
-	}
+	va_start (argptr, fmt);
+	vsnprintf (text, sizeof(text), fmt, argptr);
+	va_end (argptr);
+
+	free (sb->data);
+	sb->data = NULL;
 
-	// write the block
-	fwrite (&temp, sizeof(temp), 1, f);
+	gi.error ("%s", text);
+}
+
+static void *SaveAlloc (saveBuffer_t *sb, int length)
+{
+	void	*p;
+	byte	*data;
 
-	// now write any allocated data following the edict
-	for (field=clientfields ; field->name ; field++)
+	if (sb->size + length > sb->maxsize)
 	{
-		WriteField2 (f, field, (byte *)client);
+		sb->maxsize = sb->maxsize * 2;
+		if (sb->maxsize < sb->size + length)
+			sb->maxsize = sb->size + length;
+		if (sb->maxsize < 0x10000)
+			sb->maxsize = 0x10000;
+
+		data = realloc (sb->data, sb->maxsize);
+		if (!data)
+			SaveError (sb, "SaveAlloc: couldn't allocate %i bytes", sb->maxsize);
+		sb->data = data;
 	}
+
+	p = sb->data + sb->size;
+	sb->size += length;
+
+	return p;
 }
 
-/*
-==============
-ReadClient
+static void SaveWrite (saveBuffer_t *sb, void *data, int length)
+{
+	memcpy (SaveAlloc (sb, length), data, length);
+}
 
-All pointer variables (except function pointers) must be handled specially.
-==============
-*/
-void ReadClient (FILE *f, gclient_t *client)
+static void *SaveRead (saveBuffer_t *sb, int length)
 {
-	field_t		*field;
+	void	*p;
 
-	fread (client, sizeof(*client), 1, f);
+	if (length < 0 || sb->readcount + length > sb->size)
+		SaveError (sb, "Savegame is truncated\n");
 
-	for (field=clientfields ; field->name ; field++)
-	{
-		ReadField (f, field, (byte *)client);
-	}
+	p = sb->data + sb->readcount;
+	sb->readcount += length;
+
+	return p;
 }
 
-/*
-============
-WriteGame
+static int SaveReadInt (saveBuffer_t *sb)
+{
+	int		i;
 
-This will be called whenever the game goes to a new level,
-and when the user explicitly saves the game.
+	memcpy (&i, SaveRead (sb, sizeof(i)), sizeof(i));
 
-Game information include cross level data, like multi level
-triggers, help computer info, and all client states.
+	return i;
+}
 
-A single player death will automatically restore from the
-last save position.
-============
+/*
+==============
+WriteBlock
+
+Appends a copy of the structure with its pointers converted, followed by
+its strings
+==============
 */
-void WriteGame (char *filename, qboolean autosave)
+static void WriteBlock (saveBuffer_t *sb, saveTable_t *table, void *base, int size)
 {
-	FILE	*f;
-	int		i;
-	char	str[16];
+	byte	*block;
+	void	*p;
+	char	*s;
+	int		i, index;
 
-	if (!autosave)
-		SaveClientData ();
+	block = SaveAlloc (sb, size);
+	memcpy (block, base, size);
 
-	f = fopen (filename, "wb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	for (i=0 ; i<table->numfields ; i++)
+	{
+		p = (void *)(block + table->ofs[i]);
+		switch (table->type[i])
+		{
+		case F_LSTRING:
+		case F_GSTRING:
+			if ( *(char **)p )
+				index = strlen(*(char **)p) + 1;
+			else
+				index = 0;
+			break;
+		case F_EDICT:
+			if ( *(edict_t **)p == NULL)
+				index = -1;
+			else
+				index = *(edict_t **)p - g_edicts;
+			break;
+		case F_CLIENT:
+			if ( *(gclient_t **)p == NULL)
+				index = -1;
+			else
+				index = *(gclient_t **)p - game.clients;
+			break;
+		case F_ITEM:
+			if ( *(gitem_t **)p == NULL)
+				index = -1;
+			else
+				index = *(gitem_t **)p - itemlist;
+			break;
 
-	memset (str, 0, sizeof(str));
-	strcpy (str, "Oct 16 1998");	// HACK
-	fwrite (str, sizeof(str), 1, f);
+		//relative to code segment
+		case F_FUNCTION:
+			if (*(byte **)p == NULL)
+				index = 0;
+			else
+				index = *(byte **)p - ((byte *)InitGame);
+			break;
 
-	game.autosaved = autosave;
-	fwrite (&game, sizeof(game), 1, f);
-	game.autosaved = false;
+		//relative to data segment
+		case F_MMOVE:
+			if (*(byte **)p == NULL)
+				index = 0;
+			else
+				index = *(byte **)p - (byte *)&mmove_reloc;
+			break;
 
-	for (i=0 ; i<game.maxclients ; i++)
-		WriteClient (f, &game.clients[i]);
+		default:
+			index = 0;
+			SaveError (sb, "WriteBlock: unknown field type");
+		}
 
-	fclose (f);
+		*(int *)p = index;
+	}
+
+	// the block may move from here on
+	for (i=0 ; i<table->numfields ; i++)
+	{
+		if (table->type[i] != F_LSTRING && table->type[i] != F_GSTRING)
+			continue;
+
+		s = *(char **)((byte *)base + table->ofs[i]);
+		if (s)
+			SaveWrite (sb, s, strlen(s) + 1);
+	}
 }
 
-void ReadGame (char *filename)
+/*
+==============
+ReadBlock
+==============
+*/
+static void ReadBlock (saveBuffer_t *sb, saveTable_t *table, void *base, int size)
 {
-	FILE	*f;
-	int		i;
-	char	str[16];
+	void	*p;
+	char	*s;
+	int		i, index;
 
-	gi.FreeTags (TAG_GAME);
-
-	f = fopen (filename, "rb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	memcpy (base, SaveRead (sb, size), size);
 
-	fread (str, sizeof(str), 1, f);
-	if (Q_strcmp(str, "Oct 16 1998"))	// HACK
+	for (i=0 ; i<table->numfields ; i++)
 	{
-		fclose (f);
-		gi.error ("Savegame from an older version.\n");
-	}
-
-	g_edicts =  gi.TagMalloc (game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
-	globals.edicts = g_edicts;
+		p = (void *)((byte *)base + table->ofs[i]);
+		index = *(int *)p;
 
-	fread (&game, sizeof(game), 1, f);
-	game.clients = gi.TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME);
-	for (i=0 ; i<game.maxclients ; i++)
-		ReadClient (f, &game.clients[i]);
+		switch (table->type[i])
+		{
+		case F_LSTRING:
+		case F_GSTRING:
+			if (!index)
+			{
+				*(char **)p = NULL;
+				break;
+			}
+			s = gi.TagMalloc (index, (table->type[i] == F_LSTRING) ? TAG_LEVEL : TAG_GAME);
+			memcpy (s, SaveRead (sb, index), index);
+			s[index-1] = 0;
+			*(char **)p = s;
+			break;
+		case F_EDICT:
+			if (index < -1 || index >= game.maxentities)
+				SaveError (sb, "ReadBlock: bad edict index %i", index);
+			if ( index == -1 )
+				*(edict_t **)p = NULL;
+			else
+				*(edict_t **)p = &g_edicts[index];
+			break;
+		case F_CLIENT:
+			if (index < -1 || index >= game.maxclients)
+				SaveError (sb, "ReadBlock: bad client index %i", index);
+			if ( index == -1 )
+				*(gclient_t **)p = NULL;
+			else
+				*(gclient_t **)p = &game.clients[index];
+			break;
+		case F_ITEM:
+			if (index < -1 || index >= game.num_items)
+				SaveError (sb, "ReadBlock: bad item index %i", index);
+			if ( index == -1 )
+				*(gitem_t **)p = NULL;
+			else
+				*(gitem_t **)p = &itemlist[index];
+			break;
 
-	fclose (f);
-}
+		//relative to code segment
+		case F_FUNCTION:
+			if ( index == 0 )
+				*(byte **)p = NULL;
+			else
+				*(byte **)p = ((byte *)InitGame) + index;
+			break;
 
-//==========================================================
+		//relative to data segment
+		case F_MMOVE:
+			if (index == 0)
+				*(byte **)p = NULL;
+			else
+				*(byte **)p = (byte *)&mmove_reloc + index;
+			break;
 
+		default:
+			SaveError (sb, "ReadBlock: unknown field type");
+		}
+	}
+}
 
 /*
 ==============
-WriteEdict
+BeginSave
 
-All pointer variables (except function pointers) must be handled specially.
+Leaves room for the header
 ==============
 */
-void WriteEdict (FILE *f, edict_t *ent)
+static void BeginSave (saveBuffer_t *sb)
 {
-	field_t		*field;
-	edict_t		temp;
+	CompileSaveTables ();
+
+	memset (sb, 0, sizeof(*sb));
+	SaveAlloc (sb, sizeof(saveHeader_t));
+}
 
-	// all of the ints, floats, and vectors stay as they are
-	temp = *ent;
+/*
+==============
+FinishSave
 
-	// change the pointers to lengths or indexes
-	for (field=fields ; field->name ; field++)
+Fills in the header, deflates the data if wanted, and writes it all out
+at once
+==============
+*/
+static void FinishSave (saveBuffer_t *sb, char *filename, int type)
+{
+	saveHeader_t	header;
+	FILE			*f;
+	byte			*out;
+	uLongf			outlen;
+	int				level;
+
+	header.ident = SAVE_IDENT;
+	header.version = SAVE_VERSION;
+	header.type = type;
+	header.flags = 0;
+	header.localsSize = (type == SAVE_GAME) ? sizeof(game_locals_t) : sizeof(level_locals_t);
+	header.clientSize = sizeof(gclient_t);
+	header.edictSize = sizeof(edict_t);
+	header.dataSize = sb->size - sizeof(header);
+	header.storedSize = header.dataSize;
+
+	out = sb->data;
+
+	level = g_savecompress->value;
+	if (level > 9)
+		level = 9;
+
+	if (level > 0)
 	{
-		WriteField1 (f, field, (byte *)&temp);
+		// zlib wants a little more than the input in the worst case
+		outlen = header.dataSize + (header.dataSize >> 8) + 64;
+		out = malloc (sizeof(header) + outlen);
+
+		if (out && compress2 (out + sizeof(header), &outlen, sb->data + sizeof(header), header.dataSize, level) == Z_OK && outlen < header.dataSize)
+		{
+			header.flags |= SAVE_DEFLATED;
+			header.storedSize = outlen;
+		}
+		else
+		{
+			free (out);
+			out = sb->data;
+		}
 	}
 
-	// write the block
-	fwrite (&temp, sizeof(temp), 1, f);
+	memcpy (out, &header, sizeof(header));
 
-	// now write any allocated data following the edict
-	for (field=fields ; field->name ; field++)
+	f = fopen (filename, "wb");
+	if (!f)
 	{
-		WriteField2 (f, field, (byte *)ent);
+		if (out != sb->data)
+			free (out);
+		SaveError (sb, "Couldn't open %s", filename);
 	}
 
+	if (fwrite (out, sizeof(header) + header.storedSize, 1, f) != 1)
+		gi.dprintf ("Couldn't write %s\n", filename);
+
+	fclose (f);
+
+	if (out != sb->data)
+		free (out);
+	free (sb->data);
 }
 
 /*
 ==============
-WriteLevelLocals
+LoadSave
 
-All pointer variables (except function pointers) must be handled specially.
+Reads the whole file and inflates it if needed
 ==============
 */
-void WriteLevelLocals (FILE *f)
+static void LoadSave (saveBuffer_t *sb, char *filename, int type)
 {
-	field_t		*field;
-	level_locals_t		temp;
+	saveHeader_t	header;
+	FILE			*f;
+	byte			*stored;
+	uLongf			outlen;
+	int				length;
+
+	CompileSaveTables ();
 
-	// all of the ints, floats, and vectors stay as they are
-	temp = level;
+	memset (sb, 0, sizeof(*sb));
 
-	// change the pointers to lengths or indexes
-	for (field=levelfields ; field->name ; field++)
+	f = fopen (filename, "rb");
+	if (!f)
+		gi.error ("Couldn't open %s", filename);
+
+	if (fread (&header, sizeof(header), 1, f) != 1 || header.ident != SAVE_IDENT || header.version != SAVE_VERSION)
 	{
-		WriteField1 (f, field, (byte *)&temp);
+		fclose (f);
+		gi.error ("Savegame from an older version.\n");
 	}
 
-	// write the block
-	fwrite (&temp, sizeof(temp), 1, f);
+	if (header.type != type || header.clientSize != sizeof(gclient_t) || header.edictSize != sizeof(edict_t)
+		|| header.localsSize != ((type == SAVE_GAME) ? sizeof(game_locals_t) : sizeof(level_locals_t)))
+	{
+		fclose (f);
+		gi.error ("Savegame doesn't match this game.\n");
+	}
 
-	// now write any allocated data following the edict
-	for (field=levelfields ; field->name ; field++)
+	if (header.dataSize < 0 || header.storedSize < 0 || header.storedSize > header.dataSize)
 	{
-		WriteField2 (f, field, (byte *)&level);
+		fclose (f);
+		gi.error ("Savegame is corrupt.\n");
 	}
-}
 
+	sb->data = malloc (header.dataSize + 1);
+	sb->size = sb->maxsize = header.dataSize;
 
-/*
-==============
-ReadEdict
+	if (header.flags & SAVE_DEFLATED)
+		stored = malloc (header.storedSize + 1);
+	else
+		stored = sb->data;
 
-All pointer variables (except function pointers) must be handled specially.
-==============
-*/
-void ReadEdict (FILE *f, edict_t *ent)
-{
-	field_t		*field;
+	if (!sb->data || !stored)
+	{
+		fclose (f);
+		if (stored != sb->data)
+			free (stored);
+		SaveError (sb, "LoadSave: couldn't allocate %i bytes", header.dataSize);
+	}
+
+	length = fread (stored, 1, header.storedSize, f);
+	fclose (f);
 
-	fread (ent, sizeof(*ent), 1, f);
+	if (length != header.storedSize)
+	{
+		if (stored != sb->data)
+			free (stored);
+		SaveError (sb, "Savegame is truncated\n");
+	}
 
-	for (field=fields ; field->name ; field++)
+	if (header.flags & SAVE_DEFLATED)
 	{
-		ReadField (f, field, (byte *)ent);
+		outlen = header.dataSize;
+		if (uncompress (sb->data, &outlen, stored, header.storedSize) != Z_OK || outlen != header.dataSize)
+		{
+			free (stored);
+			SaveError (sb, "Savegame is corrupt.\n");
+		}
+
+		free (stored);
 	}
 }
 
+//=========================================================
+
 /*
-==============
-ReadLevelLocals
+============
+WriteGame
 
-All pointer variables (except function pointers) must be handled specially.
-==============
+This will be called whenever the game goes to a new level,
+and when the user explicitly saves the game.
+
+Game information include cross level data, like multi level
+triggers, help computer info, and all client states.
+
+A single player death will automatically restore from the
+last save position.
+============
 */
-void ReadLevelLocals (FILE *f)
+void WriteGame (char *filename, qboolean autosave)
 {
-	field_t		*field;
+	saveBuffer_t	sb;
+	int				i;
 
-	fread (&level, sizeof(level), 1, f);
+	if (!autosave)
+		SaveClientData ();
 
-	for (field=levelfields ; field->name ; field++)
-	{
-		ReadField (f, field, (byte *)&level);
-	}
+	BeginSave (&sb);
+
+	game.autosaved = autosave;
+	SaveWrite (&sb, &game, sizeof(game));
+	game.autosaved = false;
+
+	for (i=0 ; i<game.maxclients ; i++)
+		WriteBlock (&sb, &save_client, &game.clients[i], sizeof(gclient_t));
+
+	FinishSave (&sb, filename, SAVE_GAME);
+}
+
+void ReadGame (char *filename)
+{
+	saveBuffer_t	sb;
+	int				i;
+
+	gi.FreeTags (TAG_GAME);
+
+	LoadSave (&sb, filename, SAVE_GAME);
+
+	g_edicts =  gi.TagMalloc (game.maxentities * sizeof(g_edicts[0]), TAG_GAME);
+	globals.edicts = g_edicts;
+
+	memcpy (&game, SaveRead (&sb, sizeof(game)), sizeof(game));
+	game.clients = gi.TagMalloc (game.maxclients * sizeof(game.clients[0]), TAG_GAME);
+	G_InitEdictIndex ();
+	for (i=0 ; i<game.maxclients ; i++)
+		ReadBlock (&sb, &save_client, &game.clients[i], sizeof(gclient_t));
+
+	free (sb.data);
 }
 
+//==========================================================
+
+
 /*
 =================
 WriteLevel
@@ -630,26 +805,14 @@ WriteLevel
 */
 void WriteLevel (char *filename)
 {
+	saveBuffer_t	sb;
 	int		i;
 	edict_t	*ent;
-	FILE	*f;
-	void	*base;
-
-	f = fopen (filename, "wb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
-
-	// write out edict size for checking
-	i = sizeof(edict_t);
-	fwrite (&i, sizeof(i), 1, f);
 
-	// write out a function pointer for checking
-//	base = (void *)InitGame;
-	base = (void *)0x20011cb0;
-	fwrite (&base, sizeof(base), 1, f);
+	BeginSave (&sb);
 
 	// write out level_locals_t
-	WriteLevelLocals (f);
+	WriteBlock (&sb, &save_level, &level, sizeof(level));
 
 	// write out all the entities
 	for (i=0 ; i<globals.num_edicts ; i++)
@@ -657,13 +820,13 @@ void WriteLevel (char *filename)
 		ent = &g_edicts[i];
 		if (!ent->inuse)
 			continue;
-		fwrite (&i, sizeof(i), 1, f);
-		WriteEdict (f, ent);
+		SaveWrite (&sb, &i, sizeof(i));
+		WriteBlock (&sb, &save_edict, ent, sizeof(edict_t));
 	}
 	i = -1;
-	fwrite (&i, sizeof(i), 1, f);
+	SaveWrite (&sb, &i, sizeof(i));
 
-	fclose (f);
+	FinishSave (&sb, filename, SAVE_LEVEL);
 }
 
 
@@ -685,15 +848,12 @@ No clients are connected yet.
 */
 void ReadLevel (char *filename)
 {
+	saveBuffer_t	sb;
 	int		entnum;
-	FILE	*f;
 	int		i;
-	void	*base;
 	edict_t	*ent;
 
-	f = fopen (filename, "rb");
-	if (!f)
-		gi.error ("Couldn't open %s", filename);
+	LoadSave (&sb, filename, SAVE_LEVEL);
 
 	// free any dynamic memory allocated by loading the level
 	// base state
@@ -702,54 +862,31 @@ void ReadLevel (char *filename)
 	// wipe all the entities
 	memset (g_edicts, 0, game.maxentities*sizeof(g_edicts[0]));
 	globals.num_edicts = maxclients->value+1;
-
-	// check edict size
-	fread (&i, sizeof(i), 1, f);
-	if (i != sizeof(edict_t))
-	{
-		fclose (f);
-		gi.error ("ReadLevel: mismatched edict size");
-	}
-
-	// check function pointer base address
-	fread (&base, sizeof(base), 1, f);
-#if 0	// HACK
-#ifdef _WIN32
-	if (base != (void *)InitGame)
-	{
-		fclose (f);
-		gi.error ("ReadLevel: function pointers have moved");
-	}
-#else
-	gi.dprintf("Function offsets %d\n", ((byte *)base) - ((byte *)InitGame));
-#endif
-#endif
+	G_ClearEdictIndex ();
 
 	// load the level locals
-	ReadLevelLocals (f);
+	ReadBlock (&sb, &save_level, &level, sizeof(level));
 
 	// load all the entities
 	while (1)
 	{
-		if (fread (&entnum, sizeof(entnum), 1, f) != 1)
-		{
-			fclose (f);
-			gi.error ("ReadLevel: failed to read entnum");
-		}
+		entnum = SaveReadInt (&sb);
 		if (entnum == -1)
 			break;
+		if (entnum < 0 || entnum >= game.maxentities)
+			SaveError (&sb, "ReadLevel: bad entnum %i", entnum);
 		if (entnum >= globals.num_edicts)
 			globals.num_edicts = entnum+1;
 
 		ent = &g_edicts[entnum];
-		ReadEdict (f, ent);
+		ReadBlock (&sb, &save_edict, ent, sizeof(edict_t));
 
 		// let the server rebuild world links for this ent
 		memset (&ent->area, 0, sizeof(ent->area));
 		gi.linkentity (ent);
 	}
 
-	fclose (f);
+	free (sb.data);
 
 	// mark all clients as unconnected
 	for (i=0 ; i<maxclients->value ; i++)
@@ -759,6 +896,8 @@ void ReadLevel (char *filename)
 		ent->client->pers.connected = false;
 	}
 
+	G_SyncEdictIndex ();
+
 	// do any load time things at this point
 	for (i=0 ; i<globals.num_edicts ; i++)
 	{
@@ -295,6 +295,7 @@ void ED_CallSpawn (edict_t *ent)
 		if (!Q_strcmp(item->classname, ent->classname))
 		{	// found it
 			SpawnItem (ent, item);
+			G_IndexEdict (ent);
 			return;
 		}
 	}
@@ -305,6 +306,7 @@ void ED_CallSpawn (edict_t *ent)
 		if (!Q_strcmp(s->name, ent->classname))
 		{	// found it
 			s->spawn (ent);
+			G_IndexEdict (ent);
 			return;
 		}
 	}
@@ -539,6 +541,7 @@ void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 
 	memset (&level, 0, sizeof(level));
 	memset (g_edicts, 0, game.maxentities * sizeof (g_edicts[0]));
+	G_ClearEdictIndex ();
 
 	strncpy (level.mapname, mapname, sizeof(level.mapname)-1);
 	strncpy (game.spawnpoint, spawnpoint, sizeof(game.spawnpoint)-1);
@@ -614,6 +617,8 @@ void SpawnEntities (char *mapname, char *entities, char *spawnpoint)
 	}
 #endif
 
+	G_SyncEdictIndex ();
+
 	G_FindTeams ();
 
 	PlayerTrail_Init ();
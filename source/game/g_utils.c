@@ -30,6 +30,288 @@ void G_ProjectSource (vec3_t point, vec3_t distance, vec3_t forward, vec3_t righ
 }
 
 
+/*
+==============================================================================
+
+Entity index
+
+Entities are hashed by classname and targetname, so G_Find doesn't have
+to compare the strings of every entity.  Each chain is kept in entity
+number order, which keeps G_Find returning entities in the same order as
+a linear scan.
+
+The game assigns these fields directly all over the place, so the index
+remembers the string each entity was hashed with and rehashes it when
+that changes.  This happens whenever entities are spawned or freed, and
+for everything else at the start of each frame.  G_Find still compares
+the strings, so an entity that was renamed during the frame is never
+returned by mistake.
+
+Most assignments come right after G_Spawn, so G_Find rehashes every
+entity spawned since the start of the frame before using the index.  The
+few places that rename an entity that was already around call
+G_IndexEdict themselves.
+
+==============================================================================
+*/
+
+#define	INDEX_HASHSIZE	1024
+
+typedef struct
+{
+	int		fieldofs;
+	int		hash[INDEX_HASHSIZE];	// first entity number of each chain, -1 if empty
+	int		*next;					// next entity number in the same chain
+	int		*key;					// chain the entity is linked into, -1 if none
+	char	**value;				// string the entity was hashed with
+} edictIndex_t;
+
+static edictIndex_t	g_indexes[2];
+
+static int			*g_spawnedEdicts;	// spawned since the last G_SyncEdictIndex
+static int			g_numSpawnedEdicts;
+
+
+static unsigned G_IndexKey (char *s)
+{
+	unsigned	key;
+	int			c;
+
+	key = 0;
+	while (*s)
+	{
+		c = *s++;
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		key = key*31 + c;
+	}
+
+	return key & (INDEX_HASHSIZE-1);
+}
+
+static edictIndex_t *G_IndexForField (int fieldofs)
+{
+	int		i;
+
+	for (i=0 ; i<2 ; i++)
+	{
+		if (g_indexes[i].fieldofs == fieldofs && g_indexes[i].next)
+			return &g_indexes[i];
+	}
+
+	return NULL;
+}
+
+static void G_UnlinkIndex (edictIndex_t *index, int num)
+{
+	int		*prev;
+
+	if (index->key[num] == -1)
+		return;
+
+	for (prev = &index->hash[index->key[num]] ; *prev != -1 ; prev = &index->next[*prev])
+	{
+		if (*prev == num)
+		{
+			*prev = index->next[num];
+			break;
+		}
+	}
+
+	index->next[num] = -1;
+	index->key[num] = -1;
+	index->value[num] = NULL;
+}
+
+static void G_LinkIndex (edictIndex_t *index, int num, char *value)
+{
+	int		*prev;
+	int		key;
+
+	key = G_IndexKey (value);
+
+	// keep the chain sorted by entity number
+	for (prev = &index->hash[key] ; *prev != -1 && *prev < num ; prev = &index->next[*prev])
+		;
+
+	index->next[num] = *prev;
+	*prev = num;
+
+	index->key[num] = key;
+	index->value[num] = value;
+}
+
+/*
+=============
+G_InitEdictIndex
+
+Allocates the index for game.maxentities entities
+=============
+*/
+void G_InitEdictIndex (void)
+{
+	int		i;
+
+	g_indexes[0].fieldofs = FOFS(classname);
+	g_indexes[1].fieldofs = FOFS(targetname);
+
+	for (i=0 ; i<2 ; i++)
+	{
+		g_indexes[i].next = gi.TagMalloc (game.maxentities * sizeof(int), TAG_GAME);
+		g_indexes[i].key = gi.TagMalloc (game.maxentities * sizeof(int), TAG_GAME);
+		g_indexes[i].value = gi.TagMalloc (game.maxentities * sizeof(char *), TAG_GAME);
+	}
+
+	g_spawnedEdicts = gi.TagMalloc (game.maxentities * sizeof(int), TAG_GAME);
+
+	G_ClearEdictIndex ();
+}
+
+/*
+=============
+G_ClearEdictIndex
+
+Empties the index, call whenever all entities are wiped
+=============
+*/
+void G_ClearEdictIndex (void)
+{
+	int		i, j;
+
+	g_numSpawnedEdicts = 0;
+
+	for (i=0 ; i<2 ; i++)
+	{
+		if (!g_indexes[i].next)
+			continue;
+
+		for (j=0 ; j<INDEX_HASHSIZE ; j++)
+			g_indexes[i].hash[j] = -1;
+
+		for (j=0 ; j<game.maxentities ; j++)
+		{
+			g_indexes[i].next[j] = -1;
+			g_indexes[i].key[j] = -1;
+			g_indexes[i].value[j] = NULL;
+		}
+	}
+}
+
+/*
+=============
+G_IndexEdict
+
+Rehashes the entity if one of its indexed fields changed
+=============
+*/
+void G_IndexEdict (edict_t *ent)
+{
+	edictIndex_t	*index;
+	char			*value;
+	int				i, num;
+
+	num = ent - g_edicts;
+
+	for (i=0, index=g_indexes ; i<2 ; i++, index++)
+	{
+		if (!index->next)
+			continue;
+
+		if (ent->inuse)
+			value = *(char **) ((byte *)ent + index->fieldofs);
+		else
+			value = NULL;
+
+		if (value == index->value[num] && (value != NULL) == (index->key[num] != -1))
+			continue;
+
+		G_UnlinkIndex (index, num);
+
+		if (value)
+			G_LinkIndex (index, num, value);
+	}
+}
+
+/*
+=============
+G_SyncEdictIndex
+
+Picks up the fields that were changed since the last call
+=============
+*/
+void G_SyncEdictIndex (void)
+{
+	int		i;
+
+	for (i=0 ; i<globals.num_edicts ; i++)
+		G_IndexEdict (&g_edicts[i]);
+
+	g_numSpawnedEdicts = 0;
+}
+
+/*
+=============
+G_SpawnedEdict
+
+Remembers the entity, so G_Find can pick up the fields that are
+assigned right after it was spawned
+=============
+*/
+static void G_SpawnedEdict (edict_t *ent)
+{
+	if (!g_spawnedEdicts)
+		return;
+
+	if (g_numSpawnedEdicts == game.maxentities)
+	{
+		G_SyncEdictIndex ();
+		return;
+	}
+
+	g_spawnedEdicts[g_numSpawnedEdicts++] = ent - g_edicts;
+}
+
+static edict_t *G_FindIndexed (edictIndex_t *index, edict_t *from, char *match)
+{
+	edict_t	*ent;
+	char	*s;
+	int		num, start, key;
+	int		i;
+
+	for (i=0 ; i<g_numSpawnedEdicts ; i++)
+		G_IndexEdict (&g_edicts[g_spawnedEdicts[i]]);
+
+	key = G_IndexKey (match);
+
+	if (from)
+		start = from - g_edicts;
+	else
+		start = -1;
+
+	if (start != -1 && index->key[start] == key)
+		num = index->next[start];
+	else
+	{
+		for (num = index->hash[key] ; num != -1 && num <= start ; num = index->next[num])
+			;
+	}
+
+	for ( ; num != -1 ; num = index->next[num])
+	{
+		ent = &g_edicts[num];
+		if (!ent->inuse)
+			continue;
+		s = *(char **) ((byte *)ent + index->fieldofs);
+		if (!s)
+			continue;
+		if (!Q_stricmp(s, match))
+			return ent;
+	}
+
+	return NULL;
+}
+
+
 /*
 =============
 G_Find
@@ -44,8 +326,13 @@ NULL will be returned if the end of the list is reached.
 */
 edict_t *G_Find (edict_t *from, int fieldofs, char *match)
 {
+	edictIndex_t	*index;
 	char	*s;
 
+	index = G_IndexForField (fieldofs);
+	if (index && match)
+		return G_FindIndexed (index, from, match);
+
 	if (!from)
 		from = g_edicts;
 	else
@@ -92,7 +379,7 @@ edict_t *findradius (edict_t *from, vec3_t org, float rad)
 			continue;
 		for (j=0 ; j<3 ; j++)
 			eorg[j] = org[j] - (from->s.origin[j] + (from->mins[j] + from->maxs[j])*0.5);
-		if (VectorLength(eorg) > rad)
+		if (DotProduct(eorg, eorg) > rad*rad)
 			continue;
 		return from;
 	}
@@ -101,6 +388,61 @@ edict_t *findradius (edict_t *from, vec3_t org, float rad)
 }
 
 
+static int EdictNumSort (void const *a, void const *b)
+{
+	return *(edict_t **)a - *(edict_t **)b;
+}
+
+/*
+=================
+G_RadiusEdicts
+
+Fills list with the solid and trigger entities whose centers are within
+rad of org, in entity number order, and returns how many were found.
+
+Asks the server's area tree for the entities in the surrounding box
+instead of walking every entity like findradius, so only linked entities
+are returned.
+=================
+*/
+int G_RadiusEdicts (vec3_t org, float rad, edict_t **list, int maxcount)
+{
+	edict_t	*touch[MAX_EDICTS], *hit;
+	vec3_t	mins, maxs, eorg;
+	float	rad2;
+	int		i, j, num, count;
+
+	for (j=0 ; j<3 ; j++)
+	{
+		mins[j] = org[j] - rad;
+		maxs[j] = org[j] + rad;
+	}
+
+	num = gi.BoxEdicts (mins, maxs, touch, MAX_EDICTS, AREA_SOLID);
+	num += gi.BoxEdicts (mins, maxs, touch+num, MAX_EDICTS-num, AREA_TRIGGERS);
+
+	rad2 = rad*rad;
+	count = 0;
+
+	for (i=0 ; i<num && count<maxcount ; i++)
+	{
+		hit = touch[i];
+		if (!hit->inuse)
+			continue;
+		for (j=0 ; j<3 ; j++)
+			eorg[j] = org[j] - (hit->s.origin[j] + (hit->mins[j] + hit->maxs[j])*0.5);
+		if (DotProduct(eorg, eorg) > rad2)
+			continue;
+		list[count++] = hit;
+	}
+
+	// keep the order findradius would have returned them in
+	qsort (list, count, sizeof(list[0]), EdictNumSort);
+
+	return count;
+}
+
+
 /*
 =============
 G_PickTarget
@@ -404,6 +746,9 @@ void G_InitEdict (edict_t *e)
 	e->classname = "noclass";
 	e->gravity = 1.0;
 	e->s.number = e - g_edicts;
+
+	G_IndexEdict (e);
+	G_SpawnedEdict (e);
 }
 
 /*
@@ -463,6 +808,8 @@ void G_FreeEdict (edict_t *ed)
 	ed->classname = "freed";
 	ed->freetime = level.time;
 	ed->inuse = false;
+
+	G_IndexEdict (ed);
 }
 
 
@@ -549,7 +896,38 @@ of ent.  Ent should be unlinked before calling this!
 qboolean KillBox (edict_t *ent)
 {
 	trace_t		tr;
+	edict_t		*touch[MAX_EDICTS], *hit;
+	vec3_t		mins, maxs;
+	int			i, j, num;
+
+	// telefrag everyone standing in the box at once, instead of
+	// tracing again for every one of them
+	VectorAdd (ent->s.origin, ent->mins, mins);
+	VectorAdd (ent->s.origin, ent->maxs, maxs);
+
+	num = gi.BoxEdicts (mins, maxs, touch, MAX_EDICTS, AREA_SOLID);
+
+	for (i=0 ; i<num ; i++)
+	{
+		hit = touch[i];
+		if (hit == ent || !hit->inuse || hit->solid != SOLID_BBOX)
+			continue;
+		if (hit->svflags & SVF_DEADMONSTER)
+			continue;		// not in MASK_PLAYERSOLID
+		for (j=0 ; j<3 ; j++)
+		{
+			if (hit->s.origin[j] + hit->mins[j] >= maxs[j] || hit->s.origin[j] + hit->maxs[j] <= mins[j])
+				break;
+		}
+		if (j != 3)
+			continue;		// only within the link epsilon
+
+		// nail it
+		T_Damage (hit, ent, ent, vec3_origin, ent->s.origin, vec3_origin, 100000, 0, DAMAGE_NO_PROTECTION, MOD_TELEFRAG);
+	}
 
+	// whatever is left (the world, brush models and anything that
+	// survived) is found by tracing
 	while (1)
 	{
 		tr = gi.trace (ent->s.origin, ent->mins, ent->maxs, ent->s.origin, NULL, MASK_PLAYERSOLID);
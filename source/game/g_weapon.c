@@ -724,16 +724,21 @@ fire_bfg
 void bfg_explode (edict_t *self)
 {
 	edict_t	*ent;
+	edict_t	*list[MAX_EDICTS];
 	float	points;
 	vec3_t	v;
 	float	dist;
+	int		i, num;
 
 	if (self->s.frame == 0)
 	{
 		// the BFG effect
-		ent = NULL;
-		while ((ent = findradius(ent, self->s.origin, self->dmg_radius)) != NULL)
+		num = G_RadiusEdicts (self->s.origin, self->dmg_radius, list, MAX_EDICTS);
+		for (i=0 ; i<num ; i++)
 		{
+			ent = list[i];
+			if (!ent->inuse)
+				continue;
 			if (!ent->takedamage)
 				continue;
 			if (ent == self->owner)
@@ -808,11 +813,13 @@ void bfg_think (edict_t *self)
 {
 	edict_t	*ent;
 	edict_t	*ignore;
+	edict_t	*list[MAX_EDICTS];
 	vec3_t	point;
 	vec3_t	dir;
 	vec3_t	start;
 	vec3_t	end;
 	int		dmg;
+	int		n, num;
 	trace_t	tr;
 
 	if (deathmatch->value)
@@ -820,9 +827,13 @@ void bfg_think (edict_t *self)
 	else
 		dmg = 10;
 
-	ent = NULL;
-	while ((ent = findradius(ent, self->s.origin, 256)) != NULL)
+	num = G_RadiusEdicts (self->s.origin, 256, list, MAX_EDICTS);
+	for (n=0 ; n<num ; n++)
 	{
+		ent = list[n];
+		if (!ent->inuse)
+			continue;
+
 		if (ent == self)
 			continue;
 
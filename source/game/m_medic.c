@@ -45,11 +45,15 @@ static int	sound_hook_retract;
 
 edict_t *medic_FindDeadMonster (edict_t *self)
 {
-	edict_t	*ent = NULL;
+	edict_t	*ent;
 	edict_t	*best = NULL;
+	edict_t	*list[MAX_EDICTS];
+	int		i, num;
 
-	while ((ent = findradius(ent, self->s.origin, 1024)) != NULL)
+	num = G_RadiusEdicts (self->s.origin, 1024, list, MAX_EDICTS);
+	for (i=0 ; i<num ; i++)
 	{
+		ent = list[i];
 		if (ent == self)
 			continue;
 		if (!(ent->svflags & SVF_MONSTER))
@@ -57,6 +57,7 @@ static void SP_FixCoopSpots (edict_t *self)
 			{
 //				gi.dprintf("FixCoopSpots changed %s at %s targetname from %s to %s\n", self->classname, vtos(self->s.origin), self->targetname, spot->targetname);
 				self->targetname = spot->targetname;
+				G_IndexEdict (self);
 			}
 			return;
 		}
@@ -1167,6 +1168,7 @@ void PutClientInServer (edict_t *ent)
 	ent->viewheight = 22;
 	ent->inuse = true;
 	ent->classname = "player";
+	G_IndexEdict (ent);
 	ent->mass = 200;
 	ent->solid = SOLID_BBOX;
 	ent->deadflag = DEAD_NO;
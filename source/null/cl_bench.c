@@ -0,0 +1,613 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// cl_bench.c -- client for the headless renderer benchmark
+//
+// Links the refresh with the null GL driver instead of the client, and
+// plays back scenes recorded with "recordscenes". Nothing is drawn, so
+// the timings are those of the CPU side of the renderer.
+//
+//   refbench +benchscenes <name> [csv file] +quit
+
+
+#include "../qcommon/qcommon.h"
+#include "../client/refresh.h"
+#include "../client/cinematic.h"
+
+
+// Same as the limits of the refresh
+#define MAX_BENCH_MODELS		1024
+#define MAX_BENCH_SHADERS		1024
+
+typedef struct {
+	fileHandle_t	file;
+	fileHandle_t	csvFile;
+
+	byte			*data;
+	int				dataSize;
+
+	qboolean		worldLoaded;
+
+	struct model_s	*models[MAX_BENCH_MODELS];
+	struct shader_s	*shaders[MAX_BENCH_SHADERS];
+
+	// Current frame
+	qboolean		inFrame;
+	unsigned		frameStart;
+
+	// Totals
+	int				numFrames;
+	int				numViews;
+	unsigned		loadTime;
+	unsigned		frameTime;
+	unsigned		minFrameTime;
+	unsigned		maxFrameTime;
+
+	refStats_t		stats;
+} bench_t;
+
+static bench_t		bench;
+
+static qboolean		bench_initialized;
+
+static entity_t		bench_entity;
+static polyVert_t	bench_polyVerts[MAX_POLY_VERTS];
+
+
+/*
+ =================
+ CL_BenchModel
+ =================
+*/
+static struct model_s *CL_BenchModel (int index){
+
+	if (index == -1)
+		return NULL;
+
+	if (index < 0 || index >= MAX_BENCH_MODELS)
+		Com_Error(ERR_DROP, "CL_BenchModel: bad model index (%i)", index);
+
+	return bench.models[index];
+}
+
+/*
+ =================
+ CL_BenchShader
+ =================
+*/
+static struct shader_s *CL_BenchShader (int index){
+
+	if (index == -1)
+		return NULL;
+
+	if (index < 0 || index >= MAX_BENCH_SHADERS)
+		Com_Error(ERR_DROP, "CL_BenchShader: bad shader index (%i)", index);
+
+	return bench.shaders[index];
+}
+
+/*
+ =================
+ CL_BenchWorld
+ =================
+*/
+static void CL_BenchWorld (const sceneWorld_t *world){
+
+	unsigned	time;
+
+	time = Sys_Microseconds();
+
+	// Flush the previous map like the client does
+	if (bench.worldLoaded){
+		R_Shutdown(false);
+
+		if (!Com_ServerState())
+			Hunk_Clear();
+
+		R_Init(false);
+	}
+
+	memset(bench.models, 0, sizeof(bench.models));
+	memset(bench.shaders, 0, sizeof(bench.shaders));
+
+	R_LoadWorldMap(world->mapName, world->skyName, world->skyRotate, world->skyAxis);
+
+	bench.worldLoaded = true;
+
+	bench.loadTime += Sys_Microseconds() - time;
+}
+
+/*
+ =================
+ CL_BenchModelRecord
+ =================
+*/
+static void CL_BenchModelRecord (const sceneModel_t *model){
+
+	if (model->index < 0 || model->index >= MAX_BENCH_MODELS)
+		Com_Error(ERR_DROP, "CL_BenchModelRecord: bad model index (%i)", model->index);
+
+	bench.models[model->index] = R_RegisterModel(model->name);
+}
+
+/*
+ =================
+ CL_BenchShaderRecord
+ =================
+*/
+static void CL_BenchShaderRecord (const sceneShader_t *shader){
+
+	if (shader->index < 0 || shader->index >= MAX_BENCH_SHADERS)
+		Com_Error(ERR_DROP, "CL_BenchShaderRecord: bad shader index (%i)", shader->index);
+
+	switch (shader->type){
+	case SCN_SHADER_SKIN:
+		bench.shaders[shader->index] = R_RegisterShaderSkin(shader->name);
+		break;
+	case SCN_SHADER_NOMIP:
+		bench.shaders[shader->index] = R_RegisterShaderNoMip(shader->name);
+		break;
+	default:
+		bench.shaders[shader->index] = R_RegisterShader(shader->name);
+		break;
+	}
+}
+
+/*
+ =================
+ CL_EndBenchFrame
+ =================
+*/
+static void CL_EndBenchFrame (void){
+
+	refStats_t	stats;
+	unsigned	time;
+
+	if (!bench.inFrame)
+		return;
+	bench.inFrame = false;
+
+	R_EndFrame();
+
+	time = Sys_Microseconds() - bench.frameStart;
+
+	R_GetStats(&stats);
+
+	bench.numFrames++;
+
+	bench.frameTime += time;
+
+	if (time < bench.minFrameTime)
+		bench.minFrameTime = time;
+	if (time > bench.maxFrameTime)
+		bench.maxFrameTime = time;
+
+	bench.stats.numShaders += stats.numShaders;
+	bench.stats.numStages += stats.numStages;
+	bench.stats.numMeshes += stats.numMeshes;
+	bench.stats.numLeafs += stats.numLeafs;
+	bench.stats.numVertices += stats.numVertices;
+	bench.stats.numIndices += stats.numIndices;
+	bench.stats.totalIndices += stats.totalIndices;
+	bench.stats.numEntities += stats.numEntities;
+	bench.stats.numDLights += stats.numDLights;
+	bench.stats.numParticles += stats.numParticles;
+	bench.stats.numPolys += stats.numPolys;
+	bench.stats.timeWorld += stats.timeWorld;
+	bench.stats.timeEntities += stats.timeEntities;
+	bench.stats.timeParticles += stats.timeParticles;
+	bench.stats.timeSort += stats.timeSort;
+	bench.stats.timeBackEnd += stats.timeBackEnd;
+
+	if (!bench.csvFile)
+		return;
+
+	FS_Printf(bench.csvFile, "%i,%u,%u,%u,%u,%u,%u,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i,%i\n", bench.numFrames - 1, time, stats.timeWorld, stats.timeEntities, stats.timeParticles, stats.timeSort, stats.timeBackEnd, stats.numShaders, stats.numStages, stats.numMeshes, stats.numLeafs, stats.numVertices, stats.numIndices, stats.totalIndices, stats.numEntities, stats.numDLights, stats.numParticles, stats.numPolys);
+}
+
+/*
+ =================
+ CL_BeginBenchFrame
+ =================
+*/
+static void CL_BeginBenchFrame (const sceneFrame_t *frame){
+
+	CL_EndBenchFrame();
+
+	bench.inFrame = true;
+	bench.frameStart = Sys_Microseconds();
+
+	R_BeginFrame(frame->realTime, 0);
+}
+
+/*
+ =================
+ CL_BenchView
+ =================
+*/
+static void CL_BenchView (const sceneView_t *view, int length){
+
+	const sceneEntity_t		*entity;
+	const sceneDLight_t		*dlight;
+	const sceneParticle_t	*particle;
+	const scenePoly_t		*poly;
+	const scenePolyVert_t	*polyVert;
+	polyVert_t				*pv;
+	refDef_t				rd;
+	int						i, j;
+
+	if (!bench.inFrame)
+		return;
+
+	if (view->numEntities < 0 || view->numDLights < 0 || view->numParticles < 0 || view->numPolys < 0 || view->numPolyVerts < 0 || view->numPolyVerts > MAX_POLY_VERTS)
+		Com_Error(ERR_DROP, "CL_BenchView: bad scene");
+
+	entity = (const sceneEntity_t *)(view + 1);
+	dlight = (const sceneDLight_t *)(entity + view->numEntities);
+	particle = (const sceneParticle_t *)(dlight + view->numDLights);
+	poly = (const scenePoly_t *)(particle + view->numParticles);
+	polyVert = (const scenePolyVert_t *)(poly + view->numPolys);
+
+	if ((const byte *)(polyVert + view->numPolyVerts) - (const byte *)view != length)
+		Com_Error(ERR_DROP, "CL_BenchView: bad scene size");
+
+	bench.numViews++;
+
+	for (i = 0; i < MAX_LIGHTSTYLES; i++)
+		R_SetLightStyle(i, view->lightStyles[i][0], view->lightStyles[i][1], view->lightStyles[i][2]);
+
+	R_ClearScene();
+
+	for (i = 0; i < view->numEntities; i++, entity++){
+		bench_entity.entityType = entity->entityType;
+		bench_entity.renderFX = entity->renderFX;
+		bench_entity.flags = entity->flags;
+		bench_entity.model = CL_BenchModel(entity->model);
+		AxisCopy(entity->axis, bench_entity.axis);
+		VectorCopy(entity->origin, bench_entity.origin);
+		bench_entity.frame = entity->frame;
+		VectorCopy(entity->oldOrigin, bench_entity.oldOrigin);
+		bench_entity.oldFrame = entity->oldFrame;
+		bench_entity.backLerp = entity->backLerp;
+		bench_entity.ammoValue = entity->ammoValue;
+		bench_entity.radius = entity->radius;
+		bench_entity.rotation = entity->rotation;
+		bench_entity.skinNum = entity->skinNum;
+		bench_entity.customShader = CL_BenchShader(entity->customShader);
+		MakeRGBA(bench_entity.shaderRGBA, entity->shaderRGBA[0], entity->shaderRGBA[1], entity->shaderRGBA[2], entity->shaderRGBA[3]);
+		bench_entity.shaderTime = entity->shaderTime;
+
+		R_AddEntityToScene(&bench_entity);
+	}
+
+	for (i = 0; i < view->numDLights; i++, dlight++)
+		R_AddLightToScene(dlight->origin, dlight->intensity, dlight->color[0], dlight->color[1], dlight->color[2]);
+
+	for (i = 0; i < view->numParticles; i++, particle++)
+		R_AddParticleToScene(CL_BenchShader(particle->shader), particle->origin, particle->oldOrigin, particle->radius, particle->length, particle->rotation, particle->modulate, particle->flags);
+
+	for (i = 0; i < view->numPolys; i++, poly++){
+		if (poly->numVerts < 0 || poly->numVerts > view->numPolyVerts - (polyVert - (const scenePolyVert_t *)(view + 1)))
+			Com_Error(ERR_DROP, "CL_BenchView: bad poly");
+
+		for (j = 0, pv = bench_polyVerts; j < poly->numVerts; j++, pv++, polyVert++){
+			VectorCopy(polyVert->xyz, pv->xyz);
+			pv->st[0] = polyVert->st[0];
+			pv->st[1] = polyVert->st[1];
+			MakeRGBA(pv->modulate, polyVert->modulate[0], polyVert->modulate[1], polyVert->modulate[2], polyVert->modulate[3]);
+		}
+
+		R_AddPolyToScene(CL_BenchShader(poly->shader), poly->numVerts, bench_polyVerts);
+	}
+
+	rd.x = view->x;
+	rd.y = view->y;
+	rd.width = view->width;
+	rd.height = view->height;
+	rd.fovX = view->fovX;
+	rd.fovY = view->fovY;
+	VectorCopy(view->viewOrigin, rd.viewOrigin);
+	AxisCopy(view->viewAxis, rd.viewAxis);
+	rd.time = view->time;
+	rd.rdFlags = view->rdFlags;
+
+	if (view->hasAreaBits)
+		rd.areaBits = (byte *)view->areaBits;
+	else
+		rd.areaBits = NULL;
+
+	R_RenderScene(&rd);
+}
+
+/*
+ =================
+ CL_PrintBenchResults
+
+ One "name value" pair per line, so scripts can compare runs
+ =================
+*/
+static void CL_PrintBenchResults (const char *name){
+
+	double	frames;
+
+	frames = (bench.numFrames) ? bench.numFrames : 1;
+
+	Com_Printf("bench_name %s\n", name);
+	Com_Printf("bench_frames %i\n", bench.numFrames);
+	Com_Printf("bench_views %i\n", bench.numViews);
+	Com_Printf("bench_load_usec %u\n", bench.loadTime);
+	Com_Printf("bench_frame_usec_total %u\n", bench.frameTime);
+	Com_Printf("bench_frame_usec_avg %.2f\n", bench.frameTime / frames);
+	Com_Printf("bench_frame_usec_min %u\n", (bench.numFrames) ? bench.minFrameTime : 0);
+	Com_Printf("bench_frame_usec_max %u\n", bench.maxFrameTime);
+	Com_Printf("bench_world_usec_avg %.2f\n", bench.stats.timeWorld / frames);
+	Com_Printf("bench_entities_usec_avg %.2f\n", bench.stats.timeEntities / frames);
+	Com_Printf("bench_particles_usec_avg %.2f\n", bench.stats.timeParticles / frames);
+	Com_Printf("bench_sort_usec_avg %.2f\n", bench.stats.timeSort / frames);
+	Com_Printf("bench_backend_usec_avg %.2f\n", bench.stats.timeBackEnd / frames);
+	Com_Printf("bench_shaders_avg %.2f\n", bench.stats.numShaders / frames);
+	Com_Printf("bench_stages_avg %.2f\n", bench.stats.numStages / frames);
+	Com_Printf("bench_meshes_avg %.2f\n", bench.stats.numMeshes / frames);
+	Com_Printf("bench_leafs_avg %.2f\n", bench.stats.numLeafs / frames);
+	Com_Printf("bench_vertices_avg %.2f\n", bench.stats.numVertices / frames);
+	Com_Printf("bench_indices_avg %.2f\n", bench.stats.numIndices / frames);
+	Com_Printf("bench_total_indices_avg %.2f\n", bench.stats.totalIndices / frames);
+	Com_Printf("bench_entities_avg %.2f\n", bench.stats.numEntities / frames);
+	Com_Printf("bench_dlights_avg %.2f\n", bench.stats.numDLights / frames);
+	Com_Printf("bench_particles_avg %.2f\n", bench.stats.numParticles / frames);
+	Com_Printf("bench_polys_avg %.2f\n", bench.stats.numPolys / frames);
+}
+
+/*
+ =================
+ CL_CloseBenchFiles
+
+ A Com_Error during playback can leave the files of the last run open
+ =================
+*/
+static void CL_CloseBenchFiles (void){
+
+	if (bench.file){
+		FS_FCloseFile(bench.file);
+		bench.file = 0;
+	}
+
+	if (bench.csvFile){
+		FS_FCloseFile(bench.csvFile);
+		bench.csvFile = 0;
+	}
+}
+
+/*
+ =================
+ CL_BenchScenes_f
+ =================
+*/
+static void CL_BenchScenes_f (void){
+
+	sceneHeader_t	header;
+	sceneRecord_t	record;
+	char			name[MAX_OSPATH];
+
+	if (Cmd_Argc() != 2 && Cmd_Argc() != 3){
+		Com_Printf("Usage: benchscenes <name> [csv file]\n");
+		return;
+	}
+
+	Q_snprintfz(name, sizeof(name), "scenes/%s", Cmd_Argv(1));
+	Com_DefaultExtension(name, sizeof(name), ".scn");
+
+	CL_CloseBenchFiles();
+
+	FS_FOpenFile(name, &bench.file, FS_READ);
+	if (!bench.file){
+		Com_Printf("Couldn't find %s\n", name);
+		return;
+	}
+
+	if (FS_Read(&header, sizeof(sceneHeader_t), bench.file) != sizeof(sceneHeader_t) || header.ident != SCN_IDENT || header.version != SCN_VERSION){
+		Com_Printf("%s is not a scene recording\n", name);
+
+		FS_FCloseFile(bench.file);
+		bench.file = 0;
+		return;
+	}
+
+	if (Cmd_Argc() == 3){
+		FS_FOpenFile(Cmd_Argv(2), &bench.csvFile, FS_WRITE);
+		if (!bench.csvFile)
+			Com_Printf("Couldn't write %s\n", Cmd_Argv(2));
+		else
+			FS_Printf(bench.csvFile, "frame,frame_usec,world_usec,entities_usec,particles_usec,sort_usec,backend_usec,shaders,stages,meshes,leafs,vertices,indices,total_indices,entities,dlights,particles,polys\n");
+	}
+
+	bench.inFrame = false;
+	bench.numFrames = 0;
+	bench.numViews = 0;
+	bench.loadTime = 0;
+	bench.frameTime = 0;
+	bench.minFrameTime = 0xFFFFFFFF;
+	bench.maxFrameTime = 0;
+	memset(&bench.stats, 0, sizeof(refStats_t));
+
+	while (FS_Read(&record, sizeof(sceneRecord_t), bench.file) == sizeof(sceneRecord_t)){
+		if (record.length < 0)
+			Com_Error(ERR_DROP, "CL_BenchScenes_f: bad record length in %s", name);
+
+		if (record.length > bench.dataSize){
+			if (bench.data)
+				Z_Free(bench.data);
+
+			bench.data = Z_Malloc(record.length);
+			bench.dataSize = record.length;
+		}
+
+		if (FS_Read(bench.data, record.length, bench.file) != record.length)
+			break;
+
+		switch (record.type){
+		case SCN_WORLD:
+			if (record.length != sizeof(sceneWorld_t))
+				Com_Error(ERR_DROP, "CL_BenchScenes_f: bad world record in %s", name);
+
+			CL_EndBenchFrame();
+			CL_BenchWorld((const sceneWorld_t *)bench.data);
+
+			break;
+		case SCN_MODEL:
+			if (record.length != sizeof(sceneModel_t))
+				Com_Error(ERR_DROP, "CL_BenchScenes_f: bad model record in %s", name);
+
+			CL_BenchModelRecord((const sceneModel_t *)bench.data);
+
+			break;
+		case SCN_SHADER:
+			if (record.length != sizeof(sceneShader_t))
+				Com_Error(ERR_DROP, "CL_BenchScenes_f: bad shader record in %s", name);
+
+			CL_BenchShaderRecord((const sceneShader_t *)bench.data);
+
+			break;
+		case SCN_FRAME:
+			if (record.length != sizeof(sceneFrame_t))
+				Com_Error(ERR_DROP, "CL_BenchScenes_f: bad frame record in %s", name);
+
+			CL_BeginBenchFrame((const sceneFrame_t *)bench.data);
+
+			break;
+		case SCN_VIEW:
+			if (record.length < sizeof(sceneView_t))
+				Com_Error(ERR_DROP, "CL_BenchScenes_f: bad view record in %s", name);
+
+			CL_BenchView((const sceneView_t *)bench.data, record.length);
+
+			break;
+		default:
+			Com_DPrintf(S_COLOR_YELLOW "CL_BenchScenes_f: unknown record type %i in %s\n", record.type, name);
+			break;
+		}
+	}
+
+	CL_EndBenchFrame();
+
+	CL_CloseBenchFiles();
+
+	CL_PrintBenchResults(name);
+}
+
+/*
+ =================
+ CIN_RunCinematic
+
+ Cinematics belong to the client, so videoMap stages never find their
+ video in the benchmark
+ =================
+*/
+qboolean CIN_RunCinematic (cinHandle_t handle){
+
+	return false;
+}
+
+void CIN_SetExtents (cinHandle_t handle, int x, int y, int w, int h){
+
+}
+
+void CIN_DrawCinematic (cinHandle_t handle){
+
+}
+
+cinHandle_t CIN_PlayCinematic (const char *name, int x, int y, int w, int h, int flags){
+
+	return 0;
+}
+
+void CIN_StopCinematic (cinHandle_t handle){
+
+}
+
+void Con_Print (const char *text){
+
+}
+
+void Key_WriteBindings (fileHandle_t f){
+
+}
+
+void Key_Init (void){
+
+}
+
+void Key_Shutdown (void){
+
+}
+
+void CL_Loading (void){
+
+}
+
+void CL_UpdateScreen (void){
+
+}
+
+void CL_ForwardToServer (void){
+
+	Com_Printf("Unknown command \"%s\"\n", Cmd_Argv(0));
+}
+
+void CL_ClearMemory (void){
+
+}
+
+void CL_Drop (void){
+
+}
+
+void CL_Frame (int msec){
+
+}
+
+void CL_Init (void){
+
+	R_Init(true);
+
+	Cmd_AddCommand("benchscenes", CL_BenchScenes_f);
+
+	bench_initialized = true;
+}
+
+void CL_Shutdown (void){
+
+	// Com_Error can get here before CL_Init ran
+	if (!bench_initialized)
+		return;
+	bench_initialized = false;
+
+	Cmd_RemoveCommand("benchscenes");
+
+	CL_CloseBenchFiles();
+
+	R_Shutdown(true);
+}
+
+void CDAudio_Stop (void){
+
+}
@@ -0,0 +1,80 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// cl_null.c -- client stubs for the dedicated server
+
+
+#include "../qcommon/qcommon.h"
+
+
+void Con_Print (const char *text){
+
+}
+
+void Key_WriteBindings (fileHandle_t f){
+
+}
+
+void Key_Init (void){
+
+}
+
+void Key_Shutdown (void){
+
+}
+
+void CL_Loading (void){
+
+}
+
+void CL_UpdateScreen (void){
+
+}
+
+void CL_ForwardToServer (void){
+
+	Com_Printf("Unknown command \"%s\"\n", Cmd_Argv(0));
+}
+
+void CL_ClearMemory (void){
+
+}
+
+void CL_Drop (void){
+
+}
+
+void CL_Frame (int msec){
+
+}
+
+void CL_Init (void){
+
+}
+
+void CL_Shutdown (void){
+
+}
+
+void CDAudio_Stop (void){
+
+}
@@ -0,0 +1,198 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// glw_null.c -- GLimp_* for the null driver
+//
+// There is no window or context. The video mode only sets the size the
+// renderer thinks it is drawing to, and every extension the null driver
+// advertises is enabled as long as its cvar allows it, so the same code
+// paths run as on a real driver
+
+
+#include "../refresh/r_local.h"
+
+
+typedef struct {
+	const char	*name;
+	cvar_t		**cvar;
+	qboolean	*enabled;
+} glwExtension_t;
+
+glConfig_t	glConfig;
+
+static glwExtension_t	glwExtensions[] = {
+	{"GL_ARB_multitexture",					&r_arb_multitexture,				&glConfig.multitexture},
+	{"GL_ARB_texture_env_add",				&r_arb_texture_env_add,				&glConfig.textureEnvAdd},
+	{"GL_ARB_texture_env_combine",			&r_arb_texture_env_combine,			&glConfig.textureEnvCombine},
+	{"GL_ARB_texture_env_dot3",				&r_arb_texture_env_dot3,			&glConfig.textureEnvDot3},
+	{"GL_ARB_texture_cube_map",				&r_arb_texture_cube_map,			&glConfig.textureCubeMap},
+	{"GL_ARB_texture_compression",			&r_arb_texture_compression,			&glConfig.textureCompression},
+	{"GL_ARB_vertex_buffer_object",			&r_arb_vertex_buffer_object,		&glConfig.vertexBufferObject},
+	{"GL_ARB_vertex_program",				&r_arb_vertex_program,				&glConfig.vertexProgram},
+	{"GL_ARB_fragment_program",				&r_arb_fragment_program,			&glConfig.fragmentProgram},
+	{"GL_EXT_draw_range_elements",			&r_ext_draw_range_elements,			&glConfig.drawRangeElements},
+	{"GL_EXT_compiled_vertex_array",		&r_ext_compiled_vertex_array,		&glConfig.compiledVertexArray},
+	{"GL_EXT_texture_edge_clamp",			&r_ext_texture_edge_clamp,			&glConfig.textureEdgeClamp},
+	{"GL_EXT_texture_filter_anisotropic",	&r_ext_texture_filter_anisotropic,	&glConfig.textureFilterAnisotropic},
+	{"GL_NV_texture_rectangle",				&r_ext_texture_rectangle,			&glConfig.textureRectangle},
+	{"GL_EXT_stencil_two_side",				&r_ext_stencil_two_side,			&glConfig.stencilTwoSide},
+	{"GL_SGIS_generate_mipmap",				&r_ext_generate_mipmap,				&glConfig.generateMipmap},
+	{NULL,									NULL,								NULL}
+};
+
+
+/*
+ =================
+ GLW_InitExtensions
+ =================
+*/
+static void GLW_InitExtensions (void){
+
+	glwExtension_t	*ext;
+
+	if (!r_allowExtensions->integer){
+		Com_Printf("*** IGNORING OPENGL EXTENSIONS ***\n");
+		return;
+	}
+
+	Com_Printf("Initializing OpenGL extensions\n");
+
+	for (ext = glwExtensions; ext->name; ext++){
+		if (!(*ext->cvar)->integer){
+			Com_Printf("...ignoring %s\n", ext->name);
+			continue;
+		}
+
+		*ext->enabled = true;
+
+		Com_Printf("...using %s\n", ext->name);
+	}
+
+	if (glConfig.multitexture)
+		qglGetIntegerv(GL_MAX_TEXTURE_UNITS_ARB, &glConfig.maxTextureUnits);
+
+	if (glConfig.textureCubeMap)
+		qglGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE_ARB, &glConfig.maxCubeMapTextureSize);
+
+	if (glConfig.fragmentProgram){
+		qglGetIntegerv(GL_MAX_TEXTURE_COORDS_ARB, &glConfig.maxTextureCoords);
+		qglGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS_ARB, &glConfig.maxTextureImageUnits);
+	}
+
+	if (glConfig.textureFilterAnisotropic)
+		qglGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &glConfig.maxTextureMaxAnisotropy);
+
+	if (glConfig.textureRectangle)
+		qglGetIntegerv(GL_MAX_RECTANGLE_TEXTURE_SIZE_NV, &glConfig.maxRectangleTextureSize);
+}
+
+/*
+ =================
+ GLimp_SetDeviceGammaRamp
+ =================
+*/
+void GLimp_SetDeviceGammaRamp (unsigned short *gammaRamp){
+
+}
+
+/*
+ =================
+ GLimp_SwapBuffers
+ =================
+*/
+void GLimp_SwapBuffers (void){
+
+	if (r_swapInterval->modified){
+		if (r_swapInterval->integer < 0)
+			Cvar_SetInteger("r_swapInterval", 0);
+
+		r_swapInterval->modified = false;
+	}
+}
+
+/*
+ =================
+ GLimp_Activate
+ =================
+*/
+void GLimp_Activate (qboolean active){
+
+}
+
+/*
+ =================
+ GLimp_Init
+ =================
+*/
+void GLimp_Init (void){
+
+	Com_Printf("Initializing OpenGL subsystem\n");
+
+	if (!QGL_Init(GL_DRIVER_OPENGL))
+		Com_Error(ERR_FATAL, "GLimp_Init: could not load OpenGL subsystem");
+
+	Com_Printf("...setting mode %i: ", r_mode->integer);
+	if (!R_GetModeInfo(&glConfig.videoWidth, &glConfig.videoHeight, r_mode->integer)){
+		Com_Printf("invalid mode, using 640 480\n");
+
+		glConfig.videoWidth = 640;
+		glConfig.videoHeight = 480;
+	}
+	else
+		Com_Printf("%i %i W\n", glConfig.videoWidth, glConfig.videoHeight);
+
+	glConfig.colorBits = 32;
+	glConfig.depthBits = 24;
+	glConfig.stencilBits = 8;
+
+	glConfig.displayDepth = 32;
+	glConfig.displayFrequency = 60;
+
+	// Get GL strings
+	glConfig.vendorString = (const char *)qglGetString(GL_VENDOR);
+	glConfig.rendererString = (const char *)qglGetString(GL_RENDERER);
+	glConfig.versionString = (const char *)qglGetString(GL_VERSION);
+	glConfig.extensionsString = (const char *)qglGetString(GL_EXTENSIONS);
+
+	// Get max texture size supported
+	qglGetIntegerv(GL_MAX_TEXTURE_SIZE, &glConfig.maxTextureSize);
+
+	// Initialize extensions
+	GLW_InitExtensions();
+
+	// Enable logging if requested
+	QGL_EnableLogging(r_logFile->integer);
+}
+
+/*
+ =================
+ GLimp_Shutdown
+ =================
+*/
+void GLimp_Shutdown (void){
+
+	Com_Printf("Shutting down OpenGL subsystem\n");
+
+	QGL_Shutdown();
+
+	memset(&glConfig, 0, sizeof(glConfig_t));
+}
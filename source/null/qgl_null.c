@@ -0,0 +1,3477 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// qgl_null.c -- binds QGL to functions that draw nothing
+//
+// Every call goes to a stub, so the renderer does all of its CPU work and
+// none of the GPU work. Queries return values of a plausible driver, and
+// with r_logFile set the name of each call is written to gl.log
+
+
+#include "../refresh/r_local.h"
+
+
+#define NULL_EXTENSIONS		"GL_ARB_multitexture GL_ARB_texture_env_add GL_ARB_texture_env_combine GL_ARB_texture_env_dot3 GL_ARB_texture_cube_map GL_ARB_texture_compression GL_ARB_vertex_buffer_object GL_ARB_vertex_program GL_ARB_fragment_program GL_EXT_draw_range_elements GL_EXT_compiled_vertex_array GL_EXT_texture_edge_clamp GL_EXT_texture_filter_anisotropic GL_NV_texture_rectangle GL_EXT_stencil_two_side GL_SGIS_generate_mipmap"
+
+typedef struct {
+	FILE		*logFile;
+
+	GLuint		numNames;		// Names handed out by the glGen* functions
+
+	byte		*mapBuffer;		// Returned by glMapBufferARB
+	int			mapBufferSize;
+} qglNull_t;
+
+static qglNull_t	qglNull;
+
+GLvoid			(APIENTRY * qglAccum)(GLenum op, GLfloat value);
+GLvoid			(APIENTRY * qglAlphaFunc)(GLenum func, GLclampf ref);
+GLboolean		(APIENTRY * qglAreTexturesResident)(GLsizei n, const GLuint *textures, GLboolean *residences);
+GLvoid			(APIENTRY * qglArrayElement)(GLint i);
+GLvoid			(APIENTRY * qglBegin)(GLenum mode);
+GLvoid			(APIENTRY * qglBindTexture)(GLenum target, GLuint texture);
+GLvoid			(APIENTRY * qglBitmap)(GLsizei width, GLsizei height, GLfloat xorig, GLfloat yorig, GLfloat xmove, GLfloat ymove, const GLubyte *bitmap);
+GLvoid			(APIENTRY * qglBlendFunc)(GLenum sfactor, GLenum dfactor);
+GLvoid			(APIENTRY * qglCallList)(GLuint list);
+GLvoid			(APIENTRY * qglCallLists)(GLsizei n, GLenum type, const GLvoid *lists);
+GLvoid			(APIENTRY * qglClear)(GLbitfield mask);
+GLvoid			(APIENTRY * qglClearAccum)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+GLvoid			(APIENTRY * qglClearColor)(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+GLvoid			(APIENTRY * qglClearDepth)(GLclampd depth);
+GLvoid			(APIENTRY * qglClearIndex)(GLfloat c);
+GLvoid			(APIENTRY * qglClearStencil)(GLint s);
+GLvoid			(APIENTRY * qglClipPlane)(GLenum plane, const GLdouble *equation);
+GLvoid			(APIENTRY * qglColor3b)(GLbyte red, GLbyte green, GLbyte blue);
+GLvoid			(APIENTRY * qglColor3bv)(const GLbyte *v);
+GLvoid			(APIENTRY * qglColor3d)(GLdouble red, GLdouble green, GLdouble blue);
+GLvoid			(APIENTRY * qglColor3dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglColor3f)(GLfloat red, GLfloat green, GLfloat blue);
+GLvoid			(APIENTRY * qglColor3fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglColor3i)(GLint red, GLint green, GLint blue);
+GLvoid			(APIENTRY * qglColor3iv)(const GLint *v);
+GLvoid			(APIENTRY * qglColor3s)(GLshort red, GLshort green, GLshort blue);
+GLvoid			(APIENTRY * qglColor3sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglColor3ub)(GLubyte red, GLubyte green, GLubyte blue);
+GLvoid			(APIENTRY * qglColor3ubv)(const GLubyte *v);
+GLvoid			(APIENTRY * qglColor3ui)(GLuint red, GLuint green, GLuint blue);
+GLvoid			(APIENTRY * qglColor3uiv)(const GLuint *v);
+GLvoid			(APIENTRY * qglColor3us)(GLushort red, GLushort green, GLushort blue);
+GLvoid			(APIENTRY * qglColor3usv)(const GLushort *v);
+GLvoid			(APIENTRY * qglColor4b)(GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha);
+GLvoid			(APIENTRY * qglColor4bv)(const GLbyte *v);
+GLvoid			(APIENTRY * qglColor4d)(GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha);
+GLvoid			(APIENTRY * qglColor4dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglColor4f)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+GLvoid			(APIENTRY * qglColor4fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglColor4i)(GLint red, GLint green, GLint blue, GLint alpha);
+GLvoid			(APIENTRY * qglColor4iv)(const GLint *v);
+GLvoid			(APIENTRY * qglColor4s)(GLshort red, GLshort green, GLshort blue, GLshort alpha);
+GLvoid			(APIENTRY * qglColor4sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglColor4ub)(GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha);
+GLvoid			(APIENTRY * qglColor4ubv)(const GLubyte *v);
+GLvoid			(APIENTRY * qglColor4ui)(GLuint red, GLuint green, GLuint blue, GLuint alpha);
+GLvoid			(APIENTRY * qglColor4uiv)(const GLuint *v);
+GLvoid			(APIENTRY * qglColor4us)(GLushort red, GLushort green, GLushort blue, GLushort alpha);
+GLvoid			(APIENTRY * qglColor4usv)(const GLushort *v);
+GLvoid			(APIENTRY * qglColorMask)(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+GLvoid			(APIENTRY * qglColorMaterial)(GLenum face, GLenum mode);
+GLvoid			(APIENTRY * qglColorPointer)(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+GLvoid			(APIENTRY * qglCopyPixels)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum type);
+GLvoid			(APIENTRY * qglCopyTexImage1D)(GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLint border);
+GLvoid			(APIENTRY * qglCopyTexImage2D)(GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
+GLvoid			(APIENTRY * qglCopyTexSubImage1D)(GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width);
+GLvoid			(APIENTRY * qglCopyTexSubImage2D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+GLvoid			(APIENTRY * qglCullFace)(GLenum mode);
+GLvoid			(APIENTRY * qglDeleteLists)(GLuint list, GLsizei range);
+GLvoid			(APIENTRY * qglDeleteTextures)(GLsizei n, const GLuint *textures);
+GLvoid			(APIENTRY * qglDepthFunc)(GLenum func);
+GLvoid			(APIENTRY * qglDepthMask)(GLboolean flag);
+GLvoid			(APIENTRY * qglDepthRange)(GLclampd zNear, GLclampd zFar);
+GLvoid			(APIENTRY * qglDisable)(GLenum cap);
+GLvoid			(APIENTRY * qglDisableClientState)(GLenum array);
+GLvoid			(APIENTRY * qglDrawArrays)(GLenum mode, GLint first, GLsizei count);
+GLvoid			(APIENTRY * qglDrawBuffer)(GLenum mode);
+GLvoid			(APIENTRY * qglDrawElements)(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices);
+GLvoid			(APIENTRY * qglDrawPixels)(GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels);
+GLvoid			(APIENTRY * qglEdgeFlag)(GLboolean flag);
+GLvoid			(APIENTRY * qglEdgeFlagPointer)(GLsizei stride, const GLvoid *pointer);
+GLvoid			(APIENTRY * qglEdgeFlagv)(const GLboolean *flag);
+GLvoid			(APIENTRY * qglEnable)(GLenum cap);
+GLvoid			(APIENTRY * qglEnableClientState)(GLenum array);
+GLvoid			(APIENTRY * qglEnd)(GLvoid);
+GLvoid			(APIENTRY * qglEndList)(GLvoid);
+GLvoid			(APIENTRY * qglEvalCoord1d)(GLdouble u);
+GLvoid			(APIENTRY * qglEvalCoord1dv)(const GLdouble *u);
+GLvoid			(APIENTRY * qglEvalCoord1f)(GLfloat u);
+GLvoid			(APIENTRY * qglEvalCoord1fv)(const GLfloat *u);
+GLvoid			(APIENTRY * qglEvalCoord2d)(GLdouble u, GLdouble v);
+GLvoid			(APIENTRY * qglEvalCoord2dv)(const GLdouble *u);
+GLvoid			(APIENTRY * qglEvalCoord2f)(GLfloat u, GLfloat v);
+GLvoid			(APIENTRY * qglEvalCoord2fv)(const GLfloat *u);
+GLvoid			(APIENTRY * qglEvalMesh1)(GLenum mode, GLint i1, GLint i2);
+GLvoid			(APIENTRY * qglEvalMesh2)(GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2);
+GLvoid			(APIENTRY * qglEvalPoint1)(GLint i);
+GLvoid			(APIENTRY * qglEvalPoint2)(GLint i, GLint j);
+GLvoid			(APIENTRY * qglFeedbackBuffer)(GLsizei size, GLenum type, GLfloat *buffer);
+GLvoid			(APIENTRY * qglFinish)(GLvoid);
+GLvoid			(APIENTRY * qglFlush)(GLvoid);
+GLvoid			(APIENTRY * qglFogf)(GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglFogfv)(GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglFogi)(GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglFogiv)(GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglFrontFace)(GLenum mode);
+GLvoid			(APIENTRY * qglFrustum)(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar);
+GLuint			(APIENTRY * qglGenLists)(GLsizei range);
+GLvoid			(APIENTRY * qglGenTextures)(GLsizei n, GLuint *textures);
+GLvoid			(APIENTRY * qglGetBooleanv)(GLenum pname, GLboolean *params);
+GLvoid			(APIENTRY * qglGetClipPlane)(GLenum plane, GLdouble *equation);
+GLvoid			(APIENTRY * qglGetDoublev)(GLenum pname, GLdouble *params);
+GLenum			(APIENTRY * qglGetError)(GLvoid);
+GLvoid			(APIENTRY * qglGetFloatv)(GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetIntegerv)(GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglGetLightfv)(GLenum light, GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetLightiv)(GLenum light, GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglGetMapdv)(GLenum target, GLenum query, GLdouble *v);
+GLvoid			(APIENTRY * qglGetMapfv)(GLenum target, GLenum query, GLfloat *v);
+GLvoid			(APIENTRY * qglGetMapiv)(GLenum target, GLenum query, GLint *v);
+GLvoid			(APIENTRY * qglGetMaterialfv)(GLenum face, GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetMaterialiv)(GLenum face, GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglGetPixelMapfv)(GLenum map, GLfloat *values);
+GLvoid			(APIENTRY * qglGetPixelMapuiv)(GLenum map, GLuint *values);
+GLvoid			(APIENTRY * qglGetPixelMapusv)(GLenum map, GLushort *values);
+GLvoid			(APIENTRY * qglGetPointerv)(GLenum pname, GLvoid* *params);
+GLvoid			(APIENTRY * qglGetPolygonStipple)(GLubyte *mask);
+const GLubyte *	(APIENTRY * qglGetString)(GLenum name);
+GLvoid			(APIENTRY * qglGetTexEnvfv)(GLenum target, GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetTexEnviv)(GLenum target, GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglGetTexGendv)(GLenum coord, GLenum pname, GLdouble *params);
+GLvoid			(APIENTRY * qglGetTexGenfv)(GLenum coord, GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetTexGeniv)(GLenum coord, GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglGetTexImage)(GLenum target, GLint level, GLenum format, GLenum type, GLvoid *pixels);
+GLvoid			(APIENTRY * qglGetTexLevelParameterfv)(GLenum target, GLint level, GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetTexLevelParameteriv)(GLenum target, GLint level, GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglGetTexParameterfv)(GLenum target, GLenum pname, GLfloat *params);
+GLvoid			(APIENTRY * qglGetTexParameteriv)(GLenum target, GLenum pname, GLint *params);
+GLvoid			(APIENTRY * qglHint)(GLenum target, GLenum mode);
+GLvoid			(APIENTRY * qglIndexMask)(GLuint mask);
+GLvoid			(APIENTRY * qglIndexPointer)(GLenum type, GLsizei stride, const GLvoid *pointer);
+GLvoid			(APIENTRY * qglIndexd)(GLdouble c);
+GLvoid			(APIENTRY * qglIndexdv)(const GLdouble *c);
+GLvoid			(APIENTRY * qglIndexf)(GLfloat c);
+GLvoid			(APIENTRY * qglIndexfv)(const GLfloat *c);
+GLvoid			(APIENTRY * qglIndexi)(GLint c);
+GLvoid			(APIENTRY * qglIndexiv)(const GLint *c);
+GLvoid			(APIENTRY * qglIndexs)(GLshort c);
+GLvoid			(APIENTRY * qglIndexsv)(const GLshort *c);
+GLvoid			(APIENTRY * qglIndexub)(GLubyte c);
+GLvoid			(APIENTRY * qglIndexubv)(const GLubyte *c);
+GLvoid			(APIENTRY * qglInitNames)(GLvoid);
+GLvoid			(APIENTRY * qglInterleavedArrays)(GLenum format, GLsizei stride, const GLvoid *pointer);
+GLboolean		(APIENTRY * qglIsEnabled)(GLenum cap);
+GLboolean		(APIENTRY * qglIsList)(GLuint list);
+GLboolean		(APIENTRY * qglIsTexture)(GLuint texture);
+GLvoid			(APIENTRY * qglLightModelf)(GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglLightModelfv)(GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglLightModeli)(GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglLightModeliv)(GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglLightf)(GLenum light, GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglLightfv)(GLenum light, GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglLighti)(GLenum light, GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglLightiv)(GLenum light, GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglLineStipple)(GLint factor, GLushort pattern);
+GLvoid			(APIENTRY * qglLineWidth)(GLfloat width);
+GLvoid			(APIENTRY * qglListBase)(GLuint base);
+GLvoid			(APIENTRY * qglLoadIdentity)(GLvoid);
+GLvoid			(APIENTRY * qglLoadMatrixd)(const GLdouble *m);
+GLvoid			(APIENTRY * qglLoadMatrixf)(const GLfloat *m);
+GLvoid			(APIENTRY * qglLoadName)(GLuint name);
+GLvoid			(APIENTRY * qglLogicOp)(GLenum opcode);
+GLvoid			(APIENTRY * qglMap1d)(GLenum target, GLdouble u1, GLdouble u2, GLint stride, GLint order, const GLdouble *points);
+GLvoid			(APIENTRY * qglMap1f)(GLenum target, GLfloat u1, GLfloat u2, GLint stride, GLint order, const GLfloat *points);
+GLvoid			(APIENTRY * qglMap2d)(GLenum target, GLdouble u1, GLdouble u2, GLint ustride, GLint uorder, GLdouble v1, GLdouble v2, GLint vstride, GLint vorder, const GLdouble *points);
+GLvoid			(APIENTRY * qglMap2f)(GLenum target, GLfloat u1, GLfloat u2, GLint ustride, GLint uorder, GLfloat v1, GLfloat v2, GLint vstride, GLint vorder, const GLfloat *points);
+GLvoid			(APIENTRY * qglMapGrid1d)(GLint un, GLdouble u1, GLdouble u2);
+GLvoid			(APIENTRY * qglMapGrid1f)(GLint un, GLfloat u1, GLfloat u2);
+GLvoid			(APIENTRY * qglMapGrid2d)(GLint un, GLdouble u1, GLdouble u2, GLint vn, GLdouble v1, GLdouble v2);
+GLvoid			(APIENTRY * qglMapGrid2f)(GLint un, GLfloat u1, GLfloat u2, GLint vn, GLfloat v1, GLfloat v2);
+GLvoid			(APIENTRY * qglMaterialf)(GLenum face, GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglMaterialfv)(GLenum face, GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglMateriali)(GLenum face, GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglMaterialiv)(GLenum face, GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglMatrixMode)(GLenum mode);
+GLvoid			(APIENTRY * qglMultMatrixd)(const GLdouble *m);
+GLvoid			(APIENTRY * qglMultMatrixf)(const GLfloat *m);
+GLvoid			(APIENTRY * qglNewList)(GLuint list, GLenum mode);
+GLvoid			(APIENTRY * qglNormal3b)(GLbyte nx, GLbyte ny, GLbyte nz);
+GLvoid			(APIENTRY * qglNormal3bv)(const GLbyte *v);
+GLvoid			(APIENTRY * qglNormal3d)(GLdouble nx, GLdouble ny, GLdouble nz);
+GLvoid			(APIENTRY * qglNormal3dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglNormal3f)(GLfloat nx, GLfloat ny, GLfloat nz);
+GLvoid			(APIENTRY * qglNormal3fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglNormal3i)(GLint nx, GLint ny, GLint nz);
+GLvoid			(APIENTRY * qglNormal3iv)(const GLint *v);
+GLvoid			(APIENTRY * qglNormal3s)(GLshort nx, GLshort ny, GLshort nz);
+GLvoid			(APIENTRY * qglNormal3sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglNormalPointer)(GLenum type, GLsizei stride, const GLvoid *pointer);
+GLvoid			(APIENTRY * qglOrtho)(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar);
+GLvoid			(APIENTRY * qglPassThrough)(GLfloat token);
+GLvoid			(APIENTRY * qglPixelMapfv)(GLenum map, GLsizei mapsize, const GLfloat *values);
+GLvoid			(APIENTRY * qglPixelMapuiv)(GLenum map, GLsizei mapsize, const GLuint *values);
+GLvoid			(APIENTRY * qglPixelMapusv)(GLenum map, GLsizei mapsize, const GLushort *values);
+GLvoid			(APIENTRY * qglPixelStoref)(GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglPixelStorei)(GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglPixelTransferf)(GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglPixelTransferi)(GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglPixelZoom)(GLfloat xfactor, GLfloat yfactor);
+GLvoid			(APIENTRY * qglPointSize)(GLfloat size);
+GLvoid			(APIENTRY * qglPolygonMode)(GLenum face, GLenum mode);
+GLvoid			(APIENTRY * qglPolygonOffset)(GLfloat factor, GLfloat units);
+GLvoid			(APIENTRY * qglPolygonStipple)(const GLubyte *mask);
+GLvoid			(APIENTRY * qglPopAttrib)(GLvoid);
+GLvoid			(APIENTRY * qglPopClientAttrib)(GLvoid);
+GLvoid			(APIENTRY * qglPopMatrix)(GLvoid);
+GLvoid			(APIENTRY * qglPopName)(GLvoid);
+GLvoid			(APIENTRY * qglPrioritizeTextures)(GLsizei n, const GLuint *textures, const GLclampf *priorities);
+GLvoid			(APIENTRY * qglPushAttrib)(GLbitfield mask);
+GLvoid			(APIENTRY * qglPushClientAttrib)(GLbitfield mask);
+GLvoid			(APIENTRY * qglPushMatrix)(GLvoid);
+GLvoid			(APIENTRY * qglPushName)(GLuint name);
+GLvoid			(APIENTRY * qglRasterPos2d)(GLdouble x, GLdouble y);
+GLvoid			(APIENTRY * qglRasterPos2dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglRasterPos2f)(GLfloat x, GLfloat y);
+GLvoid			(APIENTRY * qglRasterPos2fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglRasterPos2i)(GLint x, GLint y);
+GLvoid			(APIENTRY * qglRasterPos2iv)(const GLint *v);
+GLvoid			(APIENTRY * qglRasterPos2s)(GLshort x, GLshort y);
+GLvoid			(APIENTRY * qglRasterPos2sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglRasterPos3d)(GLdouble x, GLdouble y, GLdouble z);
+GLvoid			(APIENTRY * qglRasterPos3dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglRasterPos3f)(GLfloat x, GLfloat y, GLfloat z);
+GLvoid			(APIENTRY * qglRasterPos3fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglRasterPos3i)(GLint x, GLint y, GLint z);
+GLvoid			(APIENTRY * qglRasterPos3iv)(const GLint *v);
+GLvoid			(APIENTRY * qglRasterPos3s)(GLshort x, GLshort y, GLshort z);
+GLvoid			(APIENTRY * qglRasterPos3sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglRasterPos4d)(GLdouble x, GLdouble y, GLdouble z, GLdouble w);
+GLvoid			(APIENTRY * qglRasterPos4dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglRasterPos4f)(GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+GLvoid			(APIENTRY * qglRasterPos4fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglRasterPos4i)(GLint x, GLint y, GLint z, GLint w);
+GLvoid			(APIENTRY * qglRasterPos4iv)(const GLint *v);
+GLvoid			(APIENTRY * qglRasterPos4s)(GLshort x, GLshort y, GLshort z, GLshort w);
+GLvoid			(APIENTRY * qglRasterPos4sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglReadBuffer)(GLenum mode);
+GLvoid			(APIENTRY * qglReadPixels)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels);
+GLvoid			(APIENTRY * qglRectd)(GLdouble x1, GLdouble y1, GLdouble x2, GLdouble y2);
+GLvoid			(APIENTRY * qglRectdv)(const GLdouble *v1, const GLdouble *v2);
+GLvoid			(APIENTRY * qglRectf)(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2);
+GLvoid			(APIENTRY * qglRectfv)(const GLfloat *v1, const GLfloat *v2);
+GLvoid			(APIENTRY * qglRecti)(GLint x1, GLint y1, GLint x2, GLint y2);
+GLvoid			(APIENTRY * qglRectiv)(const GLint *v1, const GLint *v2);
+GLvoid			(APIENTRY * qglRects)(GLshort x1, GLshort y1, GLshort x2, GLshort y2);
+GLvoid			(APIENTRY * qglRectsv)(const GLshort *v1, const GLshort *v2);
+GLint			(APIENTRY * qglRenderMode)(GLenum mode);
+GLvoid			(APIENTRY * qglRotated)(GLdouble angle, GLdouble x, GLdouble y, GLdouble z);
+GLvoid			(APIENTRY * qglRotatef)(GLfloat angle, GLfloat x, GLfloat y, GLfloat z);
+GLvoid			(APIENTRY * qglScaled)(GLdouble x, GLdouble y, GLdouble z);
+GLvoid			(APIENTRY * qglScalef)(GLfloat x, GLfloat y, GLfloat z);
+GLvoid			(APIENTRY * qglScissor)(GLint x, GLint y, GLsizei width, GLsizei height);
+GLvoid			(APIENTRY * qglSelectBuffer)(GLsizei size, GLuint *buffer);
+GLvoid			(APIENTRY * qglShadeModel)(GLenum mode);
+GLvoid			(APIENTRY * qglStencilFunc)(GLenum func, GLint ref, GLuint mask);
+GLvoid			(APIENTRY * qglStencilMask)(GLuint mask);
+GLvoid			(APIENTRY * qglStencilOp)(GLenum fail, GLenum zfail, GLenum zpass);
+GLvoid			(APIENTRY * qglTexCoord1d)(GLdouble s);
+GLvoid			(APIENTRY * qglTexCoord1dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglTexCoord1f)(GLfloat s);
+GLvoid			(APIENTRY * qglTexCoord1fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglTexCoord1i)(GLint s);
+GLvoid			(APIENTRY * qglTexCoord1iv)(const GLint *v);
+GLvoid			(APIENTRY * qglTexCoord1s)(GLshort s);
+GLvoid			(APIENTRY * qglTexCoord1sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglTexCoord2d)(GLdouble s, GLdouble t);
+GLvoid			(APIENTRY * qglTexCoord2dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglTexCoord2f)(GLfloat s, GLfloat t);
+GLvoid			(APIENTRY * qglTexCoord2fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglTexCoord2i)(GLint s, GLint t);
+GLvoid			(APIENTRY * qglTexCoord2iv)(const GLint *v);
+GLvoid			(APIENTRY * qglTexCoord2s)(GLshort s, GLshort t);
+GLvoid			(APIENTRY * qglTexCoord2sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglTexCoord3d)(GLdouble s, GLdouble t, GLdouble r);
+GLvoid			(APIENTRY * qglTexCoord3dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglTexCoord3f)(GLfloat s, GLfloat t, GLfloat r);
+GLvoid			(APIENTRY * qglTexCoord3fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglTexCoord3i)(GLint s, GLint t, GLint r);
+GLvoid			(APIENTRY * qglTexCoord3iv)(const GLint *v);
+GLvoid			(APIENTRY * qglTexCoord3s)(GLshort s, GLshort t, GLshort r);
+GLvoid			(APIENTRY * qglTexCoord3sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglTexCoord4d)(GLdouble s, GLdouble t, GLdouble r, GLdouble q);
+GLvoid			(APIENTRY * qglTexCoord4dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglTexCoord4f)(GLfloat s, GLfloat t, GLfloat r, GLfloat q);
+GLvoid			(APIENTRY * qglTexCoord4fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglTexCoord4i)(GLint s, GLint t, GLint r, GLint q);
+GLvoid			(APIENTRY * qglTexCoord4iv)(const GLint *v);
+GLvoid			(APIENTRY * qglTexCoord4s)(GLshort s, GLshort t, GLshort r, GLshort q);
+GLvoid			(APIENTRY * qglTexCoord4sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglTexCoordPointer)(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+GLvoid			(APIENTRY * qglTexEnvf)(GLenum target, GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglTexEnvfv)(GLenum target, GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglTexEnvi)(GLenum target, GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglTexEnviv)(GLenum target, GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglTexGend)(GLenum coord, GLenum pname, GLdouble param);
+GLvoid			(APIENTRY * qglTexGendv)(GLenum coord, GLenum pname, const GLdouble *params);
+GLvoid			(APIENTRY * qglTexGenf)(GLenum coord, GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglTexGenfv)(GLenum coord, GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglTexGeni)(GLenum coord, GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglTexGeniv)(GLenum coord, GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglTexImage1D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid *pixels);
+GLvoid			(APIENTRY * qglTexImage2D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels);
+GLvoid			(APIENTRY * qglTexParameterf)(GLenum target, GLenum pname, GLfloat param);
+GLvoid			(APIENTRY * qglTexParameterfv)(GLenum target, GLenum pname, const GLfloat *params);
+GLvoid			(APIENTRY * qglTexParameteri)(GLenum target, GLenum pname, GLint param);
+GLvoid			(APIENTRY * qglTexParameteriv)(GLenum target, GLenum pname, const GLint *params);
+GLvoid			(APIENTRY * qglTexSubImage1D)(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid *pixels);
+GLvoid			(APIENTRY * qglTexSubImage2D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels);
+GLvoid			(APIENTRY * qglTranslated)(GLdouble x, GLdouble y, GLdouble z);
+GLvoid			(APIENTRY * qglTranslatef)(GLfloat x, GLfloat y, GLfloat z);
+GLvoid			(APIENTRY * qglVertex2d)(GLdouble x, GLdouble y);
+GLvoid			(APIENTRY * qglVertex2dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglVertex2f)(GLfloat x, GLfloat y);
+GLvoid			(APIENTRY * qglVertex2fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglVertex2i)(GLint x, GLint y);
+GLvoid			(APIENTRY * qglVertex2iv)(const GLint *v);
+GLvoid			(APIENTRY * qglVertex2s)(GLshort x, GLshort y);
+GLvoid			(APIENTRY * qglVertex2sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglVertex3d)(GLdouble x, GLdouble y, GLdouble z);
+GLvoid			(APIENTRY * qglVertex3dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglVertex3f)(GLfloat x, GLfloat y, GLfloat z);
+GLvoid			(APIENTRY * qglVertex3fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglVertex3i)(GLint x, GLint y, GLint z);
+GLvoid			(APIENTRY * qglVertex3iv)(const GLint *v);
+GLvoid			(APIENTRY * qglVertex3s)(GLshort x, GLshort y, GLshort z);
+GLvoid			(APIENTRY * qglVertex3sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglVertex4d)(GLdouble x, GLdouble y, GLdouble z, GLdouble w);
+GLvoid			(APIENTRY * qglVertex4dv)(const GLdouble *v);
+GLvoid			(APIENTRY * qglVertex4f)(GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+GLvoid			(APIENTRY * qglVertex4fv)(const GLfloat *v);
+GLvoid			(APIENTRY * qglVertex4i)(GLint x, GLint y, GLint z, GLint w);
+GLvoid			(APIENTRY * qglVertex4iv)(const GLint *v);
+GLvoid			(APIENTRY * qglVertex4s)(GLshort x, GLshort y, GLshort z, GLshort w);
+GLvoid			(APIENTRY * qglVertex4sv)(const GLshort *v);
+GLvoid			(APIENTRY * qglVertexPointer)(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer);
+GLvoid			(APIENTRY * qglViewport)(GLint x, GLint y, GLsizei width, GLsizei height);
+
+GLvoid			(APIENTRY * qglActiveTextureARB)(GLenum texture);
+GLvoid			(APIENTRY * qglClientActiveTextureARB)(GLenum texture);
+
+GLvoid			(APIENTRY * qglBindBufferARB)(GLenum target, GLuint buffer);
+GLvoid			(APIENTRY * qglDeleteBuffersARB)(GLsizei n, const GLuint *buffers);
+GLvoid			(APIENTRY * qglGenBuffersARB)(GLsizei n, GLuint *buffers);
+GLvoid			(APIENTRY * qglBufferDataARB)(GLenum target, GLsizeiptrARB size, const GLvoid *data, GLenum usage);
+GLvoid			(APIENTRY * qglBufferSubDataARB)(GLenum target, GLintptrARB offset, GLsizeiptrARB size, const GLvoid *data);
+GLvoid *			(APIENTRY * qglMapBufferARB)(GLenum target, GLenum access);
+GLboolean		(APIENTRY * qglUnmapBufferARB)(GLenum target);
+
+GLvoid			(APIENTRY * qglBindProgramARB)(GLenum target, GLuint program);
+GLvoid			(APIENTRY * qglDeleteProgramsARB)(GLsizei n, const GLuint *programs);
+GLvoid			(APIENTRY * qglGenProgramsARB)(GLsizei n, GLuint *programs);
+GLvoid			(APIENTRY * qglProgramStringARB)(GLenum target, GLenum format, GLsizei len, const GLvoid *string);
+GLvoid			(APIENTRY * qglProgramEnvParameter4fARB)(GLenum target, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+GLvoid			(APIENTRY * qglProgramLocalParameter4fARB)(GLenum target, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+
+GLvoid			(APIENTRY * qglDrawRangeElementsEXT)(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const GLvoid *indices);
+
+GLvoid			(APIENTRY * qglLockArraysEXT)(GLint start, GLsizei count);
+GLvoid			(APIENTRY * qglUnlockArraysEXT)(GLvoid);
+
+GLvoid			(APIENTRY * qglActiveStencilFaceEXT)(GLenum face);
+
+GLvoid			(APIENTRY * qglStencilOpSeparateATI)(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+GLvoid			(APIENTRY * qglStencilFuncSeparateATI)(GLenum frontfunc, GLenum backfunc, GLint red, GLuint mask);
+
+
+/*
+ =================
+ NULL_GenNames
+ =================
+*/
+static void NULL_GenNames (GLsizei n, GLuint *names){
+
+	int		i;
+
+	for (i = 0; i < n; i++)
+		names[i] = ++qglNull.numNames;
+}
+
+static GLvoid APIENTRY nullAccum (GLenum op, GLfloat value){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glAccum\n");
+}
+
+static GLvoid APIENTRY nullAlphaFunc (GLenum func, GLclampf ref){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glAlphaFunc\n");
+}
+
+static GLboolean APIENTRY nullAreTexturesResident (GLsizei n, const GLuint *textures, GLboolean *residences){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glAreTexturesResident\n");
+
+	int		i;
+
+	for (i = 0; i < n; i++)
+		residences[i] = GL_TRUE;
+
+	return GL_TRUE;
+}
+
+static GLvoid APIENTRY nullArrayElement (GLint i){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glArrayElement\n");
+}
+
+static GLvoid APIENTRY nullBegin (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBegin\n");
+}
+
+static GLvoid APIENTRY nullBindTexture (GLenum target, GLuint texture){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBindTexture\n");
+}
+
+static GLvoid APIENTRY nullBitmap (GLsizei width, GLsizei height, GLfloat xorig, GLfloat yorig, GLfloat xmove, GLfloat ymove, const GLubyte *bitmap){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBitmap\n");
+}
+
+static GLvoid APIENTRY nullBlendFunc (GLenum sfactor, GLenum dfactor){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBlendFunc\n");
+}
+
+static GLvoid APIENTRY nullCallList (GLuint list){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCallList\n");
+}
+
+static GLvoid APIENTRY nullCallLists (GLsizei n, GLenum type, const GLvoid *lists){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCallLists\n");
+}
+
+static GLvoid APIENTRY nullClear (GLbitfield mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClear\n");
+}
+
+static GLvoid APIENTRY nullClearAccum (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClearAccum\n");
+}
+
+static GLvoid APIENTRY nullClearColor (GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClearColor\n");
+}
+
+static GLvoid APIENTRY nullClearDepth (GLclampd depth){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClearDepth\n");
+}
+
+static GLvoid APIENTRY nullClearIndex (GLfloat c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClearIndex\n");
+}
+
+static GLvoid APIENTRY nullClearStencil (GLint s){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClearStencil\n");
+}
+
+static GLvoid APIENTRY nullClipPlane (GLenum plane, const GLdouble *equation){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClipPlane\n");
+}
+
+static GLvoid APIENTRY nullColor3b (GLbyte red, GLbyte green, GLbyte blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3b\n");
+}
+
+static GLvoid APIENTRY nullColor3bv (const GLbyte *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3bv\n");
+}
+
+static GLvoid APIENTRY nullColor3d (GLdouble red, GLdouble green, GLdouble blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3d\n");
+}
+
+static GLvoid APIENTRY nullColor3dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3dv\n");
+}
+
+static GLvoid APIENTRY nullColor3f (GLfloat red, GLfloat green, GLfloat blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3f\n");
+}
+
+static GLvoid APIENTRY nullColor3fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3fv\n");
+}
+
+static GLvoid APIENTRY nullColor3i (GLint red, GLint green, GLint blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3i\n");
+}
+
+static GLvoid APIENTRY nullColor3iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3iv\n");
+}
+
+static GLvoid APIENTRY nullColor3s (GLshort red, GLshort green, GLshort blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3s\n");
+}
+
+static GLvoid APIENTRY nullColor3sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3sv\n");
+}
+
+static GLvoid APIENTRY nullColor3ub (GLubyte red, GLubyte green, GLubyte blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3ub\n");
+}
+
+static GLvoid APIENTRY nullColor3ubv (const GLubyte *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3ubv\n");
+}
+
+static GLvoid APIENTRY nullColor3ui (GLuint red, GLuint green, GLuint blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3ui\n");
+}
+
+static GLvoid APIENTRY nullColor3uiv (const GLuint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3uiv\n");
+}
+
+static GLvoid APIENTRY nullColor3us (GLushort red, GLushort green, GLushort blue){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3us\n");
+}
+
+static GLvoid APIENTRY nullColor3usv (const GLushort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor3usv\n");
+}
+
+static GLvoid APIENTRY nullColor4b (GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4b\n");
+}
+
+static GLvoid APIENTRY nullColor4bv (const GLbyte *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4bv\n");
+}
+
+static GLvoid APIENTRY nullColor4d (GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4d\n");
+}
+
+static GLvoid APIENTRY nullColor4dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4dv\n");
+}
+
+static GLvoid APIENTRY nullColor4f (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4f\n");
+}
+
+static GLvoid APIENTRY nullColor4fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4fv\n");
+}
+
+static GLvoid APIENTRY nullColor4i (GLint red, GLint green, GLint blue, GLint alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4i\n");
+}
+
+static GLvoid APIENTRY nullColor4iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4iv\n");
+}
+
+static GLvoid APIENTRY nullColor4s (GLshort red, GLshort green, GLshort blue, GLshort alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4s\n");
+}
+
+static GLvoid APIENTRY nullColor4sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4sv\n");
+}
+
+static GLvoid APIENTRY nullColor4ub (GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4ub\n");
+}
+
+static GLvoid APIENTRY nullColor4ubv (const GLubyte *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4ubv\n");
+}
+
+static GLvoid APIENTRY nullColor4ui (GLuint red, GLuint green, GLuint blue, GLuint alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4ui\n");
+}
+
+static GLvoid APIENTRY nullColor4uiv (const GLuint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4uiv\n");
+}
+
+static GLvoid APIENTRY nullColor4us (GLushort red, GLushort green, GLushort blue, GLushort alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4us\n");
+}
+
+static GLvoid APIENTRY nullColor4usv (const GLushort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColor4usv\n");
+}
+
+static GLvoid APIENTRY nullColorMask (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColorMask\n");
+}
+
+static GLvoid APIENTRY nullColorMaterial (GLenum face, GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColorMaterial\n");
+}
+
+static GLvoid APIENTRY nullColorPointer (GLint size, GLenum type, GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glColorPointer\n");
+}
+
+static GLvoid APIENTRY nullCopyPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum type){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCopyPixels\n");
+}
+
+static GLvoid APIENTRY nullCopyTexImage1D (GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLint border){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCopyTexImage1D\n");
+}
+
+static GLvoid APIENTRY nullCopyTexImage2D (GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCopyTexImage2D\n");
+}
+
+static GLvoid APIENTRY nullCopyTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCopyTexSubImage1D\n");
+}
+
+static GLvoid APIENTRY nullCopyTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCopyTexSubImage2D\n");
+}
+
+static GLvoid APIENTRY nullCullFace (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glCullFace\n");
+}
+
+static GLvoid APIENTRY nullDeleteLists (GLuint list, GLsizei range){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDeleteLists\n");
+}
+
+static GLvoid APIENTRY nullDeleteTextures (GLsizei n, const GLuint *textures){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDeleteTextures\n");
+}
+
+static GLvoid APIENTRY nullDepthFunc (GLenum func){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDepthFunc\n");
+}
+
+static GLvoid APIENTRY nullDepthMask (GLboolean flag){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDepthMask\n");
+}
+
+static GLvoid APIENTRY nullDepthRange (GLclampd zNear, GLclampd zFar){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDepthRange\n");
+}
+
+static GLvoid APIENTRY nullDisable (GLenum cap){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDisable\n");
+}
+
+static GLvoid APIENTRY nullDisableClientState (GLenum array){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDisableClientState\n");
+}
+
+static GLvoid APIENTRY nullDrawArrays (GLenum mode, GLint first, GLsizei count){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDrawArrays\n");
+}
+
+static GLvoid APIENTRY nullDrawBuffer (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDrawBuffer\n");
+}
+
+static GLvoid APIENTRY nullDrawElements (GLenum mode, GLsizei count, GLenum type, const GLvoid *indices){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDrawElements\n");
+}
+
+static GLvoid APIENTRY nullDrawPixels (GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDrawPixels\n");
+}
+
+static GLvoid APIENTRY nullEdgeFlag (GLboolean flag){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEdgeFlag\n");
+}
+
+static GLvoid APIENTRY nullEdgeFlagPointer (GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEdgeFlagPointer\n");
+}
+
+static GLvoid APIENTRY nullEdgeFlagv (const GLboolean *flag){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEdgeFlagv\n");
+}
+
+static GLvoid APIENTRY nullEnable (GLenum cap){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEnable\n");
+}
+
+static GLvoid APIENTRY nullEnableClientState (GLenum array){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEnableClientState\n");
+}
+
+static GLvoid APIENTRY nullEnd (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEnd\n");
+}
+
+static GLvoid APIENTRY nullEndList (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEndList\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord1d (GLdouble u){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord1d\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord1dv (const GLdouble *u){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord1dv\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord1f (GLfloat u){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord1f\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord1fv (const GLfloat *u){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord1fv\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord2d (GLdouble u, GLdouble v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord2d\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord2dv (const GLdouble *u){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord2dv\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord2f (GLfloat u, GLfloat v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord2f\n");
+}
+
+static GLvoid APIENTRY nullEvalCoord2fv (const GLfloat *u){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalCoord2fv\n");
+}
+
+static GLvoid APIENTRY nullEvalMesh1 (GLenum mode, GLint i1, GLint i2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalMesh1\n");
+}
+
+static GLvoid APIENTRY nullEvalMesh2 (GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalMesh2\n");
+}
+
+static GLvoid APIENTRY nullEvalPoint1 (GLint i){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalPoint1\n");
+}
+
+static GLvoid APIENTRY nullEvalPoint2 (GLint i, GLint j){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glEvalPoint2\n");
+}
+
+static GLvoid APIENTRY nullFeedbackBuffer (GLsizei size, GLenum type, GLfloat *buffer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFeedbackBuffer\n");
+}
+
+static GLvoid APIENTRY nullFinish (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFinish\n");
+}
+
+static GLvoid APIENTRY nullFlush (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFlush\n");
+}
+
+static GLvoid APIENTRY nullFogf (GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFogf\n");
+}
+
+static GLvoid APIENTRY nullFogfv (GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFogfv\n");
+}
+
+static GLvoid APIENTRY nullFogi (GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFogi\n");
+}
+
+static GLvoid APIENTRY nullFogiv (GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFogiv\n");
+}
+
+static GLvoid APIENTRY nullFrontFace (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFrontFace\n");
+}
+
+static GLvoid APIENTRY nullFrustum (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glFrustum\n");
+}
+
+static GLuint APIENTRY nullGenLists (GLsizei range){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGenLists\n");
+
+	qglNull.numNames += range;
+
+	return qglNull.numNames - range + 1;
+}
+
+static GLvoid APIENTRY nullGenTextures (GLsizei n, GLuint *textures){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGenTextures\n");
+
+	NULL_GenNames(n, textures);
+}
+
+static GLvoid APIENTRY nullGetBooleanv (GLenum pname, GLboolean *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetBooleanv\n");
+}
+
+static GLvoid APIENTRY nullGetClipPlane (GLenum plane, GLdouble *equation){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetClipPlane\n");
+}
+
+static GLvoid APIENTRY nullGetDoublev (GLenum pname, GLdouble *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetDoublev\n");
+}
+
+static GLenum APIENTRY nullGetError (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetError\n");
+
+	return GL_NO_ERROR;
+}
+
+static GLvoid APIENTRY nullGetFloatv (GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetFloatv\n");
+
+	switch (pname){
+	case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT:
+		*params = 16.0;
+		break;
+	default:
+		*params = 0.0;
+		break;
+	}
+}
+
+static GLvoid APIENTRY nullGetIntegerv (GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetIntegerv\n");
+
+	switch (pname){
+	case GL_MAX_TEXTURE_SIZE:
+	case GL_MAX_RECTANGLE_TEXTURE_SIZE_NV:
+		*params = 4096;
+		break;
+	case GL_MAX_CUBE_MAP_TEXTURE_SIZE_ARB:
+		*params = 2048;
+		break;
+	case GL_MAX_TEXTURE_UNITS_ARB:
+		*params = 4;
+		break;
+	case GL_MAX_TEXTURE_COORDS_ARB:
+		*params = 8;
+		break;
+	case GL_MAX_TEXTURE_IMAGE_UNITS_ARB:
+		*params = 16;
+		break;
+	case GL_PROGRAM_ERROR_POSITION_ARB:
+		*params = -1;
+		break;
+	default:
+		*params = 0;
+		break;
+	}
+}
+
+static GLvoid APIENTRY nullGetLightfv (GLenum light, GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetLightfv\n");
+}
+
+static GLvoid APIENTRY nullGetLightiv (GLenum light, GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetLightiv\n");
+}
+
+static GLvoid APIENTRY nullGetMapdv (GLenum target, GLenum query, GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetMapdv\n");
+}
+
+static GLvoid APIENTRY nullGetMapfv (GLenum target, GLenum query, GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetMapfv\n");
+}
+
+static GLvoid APIENTRY nullGetMapiv (GLenum target, GLenum query, GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetMapiv\n");
+}
+
+static GLvoid APIENTRY nullGetMaterialfv (GLenum face, GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetMaterialfv\n");
+}
+
+static GLvoid APIENTRY nullGetMaterialiv (GLenum face, GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetMaterialiv\n");
+}
+
+static GLvoid APIENTRY nullGetPixelMapfv (GLenum map, GLfloat *values){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetPixelMapfv\n");
+}
+
+static GLvoid APIENTRY nullGetPixelMapuiv (GLenum map, GLuint *values){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetPixelMapuiv\n");
+}
+
+static GLvoid APIENTRY nullGetPixelMapusv (GLenum map, GLushort *values){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetPixelMapusv\n");
+}
+
+static GLvoid APIENTRY nullGetPointerv (GLenum pname, GLvoid* *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetPointerv\n");
+}
+
+static GLvoid APIENTRY nullGetPolygonStipple (GLubyte *mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetPolygonStipple\n");
+}
+
+static const GLubyte * APIENTRY nullGetString (GLenum name){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetString\n");
+
+	switch (name){
+	case GL_VENDOR:
+		return (const GLubyte *)"Quake 2 Evolved";
+	case GL_RENDERER:
+		return (const GLubyte *)"Null driver";
+	case GL_VERSION:
+		return (const GLubyte *)"1.4";
+	case GL_EXTENSIONS:
+		return (const GLubyte *)NULL_EXTENSIONS;
+	}
+
+	return (const GLubyte *)"";
+}
+
+static GLvoid APIENTRY nullGetTexEnvfv (GLenum target, GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexEnvfv\n");
+}
+
+static GLvoid APIENTRY nullGetTexEnviv (GLenum target, GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexEnviv\n");
+}
+
+static GLvoid APIENTRY nullGetTexGendv (GLenum coord, GLenum pname, GLdouble *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexGendv\n");
+}
+
+static GLvoid APIENTRY nullGetTexGenfv (GLenum coord, GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexGenfv\n");
+}
+
+static GLvoid APIENTRY nullGetTexGeniv (GLenum coord, GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexGeniv\n");
+}
+
+static GLvoid APIENTRY nullGetTexImage (GLenum target, GLint level, GLenum format, GLenum type, GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexImage\n");
+}
+
+static GLvoid APIENTRY nullGetTexLevelParameterfv (GLenum target, GLint level, GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexLevelParameterfv\n");
+}
+
+static GLvoid APIENTRY nullGetTexLevelParameteriv (GLenum target, GLint level, GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexLevelParameteriv\n");
+}
+
+static GLvoid APIENTRY nullGetTexParameterfv (GLenum target, GLenum pname, GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexParameterfv\n");
+}
+
+static GLvoid APIENTRY nullGetTexParameteriv (GLenum target, GLenum pname, GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGetTexParameteriv\n");
+}
+
+static GLvoid APIENTRY nullHint (GLenum target, GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glHint\n");
+}
+
+static GLvoid APIENTRY nullIndexMask (GLuint mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexMask\n");
+}
+
+static GLvoid APIENTRY nullIndexPointer (GLenum type, GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexPointer\n");
+}
+
+static GLvoid APIENTRY nullIndexd (GLdouble c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexd\n");
+}
+
+static GLvoid APIENTRY nullIndexdv (const GLdouble *c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexdv\n");
+}
+
+static GLvoid APIENTRY nullIndexf (GLfloat c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexf\n");
+}
+
+static GLvoid APIENTRY nullIndexfv (const GLfloat *c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexfv\n");
+}
+
+static GLvoid APIENTRY nullIndexi (GLint c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexi\n");
+}
+
+static GLvoid APIENTRY nullIndexiv (const GLint *c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexiv\n");
+}
+
+static GLvoid APIENTRY nullIndexs (GLshort c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexs\n");
+}
+
+static GLvoid APIENTRY nullIndexsv (const GLshort *c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexsv\n");
+}
+
+static GLvoid APIENTRY nullIndexub (GLubyte c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexub\n");
+}
+
+static GLvoid APIENTRY nullIndexubv (const GLubyte *c){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIndexubv\n");
+}
+
+static GLvoid APIENTRY nullInitNames (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glInitNames\n");
+}
+
+static GLvoid APIENTRY nullInterleavedArrays (GLenum format, GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glInterleavedArrays\n");
+}
+
+static GLboolean APIENTRY nullIsEnabled (GLenum cap){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIsEnabled\n");
+
+	return 0;
+}
+
+static GLboolean APIENTRY nullIsList (GLuint list){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIsList\n");
+
+	return 0;
+}
+
+static GLboolean APIENTRY nullIsTexture (GLuint texture){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glIsTexture\n");
+
+	return 0;
+}
+
+static GLvoid APIENTRY nullLightModelf (GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightModelf\n");
+}
+
+static GLvoid APIENTRY nullLightModelfv (GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightModelfv\n");
+}
+
+static GLvoid APIENTRY nullLightModeli (GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightModeli\n");
+}
+
+static GLvoid APIENTRY nullLightModeliv (GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightModeliv\n");
+}
+
+static GLvoid APIENTRY nullLightf (GLenum light, GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightf\n");
+}
+
+static GLvoid APIENTRY nullLightfv (GLenum light, GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightfv\n");
+}
+
+static GLvoid APIENTRY nullLighti (GLenum light, GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLighti\n");
+}
+
+static GLvoid APIENTRY nullLightiv (GLenum light, GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLightiv\n");
+}
+
+static GLvoid APIENTRY nullLineStipple (GLint factor, GLushort pattern){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLineStipple\n");
+}
+
+static GLvoid APIENTRY nullLineWidth (GLfloat width){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLineWidth\n");
+}
+
+static GLvoid APIENTRY nullListBase (GLuint base){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glListBase\n");
+}
+
+static GLvoid APIENTRY nullLoadIdentity (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLoadIdentity\n");
+}
+
+static GLvoid APIENTRY nullLoadMatrixd (const GLdouble *m){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLoadMatrixd\n");
+}
+
+static GLvoid APIENTRY nullLoadMatrixf (const GLfloat *m){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLoadMatrixf\n");
+}
+
+static GLvoid APIENTRY nullLoadName (GLuint name){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLoadName\n");
+}
+
+static GLvoid APIENTRY nullLogicOp (GLenum opcode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLogicOp\n");
+}
+
+static GLvoid APIENTRY nullMap1d (GLenum target, GLdouble u1, GLdouble u2, GLint stride, GLint order, const GLdouble *points){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMap1d\n");
+}
+
+static GLvoid APIENTRY nullMap1f (GLenum target, GLfloat u1, GLfloat u2, GLint stride, GLint order, const GLfloat *points){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMap1f\n");
+}
+
+static GLvoid APIENTRY nullMap2d (GLenum target, GLdouble u1, GLdouble u2, GLint ustride, GLint uorder, GLdouble v1, GLdouble v2, GLint vstride, GLint vorder, const GLdouble *points){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMap2d\n");
+}
+
+static GLvoid APIENTRY nullMap2f (GLenum target, GLfloat u1, GLfloat u2, GLint ustride, GLint uorder, GLfloat v1, GLfloat v2, GLint vstride, GLint vorder, const GLfloat *points){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMap2f\n");
+}
+
+static GLvoid APIENTRY nullMapGrid1d (GLint un, GLdouble u1, GLdouble u2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMapGrid1d\n");
+}
+
+static GLvoid APIENTRY nullMapGrid1f (GLint un, GLfloat u1, GLfloat u2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMapGrid1f\n");
+}
+
+static GLvoid APIENTRY nullMapGrid2d (GLint un, GLdouble u1, GLdouble u2, GLint vn, GLdouble v1, GLdouble v2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMapGrid2d\n");
+}
+
+static GLvoid APIENTRY nullMapGrid2f (GLint un, GLfloat u1, GLfloat u2, GLint vn, GLfloat v1, GLfloat v2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMapGrid2f\n");
+}
+
+static GLvoid APIENTRY nullMaterialf (GLenum face, GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMaterialf\n");
+}
+
+static GLvoid APIENTRY nullMaterialfv (GLenum face, GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMaterialfv\n");
+}
+
+static GLvoid APIENTRY nullMateriali (GLenum face, GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMateriali\n");
+}
+
+static GLvoid APIENTRY nullMaterialiv (GLenum face, GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMaterialiv\n");
+}
+
+static GLvoid APIENTRY nullMatrixMode (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMatrixMode\n");
+}
+
+static GLvoid APIENTRY nullMultMatrixd (const GLdouble *m){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMultMatrixd\n");
+}
+
+static GLvoid APIENTRY nullMultMatrixf (const GLfloat *m){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMultMatrixf\n");
+}
+
+static GLvoid APIENTRY nullNewList (GLuint list, GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNewList\n");
+}
+
+static GLvoid APIENTRY nullNormal3b (GLbyte nx, GLbyte ny, GLbyte nz){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3b\n");
+}
+
+static GLvoid APIENTRY nullNormal3bv (const GLbyte *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3bv\n");
+}
+
+static GLvoid APIENTRY nullNormal3d (GLdouble nx, GLdouble ny, GLdouble nz){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3d\n");
+}
+
+static GLvoid APIENTRY nullNormal3dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3dv\n");
+}
+
+static GLvoid APIENTRY nullNormal3f (GLfloat nx, GLfloat ny, GLfloat nz){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3f\n");
+}
+
+static GLvoid APIENTRY nullNormal3fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3fv\n");
+}
+
+static GLvoid APIENTRY nullNormal3i (GLint nx, GLint ny, GLint nz){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3i\n");
+}
+
+static GLvoid APIENTRY nullNormal3iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3iv\n");
+}
+
+static GLvoid APIENTRY nullNormal3s (GLshort nx, GLshort ny, GLshort nz){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3s\n");
+}
+
+static GLvoid APIENTRY nullNormal3sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormal3sv\n");
+}
+
+static GLvoid APIENTRY nullNormalPointer (GLenum type, GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glNormalPointer\n");
+}
+
+static GLvoid APIENTRY nullOrtho (GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glOrtho\n");
+}
+
+static GLvoid APIENTRY nullPassThrough (GLfloat token){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPassThrough\n");
+}
+
+static GLvoid APIENTRY nullPixelMapfv (GLenum map, GLsizei mapsize, const GLfloat *values){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelMapfv\n");
+}
+
+static GLvoid APIENTRY nullPixelMapuiv (GLenum map, GLsizei mapsize, const GLuint *values){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelMapuiv\n");
+}
+
+static GLvoid APIENTRY nullPixelMapusv (GLenum map, GLsizei mapsize, const GLushort *values){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelMapusv\n");
+}
+
+static GLvoid APIENTRY nullPixelStoref (GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelStoref\n");
+}
+
+static GLvoid APIENTRY nullPixelStorei (GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelStorei\n");
+}
+
+static GLvoid APIENTRY nullPixelTransferf (GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelTransferf\n");
+}
+
+static GLvoid APIENTRY nullPixelTransferi (GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelTransferi\n");
+}
+
+static GLvoid APIENTRY nullPixelZoom (GLfloat xfactor, GLfloat yfactor){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPixelZoom\n");
+}
+
+static GLvoid APIENTRY nullPointSize (GLfloat size){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPointSize\n");
+}
+
+static GLvoid APIENTRY nullPolygonMode (GLenum face, GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPolygonMode\n");
+}
+
+static GLvoid APIENTRY nullPolygonOffset (GLfloat factor, GLfloat units){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPolygonOffset\n");
+}
+
+static GLvoid APIENTRY nullPolygonStipple (const GLubyte *mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPolygonStipple\n");
+}
+
+static GLvoid APIENTRY nullPopAttrib (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPopAttrib\n");
+}
+
+static GLvoid APIENTRY nullPopClientAttrib (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPopClientAttrib\n");
+}
+
+static GLvoid APIENTRY nullPopMatrix (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPopMatrix\n");
+}
+
+static GLvoid APIENTRY nullPopName (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPopName\n");
+}
+
+static GLvoid APIENTRY nullPrioritizeTextures (GLsizei n, const GLuint *textures, const GLclampf *priorities){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPrioritizeTextures\n");
+}
+
+static GLvoid APIENTRY nullPushAttrib (GLbitfield mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPushAttrib\n");
+}
+
+static GLvoid APIENTRY nullPushClientAttrib (GLbitfield mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPushClientAttrib\n");
+}
+
+static GLvoid APIENTRY nullPushMatrix (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPushMatrix\n");
+}
+
+static GLvoid APIENTRY nullPushName (GLuint name){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glPushName\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2d (GLdouble x, GLdouble y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2d\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2dv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2f (GLfloat x, GLfloat y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2f\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2fv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2i (GLint x, GLint y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2i\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2iv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2s (GLshort x, GLshort y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2s\n");
+}
+
+static GLvoid APIENTRY nullRasterPos2sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos2sv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3d (GLdouble x, GLdouble y, GLdouble z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3d\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3dv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3f (GLfloat x, GLfloat y, GLfloat z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3f\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3fv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3i (GLint x, GLint y, GLint z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3i\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3iv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3s (GLshort x, GLshort y, GLshort z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3s\n");
+}
+
+static GLvoid APIENTRY nullRasterPos3sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos3sv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4d (GLdouble x, GLdouble y, GLdouble z, GLdouble w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4d\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4dv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4f (GLfloat x, GLfloat y, GLfloat z, GLfloat w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4f\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4fv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4i (GLint x, GLint y, GLint z, GLint w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4i\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4iv\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4s (GLshort x, GLshort y, GLshort z, GLshort w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4s\n");
+}
+
+static GLvoid APIENTRY nullRasterPos4sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRasterPos4sv\n");
+}
+
+static GLvoid APIENTRY nullReadBuffer (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glReadBuffer\n");
+}
+
+static GLvoid APIENTRY nullReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glReadPixels\n");
+}
+
+static GLvoid APIENTRY nullRectd (GLdouble x1, GLdouble y1, GLdouble x2, GLdouble y2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRectd\n");
+}
+
+static GLvoid APIENTRY nullRectdv (const GLdouble *v1, const GLdouble *v2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRectdv\n");
+}
+
+static GLvoid APIENTRY nullRectf (GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRectf\n");
+}
+
+static GLvoid APIENTRY nullRectfv (const GLfloat *v1, const GLfloat *v2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRectfv\n");
+}
+
+static GLvoid APIENTRY nullRecti (GLint x1, GLint y1, GLint x2, GLint y2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRecti\n");
+}
+
+static GLvoid APIENTRY nullRectiv (const GLint *v1, const GLint *v2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRectiv\n");
+}
+
+static GLvoid APIENTRY nullRects (GLshort x1, GLshort y1, GLshort x2, GLshort y2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRects\n");
+}
+
+static GLvoid APIENTRY nullRectsv (const GLshort *v1, const GLshort *v2){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRectsv\n");
+}
+
+static GLint APIENTRY nullRenderMode (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRenderMode\n");
+
+	return 0;
+}
+
+static GLvoid APIENTRY nullRotated (GLdouble angle, GLdouble x, GLdouble y, GLdouble z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRotated\n");
+}
+
+static GLvoid APIENTRY nullRotatef (GLfloat angle, GLfloat x, GLfloat y, GLfloat z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glRotatef\n");
+}
+
+static GLvoid APIENTRY nullScaled (GLdouble x, GLdouble y, GLdouble z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glScaled\n");
+}
+
+static GLvoid APIENTRY nullScalef (GLfloat x, GLfloat y, GLfloat z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glScalef\n");
+}
+
+static GLvoid APIENTRY nullScissor (GLint x, GLint y, GLsizei width, GLsizei height){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glScissor\n");
+}
+
+static GLvoid APIENTRY nullSelectBuffer (GLsizei size, GLuint *buffer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glSelectBuffer\n");
+}
+
+static GLvoid APIENTRY nullShadeModel (GLenum mode){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glShadeModel\n");
+}
+
+static GLvoid APIENTRY nullStencilFunc (GLenum func, GLint ref, GLuint mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glStencilFunc\n");
+}
+
+static GLvoid APIENTRY nullStencilMask (GLuint mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glStencilMask\n");
+}
+
+static GLvoid APIENTRY nullStencilOp (GLenum fail, GLenum zfail, GLenum zpass){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glStencilOp\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1d (GLdouble s){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1d\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1dv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1f (GLfloat s){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1f\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1fv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1i (GLint s){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1i\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1iv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1s (GLshort s){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1s\n");
+}
+
+static GLvoid APIENTRY nullTexCoord1sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord1sv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2d (GLdouble s, GLdouble t){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2d\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2dv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2f (GLfloat s, GLfloat t){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2f\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2fv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2i (GLint s, GLint t){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2i\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2iv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2s (GLshort s, GLshort t){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2s\n");
+}
+
+static GLvoid APIENTRY nullTexCoord2sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord2sv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3d (GLdouble s, GLdouble t, GLdouble r){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3d\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3dv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3f (GLfloat s, GLfloat t, GLfloat r){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3f\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3fv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3i (GLint s, GLint t, GLint r){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3i\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3iv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3s (GLshort s, GLshort t, GLshort r){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3s\n");
+}
+
+static GLvoid APIENTRY nullTexCoord3sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord3sv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4d (GLdouble s, GLdouble t, GLdouble r, GLdouble q){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4d\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4dv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4f (GLfloat s, GLfloat t, GLfloat r, GLfloat q){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4f\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4fv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4i (GLint s, GLint t, GLint r, GLint q){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4i\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4iv\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4s (GLshort s, GLshort t, GLshort r, GLshort q){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4s\n");
+}
+
+static GLvoid APIENTRY nullTexCoord4sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoord4sv\n");
+}
+
+static GLvoid APIENTRY nullTexCoordPointer (GLint size, GLenum type, GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexCoordPointer\n");
+}
+
+static GLvoid APIENTRY nullTexEnvf (GLenum target, GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexEnvf\n");
+}
+
+static GLvoid APIENTRY nullTexEnvfv (GLenum target, GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexEnvfv\n");
+}
+
+static GLvoid APIENTRY nullTexEnvi (GLenum target, GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexEnvi\n");
+}
+
+static GLvoid APIENTRY nullTexEnviv (GLenum target, GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexEnviv\n");
+}
+
+static GLvoid APIENTRY nullTexGend (GLenum coord, GLenum pname, GLdouble param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexGend\n");
+}
+
+static GLvoid APIENTRY nullTexGendv (GLenum coord, GLenum pname, const GLdouble *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexGendv\n");
+}
+
+static GLvoid APIENTRY nullTexGenf (GLenum coord, GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexGenf\n");
+}
+
+static GLvoid APIENTRY nullTexGenfv (GLenum coord, GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexGenfv\n");
+}
+
+static GLvoid APIENTRY nullTexGeni (GLenum coord, GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexGeni\n");
+}
+
+static GLvoid APIENTRY nullTexGeniv (GLenum coord, GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexGeniv\n");
+}
+
+static GLvoid APIENTRY nullTexImage1D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexImage1D\n");
+}
+
+static GLvoid APIENTRY nullTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexImage2D\n");
+}
+
+static GLvoid APIENTRY nullTexParameterf (GLenum target, GLenum pname, GLfloat param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexParameterf\n");
+}
+
+static GLvoid APIENTRY nullTexParameterfv (GLenum target, GLenum pname, const GLfloat *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexParameterfv\n");
+}
+
+static GLvoid APIENTRY nullTexParameteri (GLenum target, GLenum pname, GLint param){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexParameteri\n");
+}
+
+static GLvoid APIENTRY nullTexParameteriv (GLenum target, GLenum pname, const GLint *params){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexParameteriv\n");
+}
+
+static GLvoid APIENTRY nullTexSubImage1D (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexSubImage1D\n");
+}
+
+static GLvoid APIENTRY nullTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTexSubImage2D\n");
+}
+
+static GLvoid APIENTRY nullTranslated (GLdouble x, GLdouble y, GLdouble z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTranslated\n");
+}
+
+static GLvoid APIENTRY nullTranslatef (GLfloat x, GLfloat y, GLfloat z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glTranslatef\n");
+}
+
+static GLvoid APIENTRY nullVertex2d (GLdouble x, GLdouble y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2d\n");
+}
+
+static GLvoid APIENTRY nullVertex2dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2dv\n");
+}
+
+static GLvoid APIENTRY nullVertex2f (GLfloat x, GLfloat y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2f\n");
+}
+
+static GLvoid APIENTRY nullVertex2fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2fv\n");
+}
+
+static GLvoid APIENTRY nullVertex2i (GLint x, GLint y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2i\n");
+}
+
+static GLvoid APIENTRY nullVertex2iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2iv\n");
+}
+
+static GLvoid APIENTRY nullVertex2s (GLshort x, GLshort y){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2s\n");
+}
+
+static GLvoid APIENTRY nullVertex2sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex2sv\n");
+}
+
+static GLvoid APIENTRY nullVertex3d (GLdouble x, GLdouble y, GLdouble z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3d\n");
+}
+
+static GLvoid APIENTRY nullVertex3dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3dv\n");
+}
+
+static GLvoid APIENTRY nullVertex3f (GLfloat x, GLfloat y, GLfloat z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3f\n");
+}
+
+static GLvoid APIENTRY nullVertex3fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3fv\n");
+}
+
+static GLvoid APIENTRY nullVertex3i (GLint x, GLint y, GLint z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3i\n");
+}
+
+static GLvoid APIENTRY nullVertex3iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3iv\n");
+}
+
+static GLvoid APIENTRY nullVertex3s (GLshort x, GLshort y, GLshort z){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3s\n");
+}
+
+static GLvoid APIENTRY nullVertex3sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex3sv\n");
+}
+
+static GLvoid APIENTRY nullVertex4d (GLdouble x, GLdouble y, GLdouble z, GLdouble w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4d\n");
+}
+
+static GLvoid APIENTRY nullVertex4dv (const GLdouble *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4dv\n");
+}
+
+static GLvoid APIENTRY nullVertex4f (GLfloat x, GLfloat y, GLfloat z, GLfloat w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4f\n");
+}
+
+static GLvoid APIENTRY nullVertex4fv (const GLfloat *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4fv\n");
+}
+
+static GLvoid APIENTRY nullVertex4i (GLint x, GLint y, GLint z, GLint w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4i\n");
+}
+
+static GLvoid APIENTRY nullVertex4iv (const GLint *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4iv\n");
+}
+
+static GLvoid APIENTRY nullVertex4s (GLshort x, GLshort y, GLshort z, GLshort w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4s\n");
+}
+
+static GLvoid APIENTRY nullVertex4sv (const GLshort *v){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertex4sv\n");
+}
+
+static GLvoid APIENTRY nullVertexPointer (GLint size, GLenum type, GLsizei stride, const GLvoid *pointer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glVertexPointer\n");
+}
+
+static GLvoid APIENTRY nullViewport (GLint x, GLint y, GLsizei width, GLsizei height){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glViewport\n");
+}
+
+static GLvoid APIENTRY nullActiveTextureARB (GLenum texture){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glActiveTextureARB\n");
+}
+
+static GLvoid APIENTRY nullClientActiveTextureARB (GLenum texture){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glClientActiveTextureARB\n");
+}
+
+static GLvoid APIENTRY nullBindBufferARB (GLenum target, GLuint buffer){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBindBufferARB\n");
+}
+
+static GLvoid APIENTRY nullDeleteBuffersARB (GLsizei n, const GLuint *buffers){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDeleteBuffersARB\n");
+}
+
+static GLvoid APIENTRY nullGenBuffersARB (GLsizei n, GLuint *buffers){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGenBuffersARB\n");
+
+	NULL_GenNames(n, buffers);
+}
+
+static GLvoid APIENTRY nullBufferDataARB (GLenum target, GLsizeiptrARB size, const GLvoid *data, GLenum usage){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBufferDataARB\n");
+
+	// Keep scratch memory for glMapBufferARB as large as the largest
+	// buffer, so whatever is written to a mapping stays in bounds
+	if (size > qglNull.mapBufferSize){
+		qglNull.mapBuffer = realloc(qglNull.mapBuffer, size);
+		if (!qglNull.mapBuffer)
+			Com_Error(ERR_FATAL, "glBufferDataARB: out of memory");
+
+		qglNull.mapBufferSize = size;
+	}
+}
+
+static GLvoid APIENTRY nullBufferSubDataARB (GLenum target, GLintptrARB offset, GLsizeiptrARB size, const GLvoid *data){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBufferSubDataARB\n");
+}
+
+static GLvoid * APIENTRY nullMapBufferARB (GLenum target, GLenum access){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glMapBufferARB\n");
+
+	return qglNull.mapBuffer;
+}
+
+static GLboolean APIENTRY nullUnmapBufferARB (GLenum target){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glUnmapBufferARB\n");
+
+	return GL_TRUE;
+}
+
+static GLvoid APIENTRY nullBindProgramARB (GLenum target, GLuint program){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glBindProgramARB\n");
+}
+
+static GLvoid APIENTRY nullDeleteProgramsARB (GLsizei n, const GLuint *programs){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDeleteProgramsARB\n");
+}
+
+static GLvoid APIENTRY nullGenProgramsARB (GLsizei n, GLuint *programs){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glGenProgramsARB\n");
+
+	NULL_GenNames(n, programs);
+}
+
+static GLvoid APIENTRY nullProgramStringARB (GLenum target, GLenum format, GLsizei len, const GLvoid *string){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glProgramStringARB\n");
+}
+
+static GLvoid APIENTRY nullProgramEnvParameter4fARB (GLenum target, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glProgramEnvParameter4fARB\n");
+}
+
+static GLvoid APIENTRY nullProgramLocalParameter4fARB (GLenum target, GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glProgramLocalParameter4fARB\n");
+}
+
+static GLvoid APIENTRY nullDrawRangeElementsEXT (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const GLvoid *indices){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glDrawRangeElementsEXT\n");
+}
+
+static GLvoid APIENTRY nullLockArraysEXT (GLint start, GLsizei count){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glLockArraysEXT\n");
+}
+
+static GLvoid APIENTRY nullUnlockArraysEXT (GLvoid){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glUnlockArraysEXT\n");
+}
+
+static GLvoid APIENTRY nullActiveStencilFaceEXT (GLenum face){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glActiveStencilFaceEXT\n");
+}
+
+static GLvoid APIENTRY nullStencilOpSeparateATI (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glStencilOpSeparateATI\n");
+}
+
+static GLvoid APIENTRY nullStencilFuncSeparateATI (GLenum frontfunc, GLenum backfunc, GLint red, GLuint mask){
+
+	if (qglNull.logFile)
+		fprintf(qglNull.logFile, "glStencilFuncSeparateATI\n");
+}
+
+/*
+ =================
+ QGL_Shutdown
+ =================
+*/
+void QGL_Shutdown (void){
+
+	Com_Printf("...shutting down QGL\n");
+
+	QGL_EnableLogging(false);
+
+	if (qglNull.mapBuffer){
+		free(qglNull.mapBuffer);
+
+		qglNull.mapBuffer = NULL;
+		qglNull.mapBufferSize = 0;
+	}
+
+	qglAccum                        = NULL;
+	qglAlphaFunc                    = NULL;
+	qglAreTexturesResident          = NULL;
+	qglArrayElement                 = NULL;
+	qglBegin                        = NULL;
+	qglBindTexture                  = NULL;
+	qglBitmap                       = NULL;
+	qglBlendFunc                    = NULL;
+	qglCallList                     = NULL;
+	qglCallLists                    = NULL;
+	qglClear                        = NULL;
+	qglClearAccum                   = NULL;
+	qglClearColor                   = NULL;
+	qglClearDepth                   = NULL;
+	qglClearIndex                   = NULL;
+	qglClearStencil                 = NULL;
+	qglClipPlane                    = NULL;
+	qglColor3b                      = NULL;
+	qglColor3bv                     = NULL;
+	qglColor3d                      = NULL;
+	qglColor3dv                     = NULL;
+	qglColor3f                      = NULL;
+	qglColor3fv                     = NULL;
+	qglColor3i                      = NULL;
+	qglColor3iv                     = NULL;
+	qglColor3s                      = NULL;
+	qglColor3sv                     = NULL;
+	qglColor3ub                     = NULL;
+	qglColor3ubv                    = NULL;
+	qglColor3ui                     = NULL;
+	qglColor3uiv                    = NULL;
+	qglColor3us                     = NULL;
+	qglColor3usv                    = NULL;
+	qglColor4b                      = NULL;
+	qglColor4bv                     = NULL;
+	qglColor4d                      = NULL;
+	qglColor4dv                     = NULL;
+	qglColor4f                      = NULL;
+	qglColor4fv                     = NULL;
+	qglColor4i                      = NULL;
+	qglColor4iv                     = NULL;
+	qglColor4s                      = NULL;
+	qglColor4sv                     = NULL;
+	qglColor4ub                     = NULL;
+	qglColor4ubv                    = NULL;
+	qglColor4ui                     = NULL;
+	qglColor4uiv                    = NULL;
+	qglColor4us                     = NULL;
+	qglColor4usv                    = NULL;
+	qglColorMask                    = NULL;
+	qglColorMaterial                = NULL;
+	qglColorPointer                 = NULL;
+	qglCopyPixels                   = NULL;
+	qglCopyTexImage1D               = NULL;
+	qglCopyTexImage2D               = NULL;
+	qglCopyTexSubImage1D            = NULL;
+	qglCopyTexSubImage2D            = NULL;
+	qglCullFace                     = NULL;
+	qglDeleteLists                  = NULL;
+	qglDeleteTextures               = NULL;
+	qglDepthFunc                    = NULL;
+	qglDepthMask                    = NULL;
+	qglDepthRange                   = NULL;
+	qglDisable                      = NULL;
+	qglDisableClientState           = NULL;
+	qglDrawArrays                   = NULL;
+	qglDrawBuffer                   = NULL;
+	qglDrawElements                 = NULL;
+	qglDrawPixels                   = NULL;
+	qglEdgeFlag                     = NULL;
+	qglEdgeFlagPointer              = NULL;
+	qglEdgeFlagv                    = NULL;
+	qglEnable                       = NULL;
+	qglEnableClientState            = NULL;
+	qglEnd                          = NULL;
+	qglEndList                      = NULL;
+	qglEvalCoord1d                  = NULL;
+	qglEvalCoord1dv                 = NULL;
+	qglEvalCoord1f                  = NULL;
+	qglEvalCoord1fv                 = NULL;
+	qglEvalCoord2d                  = NULL;
+	qglEvalCoord2dv                 = NULL;
+	qglEvalCoord2f                  = NULL;
+	qglEvalCoord2fv                 = NULL;
+	qglEvalMesh1                    = NULL;
+	qglEvalMesh2                    = NULL;
+	qglEvalPoint1                   = NULL;
+	qglEvalPoint2                   = NULL;
+	qglFeedbackBuffer               = NULL;
+	qglFinish                       = NULL;
+	qglFlush                        = NULL;
+	qglFogf                         = NULL;
+	qglFogfv                        = NULL;
+	qglFogi                         = NULL;
+	qglFogiv                        = NULL;
+	qglFrontFace                    = NULL;
+	qglFrustum                      = NULL;
+	qglGenLists                     = NULL;
+	qglGenTextures                  = NULL;
+	qglGetBooleanv                  = NULL;
+	qglGetClipPlane                 = NULL;
+	qglGetDoublev                   = NULL;
+	qglGetError                     = NULL;
+	qglGetFloatv                    = NULL;
+	qglGetIntegerv                  = NULL;
+	qglGetLightfv                   = NULL;
+	qglGetLightiv                   = NULL;
+	qglGetMapdv                     = NULL;
+	qglGetMapfv                     = NULL;
+	qglGetMapiv                     = NULL;
+	qglGetMaterialfv                = NULL;
+	qglGetMaterialiv                = NULL;
+	qglGetPixelMapfv                = NULL;
+	qglGetPixelMapuiv               = NULL;
+	qglGetPixelMapusv               = NULL;
+	qglGetPointerv                  = NULL;
+	qglGetPolygonStipple            = NULL;
+	qglGetString                    = NULL;
+	qglGetTexEnvfv                  = NULL;
+	qglGetTexEnviv                  = NULL;
+	qglGetTexGendv                  = NULL;
+	qglGetTexGenfv                  = NULL;
+	qglGetTexGeniv                  = NULL;
+	qglGetTexImage                  = NULL;
+	qglGetTexLevelParameterfv       = NULL;
+	qglGetTexLevelParameteriv       = NULL;
+	qglGetTexParameterfv            = NULL;
+	qglGetTexParameteriv            = NULL;
+	qglHint                         = NULL;
+	qglIndexMask                    = NULL;
+	qglIndexPointer                 = NULL;
+	qglIndexd                       = NULL;
+	qglIndexdv                      = NULL;
+	qglIndexf                       = NULL;
+	qglIndexfv                      = NULL;
+	qglIndexi                       = NULL;
+	qglIndexiv                      = NULL;
+	qglIndexs                       = NULL;
+	qglIndexsv                      = NULL;
+	qglIndexub                      = NULL;
+	qglIndexubv                     = NULL;
+	qglInitNames                    = NULL;
+	qglInterleavedArrays            = NULL;
+	qglIsEnabled                    = NULL;
+	qglIsList                       = NULL;
+	qglIsTexture                    = NULL;
+	qglLightModelf                  = NULL;
+	qglLightModelfv                 = NULL;
+	qglLightModeli                  = NULL;
+	qglLightModeliv                 = NULL;
+	qglLightf                       = NULL;
+	qglLightfv                      = NULL;
+	qglLighti                       = NULL;
+	qglLightiv                      = NULL;
+	qglLineStipple                  = NULL;
+	qglLineWidth                    = NULL;
+	qglListBase                     = NULL;
+	qglLoadIdentity                 = NULL;
+	qglLoadMatrixd                  = NULL;
+	qglLoadMatrixf                  = NULL;
+	qglLoadName                     = NULL;
+	qglLogicOp                      = NULL;
+	qglMap1d                        = NULL;
+	qglMap1f                        = NULL;
+	qglMap2d                        = NULL;
+	qglMap2f                        = NULL;
+	qglMapGrid1d                    = NULL;
+	qglMapGrid1f                    = NULL;
+	qglMapGrid2d                    = NULL;
+	qglMapGrid2f                    = NULL;
+	qglMaterialf                    = NULL;
+	qglMaterialfv                   = NULL;
+	qglMateriali                    = NULL;
+	qglMaterialiv                   = NULL;
+	qglMatrixMode                   = NULL;
+	qglMultMatrixd                  = NULL;
+	qglMultMatrixf                  = NULL;
+	qglNewList                      = NULL;
+	qglNormal3b                     = NULL;
+	qglNormal3bv                    = NULL;
+	qglNormal3d                     = NULL;
+	qglNormal3dv                    = NULL;
+	qglNormal3f                     = NULL;
+	qglNormal3fv                    = NULL;
+	qglNormal3i                     = NULL;
+	qglNormal3iv                    = NULL;
+	qglNormal3s                     = NULL;
+	qglNormal3sv                    = NULL;
+	qglNormalPointer                = NULL;
+	qglOrtho                        = NULL;
+	qglPassThrough                  = NULL;
+	qglPixelMapfv                   = NULL;
+	qglPixelMapuiv                  = NULL;
+	qglPixelMapusv                  = NULL;
+	qglPixelStoref                  = NULL;
+	qglPixelStorei                  = NULL;
+	qglPixelTransferf               = NULL;
+	qglPixelTransferi               = NULL;
+	qglPixelZoom                    = NULL;
+	qglPointSize                    = NULL;
+	qglPolygonMode                  = NULL;
+	qglPolygonOffset                = NULL;
+	qglPolygonStipple               = NULL;
+	qglPopAttrib                    = NULL;
+	qglPopClientAttrib              = NULL;
+	qglPopMatrix                    = NULL;
+	qglPopName                      = NULL;
+	qglPrioritizeTextures           = NULL;
+	qglPushAttrib                   = NULL;
+	qglPushClientAttrib             = NULL;
+	qglPushMatrix                   = NULL;
+	qglPushName                     = NULL;
+	qglRasterPos2d                  = NULL;
+	qglRasterPos2dv                 = NULL;
+	qglRasterPos2f                  = NULL;
+	qglRasterPos2fv                 = NULL;
+	qglRasterPos2i                  = NULL;
+	qglRasterPos2iv                 = NULL;
+	qglRasterPos2s                  = NULL;
+	qglRasterPos2sv                 = NULL;
+	qglRasterPos3d                  = NULL;
+	qglRasterPos3dv                 = NULL;
+	qglRasterPos3f                  = NULL;
+	qglRasterPos3fv                 = NULL;
+	qglRasterPos3i                  = NULL;
+	qglRasterPos3iv                 = NULL;
+	qglRasterPos3s                  = NULL;
+	qglRasterPos3sv                 = NULL;
+	qglRasterPos4d                  = NULL;
+	qglRasterPos4dv                 = NULL;
+	qglRasterPos4f                  = NULL;
+	qglRasterPos4fv                 = NULL;
+	qglRasterPos4i                  = NULL;
+	qglRasterPos4iv                 = NULL;
+	qglRasterPos4s                  = NULL;
+	qglRasterPos4sv                 = NULL;
+	qglReadBuffer                   = NULL;
+	qglReadPixels                   = NULL;
+	qglRectd                        = NULL;
+	qglRectdv                       = NULL;
+	qglRectf                        = NULL;
+	qglRectfv                       = NULL;
+	qglRecti                        = NULL;
+	qglRectiv                       = NULL;
+	qglRects                        = NULL;
+	qglRectsv                       = NULL;
+	qglRenderMode                   = NULL;
+	qglRotated                      = NULL;
+	qglRotatef                      = NULL;
+	qglScaled                       = NULL;
+	qglScalef                       = NULL;
+	qglScissor                      = NULL;
+	qglSelectBuffer                 = NULL;
+	qglShadeModel                   = NULL;
+	qglStencilFunc                  = NULL;
+	qglStencilMask                  = NULL;
+	qglStencilOp                    = NULL;
+	qglTexCoord1d                   = NULL;
+	qglTexCoord1dv                  = NULL;
+	qglTexCoord1f                   = NULL;
+	qglTexCoord1fv                  = NULL;
+	qglTexCoord1i                   = NULL;
+	qglTexCoord1iv                  = NULL;
+	qglTexCoord1s                   = NULL;
+	qglTexCoord1sv                  = NULL;
+	qglTexCoord2d                   = NULL;
+	qglTexCoord2dv                  = NULL;
+	qglTexCoord2f                   = NULL;
+	qglTexCoord2fv                  = NULL;
+	qglTexCoord2i                   = NULL;
+	qglTexCoord2iv                  = NULL;
+	qglTexCoord2s                   = NULL;
+	qglTexCoord2sv                  = NULL;
+	qglTexCoord3d                   = NULL;
+	qglTexCoord3dv                  = NULL;
+	qglTexCoord3f                   = NULL;
+	qglTexCoord3fv                  = NULL;
+	qglTexCoord3i                   = NULL;
+	qglTexCoord3iv                  = NULL;
+	qglTexCoord3s                   = NULL;
+	qglTexCoord3sv                  = NULL;
+	qglTexCoord4d                   = NULL;
+	qglTexCoord4dv                  = NULL;
+	qglTexCoord4f                   = NULL;
+	qglTexCoord4fv                  = NULL;
+	qglTexCoord4i                   = NULL;
+	qglTexCoord4iv                  = NULL;
+	qglTexCoord4s                   = NULL;
+	qglTexCoord4sv                  = NULL;
+	qglTexCoordPointer              = NULL;
+	qglTexEnvf                      = NULL;
+	qglTexEnvfv                     = NULL;
+	qglTexEnvi                      = NULL;
+	qglTexEnviv                     = NULL;
+	qglTexGend                      = NULL;
+	qglTexGendv                     = NULL;
+	qglTexGenf                      = NULL;
+	qglTexGenfv                     = NULL;
+	qglTexGeni                      = NULL;
+	qglTexGeniv                     = NULL;
+	qglTexImage1D                   = NULL;
+	qglTexImage2D                   = NULL;
+	qglTexParameterf                = NULL;
+	qglTexParameterfv               = NULL;
+	qglTexParameteri                = NULL;
+	qglTexParameteriv               = NULL;
+	qglTexSubImage1D                = NULL;
+	qglTexSubImage2D                = NULL;
+	qglTranslated                   = NULL;
+	qglTranslatef                   = NULL;
+	qglVertex2d                     = NULL;
+	qglVertex2dv                    = NULL;
+	qglVertex2f                     = NULL;
+	qglVertex2fv                    = NULL;
+	qglVertex2i                     = NULL;
+	qglVertex2iv                    = NULL;
+	qglVertex2s                     = NULL;
+	qglVertex2sv                    = NULL;
+	qglVertex3d                     = NULL;
+	qglVertex3dv                    = NULL;
+	qglVertex3f                     = NULL;
+	qglVertex3fv                    = NULL;
+	qglVertex3i                     = NULL;
+	qglVertex3iv                    = NULL;
+	qglVertex3s                     = NULL;
+	qglVertex3sv                    = NULL;
+	qglVertex4d                     = NULL;
+	qglVertex4dv                    = NULL;
+	qglVertex4f                     = NULL;
+	qglVertex4fv                    = NULL;
+	qglVertex4i                     = NULL;
+	qglVertex4iv                    = NULL;
+	qglVertex4s                     = NULL;
+	qglVertex4sv                    = NULL;
+	qglVertexPointer                = NULL;
+	qglViewport                     = NULL;
+
+	qglActiveTextureARB             = NULL;
+	qglClientActiveTextureARB       = NULL;
+
+	qglBindBufferARB                = NULL;
+	qglDeleteBuffersARB             = NULL;
+	qglGenBuffersARB                = NULL;
+	qglBufferDataARB                = NULL;
+	qglBufferSubDataARB             = NULL;
+	qglMapBufferARB                 = NULL;
+	qglUnmapBufferARB               = NULL;
+
+	qglBindProgramARB               = NULL;
+	qglDeleteProgramsARB            = NULL;
+	qglGenProgramsARB               = NULL;
+	qglProgramStringARB             = NULL;
+	qglProgramEnvParameter4fARB     = NULL;
+	qglProgramLocalParameter4fARB   = NULL;
+
+	qglDrawRangeElementsEXT         = NULL;
+
+	qglLockArraysEXT                = NULL;
+	qglUnlockArraysEXT              = NULL;
+
+	qglActiveStencilFaceEXT         = NULL;
+
+	qglStencilOpSeparateATI         = NULL;
+	qglStencilFuncSeparateATI       = NULL;
+}
+
+/*
+ =================
+ QGL_Init
+
+ The driver name is ignored, there is nothing to load
+ =================
+*/
+qboolean QGL_Init (const char *driver){
+
+	Com_Printf("...initializing QGL\n");
+	Com_Printf("...using the null driver\n");
+
+	qglAccum                        = nullAccum;
+	qglAlphaFunc                    = nullAlphaFunc;
+	qglAreTexturesResident          = nullAreTexturesResident;
+	qglArrayElement                 = nullArrayElement;
+	qglBegin                        = nullBegin;
+	qglBindTexture                  = nullBindTexture;
+	qglBitmap                       = nullBitmap;
+	qglBlendFunc                    = nullBlendFunc;
+	qglCallList                     = nullCallList;
+	qglCallLists                    = nullCallLists;
+	qglClear                        = nullClear;
+	qglClearAccum                   = nullClearAccum;
+	qglClearColor                   = nullClearColor;
+	qglClearDepth                   = nullClearDepth;
+	qglClearIndex                   = nullClearIndex;
+	qglClearStencil                 = nullClearStencil;
+	qglClipPlane                    = nullClipPlane;
+	qglColor3b                      = nullColor3b;
+	qglColor3bv                     = nullColor3bv;
+	qglColor3d                      = nullColor3d;
+	qglColor3dv                     = nullColor3dv;
+	qglColor3f                      = nullColor3f;
+	qglColor3fv                     = nullColor3fv;
+	qglColor3i                      = nullColor3i;
+	qglColor3iv                     = nullColor3iv;
+	qglColor3s                      = nullColor3s;
+	qglColor3sv                     = nullColor3sv;
+	qglColor3ub                     = nullColor3ub;
+	qglColor3ubv                    = nullColor3ubv;
+	qglColor3ui                     = nullColor3ui;
+	qglColor3uiv                    = nullColor3uiv;
+	qglColor3us                     = nullColor3us;
+	qglColor3usv                    = nullColor3usv;
+	qglColor4b                      = nullColor4b;
+	qglColor4bv                     = nullColor4bv;
+	qglColor4d                      = nullColor4d;
+	qglColor4dv                     = nullColor4dv;
+	qglColor4f                      = nullColor4f;
+	qglColor4fv                     = nullColor4fv;
+	qglColor4i                      = nullColor4i;
+	qglColor4iv                     = nullColor4iv;
+	qglColor4s                      = nullColor4s;
+	qglColor4sv                     = nullColor4sv;
+	qglColor4ub                     = nullColor4ub;
+	qglColor4ubv                    = nullColor4ubv;
+	qglColor4ui                     = nullColor4ui;
+	qglColor4uiv                    = nullColor4uiv;
+	qglColor4us                     = nullColor4us;
+	qglColor4usv                    = nullColor4usv;
+	qglColorMask                    = nullColorMask;
+	qglColorMaterial                = nullColorMaterial;
+	qglColorPointer                 = nullColorPointer;
+	qglCopyPixels                   = nullCopyPixels;
+	qglCopyTexImage1D               = nullCopyTexImage1D;
+	qglCopyTexImage2D               = nullCopyTexImage2D;
+	qglCopyTexSubImage1D            = nullCopyTexSubImage1D;
+	qglCopyTexSubImage2D            = nullCopyTexSubImage2D;
+	qglCullFace                     = nullCullFace;
+	qglDeleteLists                  = nullDeleteLists;
+	qglDeleteTextures               = nullDeleteTextures;
+	qglDepthFunc                    = nullDepthFunc;
+	qglDepthMask                    = nullDepthMask;
+	qglDepthRange                   = nullDepthRange;
+	qglDisable                      = nullDisable;
+	qglDisableClientState           = nullDisableClientState;
+	qglDrawArrays                   = nullDrawArrays;
+	qglDrawBuffer                   = nullDrawBuffer;
+	qglDrawElements                 = nullDrawElements;
+	qglDrawPixels                   = nullDrawPixels;
+	qglEdgeFlag                     = nullEdgeFlag;
+	qglEdgeFlagPointer              = nullEdgeFlagPointer;
+	qglEdgeFlagv                    = nullEdgeFlagv;
+	qglEnable                       = nullEnable;
+	qglEnableClientState            = nullEnableClientState;
+	qglEnd                          = nullEnd;
+	qglEndList                      = nullEndList;
+	qglEvalCoord1d                  = nullEvalCoord1d;
+	qglEvalCoord1dv                 = nullEvalCoord1dv;
+	qglEvalCoord1f                  = nullEvalCoord1f;
+	qglEvalCoord1fv                 = nullEvalCoord1fv;
+	qglEvalCoord2d                  = nullEvalCoord2d;
+	qglEvalCoord2dv                 = nullEvalCoord2dv;
+	qglEvalCoord2f                  = nullEvalCoord2f;
+	qglEvalCoord2fv                 = nullEvalCoord2fv;
+	qglEvalMesh1                    = nullEvalMesh1;
+	qglEvalMesh2                    = nullEvalMesh2;
+	qglEvalPoint1                   = nullEvalPoint1;
+	qglEvalPoint2                   = nullEvalPoint2;
+	qglFeedbackBuffer               = nullFeedbackBuffer;
+	qglFinish                       = nullFinish;
+	qglFlush                        = nullFlush;
+	qglFogf                         = nullFogf;
+	qglFogfv                        = nullFogfv;
+	qglFogi                         = nullFogi;
+	qglFogiv                        = nullFogiv;
+	qglFrontFace                    = nullFrontFace;
+	qglFrustum                      = nullFrustum;
+	qglGenLists                     = nullGenLists;
+	qglGenTextures                  = nullGenTextures;
+	qglGetBooleanv                  = nullGetBooleanv;
+	qglGetClipPlane                 = nullGetClipPlane;
+	qglGetDoublev                   = nullGetDoublev;
+	qglGetError                     = nullGetError;
+	qglGetFloatv                    = nullGetFloatv;
+	qglGetIntegerv                  = nullGetIntegerv;
+	qglGetLightfv                   = nullGetLightfv;
+	qglGetLightiv                   = nullGetLightiv;
+	qglGetMapdv                     = nullGetMapdv;
+	qglGetMapfv                     = nullGetMapfv;
+	qglGetMapiv                     = nullGetMapiv;
+	qglGetMaterialfv                = nullGetMaterialfv;
+	qglGetMaterialiv                = nullGetMaterialiv;
+	qglGetPixelMapfv                = nullGetPixelMapfv;
+	qglGetPixelMapuiv               = nullGetPixelMapuiv;
+	qglGetPixelMapusv               = nullGetPixelMapusv;
+	qglGetPointerv                  = nullGetPointerv;
+	qglGetPolygonStipple            = nullGetPolygonStipple;
+	qglGetString                    = nullGetString;
+	qglGetTexEnvfv                  = nullGetTexEnvfv;
+	qglGetTexEnviv                  = nullGetTexEnviv;
+	qglGetTexGendv                  = nullGetTexGendv;
+	qglGetTexGenfv                  = nullGetTexGenfv;
+	qglGetTexGeniv                  = nullGetTexGeniv;
+	qglGetTexImage                  = nullGetTexImage;
+	qglGetTexLevelParameterfv       = nullGetTexLevelParameterfv;
+	qglGetTexLevelParameteriv       = nullGetTexLevelParameteriv;
+	qglGetTexParameterfv            = nullGetTexParameterfv;
+	qglGetTexParameteriv            = nullGetTexParameteriv;
+	qglHint                         = nullHint;
+	qglIndexMask                    = nullIndexMask;
+	qglIndexPointer                 = nullIndexPointer;
+	qglIndexd                       = nullIndexd;
+	qglIndexdv                      = nullIndexdv;
+	qglIndexf                       = nullIndexf;
+	qglIndexfv                      = nullIndexfv;
+	qglIndexi                       = nullIndexi;
+	qglIndexiv                      = nullIndexiv;
+	qglIndexs                       = nullIndexs;
+	qglIndexsv                      = nullIndexsv;
+	qglIndexub                      = nullIndexub;
+	qglIndexubv                     = nullIndexubv;
+	qglInitNames                    = nullInitNames;
+	qglInterleavedArrays            = nullInterleavedArrays;
+	qglIsEnabled                    = nullIsEnabled;
+	qglIsList                       = nullIsList;
+	qglIsTexture                    = nullIsTexture;
+	qglLightModelf                  = nullLightModelf;
+	qglLightModelfv                 = nullLightModelfv;
+	qglLightModeli                  = nullLightModeli;
+	qglLightModeliv                 = nullLightModeliv;
+	qglLightf                       = nullLightf;
+	qglLightfv                      = nullLightfv;
+	qglLighti                       = nullLighti;
+	qglLightiv                      = nullLightiv;
+	qglLineStipple                  = nullLineStipple;
+	qglLineWidth                    = nullLineWidth;
+	qglListBase                     = nullListBase;
+	qglLoadIdentity                 = nullLoadIdentity;
+	qglLoadMatrixd                  = nullLoadMatrixd;
+	qglLoadMatrixf                  = nullLoadMatrixf;
+	qglLoadName                     = nullLoadName;
+	qglLogicOp                      = nullLogicOp;
+	qglMap1d                        = nullMap1d;
+	qglMap1f                        = nullMap1f;
+	qglMap2d                        = nullMap2d;
+	qglMap2f                        = nullMap2f;
+	qglMapGrid1d                    = nullMapGrid1d;
+	qglMapGrid1f                    = nullMapGrid1f;
+	qglMapGrid2d                    = nullMapGrid2d;
+	qglMapGrid2f                    = nullMapGrid2f;
+	qglMaterialf                    = nullMaterialf;
+	qglMaterialfv                   = nullMaterialfv;
+	qglMateriali                    = nullMateriali;
+	qglMaterialiv                   = nullMaterialiv;
+	qglMatrixMode                   = nullMatrixMode;
+	qglMultMatrixd                  = nullMultMatrixd;
+	qglMultMatrixf                  = nullMultMatrixf;
+	qglNewList                      = nullNewList;
+	qglNormal3b                     = nullNormal3b;
+	qglNormal3bv                    = nullNormal3bv;
+	qglNormal3d                     = nullNormal3d;
+	qglNormal3dv                    = nullNormal3dv;
+	qglNormal3f                     = nullNormal3f;
+	qglNormal3fv                    = nullNormal3fv;
+	qglNormal3i                     = nullNormal3i;
+	qglNormal3iv                    = nullNormal3iv;
+	qglNormal3s                     = nullNormal3s;
+	qglNormal3sv                    = nullNormal3sv;
+	qglNormalPointer                = nullNormalPointer;
+	qglOrtho                        = nullOrtho;
+	qglPassThrough                  = nullPassThrough;
+	qglPixelMapfv                   = nullPixelMapfv;
+	qglPixelMapuiv                  = nullPixelMapuiv;
+	qglPixelMapusv                  = nullPixelMapusv;
+	qglPixelStoref                  = nullPixelStoref;
+	qglPixelStorei                  = nullPixelStorei;
+	qglPixelTransferf               = nullPixelTransferf;
+	qglPixelTransferi               = nullPixelTransferi;
+	qglPixelZoom                    = nullPixelZoom;
+	qglPointSize                    = nullPointSize;
+	qglPolygonMode                  = nullPolygonMode;
+	qglPolygonOffset                = nullPolygonOffset;
+	qglPolygonStipple               = nullPolygonStipple;
+	qglPopAttrib                    = nullPopAttrib;
+	qglPopClientAttrib              = nullPopClientAttrib;
+	qglPopMatrix                    = nullPopMatrix;
+	qglPopName                      = nullPopName;
+	qglPrioritizeTextures           = nullPrioritizeTextures;
+	qglPushAttrib                   = nullPushAttrib;
+	qglPushClientAttrib             = nullPushClientAttrib;
+	qglPushMatrix                   = nullPushMatrix;
+	qglPushName                     = nullPushName;
+	qglRasterPos2d                  = nullRasterPos2d;
+	qglRasterPos2dv                 = nullRasterPos2dv;
+	qglRasterPos2f                  = nullRasterPos2f;
+	qglRasterPos2fv                 = nullRasterPos2fv;
+	qglRasterPos2i                  = nullRasterPos2i;
+	qglRasterPos2iv                 = nullRasterPos2iv;
+	qglRasterPos2s                  = nullRasterPos2s;
+	qglRasterPos2sv                 = nullRasterPos2sv;
+	qglRasterPos3d                  = nullRasterPos3d;
+	qglRasterPos3dv                 = nullRasterPos3dv;
+	qglRasterPos3f                  = nullRasterPos3f;
+	qglRasterPos3fv                 = nullRasterPos3fv;
+	qglRasterPos3i                  = nullRasterPos3i;
+	qglRasterPos3iv                 = nullRasterPos3iv;
+	qglRasterPos3s                  = nullRasterPos3s;
+	qglRasterPos3sv                 = nullRasterPos3sv;
+	qglRasterPos4d                  = nullRasterPos4d;
+	qglRasterPos4dv                 = nullRasterPos4dv;
+	qglRasterPos4f                  = nullRasterPos4f;
+	qglRasterPos4fv                 = nullRasterPos4fv;
+	qglRasterPos4i                  = nullRasterPos4i;
+	qglRasterPos4iv                 = nullRasterPos4iv;
+	qglRasterPos4s                  = nullRasterPos4s;
+	qglRasterPos4sv                 = nullRasterPos4sv;
+	qglReadBuffer                   = nullReadBuffer;
+	qglReadPixels                   = nullReadPixels;
+	qglRectd                        = nullRectd;
+	qglRectdv                       = nullRectdv;
+	qglRectf                        = nullRectf;
+	qglRectfv                       = nullRectfv;
+	qglRecti                        = nullRecti;
+	qglRectiv                       = nullRectiv;
+	qglRects                        = nullRects;
+	qglRectsv                       = nullRectsv;
+	qglRenderMode                   = nullRenderMode;
+	qglRotated                      = nullRotated;
+	qglRotatef                      = nullRotatef;
+	qglScaled                       = nullScaled;
+	qglScalef                       = nullScalef;
+	qglScissor                      = nullScissor;
+	qglSelectBuffer                 = nullSelectBuffer;
+	qglShadeModel                   = nullShadeModel;
+	qglStencilFunc                  = nullStencilFunc;
+	qglStencilMask                  = nullStencilMask;
+	qglStencilOp                    = nullStencilOp;
+	qglTexCoord1d                   = nullTexCoord1d;
+	qglTexCoord1dv                  = nullTexCoord1dv;
+	qglTexCoord1f                   = nullTexCoord1f;
+	qglTexCoord1fv                  = nullTexCoord1fv;
+	qglTexCoord1i                   = nullTexCoord1i;
+	qglTexCoord1iv                  = nullTexCoord1iv;
+	qglTexCoord1s                   = nullTexCoord1s;
+	qglTexCoord1sv                  = nullTexCoord1sv;
+	qglTexCoord2d                   = nullTexCoord2d;
+	qglTexCoord2dv                  = nullTexCoord2dv;
+	qglTexCoord2f                   = nullTexCoord2f;
+	qglTexCoord2fv                  = nullTexCoord2fv;
+	qglTexCoord2i                   = nullTexCoord2i;
+	qglTexCoord2iv                  = nullTexCoord2iv;
+	qglTexCoord2s                   = nullTexCoord2s;
+	qglTexCoord2sv                  = nullTexCoord2sv;
+	qglTexCoord3d                   = nullTexCoord3d;
+	qglTexCoord3dv                  = nullTexCoord3dv;
+	qglTexCoord3f                   = nullTexCoord3f;
+	qglTexCoord3fv                  = nullTexCoord3fv;
+	qglTexCoord3i                   = nullTexCoord3i;
+	qglTexCoord3iv                  = nullTexCoord3iv;
+	qglTexCoord3s                   = nullTexCoord3s;
+	qglTexCoord3sv                  = nullTexCoord3sv;
+	qglTexCoord4d                   = nullTexCoord4d;
+	qglTexCoord4dv                  = nullTexCoord4dv;
+	qglTexCoord4f                   = nullTexCoord4f;
+	qglTexCoord4fv                  = nullTexCoord4fv;
+	qglTexCoord4i                   = nullTexCoord4i;
+	qglTexCoord4iv                  = nullTexCoord4iv;
+	qglTexCoord4s                   = nullTexCoord4s;
+	qglTexCoord4sv                  = nullTexCoord4sv;
+	qglTexCoordPointer              = nullTexCoordPointer;
+	qglTexEnvf                      = nullTexEnvf;
+	qglTexEnvfv                     = nullTexEnvfv;
+	qglTexEnvi                      = nullTexEnvi;
+	qglTexEnviv                     = nullTexEnviv;
+	qglTexGend                      = nullTexGend;
+	qglTexGendv                     = nullTexGendv;
+	qglTexGenf                      = nullTexGenf;
+	qglTexGenfv                     = nullTexGenfv;
+	qglTexGeni                      = nullTexGeni;
+	qglTexGeniv                     = nullTexGeniv;
+	qglTexImage1D                   = nullTexImage1D;
+	qglTexImage2D                   = nullTexImage2D;
+	qglTexParameterf                = nullTexParameterf;
+	qglTexParameterfv               = nullTexParameterfv;
+	qglTexParameteri                = nullTexParameteri;
+	qglTexParameteriv               = nullTexParameteriv;
+	qglTexSubImage1D                = nullTexSubImage1D;
+	qglTexSubImage2D                = nullTexSubImage2D;
+	qglTranslated                   = nullTranslated;
+	qglTranslatef                   = nullTranslatef;
+	qglVertex2d                     = nullVertex2d;
+	qglVertex2dv                    = nullVertex2dv;
+	qglVertex2f                     = nullVertex2f;
+	qglVertex2fv                    = nullVertex2fv;
+	qglVertex2i                     = nullVertex2i;
+	qglVertex2iv                    = nullVertex2iv;
+	qglVertex2s                     = nullVertex2s;
+	qglVertex2sv                    = nullVertex2sv;
+	qglVertex3d                     = nullVertex3d;
+	qglVertex3dv                    = nullVertex3dv;
+	qglVertex3f                     = nullVertex3f;
+	qglVertex3fv                    = nullVertex3fv;
+	qglVertex3i                     = nullVertex3i;
+	qglVertex3iv                    = nullVertex3iv;
+	qglVertex3s                     = nullVertex3s;
+	qglVertex3sv                    = nullVertex3sv;
+	qglVertex4d                     = nullVertex4d;
+	qglVertex4dv                    = nullVertex4dv;
+	qglVertex4f                     = nullVertex4f;
+	qglVertex4fv                    = nullVertex4fv;
+	qglVertex4i                     = nullVertex4i;
+	qglVertex4iv                    = nullVertex4iv;
+	qglVertex4s                     = nullVertex4s;
+	qglVertex4sv                    = nullVertex4sv;
+	qglVertexPointer                = nullVertexPointer;
+	qglViewport                     = nullViewport;
+
+	qglActiveTextureARB             = nullActiveTextureARB;
+	qglClientActiveTextureARB       = nullClientActiveTextureARB;
+
+	qglBindBufferARB                = nullBindBufferARB;
+	qglDeleteBuffersARB             = nullDeleteBuffersARB;
+	qglGenBuffersARB                = nullGenBuffersARB;
+	qglBufferDataARB                = nullBufferDataARB;
+	qglBufferSubDataARB             = nullBufferSubDataARB;
+	qglMapBufferARB                 = nullMapBufferARB;
+	qglUnmapBufferARB               = nullUnmapBufferARB;
+
+	qglBindProgramARB               = nullBindProgramARB;
+	qglDeleteProgramsARB            = nullDeleteProgramsARB;
+	qglGenProgramsARB               = nullGenProgramsARB;
+	qglProgramStringARB             = nullProgramStringARB;
+	qglProgramEnvParameter4fARB     = nullProgramEnvParameter4fARB;
+	qglProgramLocalParameter4fARB   = nullProgramLocalParameter4fARB;
+
+	qglDrawRangeElementsEXT         = nullDrawRangeElementsEXT;
+
+	qglLockArraysEXT                = nullLockArraysEXT;
+	qglUnlockArraysEXT              = nullUnlockArraysEXT;
+
+	qglActiveStencilFaceEXT         = nullActiveStencilFaceEXT;
+
+	qglStencilOpSeparateATI         = nullStencilOpSeparateATI;
+	qglStencilFuncSeparateATI       = nullStencilFuncSeparateATI;
+
+	return true;
+}
+
+/*
+ =================
+ QGL_EnableLogging
+
+ The stubs check the log file themselves, so unlike the real drivers
+ nothing needs to be rebound
+ =================
+*/
+void QGL_EnableLogging (qboolean enable){
+
+	time_t		clock;
+	struct tm	*ltime;
+	char		str[64];
+
+	if (enable){
+		if (qglNull.logFile)
+			return;
+
+		qglNull.logFile = fopen("gl.log", "wt");
+		if (!qglNull.logFile)
+			return;
+
+		time(&clock);
+		ltime = localtime(&clock);
+		strftime(str, sizeof(str), "%a %b %d %H:%M:%S %Y", ltime);
+
+		fprintf(qglNull.logFile, "\n*** Log file opened on %s ***\n\n", str);
+	}
+	else {
+		if (!qglNull.logFile)
+			return;
+
+		time(&clock);
+		ltime = localtime(&clock);
+		strftime(str, sizeof(str), "%a %b %d %H:%M:%S %Y", ltime);
+
+		fprintf(qglNull.logFile, "\n*** Log file closed on %s ***\n\n", str);
+
+		fclose(qglNull.logFile);
+		qglNull.logFile = NULL;
+	}
+}
+
+/*
+ =================
+ QGL_LogPrintf
+ =================
+*/
+void QGL_LogPrintf (const char *fmt, ...){
+
+	va_list	argPtr;
+
+	if (!qglNull.logFile)
+		return;
+
+	va_start(argPtr, fmt);
+	vfprintf(qglNull.logFile, fmt, argPtr);
+	va_end(argPtr);
+}
@@ -43,28 +43,38 @@ typedef struct {
 	unsigned short	numLeafBrushes;
 } cleaf_t;
 
+typedef struct {
+	cplane_t		*plane;
+	cmapsurface_t	*surface;
+} cbrushside_t;
+
 typedef struct {
 	int				contents;
 	int				numSides;
 	int				firstBrushSide;
-	int				checkCount;		// To avoid repeated testings
+	cbrushside_t	*sides;
+	vec3_t			mins;			// Bounds from the axial sides
+	vec3_t			maxs;
 } cbrush_t;
 
 typedef struct {
 	cplane_t		*plane;
-	cmapsurface_t	*surface;
-} cbrushside_t;
+	int				children[2];	// Negative numbers are leafs
+} cnode_t;
 
+// Copy of a node with its plane inlined, so point and box queries touch a
+// single 32 byte block per level
 typedef struct {
-	cplane_t		*plane;
+	vec3_t			normal;
+	float			dist;
+	int				type;
 	int				children[2];	// Negative numbers are leafs
-} cnode_t;
+	int				signbits;		// For the box corners of non-axial planes
+} cpointnode_t;
 
 typedef struct {
 	int				numAreaPortals;
 	int				firstAreaPortal;
-	int				floodNum;		// If two areas have equal floodNums, they are connected
-	int				floodValid;
 } carea_t;
 
 typedef struct {
@@ -72,6 +82,46 @@ typedef struct {
 	int				otherArea;
 } careaportal_t;
 
+typedef struct {
+	vec3_t			mins;
+	vec3_t			maxs;
+	int				axis;			// Split axis for inner nodes
+	int				children[2];
+	int				firstBrush;		// Into cm_bvhBrushes
+	int				numBrushes;		// Zero for inner nodes
+} cbvhnode_t;
+
+struct cmTraceContext_s {
+	// Current trace
+	vec3_t			start, end;
+	vec3_t			mins, maxs;
+	vec3_t			extents;
+	vec3_t			delta, invDelta;
+	trace_t			trace;
+	int				contents;
+	qboolean		isPoint;		// Optimized case
+
+	// Brushes already checked in another leaf during the current trace
+	// are stamped with its check count
+	int				checkCount;
+	int				brushCheckCounts[MAX_MAP_BRUSHES+1];
+
+	// Current box leaf list
+	int				*leafList;
+	int				leafCount;
+	int				leafMaxCount;
+	vec3_t			leafMins, leafMaxs;
+	int				leafTopNode;
+
+	// Box hull set up by CM_ContextHeadNodeForBox
+	cbrush_t		*boxBrush;
+	cplane_t		*boxPlanes;
+
+	cbrush_t		localBoxBrush;
+	cbrushside_t	localBoxSides[6];
+	cplane_t		localBoxPlanes[12];
+};
+
 static int				cm_numPlanes;
 static cplane_t			*cm_planes;
 
@@ -96,6 +146,7 @@ static cbrushside_t		*cm_brushSides;
 
 static int				cm_numNodes;
 static cnode_t			*cm_nodes;
+static cpointnode_t		*cm_pointNodes;		// Map nodes only, not the box hull
 
 static int				cm_numModels;
 static cmodel_t			*cm_models;
@@ -109,9 +160,17 @@ static careaportal_t	*cm_areaPortals;
 static int				cm_numEntityChars;
 static char				*cm_entityString;
 
+static int				cm_numBvhNodes;
+static cbvhnode_t		*cm_bvhNodes;
+
+static int				cm_numBvhBrushes;
+static int				*cm_bvhBrushes;
+
 static cmapsurface_t	cm_nullSurface;
+static cmTraceContext_t	cm_traceContext;		// Used by the non-reentrant functions
 static cmodel_t			cm_nullModel;
 
+static const byte		*cm_mapData;			// Still mapped if CM_LoadMap failed
 static char				cm_map[MAX_QPATH];
 static qboolean			cm_mapLoaded;
 static unsigned			cm_checksum;
@@ -121,9 +180,14 @@ int						cm_pointContents = 0;
 int						cm_traces = 0;
 
 cvar_t					*cm_noAreas;
+cvar_t					*cm_visCache;
+cvar_t					*cm_visCacheMegs;
+cvar_t					*cm_traceBVH;
 
 static void	CM_InitBoxHull (void);
-static void	CM_FloodAreaConnections (qboolean clear);
+static void	CM_InitVisCache (void);
+static void	CM_InitAreaConnections (void);
+static void	CM_InitBrushBVH (void);
 
 
 /*
@@ -334,7 +398,9 @@ static void CM_LoadBrushSides (const byte *data, const lump_t *l){
 
 	dbrushside_t	*in;
 	cbrushside_t	*out;
-	int				i;
+	cbrush_t		*brush;
+	cplane_t		*plane;
+	int				i, j;
 
 	in = (dbrushside_t *)(data + l->fileOfs);
 	if (l->fileLen % sizeof(dbrushside_t))
@@ -353,6 +419,31 @@ static void CM_LoadBrushSides (const byte *data, const lump_t *l){
 		out->plane = cm_planes + LittleShort(in->planeNum);
 		out->surface = cm_surfaces + LittleShort(in->texInfo);
 	}
+
+	// Find the brush bounds from the axial sides. The compiler adds axial
+	// bevels to every brush, but stay safe if any are missing.
+	for (i = 0; i < cm_numBrushes; i++){
+		brush = &cm_brushes[i];
+
+		VectorSet(brush->mins, -99999, -99999, -99999);
+		VectorSet(brush->maxs, 99999, 99999, 99999);
+
+		if (brush->firstBrushSide < 0 || brush->firstBrushSide + brush->numSides > cm_numBrushSides)
+			Com_Error(ERR_DROP, "CM_LoadMap: bad brush sides in '%s'", cm_map);
+
+		brush->sides = cm_brushSides + brush->firstBrushSide;
+
+		for (j = 0; j < brush->numSides; j++){
+			plane = brush->sides[j].plane;
+			if (plane->type >= 3)
+				continue;
+
+			if (plane->normal[plane->type] > 0)
+				brush->maxs[plane->type] = plane->dist;
+			else
+				brush->mins[plane->type] = -plane->dist;
+		}
+	}
 }
 
 /*
@@ -385,6 +476,19 @@ static void CM_LoadNodes (const byte *data, const lump_t *l){
 		out->children[0] = LittleLong(in->children[0]);
 		out->children[1] = LittleLong(in->children[1]);
 	}
+
+	// Flatten the nodes for point queries
+	cm_pointNodes = Hunk_Alloc(cm_numNodes * sizeof(cpointnode_t));
+
+	for (i = 0; i < cm_numNodes; i++){
+		VectorCopy(cm_nodes[i].plane->normal, cm_pointNodes[i].normal);
+		cm_pointNodes[i].dist = cm_nodes[i].plane->dist;
+		cm_pointNodes[i].type = cm_nodes[i].plane->type;
+
+		cm_pointNodes[i].children[0] = cm_nodes[i].children[0];
+		cm_pointNodes[i].children[1] = cm_nodes[i].children[1];
+		cm_pointNodes[i].signbits = cm_nodes[i].plane->signbits;
+	}
 }
 
 /*
@@ -449,8 +553,6 @@ static void CM_LoadAreas (const byte *data, const lump_t *l){
 	for (i = 0; i < cm_numAreas; i++, in++, out++){
 		out->numAreaPortals = LittleLong(in->numAreaPortals);
 		out->firstAreaPortal = LittleLong(in->firstAreaPortal);
-		out->floodValid = 0;
-		out->floodNum = 0;
 	}
 }
 
@@ -510,10 +612,13 @@ static void CM_LoadEntityString (const byte *data, const lump_t *l){
 cmodel_t *CM_LoadMap (const char *map, qboolean clientLoad, unsigned *checksum){
 
 	int			i, length;
-	byte		*data;
-	dheader_t	*header;
+	const byte	*data;
+	dheader_t	header;
 
 	cm_noAreas = Cvar_Get("cm_noAreas", "0", CVAR_CHEAT);
+	cm_visCache = Cvar_Get("cm_visCache", "1", CVAR_ARCHIVE);
+	cm_visCacheMegs = Cvar_Get("cm_visCacheMegs", "16", CVAR_ARCHIVE);
+	cm_traceBVH = Cvar_Get("cm_traceBVH", "1", CVAR_ARCHIVE);
 
 	// Cinematic servers won't have anything at all
 	if (!map){
@@ -535,46 +640,56 @@ cmodel_t *CM_LoadMap (const char *map, qboolean clientLoad, unsigned *checksum){
 	CM_UnloadMap();
 
 	// Load the file
-	length = FS_LoadFile(map, (void **)&data);
+	length = FS_MapFile(map, (const void **)&data);
 	if (!data)
 		Com_Error(ERR_DROP, "CM_LoadMap: '%s' not found", map);
 
+	// Any error below leaves the file mapped until CM_UnloadMap
+	cm_mapData = data;
+
 	// Fill it in
 	Q_strncpyz(cm_map, map, sizeof(cm_map));
 	cm_mapLoaded = true;
 	cm_checksum = LittleLong(Com_BlockChecksum(data, length));
 
-	header = (dheader_t *)data;
+	if (length < sizeof(dheader_t))
+		Com_Error(ERR_DROP, "CM_LoadMap: '%s' is too short", cm_map);
+
+	// The file data may be mapped read-only, so swap a copy of the header
+	memcpy(&header, data, sizeof(dheader_t));
 
 	// Byte swap the header fields and sanity check
 	for (i = 0; i < sizeof(dheader_t) / 4; i++)
-		((int *)header)[i] = LittleLong(((int *)header)[i]);
+		((int *)&header)[i] = LittleLong(((int *)&header)[i]);
 
-	if (header->ident != BSP_IDENT)
+	if (header.ident != BSP_IDENT)
 		Com_Error(ERR_DROP, "CM_LoadMap: '%s' has wrong file id", cm_map);
 
-	if (header->version != BSP_VERSION)
-		Com_Error(ERR_DROP, "CM_LoadMap: '%s' has wrong version number (%i should be %i)", cm_map, header->version, BSP_VERSION);
+	if (header.version != BSP_VERSION)
+		Com_Error(ERR_DROP, "CM_LoadMap: '%s' has wrong version number (%i should be %i)", cm_map, header.version, BSP_VERSION);
 
 	// Load into heap
-	CM_LoadPlanes(data, &header->lumps[LUMP_PLANES]);
-	CM_LoadSurfaces(data, &header->lumps[LUMP_TEXINFO]);
-	CM_LoadVisibility(data, &header->lumps[LUMP_VISIBILITY]);
-	CM_LoadLeafs(data, &header->lumps[LUMP_LEAFS]);
-	CM_LoadLeafBrushes(data, &header->lumps[LUMP_LEAFBRUSHES]);
-	CM_LoadBrushes(data, &header->lumps[LUMP_BRUSHES]);
-	CM_LoadBrushSides(data, &header->lumps[LUMP_BRUSHSIDES]);
-	CM_LoadNodes(data, &header->lumps[LUMP_NODES]);
-	CM_LoadSubmodels(data, &header->lumps[LUMP_MODELS]);
-	CM_LoadAreas(data, &header->lumps[LUMP_AREAS]);
-	CM_LoadAreaPortals(data, &header->lumps[LUMP_AREAPORTALS]);
-	CM_LoadEntityString(data, &header->lumps[LUMP_ENTITIES]);
-
-	FS_FreeFile(data);
+	CM_LoadPlanes(data, &header.lumps[LUMP_PLANES]);
+	CM_LoadSurfaces(data, &header.lumps[LUMP_TEXINFO]);
+	CM_LoadVisibility(data, &header.lumps[LUMP_VISIBILITY]);
+	CM_LoadLeafs(data, &header.lumps[LUMP_LEAFS]);
+	CM_LoadLeafBrushes(data, &header.lumps[LUMP_LEAFBRUSHES]);
+	CM_LoadBrushes(data, &header.lumps[LUMP_BRUSHES]);
+	CM_LoadBrushSides(data, &header.lumps[LUMP_BRUSHSIDES]);
+	CM_LoadNodes(data, &header.lumps[LUMP_NODES]);
+	CM_LoadSubmodels(data, &header.lumps[LUMP_MODELS]);
+	CM_LoadAreas(data, &header.lumps[LUMP_AREAS]);
+	CM_LoadAreaPortals(data, &header.lumps[LUMP_AREAPORTALS]);
+	CM_LoadEntityString(data, &header.lumps[LUMP_ENTITIES]);
+
+	FS_UnmapFile(data);
+	cm_mapData = NULL;
 
 	// Set up some needed things
 	CM_InitBoxHull();
-	CM_FloodAreaConnections(true);
+	CM_InitVisCache();
+	CM_InitAreaConnections();
+	CM_InitBrushBVH();
 
 	Hunk_SetLowMark();
 
@@ -591,6 +706,11 @@ cmodel_t *CM_LoadMap (const char *map, qboolean clientLoad, unsigned *checksum){
 */
 void CM_UnloadMap (void){
 
+	if (cm_mapData){
+		FS_UnmapFile(cm_mapData);
+		cm_mapData = NULL;
+	}
+
 	cm_numPlanes = 0;
 	cm_numSurfaces = 0;
 	cm_numVisibility = 0;
@@ -604,6 +724,8 @@ void CM_UnloadMap (void){
 	cm_numAreas = 1;
 	cm_numAreaPortals = 0;
 	cm_numEntityChars = 0;
+	cm_numBvhNodes = 0;
+	cm_numBvhBrushes = 0;
 
 	cm_map[0] = 0;
 	cm_mapLoaded = false;
@@ -717,6 +839,43 @@ static cbrush_t	*cm_boxBrush;
 static cleaf_t	*cm_boxLeaf;
 
 
+/*
+ =================
+ CM_SetupBoxBrush
+
+ Sets up the sides and planes of a box brush. The distances are filled
+ in by CM_ContextHeadNodeForBox.
+ =================
+*/
+static void CM_SetupBoxBrush (cbrush_t *brush, cbrushside_t *sides, cplane_t *planes){
+
+	int				i;
+	cplane_t		*p;
+
+	brush->numSides = 6;
+	brush->sides = sides;
+	brush->contents = CONTENTS_MONSTER;
+
+	for (i = 0; i < 6; i++){
+		// Brush sides
+		sides[i].plane = &planes[i*2+(i&1)];
+		sides[i].surface = &cm_nullSurface;
+
+		// Planes
+		p = &planes[i*2+0];
+		VectorClear(p->normal);
+		p->normal[i>>1] = 1;
+		p->type = i>>1;
+		p->signbits = 0;
+
+		p = &planes[i*2+1];
+		VectorClear(p->normal);
+		p->normal[i>>1] = -1;
+		p->type = 3;
+		p->signbits = 0;
+	}
+}
+
 /*
  =================
  CM_InitBoxHull
@@ -730,16 +889,14 @@ static void CM_InitBoxHull (void){
 	int				i;
 	int				side;
 	cnode_t			*n;
-	cplane_t		*p;
-	cbrushside_t	*s;
 
 	cm_boxPlanes = &cm_planes[cm_numPlanes];
 	cm_boxHeadNode = cm_numNodes;
 
 	cm_boxBrush = &cm_brushes[cm_numBrushes];
-	cm_boxBrush->numSides = 6;
 	cm_boxBrush->firstBrushSide = cm_numBrushSides;
-	cm_boxBrush->contents = CONTENTS_MONSTER;
+
+	CM_SetupBoxBrush(cm_boxBrush, &cm_brushSides[cm_numBrushSides], cm_boxPlanes);
 
 	cm_boxLeaf = &cm_leafs[cm_numLeafs];
 	cm_boxLeaf->numLeafBrushes = 1;
@@ -751,11 +908,6 @@ static void CM_InitBoxHull (void){
 	for (i = 0; i < 6; i++){
 		side = i & 1;
 
-		// Brush sides
-		s = &cm_brushSides[cm_numBrushSides+i];
-		s->plane = &cm_planes[cm_numPlanes+i*2+side];
-		s->surface = &cm_nullSurface;
-
 		// Nodes
 		n = &cm_nodes[cm_numNodes+i];
 		n->plane = &cm_planes[cm_numPlanes+i*2];
@@ -764,56 +916,94 @@ static void CM_InitBoxHull (void){
 			n->children[side^1] = cm_boxHeadNode+i + 1;
 		else
 			n->children[side^1] = -1 - cm_numLeafs;
+	}
 
-		// Planes
-		p = &cm_boxPlanes[i*2+0];
-		VectorClear(p->normal);
-		p->normal[i>>1] = 1;
-		p->type = i>>1;
-		p->signbits = 0;
-
-		p = &cm_boxPlanes[i*2+1];
-		VectorClear(p->normal);
-		p->normal[i>>1] = -1;
-		p->type = 3;
-		p->signbits = 0;
-	}	
+	// The default context uses the shared box hull, whose planes are the
+	// ones the nodes above point at
+	cm_traceContext.boxBrush = cm_boxBrush;
+	cm_traceContext.boxPlanes = cm_boxPlanes;
 }
 
 /*
  =================
- CM_HeadNodeForBox
+ CM_ContextHeadNodeForBox
  
  To keep everything totally uniform, bounding boxes are turned into 
- small BSP trees instead of being compared directly
+ small BSP trees instead of being compared directly.
+ Every context has a box of its own.
+ =================
+*/
+int	CM_ContextHeadNodeForBox (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs){
+
+	cplane_t	*planes = ctx->boxPlanes;
+
+	planes[0].dist = maxs[0];
+	planes[1].dist = -maxs[0];
+	planes[2].dist = mins[0];
+	planes[3].dist = -mins[0];
+	planes[4].dist = maxs[1];
+	planes[5].dist = -maxs[1];
+	planes[6].dist = mins[1];
+	planes[7].dist = -mins[1];
+	planes[8].dist = maxs[2];
+	planes[9].dist = -maxs[2];
+	planes[10].dist = mins[2];
+	planes[11].dist = -mins[2];
+
+	VectorCopy(mins, ctx->boxBrush->mins);
+	VectorCopy(maxs, ctx->boxBrush->maxs);
+
+	return cm_boxHeadNode;
+}
+
+/*
+ =================
+ CM_HeadNodeForBox
  =================
 */
 int	CM_HeadNodeForBox (const vec3_t mins, const vec3_t maxs){
 
-	cm_boxPlanes[0].dist = maxs[0];
-	cm_boxPlanes[1].dist = -maxs[0];
-	cm_boxPlanes[2].dist = mins[0];
-	cm_boxPlanes[3].dist = -mins[0];
-	cm_boxPlanes[4].dist = maxs[1];
-	cm_boxPlanes[5].dist = -maxs[1];
-	cm_boxPlanes[6].dist = mins[1];
-	cm_boxPlanes[7].dist = -mins[1];
-	cm_boxPlanes[8].dist = maxs[2];
-	cm_boxPlanes[9].dist = -maxs[2];
-	cm_boxPlanes[10].dist = mins[2];
-	cm_boxPlanes[11].dist = -mins[2];
+	return CM_ContextHeadNodeForBox(&cm_traceContext, mins, maxs);
+}
+
+/*
+ =================
+ CM_AllocTraceContext
 
-	return cm_boxHeadNode;
+ Contexts should be allocated up front by the main thread, since the zone
+ is not thread safe
+ =================
+*/
+cmTraceContext_t *CM_AllocTraceContext (void){
+
+	cmTraceContext_t	*ctx;
+
+	ctx = Z_Malloc(sizeof(cmTraceContext_t));
+	memset(ctx, 0, sizeof(cmTraceContext_t));
+
+	ctx->boxBrush = &ctx->localBoxBrush;
+	ctx->boxPlanes = ctx->localBoxPlanes;
+
+	CM_SetupBoxBrush(ctx->boxBrush, ctx->localBoxSides, ctx->localBoxPlanes);
+
+	return ctx;
 }
 
+/*
+ =================
+ CM_FreeTraceContext
+ =================
+*/
+void CM_FreeTraceContext (cmTraceContext_t *ctx){
+
+	if (!ctx || ctx == &cm_traceContext)
+		return;
 
-// =====================================================================
+	Z_Free(ctx);
+}
 
-static int		cm_leafCount, cm_leafMaxCount;
-static int		*cm_leafList;
-static vec3_t	cm_leafMins, cm_leafMaxs;
-static int		cm_leafTopNode;
 
+// =====================================================================
 
 /*
  =================
@@ -822,7 +1012,7 @@ static int		cm_leafTopNode;
  Fills in a list of all the leafs touched
  =================
 */
-static void CM_RecursiveBoxLeafNums (int nodeNum){
+static void CM_RecursiveBoxLeafNums (cmTraceContext_t *ctx, int nodeNum){
 
 	cnode_t		*node;
 	cplane_t	*plane;
@@ -830,17 +1020,17 @@ static void CM_RecursiveBoxLeafNums (int nodeNum){
 
 	while (1){
 		if (nodeNum < 0){
-			if (cm_leafCount >= cm_leafMaxCount)
+			if (ctx->leafCount >= ctx->leafMaxCount)
 				return;
 			
-			cm_leafList[cm_leafCount++] = -1 - nodeNum;
+			ctx->leafList[ctx->leafCount++] = -1 - nodeNum;
 			return;
 		}
 	
 		node = &cm_nodes[nodeNum];
 		plane = node->plane;
 
-		s = BoxOnPlaneSide(cm_leafMins, cm_leafMaxs, plane);
+		s = BoxOnPlaneSide(ctx->leafMins, ctx->leafMaxs, plane);
 
 		if (s == 1)
 			nodeNum = node->children[0];
@@ -848,35 +1038,124 @@ static void CM_RecursiveBoxLeafNums (int nodeNum){
 			nodeNum = node->children[1];
 		else {
 			// Go down both
-			if (cm_leafTopNode == -1)
-				cm_leafTopNode = nodeNum;
+			if (ctx->leafTopNode == -1)
+				ctx->leafTopNode = nodeNum;
 		
-			CM_RecursiveBoxLeafNums(node->children[0]);
+			CM_RecursiveBoxLeafNums(ctx, node->children[0]);
 			nodeNum = node->children[1];
 		}
 	}
 }
 
+#define MAX_BOX_LEAF_STACK		128		// Deeper trees finish recursively
+
 /*
  =================
- CM_BoxLeafNumsHeadNode
+ CM_FlatBoxLeafNums
+
+ Same as CM_RecursiveBoxLeafNums, but walks the flattened map nodes with
+ an explicit stack. The leafs come out in the same order.
  =================
 */
-static int CM_BoxLeafNumsHeadNode (const vec3_t mins, const vec3_t maxs, int *list, int listSize, int headNode, int *topNode){
+static void CM_FlatBoxLeafNums (cmTraceContext_t *ctx, int nodeNum){
+
+	const cpointnode_t	*node;
+	const float			*mins = ctx->leafMins, *maxs = ctx->leafMaxs;
+	float				dist1, dist2;
+	int					stack[MAX_BOX_LEAF_STACK];
+	int					depth = 0;
+	int					s;
+
+	while (1){
+		if (nodeNum < 0){
+			if (ctx->leafCount < ctx->leafMaxCount)
+				ctx->leafList[ctx->leafCount++] = -1 - nodeNum;
+			else if (ctx->leafTopNode != -1)
+				return;		// Nothing left to find
+
+			if (!depth)
+				return;
+
+			nodeNum = stack[--depth];
+			continue;
+		}
+
+		node = &cm_pointNodes[nodeNum];
+
+		// Same as BoxOnPlaneSide
+		if (node->type < 3){
+			if (node->dist <= mins[node->type])
+				s = 1;
+			else if (node->dist >= maxs[node->type])
+				s = 2;
+			else
+				s = 3;
+		}
+		else {
+			dist1 = node->normal[0] * ((node->signbits & 1) ? mins[0] : maxs[0]) + node->normal[1] * ((node->signbits & 2) ? mins[1] : maxs[1]) + node->normal[2] * ((node->signbits & 4) ? mins[2] : maxs[2]);
+			dist2 = node->normal[0] * ((node->signbits & 1) ? maxs[0] : mins[0]) + node->normal[1] * ((node->signbits & 2) ? maxs[1] : mins[1]) + node->normal[2] * ((node->signbits & 4) ? maxs[2] : mins[2]);
+
+			s = 0;
+			if (dist1 >= node->dist)
+				s |= 1;
+			if (dist2 < node->dist)
+				s |= 2;
+		}
+
+		if (s == 1)
+			nodeNum = node->children[0];
+		else if (s == 2)
+			nodeNum = node->children[1];
+		else {
+			// Go down both
+			if (ctx->leafTopNode == -1)
+				ctx->leafTopNode = nodeNum;
+
+			if (depth == MAX_BOX_LEAF_STACK)
+				CM_RecursiveBoxLeafNums(ctx, node->children[1]);
+			else
+				stack[depth++] = node->children[1];
 
-	cm_leafList = list;
-	cm_leafCount = 0;
-	cm_leafMaxCount = listSize;
-	VectorCopy(mins, cm_leafMins);
-	VectorCopy(maxs, cm_leafMaxs);
-	cm_leafTopNode = -1;
+			nodeNum = node->children[0];
+		}
+	}
+}
 
-	CM_RecursiveBoxLeafNums(headNode);
+/*
+ =================
+ CM_BoxLeafNumsHeadNode
+ =================
+*/
+static int CM_BoxLeafNumsHeadNode (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs, int *list, int listSize, int headNode, int *topNode){
+
+	ctx->leafList = list;
+	ctx->leafCount = 0;
+	ctx->leafMaxCount = listSize;
+	VectorCopy(mins, ctx->leafMins);
+	VectorCopy(maxs, ctx->leafMaxs);
+	ctx->leafTopNode = -1;
+
+	// The box hull planes change all the time, so only the map nodes have
+	// been flattened
+	if (headNode < cm_numNodes)
+		CM_FlatBoxLeafNums(ctx, headNode);
+	else
+		CM_RecursiveBoxLeafNums(ctx, headNode);
 
 	if (topNode)
-		*topNode = cm_leafTopNode;
+		*topNode = ctx->leafTopNode;
+
+	return ctx->leafCount;
+}
+
+/*
+ =================
+ CM_ContextBoxLeafNums
+ =================
+*/
+int	CM_ContextBoxLeafNums (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs, int *list, int listSize, int *topNode){
 
-	return cm_leafCount;
+	return CM_BoxLeafNumsHeadNode(ctx, mins, maxs, list, listSize, cm_models[0].headNode, topNode);
 }
 
 /*
@@ -886,7 +1165,7 @@ static int CM_BoxLeafNumsHeadNode (const vec3_t mins, const vec3_t maxs, int *li
 */
 int	CM_BoxLeafNums (const vec3_t mins, const vec3_t maxs, int *list, int listSize, int *topNode){
 
-	return CM_BoxLeafNumsHeadNode(mins, maxs, list, listSize, cm_models[0].headNode, topNode);
+	return CM_BoxLeafNumsHeadNode(&cm_traceContext, mins, maxs, list, listSize, cm_models[0].headNode, topNode);
 }
 
 /*
@@ -896,12 +1175,30 @@ int	CM_BoxLeafNums (const vec3_t mins, const vec3_t maxs, int *list, int listSiz
 */
 static int CM_RecursivePointLeafNum (const vec3_t p, int nodeNum){
 
-	float		d;
-	cnode_t		*node;
-	cplane_t	*plane;
+	float			d;
+	cnode_t			*node;
+	cplane_t		*plane;
+	cpointnode_t	*pointNode;
 
 	cm_pointContents++;		// Optimize counter
 
+	// The box hull planes change all the time, so only the map nodes have
+	// been flattened
+	if (nodeNum < cm_numNodes){
+		while (nodeNum >= 0){
+			pointNode = &cm_pointNodes[nodeNum];
+
+			if (pointNode->type < 3)
+				d = p[pointNode->type] - pointNode->dist;
+			else
+				d = DotProduct(p, pointNode->normal) - pointNode->dist;
+
+			nodeNum = pointNode->children[d < 0];
+		}
+
+		return -1 - nodeNum;
+	}
+
 	while (nodeNum >= 0){
 		node = &cm_nodes[nodeNum];
 		plane = node->plane;
@@ -935,16 +1232,100 @@ int CM_PointLeafNum (const vec3_t p){
 
 /*
  =================
- CM_PointContents
+ CM_PointLeafNums
+
+ Finds the leafs of a batch of points. The points are walked down the
+ tree together a few at a time, so the node loads of one point overlap
+ with the work of the others.
  =================
 */
-int CM_PointContents (const vec3_t p, int headNode){
+void CM_PointLeafNums (const vec3_t *points, int numPoints, int *leafNums){
+
+	int				nodeNums[8];
+	int				i, j, count, active;
+	float			d;
+	cpointnode_t	*pointNode;
+
+	if (!cm_mapLoaded){
+		for (i = 0; i < numPoints; i++)
+			leafNums[i] = 0;		// Map not loaded
+
+		return;
+	}
+
+	cm_pointContents += numPoints;	// Optimize counter
+
+	for (i = 0; i < numPoints; i += 8){
+		count = numPoints - i;
+		if (count > 8)
+			count = 8;
+
+		for (j = 0; j < count; j++)
+			nodeNums[j] = 0;
+
+		do {
+			active = 0;
+
+			for (j = 0; j < count; j++){
+				if (nodeNums[j] < 0)
+					continue;
+
+				pointNode = &cm_pointNodes[nodeNums[j]];
+
+				if (pointNode->type < 3)
+					d = points[i+j][pointNode->type] - pointNode->dist;
+				else
+					d = DotProduct(points[i+j], pointNode->normal) - pointNode->dist;
+
+				nodeNums[j] = pointNode->children[d < 0];
+				active++;
+			}
+		} while (active);
+
+		for (j = 0; j < count; j++)
+			leafNums[i+j] = -1 - nodeNums[j];
+	}
+}
+
+/*
+ =================
+ CM_BoxPointContents
+
+ The box hull nodes share their planes with the default context, so
+ points are tested against the box of the given context directly
+ =================
+*/
+static int CM_BoxPointContents (cmTraceContext_t *ctx, const vec3_t p){
+
+	const float	*mins = ctx->boxBrush->mins, *maxs = ctx->boxBrush->maxs;
+
+	cm_pointContents++;		// Optimize counter
+
+	if (p[0] < mins[0] || p[0] >= maxs[0])
+		return 0;
+	if (p[1] < mins[1] || p[1] >= maxs[1])
+		return 0;
+	if (p[2] < mins[2] || p[2] >= maxs[2])
+		return 0;
+
+	return ctx->boxBrush->contents;
+}
+
+/*
+ =================
+ CM_ContextPointContents
+ =================
+*/
+int CM_ContextPointContents (cmTraceContext_t *ctx, const vec3_t p, int headNode){
 
 	int		l;
 
 	if (!cm_mapLoaded)
 		return 0;		// Map not loaded
 
+	if (headNode == cm_boxHeadNode)
+		return CM_BoxPointContents(ctx, p);
+
 	l = CM_RecursivePointLeafNum(p, headNode);
 
 	return cm_leafs[l].contents;
@@ -952,17 +1333,26 @@ int CM_PointContents (const vec3_t p, int headNode){
 
 /*
  =================
- CM_TransformedPointContents
+ CM_PointContents
+ =================
+*/
+int CM_PointContents (const vec3_t p, int headNode){
+
+	return CM_ContextPointContents(&cm_traceContext, p, headNode);
+}
+
+/*
+ =================
+ CM_ContextTransformedPointContents
 
  Handles offseting and rotation of the point for moving and rotating
  entities
  =================
 */
-int	CM_TransformedPointContents (const vec3_t p, int headNode, const vec3_t origin, const vec3_t angles){
+int	CM_ContextTransformedPointContents (cmTraceContext_t *ctx, const vec3_t p, int headNode, const vec3_t origin, const vec3_t angles){
 
 	vec3_t	p2, temp;
 	vec3_t	axis[3];
-	int		l;
 
 	if (!cm_mapLoaded)
 		return 0;		// Map not loaded
@@ -976,65 +1366,336 @@ int	CM_TransformedPointContents (const vec3_t p, int headNode, const vec3_t orig
 	else
 		VectorSubtract(p, origin, p2);
 
-	l = CM_RecursivePointLeafNum(p2, headNode);
+	return CM_ContextPointContents(ctx, p2, headNode);
+}
 
-	return cm_leafs[l].contents;
+/*
+ =================
+ CM_TransformedPointContents
+ =================
+*/
+int	CM_TransformedPointContents (const vec3_t p, int headNode, const vec3_t origin, const vec3_t angles){
+
+	return CM_ContextTransformedPointContents(&cm_traceContext, p, headNode, origin, angles);
 }
 
 
 /*
  =======================================================================
 
- BOX TRACING
+ BRUSH BVH
 
+ Bounding volume hierarchy over the brushes of the world model, so
+ traces can find the brushes near them without walking the BSP tree
+ and testing every brush of every leaf they touch
  =======================================================================
 */
 
-// 1/32 epsilon to keep floating point happy
-#define	DIST_EPSILON	(0.03125)
-
-static vec3_t	cm_traceStart, cm_traceEnd;
-static vec3_t	cm_traceMins, cm_traceMaxs;
-static vec3_t	cm_traceExtents;
+#define BVH_LEAF_BRUSHES		4
+#define MAX_BVH_DEPTH			64
 
-static trace_t	cm_trace;
-static int		cm_traceContents;
-static qboolean	cm_traceIsPoint;		// Optimized case
+static vec3_t	*cm_bvhCenters;
 
-static int		cm_traceCheckCount;
 
 /*
  =================
- CM_ClipBoxToBrush
+ CM_MarkWorldBrushes
  =================
 */
-static void CM_ClipBoxToBrush (const vec3_t mins, const vec3_t maxs, const vec3_t p1, const vec3_t p2, trace_t *trace, cbrush_t *brush){
+static void CM_MarkWorldBrushes (int nodeNum, byte *marked){
 
-	int				i, j;
-	cbrushside_t	*side, *leadSide;
-	cplane_t		*plane, *clipPlane;
-	vec3_t			ofs;
-	float			dist, d1, d2;
-	float			enterFrac, leaveFrac;
-	float			f;
-	qboolean		getOut, startOut;
+	cleaf_t		*leaf;
+	int			i;
 
-	enterFrac = -1;
-	leaveFrac = 1;
-	clipPlane = NULL;
+	while (nodeNum >= 0){
+		CM_MarkWorldBrushes(cm_nodes[nodeNum].children[0], marked);
+		nodeNum = cm_nodes[nodeNum].children[1];
+	}
 
-	if (!brush->numSides)
-		return;
+	leaf = &cm_leafs[-1 - nodeNum];
 
-	getOut = false;
-	startOut = false;
-	leadSide = NULL;
+	for (i = 0; i < leaf->numLeafBrushes; i++)
+		marked[cm_leafBrushes[leaf->firstLeafBrush+i]] = 1;
+}
 
-	for (i = 0; i < brush->numSides; i++){
-		side = &cm_brushSides[brush->firstBrushSide+i];
-		plane = side->plane;
+/*
+ =================
+ CM_PartitionBVHBrushes
 
-		if (!cm_traceIsPoint){
+ Reorders the brushes so the one with the median center along the given
+ axis is in the middle, with the lower ones before it
+ =================
+*/
+static void CM_PartitionBVHBrushes (int *brushes, int count, int axis){
+
+	int		lo, hi, i, j;
+	int		mid, tmp;
+	float	pivot;
+
+	mid = count >> 1;
+	lo = 0;
+	hi = count - 1;
+
+	while (lo < hi){
+		pivot = cm_bvhCenters[brushes[(lo + hi) >> 1]][axis];
+
+		i = lo;
+		j = hi;
+
+		while (i <= j){
+			while (cm_bvhCenters[brushes[i]][axis] < pivot)
+				i++;
+			while (cm_bvhCenters[brushes[j]][axis] > pivot)
+				j--;
+
+			if (i <= j){
+				tmp = brushes[i];
+				brushes[i] = brushes[j];
+				brushes[j] = tmp;
+
+				i++;
+				j--;
+			}
+		}
+
+		if (mid <= j)
+			hi = j;
+		else if (mid >= i)
+			lo = i;
+		else
+			break;
+	}
+}
+
+/*
+ =================
+ CM_BuildBVHNode
+ =================
+*/
+static int CM_BuildBVHNode (int firstBrush, int numBrushes, int depth){
+
+	cbvhnode_t	*node;
+	cbrush_t	*brush;
+	vec3_t		mins, maxs;
+	int			nodeNum, half;
+	int			i, j;
+
+	nodeNum = cm_numBvhNodes++;
+	node = &cm_bvhNodes[nodeNum];
+
+	ClearBounds(node->mins, node->maxs);
+	ClearBounds(mins, maxs);
+
+	for (i = 0; i < numBrushes; i++){
+		brush = &cm_brushes[cm_bvhBrushes[firstBrush+i]];
+
+		AddPointToBounds(brush->mins, node->mins, node->maxs);
+		AddPointToBounds(brush->maxs, node->mins, node->maxs);
+
+		AddPointToBounds(cm_bvhCenters[cm_bvhBrushes[firstBrush+i]], mins, maxs);
+	}
+
+	if (numBrushes <= BVH_LEAF_BRUSHES || depth >= MAX_BVH_DEPTH - 1){
+		node->axis = 0;
+		node->children[0] = node->children[1] = 0;
+		node->firstBrush = firstBrush;
+		node->numBrushes = numBrushes;
+		return nodeNum;
+	}
+
+	// Split at the median along the axis where the centers spread most
+	node->axis = 0;
+	for (j = 1; j < 3; j++){
+		if (maxs[j] - mins[j] > maxs[node->axis] - mins[node->axis])
+			node->axis = j;
+	}
+
+	CM_PartitionBVHBrushes(cm_bvhBrushes + firstBrush, numBrushes, node->axis);
+
+	half = numBrushes >> 1;
+
+	node->firstBrush = 0;
+	node->numBrushes = 0;
+	node->children[0] = CM_BuildBVHNode(firstBrush, half, depth + 1);
+	node->children[1] = CM_BuildBVHNode(firstBrush + half, numBrushes - half, depth + 1);
+
+	return nodeNum;
+}
+
+/*
+ =================
+ CM_InitBrushBVH
+ =================
+*/
+static void CM_InitBrushBVH (void){
+
+	byte		*marked;
+	cbrush_t	*brush;
+	int			i;
+
+	cm_numBvhNodes = 0;
+	cm_numBvhBrushes = 0;
+
+	if (!cm_traceBVH->integer)
+		return;
+
+	marked = Z_Malloc(cm_numBrushes);
+	memset(marked, 0, cm_numBrushes);
+
+	CM_MarkWorldBrushes(cm_models[0].headNode, marked);
+
+	for (i = 0; i < cm_numBrushes; i++){
+		if (marked[i])
+			cm_numBvhBrushes++;
+	}
+
+	if (!cm_numBvhBrushes){
+		Z_Free(marked);
+		return;
+	}
+
+	cm_bvhBrushes = Hunk_Alloc(cm_numBvhBrushes * sizeof(int));
+	cm_bvhNodes = Hunk_Alloc(cm_numBvhBrushes * 2 * sizeof(cbvhnode_t));
+	cm_bvhCenters = Z_Malloc(cm_numBrushes * sizeof(vec3_t));
+
+	for (i = 0, cm_numBvhBrushes = 0; i < cm_numBrushes; i++){
+		if (!marked[i])
+			continue;
+
+		brush = &cm_brushes[i];
+
+		cm_bvhCenters[i][0] = (brush->mins[0] + brush->maxs[0]) * 0.5;
+		cm_bvhCenters[i][1] = (brush->mins[1] + brush->maxs[1]) * 0.5;
+		cm_bvhCenters[i][2] = (brush->mins[2] + brush->maxs[2]) * 0.5;
+
+		cm_bvhBrushes[cm_numBvhBrushes++] = i;
+	}
+
+	CM_BuildBVHNode(0, cm_numBvhBrushes, 0);
+
+	Z_Free(cm_bvhCenters);
+	Z_Free(marked);
+}
+
+
+/*
+ =======================================================================
+
+ BOX TRACING
+
+ =======================================================================
+*/
+
+// 1/32 epsilon to keep floating point happy
+#define	DIST_EPSILON	(0.03125)
+
+/*
+ =================
+ CM_TraceHitsBounds
+
+ Slab test of the swept trace box against the given bounds, clipped to
+ the current trace fraction. Used to skip brushes and BVH nodes before
+ looking at any planes.
+ =================
+*/
+static qboolean CM_TraceHitsBounds (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs){
+
+	float	enter, leave;
+	float	lo, hi, t1, t2;
+	int		i;
+
+	enter = 0;
+	leave = ctx->trace.fraction;
+
+	for (i = 0; i < 3; i++){
+		// Grow the bounds by the trace box, with a pixel to spare for the
+		// plane epsilons
+		lo = mins[i] - ctx->maxs[i] - 1;
+		hi = maxs[i] - ctx->mins[i] + 1;
+
+		if (ctx->delta[i] == 0){
+			if (ctx->start[i] < lo || ctx->start[i] > hi)
+				return false;
+
+			continue;
+		}
+
+		t1 = (lo - ctx->start[i]) * ctx->invDelta[i];
+		t2 = (hi - ctx->start[i]) * ctx->invDelta[i];
+
+		if (t1 > t2){
+			if (t2 > enter)
+				enter = t2;
+			if (t1 < leave)
+				leave = t1;
+		}
+		else {
+			if (t1 > enter)
+				enter = t1;
+			if (t2 < leave)
+				leave = t2;
+		}
+
+		if (enter > leave)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ =================
+ CM_TestHitsBounds
+
+ Overlap test of the position test box against the given bounds
+ =================
+*/
+static qboolean CM_TestHitsBounds (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs){
+
+	int		i;
+
+	for (i = 0; i < 3; i++){
+		if (ctx->start[i] + ctx->mins[i] - 1 > maxs[i])
+			return false;
+		if (ctx->start[i] + ctx->maxs[i] + 1 < mins[i])
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ =================
+ CM_ClipBoxToBrush
+ =================
+*/
+static void CM_ClipBoxToBrush (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs, const vec3_t p1, const vec3_t p2, trace_t *trace, cbrush_t *brush){
+
+	int				i, j;
+	cbrushside_t	*side, *leadSide;
+	cplane_t		*plane, *clipPlane;
+	vec3_t			ofs;
+	float			dist, d1, d2;
+	float			enterFrac, leaveFrac;
+	float			f;
+	qboolean		getOut, startOut;
+
+	enterFrac = -1;
+	leaveFrac = 1;
+	clipPlane = NULL;
+
+	if (!brush->numSides)
+		return;
+
+	getOut = false;
+	startOut = false;
+	leadSide = NULL;
+
+	for (i = 0; i < brush->numSides; i++){
+		side = &brush->sides[i];
+		plane = side->plane;
+
+		if (!ctx->isPoint){
 			// General box case
 			if (plane->type < 3){
 				// Push the plane out appropriately for mins/maxs
@@ -1142,7 +1803,7 @@ static void CM_TestBoxInBrush (const vec3_t mins, const vec3_t maxs, const vec3_
 		return;
 
 	for (i = 0; i < brush->numSides; i++){
-		side = &cm_brushSides[brush->firstBrushSide+i];
+		side = &brush->sides[i];
 		plane = side->plane;
 
 		// General box case
@@ -1185,7 +1846,7 @@ static void CM_TestBoxInBrush (const vec3_t mins, const vec3_t maxs, const vec3_
  CM_TraceToLeaf
  =================
 */
-static void CM_TraceToLeaf (int leafNum){
+static void CM_TraceToLeaf (cmTraceContext_t *ctx, int leafNum){
 
 	int			i;
 	int			brushNum;
@@ -1193,7 +1854,7 @@ static void CM_TraceToLeaf (int leafNum){
 	cbrush_t	*brush;
 
 	leaf = &cm_leafs[leafNum];
-	if (!(leaf->contents & cm_traceContents))
+	if (!(leaf->contents & ctx->contents))
 		return;
 
 	// Trace line against all brushes in the leaf
@@ -1201,15 +1862,18 @@ static void CM_TraceToLeaf (int leafNum){
 		brushNum = cm_leafBrushes[leaf->firstLeafBrush+i];
 		brush = &cm_brushes[brushNum];
 
-		if (brush->checkCount == cm_traceCheckCount)
+		if (ctx->brushCheckCounts[brushNum] == ctx->checkCount)
 			continue;		// Already checked this brush in another leaf
-		brush->checkCount = cm_traceCheckCount;
+		ctx->brushCheckCounts[brushNum] = ctx->checkCount;
 
-		if (!(brush->contents & cm_traceContents))
+		if (!(brush->contents & ctx->contents))
 			continue;
 
-		CM_ClipBoxToBrush(cm_traceMins, cm_traceMaxs, cm_traceStart, cm_traceEnd, &cm_trace, brush);
-		if (!cm_trace.fraction)
+		if (!CM_TraceHitsBounds(ctx, brush->mins, brush->maxs))
+			continue;
+
+		CM_ClipBoxToBrush(ctx, ctx->mins, ctx->maxs, ctx->start, ctx->end, &ctx->trace, brush);
+		if (!ctx->trace.fraction)
 			return;
 	}
 }
@@ -1219,7 +1883,7 @@ static void CM_TraceToLeaf (int leafNum){
  CM_TestInLeaf
  =================
 */
-static void CM_TestInLeaf (int leafNum){
+static void CM_TestInLeaf (cmTraceContext_t *ctx, int leafNum){
 
 	int			i;
 	int			brushNum;
@@ -1227,7 +1891,7 @@ static void CM_TestInLeaf (int leafNum){
 	cbrush_t	*brush;
 
 	leaf = &cm_leafs[leafNum];
-	if (!(leaf->contents & cm_traceContents))
+	if (!(leaf->contents & ctx->contents))
 		return;
 
 	// Trace line against all brushes in the leaf
@@ -1235,25 +1899,123 @@ static void CM_TestInLeaf (int leafNum){
 		brushNum = cm_leafBrushes[leaf->firstLeafBrush+i];
 		brush = &cm_brushes[brushNum];
 
-		if (brush->checkCount == cm_traceCheckCount)
+		if (ctx->brushCheckCounts[brushNum] == ctx->checkCount)
 			continue;		// Already checked this brush in another leaf
-		brush->checkCount = cm_traceCheckCount;
+		ctx->brushCheckCounts[brushNum] = ctx->checkCount;
 
-		if (!(brush->contents & cm_traceContents))
+		if (!(brush->contents & ctx->contents))
 			continue;
 
-		CM_TestBoxInBrush(cm_traceMins, cm_traceMaxs, cm_traceStart, &cm_trace, brush);
-		if (!cm_trace.fraction)
+		if (!CM_TestHitsBounds(ctx, brush->mins, brush->maxs))
+			continue;
+
+		CM_TestBoxInBrush(ctx->mins, ctx->maxs, ctx->start, &ctx->trace, brush);
+		if (!ctx->trace.fraction)
 			return;
 	}
 }
 
+/*
+ =================
+ CM_TraceThroughBVH
+
+ Sweeps through the world brushes using the BVH instead of the BSP tree,
+ visiting the near child first so far nodes can be skipped once
+ something is hit
+ =================
+*/
+static void CM_TraceThroughBVH (cmTraceContext_t *ctx){
+
+	int			stack[MAX_BVH_DEPTH*2];
+	int			i, depth, side;
+	cbvhnode_t	*node;
+	cbrush_t	*brush;
+
+	stack[0] = 0;
+	depth = 1;
+
+	while (depth){
+		node = &cm_bvhNodes[stack[--depth]];
+
+		if (!CM_TraceHitsBounds(ctx, node->mins, node->maxs))
+			continue;
+
+		if (node->numBrushes){
+			for (i = 0; i < node->numBrushes; i++){
+				brush = &cm_brushes[cm_bvhBrushes[node->firstBrush+i]];
+
+				if (!(brush->contents & ctx->contents))
+					continue;
+
+				if (!CM_TraceHitsBounds(ctx, brush->mins, brush->maxs))
+					continue;
+
+				CM_ClipBoxToBrush(ctx, ctx->mins, ctx->maxs, ctx->start, ctx->end, &ctx->trace, brush);
+				if (!ctx->trace.fraction)
+					return;
+			}
+
+			continue;
+		}
+
+		// Push the far child first so the near one is visited first
+		side = (ctx->delta[node->axis] < 0);
+
+		stack[depth++] = node->children[side^1];
+		stack[depth++] = node->children[side];
+	}
+}
+
+/*
+ =================
+ CM_TestInBVH
+ =================
+*/
+static void CM_TestInBVH (cmTraceContext_t *ctx){
+
+	int			stack[MAX_BVH_DEPTH*2];
+	int			i, depth;
+	cbvhnode_t	*node;
+	cbrush_t	*brush;
+
+	stack[0] = 0;
+	depth = 1;
+
+	while (depth){
+		node = &cm_bvhNodes[stack[--depth]];
+
+		if (!CM_TestHitsBounds(ctx, node->mins, node->maxs))
+			continue;
+
+		if (node->numBrushes){
+			for (i = 0; i < node->numBrushes; i++){
+				brush = &cm_brushes[cm_bvhBrushes[node->firstBrush+i]];
+
+				if (!(brush->contents & ctx->contents))
+					continue;
+
+				if (!CM_TestHitsBounds(ctx, brush->mins, brush->maxs))
+					continue;
+
+				CM_TestBoxInBrush(ctx->mins, ctx->maxs, ctx->start, &ctx->trace, brush);
+				if (ctx->trace.allsolid)
+					return;
+			}
+
+			continue;
+		}
+
+		stack[depth++] = node->children[0];
+		stack[depth++] = node->children[1];
+	}
+}
+
 /*
  =================
  CM_RecursiveHullCheck
  =================
 */
-static void CM_RecursiveHullCheck (int num, float pf1, float pf2, const vec3_t p1, const vec3_t p2){
+static void CM_RecursiveHullCheck (cmTraceContext_t *ctx, int num, float pf1, float pf2, const vec3_t p1, const vec3_t p2){
 
 	cnode_t		*node;
 	cplane_t	*plane;
@@ -1264,12 +2026,12 @@ static void CM_RecursiveHullCheck (int num, float pf1, float pf2, const vec3_t p
 	int			side;
 	float		midf;
 
-	if (cm_trace.fraction <= pf1)
+	if (ctx->trace.fraction <= pf1)
 		return;		// Already hit something nearer
 
 	// If < 0, we are in a leaf node
 	if (num < 0){
-		CM_TraceToLeaf(-1-num);
+		CM_TraceToLeaf(ctx, -1-num);
 		return;
 	}
 
@@ -1282,25 +2044,25 @@ static void CM_RecursiveHullCheck (int num, float pf1, float pf2, const vec3_t p
 		d1 = p1[plane->type] - plane->dist;
 		d2 = p2[plane->type] - plane->dist;
 
-		offset = cm_traceExtents[plane->type];
+		offset = ctx->extents[plane->type];
 	}
 	else {
 		d1 = DotProduct(p1, plane->normal) - plane->dist;
 		d2 = DotProduct(p2, plane->normal) - plane->dist;
 
-		if (cm_traceIsPoint)
+		if (ctx->isPoint)
 			offset = 0;
 		else
-			offset = fabs(cm_traceExtents[0]*plane->normal[0]) + fabs(cm_traceExtents[1]*plane->normal[1]) + fabs(cm_traceExtents[2]*plane->normal[2]);
+			offset = fabs(ctx->extents[0]*plane->normal[0]) + fabs(ctx->extents[1]*plane->normal[1]) + fabs(ctx->extents[2]*plane->normal[2]);
 	}
 
 	// See which sides we need to consider
 	if (d1 >= offset && d2 >= offset){
-		CM_RecursiveHullCheck(node->children[0], pf1, pf2, p1, p2);
+		CM_RecursiveHullCheck(ctx, node->children[0], pf1, pf2, p1, p2);
 		return;
 	}
 	if (d1 < -offset && d2 < -offset){
-		CM_RecursiveHullCheck(node->children[1], pf1, pf2, p1, p2);
+		CM_RecursiveHullCheck(ctx, node->children[1], pf1, pf2, p1, p2);
 		return;
 	}
 	
@@ -1335,7 +2097,7 @@ static void CM_RecursiveHullCheck (int num, float pf1, float pf2, const vec3_t p
 	mid[1] = p1[1] + (p2[1] - p1[1]) * frac1;
 	mid[2] = p1[2] + (p2[2] - p1[2]) * frac1;
 
-	CM_RecursiveHullCheck(node->children[side], pf1, midf, p1, mid);
+	CM_RecursiveHullCheck(ctx, node->children[side], pf1, midf, p1, mid);
 
 	// Go past the node
 	if (frac2 < 0)
@@ -1349,32 +2111,68 @@ static void CM_RecursiveHullCheck (int num, float pf1, float pf2, const vec3_t p
 	mid[1] = p1[1] + (p2[1] - p1[1]) * frac2;
 	mid[2] = p1[2] + (p2[2] - p1[2]) * frac2;
 
-	CM_RecursiveHullCheck(node->children[side^1], midf, pf2, mid, p2);
+	CM_RecursiveHullCheck(ctx, node->children[side^1], midf, pf2, mid, p2);
 }
 
 /*
  =================
- CM_BoxTrace
+ CM_ContextBoxTrace
  =================
 */
-trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask){
+trace_t CM_ContextBoxTrace (cmTraceContext_t *ctx, const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask){
 
 	// Fill in a default trace
-	memset(&cm_trace, 0, sizeof(cm_trace));
-	cm_trace.fraction = 1;
-	cm_trace.surface = &(cm_nullSurface.c);
+	memset(&ctx->trace, 0, sizeof(ctx->trace));
+	ctx->trace.fraction = 1;
+	ctx->trace.surface = &(cm_nullSurface.c);
 
 	if (!cm_mapLoaded)
-		return cm_trace;	// Map not loaded
+		return ctx->trace;	// Map not loaded
+
+	cm_traces++;			// Optimize counter, not exact if traces run in parallel
+
+	ctx->contents = brushMask;
+	VectorCopy(start, ctx->start);
+	VectorCopy(end, ctx->end);
+	VectorCopy(mins, ctx->mins);
+	VectorCopy(maxs, ctx->maxs);
+
+	// The box hull is a single brush, so skip walking its nodes. This also
+	// keeps the shared nodes from being used with the planes of another
+	// context.
+	if (headNode == cm_boxHeadNode){
+		if (!(ctx->boxBrush->contents & brushMask)){
+			VectorCopy(end, ctx->trace.endpos);
+			return ctx->trace;
+		}
+
+		if (VectorCompare(start, end)){
+			CM_TestBoxInBrush(mins, maxs, start, &ctx->trace, ctx->boxBrush);
 
-	cm_traceCheckCount++;	// For multi-check avoidance
-	cm_traces++;			// Optimize counter
+			VectorCopy(start, ctx->trace.endpos);
+			return ctx->trace;
+		}
+
+		ctx->isPoint = (VectorCompare(mins, vec3_origin) && VectorCompare(maxs, vec3_origin));
+
+		CM_ClipBoxToBrush(ctx, mins, maxs, start, end, &ctx->trace, ctx->boxBrush);
 
-	cm_traceContents = brushMask;
-	VectorCopy(start, cm_traceStart);
-	VectorCopy(end, cm_traceEnd);
-	VectorCopy(mins, cm_traceMins);
-	VectorCopy(maxs, cm_traceMaxs);
+		if (ctx->trace.fraction == 1.0)
+			VectorCopy(end, ctx->trace.endpos);
+		else {
+			ctx->trace.endpos[0] = start[0] + (end[0] - start[0]) * ctx->trace.fraction;
+			ctx->trace.endpos[1] = start[1] + (end[1] - start[1]) * ctx->trace.fraction;
+			ctx->trace.endpos[2] = start[2] + (end[2] - start[2]) * ctx->trace.fraction;
+		}
+
+		return ctx->trace;
+	}
+
+	// For multi-check avoidance
+	if (++ctx->checkCount == 0){
+		memset(ctx->brushCheckCounts, 0, sizeof(ctx->brushCheckCounts));
+		ctx->checkCount = 1;
+	}
 
 	// Check for position test special case
 	if (VectorCompare(start, end)){
@@ -1388,59 +2186,111 @@ trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, co
 			c2[i] = (start[i] + maxs[i]) + 1;
 		}
 
-		numLeafs = CM_BoxLeafNumsHeadNode(c1, c2, leafs, 1024, headNode, &topNode);
+		if (cm_numBvhNodes && headNode == cm_models[0].headNode && cm_traceBVH->integer){
+			CM_TestInBVH(ctx);
+
+			VectorCopy(start, ctx->trace.endpos);
+
+			return ctx->trace;
+		}
+
+		numLeafs = CM_BoxLeafNumsHeadNode(ctx, c1, c2, leafs, 1024, headNode, &topNode);
 
 		for (i = 0; i < numLeafs; i++){
-			CM_TestInLeaf(leafs[i]);
-			if (cm_trace.allsolid)
+			CM_TestInLeaf(ctx, leafs[i]);
+			if (ctx->trace.allsolid)
 				break;
 		}
 
-		VectorCopy(start, cm_trace.endpos);
+		VectorCopy(start, ctx->trace.endpos);
 
-		return cm_trace;
+		return ctx->trace;
 	}
 
 	// Check for point special case
 	if (VectorCompare(mins, vec3_origin) && VectorCompare(maxs, vec3_origin)){
-		cm_traceIsPoint = true;
+		ctx->isPoint = true;
 
-		VectorClear(cm_traceExtents);
+		VectorClear(ctx->extents);
 	}
 	else {
-		cm_traceIsPoint = false;
+		ctx->isPoint = false;
 
-		cm_traceExtents[0] = -mins[0] > maxs[0] ? -mins[0] : maxs[0];
-		cm_traceExtents[1] = -mins[1] > maxs[1] ? -mins[1] : maxs[1];
-		cm_traceExtents[2] = -mins[2] > maxs[2] ? -mins[2] : maxs[2];
+		ctx->extents[0] = -mins[0] > maxs[0] ? -mins[0] : maxs[0];
+		ctx->extents[1] = -mins[1] > maxs[1] ? -mins[1] : maxs[1];
+		ctx->extents[2] = -mins[2] > maxs[2] ? -mins[2] : maxs[2];
 	}
 
+	VectorSubtract(end, start, ctx->delta);
+
+	ctx->invDelta[0] = (ctx->delta[0]) ? 1.0 / ctx->delta[0] : 0;
+	ctx->invDelta[1] = (ctx->delta[1]) ? 1.0 / ctx->delta[1] : 0;
+	ctx->invDelta[2] = (ctx->delta[2]) ? 1.0 / ctx->delta[2] : 0;
+
 	// General sweeping through world
-	CM_RecursiveHullCheck(headNode, 0, 1, start, end);
+	if (cm_numBvhNodes && headNode == cm_models[0].headNode && cm_traceBVH->integer)
+		CM_TraceThroughBVH(ctx);
+	else
+		CM_RecursiveHullCheck(ctx, headNode, 0, 1, start, end);
 
-	if (cm_trace.fraction == 1.0){
-		cm_trace.endpos[0] = end[0];
-		cm_trace.endpos[1] = end[1];
-		cm_trace.endpos[2] = end[2];
+	if (ctx->trace.fraction == 1.0){
+		ctx->trace.endpos[0] = end[0];
+		ctx->trace.endpos[1] = end[1];
+		ctx->trace.endpos[2] = end[2];
 	}
 	else {
-		cm_trace.endpos[0] = start[0] + (end[0] - start[0]) * cm_trace.fraction;
-		cm_trace.endpos[1] = start[1] + (end[1] - start[1]) * cm_trace.fraction;
-		cm_trace.endpos[2] = start[2] + (end[2] - start[2]) * cm_trace.fraction;
+		ctx->trace.endpos[0] = start[0] + (end[0] - start[0]) * ctx->trace.fraction;
+		ctx->trace.endpos[1] = start[1] + (end[1] - start[1]) * ctx->trace.fraction;
+		ctx->trace.endpos[2] = start[2] + (end[2] - start[2]) * ctx->trace.fraction;
 	}
 
-	return cm_trace;
+	return ctx->trace;
 }
 
 /*
  =================
- CM_TransformedBoxTrace
+ CM_BoxTrace
+ =================
+*/
+trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask){
+
+	return CM_ContextBoxTrace(&cm_traceContext, start, end, mins, maxs, headNode, brushMask);
+}
+
+/*
+ =================
+ CM_ContextBoxTraceMany
+
+ Traces a batch of segments with the same box and contents mask
+ =================
+*/
+void CM_ContextBoxTraceMany (cmTraceContext_t *ctx, const vec3_t *starts, const vec3_t *ends, int count, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, trace_t *traces){
+
+	int		i;
+
+	for (i = 0; i < count; i++)
+		traces[i] = CM_ContextBoxTrace(ctx, starts[i], ends[i], mins, maxs, headNode, brushMask);
+}
+
+/*
+ =================
+ CM_BoxTraceMany
+ =================
+*/
+void CM_BoxTraceMany (const vec3_t *starts, const vec3_t *ends, int count, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, trace_t *traces){
+
+	CM_ContextBoxTraceMany(&cm_traceContext, starts, ends, count, mins, maxs, headNode, brushMask, traces);
+}
+
+/*
+ =================
+ CM_ContextTransformedBoxTrace
 
  Handles offseting and rotation of the points for moving and rotating
  entities
  =================
 */
-trace_t	CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const vec3_t origin, const vec3_t angles){
+trace_t	CM_ContextTransformedBoxTrace (cmTraceContext_t *ctx, const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const vec3_t origin, const vec3_t angles){
 
 	trace_t		trace;
 	vec3_t		start2, end2, angles2, temp;
@@ -1466,7 +2316,7 @@ trace_t	CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3
 	}
 
 	// Sweep the box through the world
-	trace = CM_BoxTrace(start2, end2, mins, maxs, headNode, brushMask);
+	trace = CM_ContextBoxTrace(ctx, start2, end2, mins, maxs, headNode, brushMask);
 
 	if (rotated && trace.fraction != 1.0){
 		VectorNegate(angles, angles2);
@@ -1490,6 +2340,16 @@ trace_t	CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3
 	return trace;
 }
 
+/*
+ =================
+ CM_TransformedBoxTrace
+ =================
+*/
+trace_t	CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const vec3_t origin, const vec3_t angles){
+
+	return CM_ContextTransformedBoxTrace(&cm_traceContext, start, end, mins, maxs, headNode, brushMask, origin, angles);
+}
+
 
 /*
  =======================================================================
@@ -1499,8 +2359,36 @@ trace_t	CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3
  =======================================================================
 */
 
-static byte	cm_pvsRow[MAX_MAP_LEAFS/8];
-static byte	cm_phsRow[MAX_MAP_LEAFS/8];
+// Decompressed vis rows are padded to a cache line so every row of the
+// matrix starts on a 32 byte boundary
+#define VIS_ROW_ALIGN			32
+
+// Minimum number of rows kept when the matrix is too large for the
+// memory budget and rows are decompressed on demand
+#define MIN_VIS_CACHE_ROWS		64
+
+// Largest cm_visCacheMegs value, so the budget in bytes fits in an int
+#define MAX_VIS_CACHE_MEGS		1024
+
+typedef struct visCacheSlot_s {
+	struct visCacheSlot_s	*prev, *next;	// LRU links, most recently used first
+	int						owner;			// Index into cm_visCacheIndex, -1 if unused
+	byte					*row;
+} visCacheSlot_t;
+
+static byte				cm_pvsRow[MAX_MAP_LEAFS/8];
+static byte				cm_phsRow[MAX_MAP_LEAFS/8];
+
+static byte				cm_visNullRow[MAX_MAP_LEAFS/8];
+
+static int				cm_visRowBytes;			// Bytes per row, including padding
+
+static byte				*cm_visMatrix;			// [2][numClusters] rows if fully decompressed
+
+static int				cm_visCacheRows;
+static int				*cm_visCacheIndex;		// [2][numClusters] slot numbers, -1 if not cached
+static visCacheSlot_t	*cm_visCacheSlots;
+static visCacheSlot_t	cm_visCacheList;		// Start/end cap for the LRU list
 
 
 /*
@@ -1548,32 +2436,173 @@ static void CM_DecompressVis (const byte *in, byte *out){
 
 /*
  =================
- CM_ClusterPVS
+ CM_InitVisCache
+
+ If enabled, either decompresses the entire PVS and PHS into a cluster
+ by cluster bit matrix, or sets up an LRU cache of decompressed rows if
+ the matrix doesn't fit in cm_visCacheMegs.
+ Must be called after the leafs are loaded so we know the cluster count.
  =================
 */
-byte *CM_ClusterPVS (int cluster){
+static void CM_InitVisCache (void){
 
-	if (cluster == -1 || cm_numVisibility == 0)
-		memset(cm_pvsRow, 0, (cm_numClusters+7)>>3);
-	else
-		CM_DecompressVis((byte *)cm_visibility + cm_visibility->bitOfs[cluster][VIS_PVS], cm_pvsRow);
+	visCacheSlot_t	*slot;
+	byte			*row;
+	int				numRows, megs, budget;
+	int				i;
+
+	cm_visRowBytes = (((cm_numClusters+7)>>3) + VIS_ROW_ALIGN-1) & ~(VIS_ROW_ALIGN-1);
+
+	cm_visMatrix = NULL;
+
+	cm_visCacheRows = 0;
+	cm_visCacheIndex = NULL;
+	cm_visCacheSlots = NULL;
+	cm_visCacheList.prev = cm_visCacheList.next = &cm_visCacheList;
+
+	if (!cm_visCache->integer || !cm_numVisibility)
+		return;
 
-	return cm_pvsRow;
+	numRows = cm_visibility->numClusters * 2;
+
+	megs = cm_visCacheMegs->integer;
+	if (megs < 0)
+		megs = 0;
+	else if (megs > MAX_VIS_CACHE_MEGS)
+		megs = MAX_VIS_CACHE_MEGS;
+
+	budget = megs << 20;
+
+	// Decompress everything if it fits
+	if (numRows * cm_visRowBytes <= budget){
+		cm_visMatrix = Hunk_Alloc(numRows * cm_visRowBytes);
+
+		for (i = 0, row = cm_visMatrix; i < cm_visibility->numClusters; i++, row += cm_visRowBytes)
+			CM_DecompressVis((byte *)cm_visibility + cm_visibility->bitOfs[i][VIS_PVS], row);
+		for (i = 0; i < cm_visibility->numClusters; i++, row += cm_visRowBytes)
+			CM_DecompressVis((byte *)cm_visibility + cm_visibility->bitOfs[i][VIS_PHS], row);
+
+		Com_DPrintf("CM_InitVisCache: decompressed %i clusters (%i KB)\n", cm_visibility->numClusters, (numRows * cm_visRowBytes) >> 10);
+		return;
+	}
+
+	// Otherwise set up an LRU cache that is filled in on demand
+	cm_visCacheRows = budget / cm_visRowBytes;
+	if (cm_visCacheRows < MIN_VIS_CACHE_ROWS)
+		cm_visCacheRows = MIN_VIS_CACHE_ROWS;
+
+	cm_visCacheIndex = Hunk_Alloc(numRows * sizeof(int));
+	cm_visCacheSlots = Hunk_Alloc(cm_visCacheRows * sizeof(visCacheSlot_t));
+	row = Hunk_Alloc(cm_visCacheRows * cm_visRowBytes);
+
+	for (i = 0; i < numRows; i++)
+		cm_visCacheIndex[i] = -1;
+
+	for (i = 0, slot = cm_visCacheSlots; i < cm_visCacheRows; i++, slot++, row += cm_visRowBytes){
+		slot->owner = -1;
+		slot->row = row;
+
+		slot->prev = cm_visCacheList.prev;
+		slot->next = &cm_visCacheList;
+		slot->prev->next = slot;
+		slot->next->prev = slot;
+	}
+
+	Com_DPrintf("CM_InitVisCache: caching %i of %i rows (%i KB)\n", cm_visCacheRows, numRows, (cm_visCacheRows * cm_visRowBytes) >> 10);
 }
 
 /*
  =================
- CM_ClusterPHS
+ CM_CachedVisRow
+
+ Returns the decompressed row from the LRU cache, decompressing it into
+ the least recently used slot if needed
  =================
 */
-byte *CM_ClusterPHS (int cluster){
+static const byte *CM_CachedVisRow (int cluster, int type){
+
+	visCacheSlot_t	*slot;
+	int				index;
+
+	index = type * cm_visibility->numClusters + cluster;
+
+	if (cm_visCacheIndex[index] != -1)
+		slot = &cm_visCacheSlots[cm_visCacheIndex[index]];
+	else {
+		// Recycle the least recently used slot
+		slot = cm_visCacheList.prev;
+
+		if (slot->owner != -1)
+			cm_visCacheIndex[slot->owner] = -1;
+
+		slot->owner = index;
+		cm_visCacheIndex[index] = slot - cm_visCacheSlots;
+
+		CM_DecompressVis((byte *)cm_visibility + cm_visibility->bitOfs[cluster][type], slot->row);
+	}
+
+	// Move to the front of the list
+	if (cm_visCacheList.next != slot){
+		slot->prev->next = slot->next;
+		slot->next->prev = slot->prev;
+
+		slot->prev = &cm_visCacheList;
+		slot->next = cm_visCacheList.next;
+		slot->next->prev = slot;
+		cm_visCacheList.next = slot;
+	}
+
+	return slot->row;
+}
+
+/*
+ =================
+ CM_ClusterVis
+ =================
+*/
+static const byte *CM_ClusterVis (int cluster, int type, byte *row){
 
 	if (cluster == -1 || cm_numVisibility == 0)
-		memset(cm_phsRow, 0, (cm_numClusters+7)>>3);
-	else
-		CM_DecompressVis((byte *)cm_visibility + cm_visibility->bitOfs[cluster][VIS_PHS], cm_phsRow);
+		return cm_visNullRow;
+
+	if (cluster < 0 || cluster >= cm_visibility->numClusters)
+		Com_Error(ERR_DROP, "CM_ClusterVis: bad cluster");
+
+	if (cm_visMatrix)
+		return cm_visMatrix + (type * cm_visibility->numClusters + cluster) * cm_visRowBytes;
+
+	if (cm_visCacheSlots)
+		return CM_CachedVisRow(cluster, type);
 
-	return cm_phsRow;
+	CM_DecompressVis((byte *)cm_visibility + cm_visibility->bitOfs[cluster][type], row);
+
+	return row;
+}
+
+/*
+ =================
+ CM_ClusterPVS
+
+ When the whole matrix is decompressed, the returned row stays valid 
+ until the map is unloaded and can be safely shared between threads.
+ Otherwise it is only valid until the next call.
+ =================
+*/
+const byte *CM_ClusterPVS (int cluster){
+
+	return CM_ClusterVis(cluster, VIS_PVS, cm_pvsRow);
+}
+
+/*
+ =================
+ CM_ClusterPHS
+
+ See CM_ClusterPVS for the lifetime of the returned row
+ =================
+*/
+const byte *CM_ClusterPHS (int cluster){
+
+	return CM_ClusterVis(cluster, VIS_PHS, cm_phsRow);
 }
 
 
@@ -1586,65 +2615,170 @@ byte *CM_ClusterPHS (int cluster){
 */
 
 static qboolean	cm_areaPortalOpen[MAX_MAP_AREAPORTALS];
-static int		cm_floodValid;
+static int		cm_portalAreas[MAX_MAP_AREAPORTALS][2];		// The two areas joined by every portal
+
+// Row N has a bit set for every area connected to area N. All the areas
+// in a connected group share identical rows. Kept up to date as portals
+// change, so the rows can be ANDed against directly.
+static byte		cm_areaMatrix[MAX_MAP_AREAS][MAX_MAP_AREAS/8];
+static byte		cm_allAreas[MAX_MAP_AREAS/8];
+
+static int		cm_areaParent[MAX_MAP_AREAS];				// Union-find forest
 
 
 /*
  =================
- CM_RecursiveFloodArea
+ CM_FindAreaGroup
  =================
 */
-static void CM_RecursiveFloodArea (carea_t *area, int floodNum){
+static int CM_FindAreaGroup (int area){
 
-	int				i;
-	careaportal_t	*p;
+	while (cm_areaParent[area] != area){
+		cm_areaParent[area] = cm_areaParent[cm_areaParent[area]];
+		area = cm_areaParent[area];
+	}
 
-	if (area->floodValid == cm_floodValid){
-		if (area->floodNum == floodNum)
-			return;
+	return area;
+}
 
-		Com_Error(ERR_DROP, "CM_RecursiveFloodArea: reflooded");
+/*
+ =================
+ CM_MergeAreaGroups
+
+ Joins the groups of the given areas, ORing together their rows in the
+ connectivity matrix
+ =================
+*/
+static void CM_MergeAreaGroups (int area1, int area2){
+
+	byte	row[MAX_MAP_AREAS/8];
+	int		group1, group2;
+	int		i, bytes;
+
+	group1 = CM_FindAreaGroup(area1);
+	group2 = CM_FindAreaGroup(area2);
+
+	if (group1 == group2)
+		return;		// Already connected
+
+	cm_areaParent[group2] = group1;
+
+	bytes = (cm_numAreas+7)>>3;
+
+	for (i = 0; i < bytes; i++)
+		row[i] = cm_areaMatrix[area1][i] | cm_areaMatrix[area2][i];
+
+	// Every member of the new group gets the combined row
+	for (i = 1; i < cm_numAreas; i++){
+		if (!(row[i>>3] & (1<<(i&7))))
+			continue;
+
+		memcpy(cm_areaMatrix[i], row, bytes);
 	}
+}
+
+/*
+ =================
+ CM_SplitAreaGroup
+
+ Breaks up the group of the given area into single areas, then joins
+ them again through the portals that are still open. Only the areas in
+ the group are touched, the rest of the map is left alone.
+ =================
+*/
+static void CM_SplitAreaGroup (int area){
+
+	byte			row[MAX_MAP_AREAS/8];
+	int				i, j, bytes;
+	careaportal_t	*p;
 
-	area->floodNum = floodNum;
-	area->floodValid = cm_floodValid;
+	bytes = (cm_numAreas+7)>>3;
+
+	memcpy(row, cm_areaMatrix[area], bytes);
 
-	p = &cm_areaPortals[area->firstAreaPortal];
-	for (i = 0; i < area->numAreaPortals; i++, p++){
-		if (!cm_areaPortalOpen[p->portalNum])
+	for (i = 1; i < cm_numAreas; i++){
+		if (!(row[i>>3] & (1<<(i&7))))
 			continue;
 
-		CM_RecursiveFloodArea(&cm_areas[p->otherArea], floodNum);
+		cm_areaParent[i] = i;
+
+		memset(cm_areaMatrix[i], 0, bytes);
+		cm_areaMatrix[i][i>>3] = 1<<(i&7);
+	}
+
+	for (i = 1; i < cm_numAreas; i++){
+		if (!(row[i>>3] & (1<<(i&7))))
+			continue;
+
+		p = &cm_areaPortals[cm_areas[i].firstAreaPortal];
+		for (j = 0; j < cm_areas[i].numAreaPortals; j++, p++){
+			if (!cm_areaPortalOpen[p->portalNum])
+				continue;
+
+			CM_MergeAreaGroups(i, p->otherArea);
+		}
 	}
 }
 
 /*
  =================
  CM_FloodAreaConnections
+
+ Rebuilds the whole connectivity matrix from the portal states
  =================
 */
-static void CM_FloodAreaConnections (qboolean clear){
+static void CM_FloodAreaConnections (void){
 
-	int		i;
-	carea_t	*area;
-	int		floodNum = 0;
+	int				i, j;
+	careaportal_t	*p;
 
-	if (clear)
-		memset(cm_areaPortalOpen, 0, sizeof(cm_areaPortalOpen));
+	memset(cm_areaMatrix, 0, sizeof(cm_areaMatrix));
 
-	// All current floods are now invalid
-	cm_floodValid++;
+	for (i = 0; i < cm_numAreas; i++){
+		cm_areaParent[i] = i;
+		cm_areaMatrix[i][i>>3] = 1<<(i&7);
+	}
 
 	// Area 0 is not used
 	for (i = 1; i < cm_numAreas; i++){
-		area = &cm_areas[i];
+		p = &cm_areaPortals[cm_areas[i].firstAreaPortal];
+		for (j = 0; j < cm_areas[i].numAreaPortals; j++, p++){
+			if (!cm_areaPortalOpen[p->portalNum])
+				continue;
 
-		if (area->floodValid == cm_floodValid)
-			continue;		// Already flooded into
+			CM_MergeAreaGroups(i, p->otherArea);
+		}
+	}
+}
 
-		floodNum++;
-		CM_RecursiveFloodArea(area, floodNum);
+/*
+ =================
+ CM_InitAreaConnections
+ =================
+*/
+static void CM_InitAreaConnections (void){
+
+	int				i, j;
+	careaportal_t	*p;
+
+	memset(cm_areaPortalOpen, 0, sizeof(cm_areaPortalOpen));
+	memset(cm_portalAreas, 0, sizeof(cm_portalAreas));
+	memset(cm_allAreas, 255, sizeof(cm_allAreas));
+
+	for (i = 1; i < cm_numAreas; i++){
+		p = &cm_areaPortals[cm_areas[i].firstAreaPortal];
+		for (j = 0; j < cm_areas[i].numAreaPortals; j++, p++){
+			if (p->portalNum < 0 || p->portalNum >= MAX_MAP_AREAPORTALS)
+				Com_Error(ERR_DROP, "CM_LoadMap: bad area portal in '%s'", cm_map);
+			if (p->otherArea < 0 || p->otherArea >= cm_numAreas)
+				Com_Error(ERR_DROP, "CM_LoadMap: bad area portal in '%s'", cm_map);
+
+			cm_portalAreas[p->portalNum][0] = i;
+			cm_portalAreas[p->portalNum][1] = p->otherArea;
+		}
 	}
+
+	CM_FloodAreaConnections();
 }
 
 /*
@@ -1657,9 +2791,20 @@ void CM_SetAreaPortalState (int portalNum, qboolean open){
 	if (portalNum < 0 || portalNum >= cm_numAreaPortals)
 		Com_Error(ERR_DROP, "CM_SetAreaPortalState: bad area portal");
 
+	if (cm_areaPortalOpen[portalNum] == open)
+		return;
+
 	cm_areaPortalOpen[portalNum] = open;
 
-	CM_FloodAreaConnections(false);
+	if (!cm_portalAreas[portalNum][0])
+		return;		// Not referenced by any area
+
+	// Opening a portal can only join two groups, but closing one may split
+	// a group apart
+	if (open)
+		CM_MergeAreaGroups(cm_portalAreas[portalNum][0], cm_portalAreas[portalNum][1]);
+	else
+		CM_SplitAreaGroup(cm_portalAreas[portalNum][0]);
 }
 
 /*
@@ -1675,12 +2820,31 @@ qboolean CM_AreasConnected (int area1, int area2){
 	if ((area1 < 0 || area1 >= cm_numAreas) || (area2 < 0 || area2 >= cm_numAreas))
 		Com_Error(ERR_DROP, "CM_AreasConnected: bad area");
 
-	if (cm_areas[area1].floodNum == cm_areas[area2].floodNum)
+	if (cm_areaMatrix[area1][area2>>3] & (1<<(area2&7)))
 		return true;
 
 	return false;
 }
 
+/*
+ =================
+ CM_AreaConnections
+
+ Returns a bit vector of all the areas connected to the given area, that
+ stays valid until an area portal changes state
+ =================
+*/
+const byte *CM_AreaConnections (int area){
+
+	if (cm_noAreas->integer)
+		return cm_allAreas;
+
+	if (area < 0 || area >= cm_numAreas)
+		Com_Error(ERR_DROP, "CM_AreaConnections: bad area");
+
+	return cm_areaMatrix[area];
+}
+
 /*
  =================
  CM_WriteAreaBits
@@ -1693,26 +2857,18 @@ qboolean CM_AreasConnected (int area1, int area2){
 */
 int CM_WriteAreaBits (byte *buffer, int area){
 
-	int		i;
-	int		floodNum;
 	int		bytes;
 
 	bytes = (cm_numAreas+7)>>3;
 
-	if (cm_noAreas->integer){
+	if (cm_noAreas->integer || !area){
 		// For debugging, send everything
 		memset(buffer, 255, bytes);
 		return bytes;
 	}
 
-	memset(buffer, 0, bytes);
+	memcpy(buffer, cm_areaMatrix[area], bytes);
 
-	floodNum = cm_areas[area].floodNum;
-	for (i = 0; i < cm_numAreas; i++){
-		if (cm_areas[i].floodNum == floodNum || !area)
-			buffer[i>>3] |= 1<<(i&7);
-	}
-	
 	return bytes;
 }
 
@@ -1740,7 +2896,7 @@ void CM_ReadPortalState (fileHandle_t f){
 
 	FS_Read(cm_areaPortalOpen, sizeof(cm_areaPortalOpen), f);
 
-	CM_FloodAreaConnections(false);
+	CM_FloodAreaConnections();
 }
 
 /*
@@ -43,6 +43,10 @@ static int		com_serverState;
 
 static jmp_buf	com_abortFrame;
 
+static void		*com_printLock;				// Other threads can't print directly
+static char		com_printQueue[MAX_PRINTMSG];
+static int		com_printQueueLength;
+
 qboolean		com_configModified = false;
 
 int				com_timeBefore, com_timeBetween, com_timeAfter;
@@ -194,6 +198,30 @@ static void Com_LogFile (const char *text){
 		fflush(com_logFileHandle);	// Force it to save every time
 }
 	
+/*
+ =================
+ Com_QueuePrint
+
+ Messages from other threads are held until the main thread prints
+ something. Whatever doesn't fit is dropped.
+ =================
+*/
+static void Com_QueuePrint (const char *string){
+
+	int		length;
+
+	length = strlen(string);
+
+	Sys_LockMutex(com_printLock);
+
+	if (com_printQueueLength + length < sizeof(com_printQueue)){
+		memcpy(com_printQueue + com_printQueueLength, string, length + 1);
+		com_printQueueLength += length;
+	}
+
+	Sys_UnlockMutex(com_printLock);
+}
+
 /*
  =================
  Com_Printf
@@ -204,13 +232,30 @@ static void Com_LogFile (const char *text){
 */
 void Com_Printf (const char *fmt, ...){
 
-	char	string[MAX_PRINTMSG];
+	char	string[MAX_PRINTMSG], queued[MAX_PRINTMSG];
 	va_list	argPtr;
 
 	va_start(argPtr, fmt);
 	vsnprintf(string, sizeof(string), fmt, argPtr);
 	va_end(argPtr);
 
+	if (!Sys_IsMainThread()){
+		Com_QueuePrint(string);
+		return;
+	}
+
+	// Print what other threads had to say first
+	if (com_printQueueLength){
+		Sys_LockMutex(com_printLock);
+
+		Q_strncpyz(queued, com_printQueue, sizeof(queued));
+		com_printQueueLength = 0;
+
+		Sys_UnlockMutex(com_printLock);
+
+		Com_Printf("%s", queued);
+	}
+
 	if (com_rdTarget){
 		Com_Redirect(string);
 		return;
@@ -267,8 +312,20 @@ void Com_Error (int code, const char *fmt, ...){
 
 	static qboolean		recursive;
 	static char			string[MAX_PRINTMSG];
+	char				threadString[MAX_PRINTMSG];
 	va_list				argPtr;
 
+	// There is no way to abort the frame from another thread, and the
+	// subsystems can only be shut down from the main thread, which might
+	// be waiting on this one
+	if (!Sys_IsMainThread()){
+		va_start(argPtr, fmt);
+		vsnprintf(threadString, sizeof(threadString), fmt, argPtr);
+		va_end(argPtr);
+
+		Sys_ThreadError(threadString);
+	}
+
 	if (recursive)
 		Sys_Error("Recursive error after: %s", string);
 	recursive = true;
@@ -591,6 +648,8 @@ void Com_Init (char *cmdLine){
 
 	Com_Printf("%s %s (%s)\n", Q2E_VERSION, BUILDSTRING, __DATE__);
 
+	com_printLock = Sys_CreateMutex();
+
 	// Parse the command line
 	Com_ParseCommandLine(cmdLine);
 
@@ -620,7 +679,12 @@ void Com_Init (char *cmdLine){
 	// Register cvars and commands
 	Cvar_Get("version", va("%s %s (%s)", Q2E_VERSION, BUILDSTRING, __DATE__), CVAR_SERVERINFO | CVAR_ROM);
 	developer = Cvar_Get("developer", "0", 0);
+#ifdef DEDICATED_ONLY
+	dedicated = Cvar_Get("dedicated", "1", CVAR_ROM);
+	Cvar_ForceSet("dedicated", "1");
+#else
 	dedicated = Cvar_Get("dedicated", "0", CVAR_INIT);
+#endif
 	paused = Cvar_Get("paused", "0", CVAR_CHEAT);
 	timedemo = Cvar_Get("timedemo", "0", CVAR_CHEAT);
 	fixedtime = Cvar_Get("fixedtime", "0", CVAR_CHEAT);
@@ -647,6 +711,10 @@ void Com_Init (char *cmdLine){
 	// Initialize the rest of the subsystems
 	Sys_Init();
 
+	Com_InitJobs();
+	Com_InitLoader();
+	Com_InitDemos();
+
 	SV_Init();
 	CL_Init();
 
@@ -727,11 +795,16 @@ void Com_Frame (int msec){
 
 	SV_Frame(msec);
 
+	// Send everything the server queued up this frame in one go
+	NET_Flush(NS_SERVER);
+
 	if (com_speeds->integer)
 		com_timeBetween = Sys_Milliseconds();
 
 	CL_Frame(msec);
 
+	NET_Flush(NS_CLIENT);
+
 	if (com_speeds->integer)
 		com_timeAfter = Sys_Milliseconds();
 
@@ -769,6 +842,9 @@ void Com_Shutdown (void){
 
 	NET_Shutdown();
 
+	Com_ShutdownLoader();
+	Com_ShutdownJobs();
+
 	FS_Shutdown();
 
 	Key_Shutdown();
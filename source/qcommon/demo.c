@@ -0,0 +1,597 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// demo.c -- demo file container
+
+
+#include "qcommon.h"
+#include "include/zlib.h"
+
+
+#define DEMO_IDENT				(('M'<<24)+('D'<<16)+('2'<<8)+'Q')	// "Q2DM"
+#define DEMO_INDEX_IDENT		(('I'<<24)+('D'<<16)+('2'<<8)+'Q')	// "Q2DI"
+#define DEMO_VERSION			1
+
+#define DEMO_BLOCK_SIZE			65536		// Raw size of a block
+#define DEMO_STORED_SIZE		(DEMO_BLOCK_SIZE + (DEMO_BLOCK_SIZE >> 8) + 64)
+
+// Each message in a block is prefixed by its length and frame
+#define DEMO_RECORD_HEADER		8
+
+// Server frames are 100 msec apart
+#define DEMO_FRAMES_PER_SECOND	10
+
+typedef enum {
+	DEMO_BLOCK_DATA,
+	DEMO_BLOCK_KEYFRAME,
+	DEMO_BLOCK_INDEX
+} demoBlockType_t;
+
+typedef struct {
+	int				ident;
+	int				version;
+} demoHeader_t;
+
+// A block is stored compressed if storedSize differs from rawSize
+typedef struct {
+	int				type;
+	int				rawSize;
+	int				storedSize;
+} demoBlock_t;
+
+typedef struct {
+	int				frameNum;
+	int				offset;				// Of the first block of the keyframe
+} demoKeyframe_t;
+
+typedef struct {
+	int				indexOffset;
+	int				lastFrame;
+	int				ident;
+} demoTrailer_t;
+
+struct demo_s {
+	fileHandle_t	file;
+	qboolean		writing;
+	qboolean		legacy;				// Plain length-prefixed messages
+
+	int				frameNum;			// Of the last message read or written
+	int				lastFrame;
+
+	// The block being written, or the block being read from
+	demoBlockType_t	blockType;
+	int				blockSize;
+	int				blockRead;
+
+	// Keyframe blocks are read only right after a seek
+	qboolean		readKeyframe;
+
+	demoKeyframe_t	*keyframes;
+	int				numKeyframes;
+	int				maxKeyframes;
+
+	byte			block[DEMO_BLOCK_SIZE];
+	byte			stored[DEMO_STORED_SIZE];
+};
+
+cvar_t	*com_demoCompress;
+cvar_t	*com_demoKeyframes;
+
+
+/*
+ =================
+ Com_AddDemoKeyframe
+ =================
+*/
+static void Com_AddDemoKeyframe (demo_t *demo, int frameNum, int offset){
+
+	demoKeyframe_t	*keyframes;
+
+	if (demo->numKeyframes == demo->maxKeyframes){
+		demo->maxKeyframes = (demo->maxKeyframes) ? demo->maxKeyframes * 2 : 64;
+
+		keyframes = Z_Malloc(demo->maxKeyframes * sizeof(demoKeyframe_t));
+		if (demo->keyframes){
+			memcpy(keyframes, demo->keyframes, demo->numKeyframes * sizeof(demoKeyframe_t));
+			Z_Free(demo->keyframes);
+		}
+
+		demo->keyframes = keyframes;
+	}
+
+	demo->keyframes[demo->numKeyframes].frameNum = frameNum;
+	demo->keyframes[demo->numKeyframes].offset = offset;
+	demo->numKeyframes++;
+}
+
+/*
+ =================
+ Com_WriteDemoBlock
+
+ Writes out the raw data of a block, compressed if it's worth it
+ =================
+*/
+static void Com_WriteDemoBlock (demo_t *demo, demoBlockType_t type, const byte *data, int size, qboolean compress){
+
+	demoBlock_t		block;
+	uLongf			storedSize;
+
+	block.type = LittleLong(type);
+	block.rawSize = LittleLong(size);
+	block.storedSize = LittleLong(size);
+
+	if (compress && size){
+		storedSize = sizeof(demo->stored);
+
+		if (compress2(demo->stored, &storedSize, data, size, Z_BEST_SPEED) == Z_OK && storedSize < size){
+			block.storedSize = LittleLong(storedSize);
+
+			FS_Write(&block, sizeof(block), demo->file);
+			FS_Write(demo->stored, storedSize, demo->file);
+			return;
+		}
+	}
+
+	FS_Write(&block, sizeof(block), demo->file);
+	FS_Write(data, size, demo->file);
+}
+
+/*
+ =================
+ Com_FlushDemoBlock
+ =================
+*/
+static void Com_FlushDemoBlock (demo_t *demo){
+
+	if (!demo->blockSize)
+		return;
+
+	Com_WriteDemoBlock(demo, demo->blockType, demo->block, demo->blockSize, com_demoCompress->integer);
+
+	demo->blockSize = 0;
+}
+
+/*
+ =================
+ Com_RecordDemo
+ =================
+*/
+demo_t *Com_RecordDemo (fileHandle_t f){
+
+	demo_t			*demo;
+	demoHeader_t	header;
+
+	demo = Z_Malloc(sizeof(demo_t));
+
+	demo->file = f;
+	demo->writing = true;
+	demo->frameNum = -1;
+	demo->lastFrame = -1;
+	demo->blockType = DEMO_BLOCK_DATA;
+
+	header.ident = LittleLong(DEMO_IDENT);
+	header.version = LittleLong(DEMO_VERSION);
+
+	FS_Write(&header, sizeof(header), demo->file);
+
+	return demo;
+}
+
+/*
+ =================
+ Com_WriteDemoMessage
+ =================
+*/
+void Com_WriteDemoMessage (demo_t *demo, int frameNum, const void *data, int length){
+
+	int		header[2];
+
+	if (length < 0 || length > DEMO_BLOCK_SIZE - DEMO_RECORD_HEADER)
+		Com_Error(ERR_DROP, "Com_WriteDemoMessage: bad length (%i)", length);
+
+	if (demo->blockSize + DEMO_RECORD_HEADER + length > DEMO_BLOCK_SIZE)
+		Com_FlushDemoBlock(demo);
+
+	header[0] = LittleLong(length);
+	header[1] = LittleLong(frameNum);
+
+	memcpy(demo->block + demo->blockSize, header, DEMO_RECORD_HEADER);
+	memcpy(demo->block + demo->blockSize + DEMO_RECORD_HEADER, data, length);
+	demo->blockSize += DEMO_RECORD_HEADER + length;
+
+	demo->frameNum = frameNum;
+
+	if (frameNum > demo->lastFrame)
+		demo->lastFrame = frameNum;
+}
+
+/*
+ =================
+ Com_DemoKeyframeDue
+ =================
+*/
+qboolean Com_DemoKeyframeDue (demo_t *demo, int frameNum){
+
+	if (com_demoKeyframes->value <= 0.0)
+		return false;
+
+	if (!demo->numKeyframes)
+		return true;
+
+	return (frameNum - demo->keyframes[demo->numKeyframes-1].frameNum >= com_demoKeyframes->value * DEMO_FRAMES_PER_SECOND);
+}
+
+/*
+ =================
+ Com_BeginDemoKeyframe
+ =================
+*/
+void Com_BeginDemoKeyframe (demo_t *demo, int frameNum){
+
+	Com_FlushDemoBlock(demo);
+
+	Com_AddDemoKeyframe(demo, frameNum, FS_Tell(demo->file));
+
+	demo->blockType = DEMO_BLOCK_KEYFRAME;
+}
+
+/*
+ =================
+ Com_EndDemoKeyframe
+ =================
+*/
+void Com_EndDemoKeyframe (demo_t *demo){
+
+	Com_FlushDemoBlock(demo);
+
+	demo->blockType = DEMO_BLOCK_DATA;
+}
+
+/*
+ =================
+ Com_ReadDemoIndex
+
+ Reads the keyframe index from the end of the file, if there is one
+ =================
+*/
+static void Com_ReadDemoIndex (demo_t *demo){
+
+	demoTrailer_t	trailer;
+	demoBlock_t		block;
+	int				i, start, end;
+
+	start = FS_Tell(demo->file);
+
+	FS_Seek(demo->file, -((int)sizeof(trailer)), FS_SEEK_END);
+	end = FS_Tell(demo->file);
+
+	if (FS_Read(&trailer, sizeof(trailer), demo->file) != sizeof(trailer) || LittleLong(trailer.ident) != DEMO_INDEX_IDENT){
+		Com_DPrintf(S_COLOR_YELLOW "Demo has no index, probably because it wasn't stopped properly\n");
+
+		FS_Seek(demo->file, start, FS_SEEK_SET);
+		return;
+	}
+
+	trailer.indexOffset = LittleLong(trailer.indexOffset);
+	trailer.lastFrame = LittleLong(trailer.lastFrame);
+
+	if (trailer.indexOffset < start || trailer.indexOffset >= end){
+		Com_DPrintf(S_COLOR_YELLOW "Demo has a bad index offset\n");
+
+		FS_Seek(demo->file, start, FS_SEEK_SET);
+		return;
+	}
+
+	FS_Seek(demo->file, trailer.indexOffset, FS_SEEK_SET);
+	FS_Read(&block, sizeof(block), demo->file);
+
+	block.type = LittleLong(block.type);
+	block.rawSize = LittleLong(block.rawSize);
+	block.storedSize = LittleLong(block.storedSize);
+
+	// The index is never compressed
+	if (block.type != DEMO_BLOCK_INDEX || block.rawSize != block.storedSize || block.rawSize % sizeof(demoKeyframe_t) || trailer.indexOffset + (int)sizeof(block) + block.rawSize > end){
+		Com_DPrintf(S_COLOR_YELLOW "Demo has a bad index\n");
+
+		FS_Seek(demo->file, start, FS_SEEK_SET);
+		return;
+	}
+
+	demo->numKeyframes = demo->maxKeyframes = block.rawSize / sizeof(demoKeyframe_t);
+
+	if (demo->numKeyframes){
+		demo->keyframes = Z_Malloc(block.rawSize);
+		FS_Read(demo->keyframes, block.rawSize, demo->file);
+
+		for (i = 0; i < demo->numKeyframes; i++){
+			demo->keyframes[i].frameNum = LittleLong(demo->keyframes[i].frameNum);
+			demo->keyframes[i].offset = LittleLong(demo->keyframes[i].offset);
+		}
+	}
+
+	demo->lastFrame = trailer.lastFrame;
+
+	FS_Seek(demo->file, start, FS_SEEK_SET);
+}
+
+/*
+ =================
+ Com_PlayDemo
+ =================
+*/
+demo_t *Com_PlayDemo (fileHandle_t f){
+
+	demo_t			*demo;
+	demoHeader_t	header;
+
+	demo = Z_Malloc(sizeof(demo_t));
+
+	demo->file = f;
+	demo->frameNum = -1;
+	demo->lastFrame = -1;
+
+	if (FS_Read(&header, sizeof(header), demo->file) != sizeof(header) || LittleLong(header.ident) != DEMO_IDENT){
+		// An old demo, just a series of messages
+		demo->legacy = true;
+
+		FS_Seek(demo->file, 0, FS_SEEK_SET);
+		return demo;
+	}
+
+	if (LittleLong(header.version) != DEMO_VERSION){
+		FS_FCloseFile(demo->file);
+		Z_Free(demo);
+
+		Com_Error(ERR_DROP, "Demo has wrong version number (%i should be %i)", LittleLong(header.version), DEMO_VERSION);
+	}
+
+	Com_ReadDemoIndex(demo);
+
+	return demo;
+}
+
+/*
+ =================
+ Com_ReadDemoBlock
+
+ Reads the next block that should be played. Returns false at the end of
+ the demo.
+ =================
+*/
+static qboolean Com_ReadDemoBlock (demo_t *demo){
+
+	demoBlock_t		block;
+	uLongf			rawSize;
+
+	demo->blockSize = 0;
+	demo->blockRead = 0;
+
+	while (1){
+		if (FS_Read(&block, sizeof(block), demo->file) != sizeof(block))
+			return false;
+
+		block.type = LittleLong(block.type);
+		block.rawSize = LittleLong(block.rawSize);
+		block.storedSize = LittleLong(block.storedSize);
+
+		if (block.type == DEMO_BLOCK_INDEX)
+			return false;
+
+		if (block.rawSize < 0 || block.rawSize > DEMO_BLOCK_SIZE || block.storedSize < 0 || block.storedSize > DEMO_STORED_SIZE)
+			Com_Error(ERR_DROP, "Com_ReadDemoBlock: bad block size");
+
+		// Keyframes are only needed right after a seek
+		if (block.type == DEMO_BLOCK_KEYFRAME && !demo->readKeyframe){
+			FS_Seek(demo->file, block.storedSize, FS_SEEK_CUR);
+			continue;
+		}
+
+		if (block.type == DEMO_BLOCK_DATA)
+			demo->readKeyframe = false;
+
+		break;
+	}
+
+	// Read the whole block at once, so the file is touched about once a
+	// second instead of twice for every message
+	if (block.storedSize == block.rawSize){
+		if (FS_Read(demo->block, block.rawSize, demo->file) != block.rawSize)
+			return false;
+	}
+	else {
+		if (FS_Read(demo->stored, block.storedSize, demo->file) != block.storedSize)
+			return false;
+
+		rawSize = block.rawSize;
+
+		if (uncompress(demo->block, &rawSize, demo->stored, block.storedSize) != Z_OK || rawSize != block.rawSize)
+			Com_Error(ERR_DROP, "Com_ReadDemoBlock: corrupted block");
+	}
+
+	demo->blockSize = block.rawSize;
+
+	return true;
+}
+
+/*
+ =================
+ Com_ReadDemoMessage
+ =================
+*/
+int Com_ReadDemoMessage (demo_t *demo, void *data, int maxLength){
+
+	int		header[2];
+	int		length;
+
+	if (demo->legacy){
+		if (FS_Read(&length, sizeof(length), demo->file) != sizeof(length))
+			return -1;
+
+		length = LittleLong(length);
+		if (length == -1)
+			return -1;
+
+		if (length < 0 || length > maxLength)
+			Com_Error(ERR_DROP, "Com_ReadDemoMessage: bad length (%i)", length);
+
+		if (FS_Read(data, length, demo->file) != length)
+			return -1;
+
+		return length;
+	}
+
+	while (demo->blockRead == demo->blockSize){
+		if (!Com_ReadDemoBlock(demo))
+			return -1;
+	}
+
+	if (demo->blockSize - demo->blockRead < DEMO_RECORD_HEADER)
+		Com_Error(ERR_DROP, "Com_ReadDemoMessage: truncated block");
+
+	memcpy(header, demo->block + demo->blockRead, DEMO_RECORD_HEADER);
+	demo->blockRead += DEMO_RECORD_HEADER;
+
+	length = LittleLong(header[0]);
+	if (length < 0 || length > maxLength || length > demo->blockSize - demo->blockRead)
+		Com_Error(ERR_DROP, "Com_ReadDemoMessage: bad length (%i)", length);
+
+	memcpy(data, demo->block + demo->blockRead, length);
+	demo->blockRead += length;
+
+	demo->frameNum = LittleLong(header[1]);
+
+	return length;
+}
+
+/*
+ =================
+ Com_SeekDemo
+ =================
+*/
+qboolean Com_SeekDemo (demo_t *demo, int frameNum){
+
+	int		i;
+
+	if (demo->writing || !demo->numKeyframes)
+		return false;
+
+	for (i = demo->numKeyframes - 1; i > 0; i--){
+		if (demo->keyframes[i].frameNum <= frameNum)
+			break;
+	}
+
+	FS_Seek(demo->file, demo->keyframes[i].offset, FS_SEEK_SET);
+
+	demo->blockSize = 0;
+	demo->blockRead = 0;
+
+	demo->readKeyframe = true;
+
+	demo->frameNum = demo->keyframes[i].frameNum;
+
+	return true;
+}
+
+/*
+ =================
+ Com_DemoFrame
+ =================
+*/
+int Com_DemoFrame (demo_t *demo){
+
+	return demo->frameNum;
+}
+
+/*
+ =================
+ Com_DemoFrameRange
+ =================
+*/
+qboolean Com_DemoFrameRange (demo_t *demo, int *firstFrame, int *lastFrame){
+
+	if (!demo->numKeyframes)
+		return false;
+
+	*firstFrame = demo->keyframes[0].frameNum;
+	*lastFrame = demo->lastFrame;
+
+	return true;
+}
+
+/*
+ =================
+ Com_DemoLength
+ =================
+*/
+int Com_DemoLength (demo_t *demo){
+
+	return FS_Tell(demo->file) + demo->blockSize;
+}
+
+/*
+ =================
+ Com_CloseDemo
+
+ When recording, writes out the last block and the index
+ =================
+*/
+void Com_CloseDemo (demo_t *demo){
+
+	demoTrailer_t	trailer;
+	int				i;
+
+	if (demo->writing){
+		Com_FlushDemoBlock(demo);
+
+		trailer.indexOffset = LittleLong(FS_Tell(demo->file));
+		trailer.lastFrame = LittleLong(demo->lastFrame);
+		trailer.ident = LittleLong(DEMO_INDEX_IDENT);
+
+		for (i = 0; i < demo->numKeyframes; i++){
+			demo->keyframes[i].frameNum = LittleLong(demo->keyframes[i].frameNum);
+			demo->keyframes[i].offset = LittleLong(demo->keyframes[i].offset);
+		}
+
+		// The index is never compressed, so it can be read back directly
+		Com_WriteDemoBlock(demo, DEMO_BLOCK_INDEX, (byte *)demo->keyframes, demo->numKeyframes * sizeof(demoKeyframe_t), false);
+
+		FS_Write(&trailer, sizeof(trailer), demo->file);
+	}
+
+	FS_FCloseFile(demo->file);
+
+	if (demo->keyframes)
+		Z_Free(demo->keyframes);
+
+	Z_Free(demo);
+}
+
+/*
+ =================
+ Com_InitDemos
+ =================
+*/
+void Com_InitDemos (void){
+
+	com_demoCompress = Cvar_Get("com_demoCompress", "1", CVAR_ARCHIVE);
+	com_demoKeyframes = Cvar_Get("com_demoKeyframes", "10", CVAR_ARCHIVE);
+}
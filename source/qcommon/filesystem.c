@@ -20,7 +20,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 
 #include "qcommon.h"
-#include "include/unzip.h"
+#include "include/zlib.h"
 
 
 /*
@@ -51,33 +51,66 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define MAX_HANDLES			64
 #define MAX_FIND_FILES		65536
 #define MAX_PACK_FILES		1024
+#define MAX_MAPPED_FILES	256
 
-typedef struct {
-	qboolean				used;
-	char					name[MAX_QPATH];
-	fsMode_t				mode;
-	FILE					*file;				// Only one of file or
-	unzFile					*zip;				// zip will be used
-} fsHandle_t;
+#define INDEX_HASHSIZE		16384
+#define INDEX_BLOCK_SIZE	1024
+
+#define INFLATE_BUFFER_SIZE	16384
+
+#define ZIP_SHORT(p)		((p)[0] | ((p)[1] << 8))
+#define ZIP_LONG(p)			((p)[0] | ((p)[1] << 8) | ((p)[2] << 16) | ((unsigned)(p)[3] << 24))
+
+#define ZIP_LOCAL_SIG		0x04034b50
+#define ZIP_CENTRAL_SIG		0x02014b50
+#define ZIP_END_SIG			0x06054b50
+
+#define ZIP_LOCAL_SIZE		30
+#define ZIP_CENTRAL_SIZE	46
+#define ZIP_END_SIZE		22
 
 typedef struct fsPackFile_s {
 	char					name[MAX_QPATH];
 	int						size;
-	int						offset;				// This is ignored in PK2 files
+	int						offset;				// Offset of the data in the pack file
+	int						localOffset;		// PK2 local header, -1 once offset is known
+	int						compressedSize;
+	qboolean				deflated;			// Only PK2 files can be compressed
+	int						mapOffset;			// Offset of the data in the mapping, -1 if not stored
 
 	struct fsPackFile_s		*nextHash;
 } fsPackFile_t;
 
 typedef struct {
 	char					name[MAX_OSPATH];
-	FILE					*pak;				// Only one of pak or
-	unzFile					*pk2;				// pk2 will be used
+	FILE					*file;				// Shared by all files opened from the pack
 	int						numFiles;
 	fsPackFile_t			*files;
 
+	byte					*mapBase;			// NULL if the pack is not mapped
+	int						mapLength;
+	int						mapRefs;			// Files handed out by FS_MapFile
+
 	fsPackFile_t			*filesHash[FILES_HASHSIZE];
 } fsPack_t;
 
+typedef struct {
+	z_stream				stream;
+	int						compressedRead;		// Bytes read from the pack so far
+	byte					buffer[INFLATE_BUFFER_SIZE];
+} fsInflate_t;
+
+typedef struct {
+	qboolean				used;
+	char					name[MAX_QPATH];
+	fsMode_t				mode;
+	FILE					*file;				// Only one of file or
+	fsPack_t				*pack;				// pack will be used
+	fsPackFile_t			*packFile;
+	int						position;			// Read position inside packFile
+	fsInflate_t				*inflate;			// Only used for deflated files
+} fsHandle_t;
+
 typedef struct fsSearchPath_s {
 	char					path[MAX_OSPATH];	// Only one of path or
 	fsPack_t				*pack;				// pack will be used
@@ -85,9 +118,51 @@ typedef struct fsSearchPath_s {
 	struct fsSearchPath_s	*next;
 } fsSearchPath_t;
 
+typedef struct {
+	const byte				*data;
+	fsPack_t				*pack;
+} fsMappedFile_t;
+
+// Every file in every search path, so opening a file is a single hash
+// lookup and a missing file costs no syscalls at all
+typedef struct fsIndexEntry_s {
+	char					*name;				// Points into packFile for pack files
+	fsSearchPath_t			*search;
+	fsPackFile_t			*packFile;			// NULL for files in a directory
+	int						priority;			// Position of search in the search path
+
+	struct fsIndexEntry_s	*nextHash;
+} fsIndexEntry_t;
+
+typedef struct fsIndexBlock_s {
+	fsIndexEntry_t			entries[INDEX_BLOCK_SIZE];
+	int						numEntries;
+
+	struct fsIndexBlock_s	*next;
+} fsIndexBlock_t;
+
+typedef struct {
+	qboolean				valid;
+
+	fsIndexBlock_t			*blocks;
+	fsIndexEntry_t			*freeEntries;
+	int						numEntries;
+
+	int						lookups;			// Statistics for FS_Path_f
+	int						misses;
+
+	fsIndexEntry_t			*hashTable[INDEX_HASHSIZE];
+} fsIndex_t;
+
 static fsHandle_t		fs_handles[MAX_HANDLES];
 static fsSearchPath_t	*fs_searchPaths;
 
+static fsMappedFile_t	fs_mappedFiles[MAX_MAPPED_FILES];
+
+static fsIndex_t		fs_index;
+
+static void				*fs_lock;			// Protects the handles, mapped files and index
+
 static char				fs_gameDir[MAX_OSPATH];
 static char				fs_curGame[MAX_QPATH];
 
@@ -97,9 +172,345 @@ cvar_t	*fs_basePath;
 cvar_t	*fs_baseGame;
 cvar_t	*fs_game;
 cvar_t	*fs_debug;
+cvar_t	*fs_mapPacks;
+cvar_t	*fs_pathIndex;
 
 void CDAudio_Stop (void);
 
+static void FS_UpdateIndexFile (const char *name);
+
+
+/*
+ =======================================================================
+
+ PATH INDEX
+
+ =======================================================================
+*/
+
+
+/*
+ =================
+ FS_FindIndexEntry
+
+ Returns false if there is no index, so the caller has to search the hard
+ way. Otherwise copies the entry that is first in the search path, with a
+ NULL search if the file doesn't exist anywhere.
+ Loader threads look files up while the main thread updates the index,
+ so the entry is copied under fs_lock.
+ =================
+*/
+static qboolean FS_FindIndexEntry (const char *name, fsIndexEntry_t *found){
+
+	fsIndexEntry_t	*entry;
+	unsigned		hashKey;
+
+	Sys_LockMutex(fs_lock);
+
+	if (!fs_index.valid){
+		Sys_UnlockMutex(fs_lock);
+		return false;
+	}
+
+	fs_index.lookups++;
+
+	hashKey = Com_HashKey(name, INDEX_HASHSIZE);
+
+	// Entries are sorted by priority, so the first match wins
+	for (entry = fs_index.hashTable[hashKey]; entry; entry = entry->nextHash){
+		if (!Q_stricmp(entry->name, name))
+			break;
+	}
+
+	if (entry)
+		*found = *entry;
+	else {
+		memset(found, 0, sizeof(fsIndexEntry_t));
+
+		fs_index.misses++;
+	}
+
+	Sys_UnlockMutex(fs_lock);
+
+	return true;
+}
+
+/*
+ =================
+ FS_AddIndexEntry
+ =================
+*/
+static void FS_AddIndexEntry (const char *name, fsSearchPath_t *search, fsPackFile_t *packFile, int priority){
+
+	fsIndexEntry_t	*entry, **prev;
+	fsIndexBlock_t	*block;
+	unsigned		hashKey;
+
+	hashKey = Com_HashKey(name, INDEX_HASHSIZE);
+
+	// Find where it goes, ignoring duplicates inside the same path
+	for (prev = &fs_index.hashTable[hashKey]; *prev; prev = &(*prev)->nextHash){
+		if ((*prev)->search == search && !Q_stricmp((*prev)->name, name))
+			return;
+
+		if ((*prev)->priority > priority)
+			break;
+	}
+
+	// Allocate a new entry
+	if (fs_index.freeEntries){
+		entry = fs_index.freeEntries;
+		fs_index.freeEntries = entry->nextHash;
+	}
+	else {
+		block = fs_index.blocks;
+
+		if (!block || block->numEntries == INDEX_BLOCK_SIZE){
+			block = Z_Malloc(sizeof(fsIndexBlock_t));
+
+			block->next = fs_index.blocks;
+			fs_index.blocks = block;
+		}
+
+		entry = &block->entries[block->numEntries++];
+	}
+
+	if (packFile)
+		entry->name = packFile->name;
+	else
+		entry->name = CopyString(name);
+
+	entry->search = search;
+	entry->packFile = packFile;
+	entry->priority = priority;
+
+	entry->nextHash = *prev;
+	*prev = entry;
+
+	fs_index.numEntries++;
+}
+
+/*
+ =================
+ FS_RemoveIndexEntry
+ =================
+*/
+static void FS_RemoveIndexEntry (const char *name, fsSearchPath_t *search){
+
+	fsIndexEntry_t	*entry, **prev;
+	unsigned		hashKey;
+
+	hashKey = Com_HashKey(name, INDEX_HASHSIZE);
+
+	for (prev = &fs_index.hashTable[hashKey]; *prev; prev = &(*prev)->nextHash){
+		entry = *prev;
+
+		if (entry->search != search || Q_stricmp(entry->name, name))
+			continue;
+
+		*prev = entry->nextHash;
+
+		if (!entry->packFile)
+			FreeString(entry->name);
+
+		entry->nextHash = fs_index.freeEntries;
+		fs_index.freeEntries = entry;
+
+		fs_index.numEntries--;
+
+		return;
+	}
+}
+
+/*
+ =================
+ FS_FreeIndex
+ =================
+*/
+static void FS_FreeIndex (void){
+
+	fsIndexBlock_t	*block, *next;
+	fsIndexEntry_t	*entry;
+	int				i;
+
+	Sys_LockMutex(fs_lock);
+
+	for (i = 0; i < INDEX_HASHSIZE; i++){
+		for (entry = fs_index.hashTable[i]; entry; entry = entry->nextHash){
+			if (!entry->packFile)
+				FreeString(entry->name);
+		}
+	}
+
+	for (block = fs_index.blocks; block; block = next){
+		next = block->next;
+
+		Z_Free(block);
+	}
+
+	memset(&fs_index, 0, sizeof(fs_index));
+
+	Sys_UnlockMutex(fs_lock);
+}
+
+/*
+ =================
+ FS_GameDirSearchPath
+
+ Returns the search path for fs_gameDir, where all files are written
+ =================
+*/
+static fsSearchPath_t *FS_GameDirSearchPath (int *priority){
+
+	fsSearchPath_t	*search;
+	int				i;
+
+	for (i = 0, search = fs_searchPaths; search; i++, search = search->next){
+		if (search->pack)
+			continue;
+
+		if (!Q_stricmp(search->path, fs_gameDir)){
+			*priority = i;
+			return search;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ =================
+ FS_UpdateIndexFile
+
+ Called after a file in fs_gameDir was created, written or removed
+ =================
+*/
+static void FS_UpdateIndexFile (const char *name){
+
+	fsSearchPath_t	*search;
+	char			path[MAX_OSPATH];
+	FILE			*f;
+	int				priority;
+
+	if (!fs_index.valid)
+		return;
+
+	search = FS_GameDirSearchPath(&priority);
+	if (!search)
+		return;
+
+	Q_snprintfz(path, sizeof(path), "%s/%s", search->path, name);
+
+	f = fopen(path, "rb");
+	if (f)
+		fclose(f);
+
+	Sys_LockMutex(fs_lock);
+
+	if (f)
+		FS_AddIndexEntry(name, search, NULL, priority);
+	else
+		FS_RemoveIndexEntry(name, search);
+
+	Sys_UnlockMutex(fs_lock);
+}
+
+/*
+ =================
+ FS_BuildIndex
+
+ Builds the index of all the files in the search path. Called whenever
+ the search path changes.
+ =================
+*/
+static void FS_BuildIndex (void){
+
+	fsSearchPath_t	*search;
+	fsPackFile_t	*packFile;
+	char			**dirFiles;
+	int				dirCount, priority, length;
+	int				i;
+
+	FS_FreeIndex();
+
+	if (!fs_pathIndex->integer)
+		return;
+
+	dirFiles = Z_Malloc(MAX_FIND_FILES * sizeof(char *));
+
+	for (priority = 0, search = fs_searchPaths; search; priority++, search = search->next){
+		if (search->pack){
+			for (i = 0, packFile = search->pack->files; i < search->pack->numFiles; i++, packFile++)
+				FS_AddIndexEntry(packFile->name, search, packFile, priority);
+
+			continue;
+		}
+
+		dirCount = Sys_RecursiveFindFiles(search->path, dirFiles, MAX_FIND_FILES, 0, true, false);
+
+		if (dirCount == MAX_FIND_FILES){
+			// We would miss files, so don't trust the index at all
+			Com_Printf(S_COLOR_YELLOW "WARNING: too many files in '%s', path index disabled\n", search->path);
+
+			for (i = 0; i < dirCount; i++)
+				FreeString(dirFiles[i]);
+
+			Z_Free(dirFiles);
+
+			FS_FreeIndex();
+			return;
+		}
+
+		length = strlen(search->path) + 1;
+
+		for (i = 0; i < dirCount; i++){
+			if (!Q_strnicmp(dirFiles[i], search->path, length - 1) && dirFiles[i][length - 1] == '/')
+				FS_AddIndexEntry(dirFiles[i] + length, search, NULL, priority);
+
+			FreeString(dirFiles[i]);
+		}
+	}
+
+	Z_Free(dirFiles);
+
+	// Entries were added while the index was still invalid, so lookups
+	// from other threads only see it once it is complete
+	Sys_LockMutex(fs_lock);
+	fs_index.valid = true;
+	Sys_UnlockMutex(fs_lock);
+}
+
+/*
+ =================
+ FS_IndexFile
+
+ Lets the file system know that a file in the game directory was
+ written by someone else, like the game library
+ =================
+*/
+void FS_IndexFile (const char *name){
+
+	FS_UpdateIndexFile(name);
+}
+
+/*
+ =================
+ FS_Rescan_f
+
+ Picks up files that were added or removed outside of the game
+ =================
+*/
+void FS_Rescan_f (void){
+
+	FS_BuildIndex();
+
+	if (fs_index.valid)
+		Com_Printf("%i files indexed\n", fs_index.numEntries);
+}
+
+
+// =====================================================================
+
 
 /*
  =================
@@ -113,16 +524,22 @@ static fsHandle_t *FS_HandleForFile (fileHandle_t *f){
 	fsHandle_t	*handle;
 	int			i;
 
+	Sys_LockMutex(fs_lock);
+
 	for (i = 0, handle = fs_handles; i < MAX_HANDLES; i++, handle++){
 		if (handle->used)
 			continue;
 
 		handle->used = true;
 
+		Sys_UnlockMutex(fs_lock);
+
 		*f = i+1;
 		return handle;
 	}
 
+	Sys_UnlockMutex(fs_lock);
+
 	// Failed
 	Com_Error(ERR_FATAL, "FS_HandleForFile: none free");
 }
@@ -156,65 +573,286 @@ static int FS_FileLength (FILE *f){
 	end = ftell(f);
 	fseek(f, cur, SEEK_SET);
 
-	return end;
+	return end;
+}
+
+/*
+ =================
+ FS_FOpenFileAppend
+
+ Returns file size or -1 on error
+ =================
+*/
+static int FS_FOpenFileAppend (fsHandle_t *handle){
+
+	char	path[MAX_OSPATH];
+
+	FS_CreatePath(handle->name);
+
+	Q_snprintfz(path, sizeof(path), "%s/%s", fs_gameDir, handle->name);
+
+	handle->file = fopen(path, "ab");
+	if (handle->file){
+		if (fs_debug->integer)
+			Com_Printf("FS_FOpenFileAppend: %s\n", path);
+
+		FS_UpdateIndexFile(handle->name);
+
+		return FS_FileLength(handle->file);
+	}
+
+	if (fs_debug->integer)
+		Com_Printf("FS_FOpenFileAppend: couldn't open %s\n", path);
+
+	return -1;
+}
+
+/*
+ =================
+ FS_FOpenFileWrite
+
+ Always returns 0 or -1 on error
+ =================
+*/
+static int FS_FOpenFileWrite (fsHandle_t *handle){
+
+	char	path[MAX_OSPATH];
+
+	FS_CreatePath(handle->name);
+
+	Q_snprintfz(path, sizeof(path), "%s/%s", fs_gameDir, handle->name);
+
+	handle->file = fopen(path, "wb");
+	if (handle->file){
+		if (fs_debug->integer)
+			Com_Printf("FS_FOpenFileWrite: %s\n", path);
+
+		FS_UpdateIndexFile(handle->name);
+
+		return 0;
+	}
+
+	if (fs_debug->integer)
+		Com_Printf("FS_FOpenFileWrite: couldn't open %s\n", path);
+
+	return -1;
+}
+
+/*
+ =================
+ FS_PK2DataOffset
+
+ The central directory only tells where the local header of a file is,
+ and the local header has its own name and extra field lengths. Read it
+ the first time the file is opened.
+ Loader threads can open the same file at once, so the offset is only
+ resolved under fs_lock, which also makes it visible to the others.
+ =================
+*/
+static qboolean FS_PK2DataOffset (fsPack_t *pack, fsPackFile_t *packFile){
+
+	byte		header[ZIP_LOCAL_SIZE];
+	const byte	*local;
+
+	Sys_LockMutex(fs_lock);
+
+	if (packFile->localOffset == -1){
+		Sys_UnlockMutex(fs_lock);
+		return true;
+	}
+
+	if (pack->mapBase && packFile->localOffset <= pack->mapLength - ZIP_LOCAL_SIZE)
+		local = pack->mapBase + packFile->localOffset;
+	else {
+		if (Sys_ReadFileAt(pack->file, header, ZIP_LOCAL_SIZE, packFile->localOffset) != ZIP_LOCAL_SIZE){
+			Sys_UnlockMutex(fs_lock);
+			return false;
+		}
+
+		local = header;
+	}
+
+	if (ZIP_LONG(local) != ZIP_LOCAL_SIG){
+		Sys_UnlockMutex(fs_lock);
+		return false;
+	}
+
+	packFile->offset = packFile->localOffset + ZIP_LOCAL_SIZE + ZIP_SHORT(local + 26) + ZIP_SHORT(local + 28);
+	packFile->localOffset = -1;
+
+	Sys_UnlockMutex(fs_lock);
+
+	return true;
+}
+
+/*
+ =================
+ FS_OpenPackFile
+
+ All the files in a pack share the descriptor of the pack, so this only
+ sets up the handle.
+ Returns file size or -1 if the entry is damaged.
+ =================
+*/
+static int FS_OpenPackFile (fsHandle_t *handle, fsPack_t *pack, fsPackFile_t *packFile){
+
+	if (fs_debug->integer)
+		Com_Printf("FS_FOpenFileRead: %s (found in %s)\n", handle->name, pack->name);
+
+	if (!FS_PK2DataOffset(pack, packFile)){
+		Com_Printf(S_COLOR_YELLOW "WARNING: bad local header for %s in %s\n", packFile->name, pack->name);
+		return -1;
+	}
+
+	handle->pack = pack;
+	handle->packFile = packFile;
+	handle->position = 0;
+
+	if (packFile->deflated){
+		handle->inflate = Z_Malloc(sizeof(fsInflate_t));
+
+		// PK2 files have no zlib header
+		if (inflateInit2(&handle->inflate->stream, -MAX_WBITS) != Z_OK)
+			Com_Error(ERR_FATAL, "FS_OpenPackFile: inflateInit2 failed for %s", packFile->name);
+	}
+
+	return packFile->size;
+}
+
+/*
+ =================
+ FS_ClosePackFile
+ =================
+*/
+static void FS_ClosePackFile (fsHandle_t *handle){
+
+	if (!handle->inflate)
+		return;
+
+	inflateEnd(&handle->inflate->stream);
+
+	Z_Free(handle->inflate);
+	handle->inflate = NULL;
 }
 
 /*
  =================
- FS_FOpenFileAppend
+ FS_ReadPackFile
 
- Returns file size or -1 on error
+ Returns the number of bytes read, 0 at the end of the file or -1 if the
+ pack can't be read
  =================
 */
-static int FS_FOpenFileAppend (fsHandle_t *handle){
+static int FS_ReadPackFile (fsHandle_t *handle, void *buffer, int size){
 
-	char	path[MAX_OSPATH];
+	fsPack_t		*pack = handle->pack;
+	fsPackFile_t	*packFile = handle->packFile;
+	fsInflate_t		*inflater = handle->inflate;
+	int				r, status;
 
-	FS_CreatePath(handle->name);
+	if (size > packFile->size - handle->position)
+		size = packFile->size - handle->position;
 
-	Q_snprintfz(path, sizeof(path), "%s/%s", fs_gameDir, handle->name);
+	if (size <= 0)
+		return 0;
 
-	handle->file = fopen(path, "ab");
-	if (handle->file){
-		if (fs_debug->integer)
-			Com_Printf("FS_FOpenFileAppend: %s\n", path);
+	// Stored files can be copied straight from the mapping
+	if (packFile->mapOffset != -1 && pack->mapBase){
+		memcpy(buffer, pack->mapBase + packFile->mapOffset + handle->position, size);
 
-		return FS_FileLength(handle->file);
+		handle->position += size;
+
+		return size;
 	}
 
-	if (fs_debug->integer)
-		Com_Printf("FS_FOpenFileAppend: couldn't open %s\n", path);
+	if (!inflater){
+		r = Sys_ReadFileAt(pack->file, buffer, size, packFile->offset + handle->position);
+		if (r > 0)
+			handle->position += r;
 
-	return -1;
+		return r;
+	}
+
+	// Inflate until the buffer is full
+	inflater->stream.next_out = buffer;
+	inflater->stream.avail_out = size;
+
+	while (inflater->stream.avail_out){
+		if (!inflater->stream.avail_in){
+			r = packFile->compressedSize - inflater->compressedRead;
+			if (r > INFLATE_BUFFER_SIZE)
+				r = INFLATE_BUFFER_SIZE;
+
+			if (r <= 0)
+				break;
+
+			if (pack->mapBase && packFile->offset + packFile->compressedSize <= pack->mapLength)
+				inflater->stream.next_in = pack->mapBase + packFile->offset + inflater->compressedRead;
+			else {
+				r = Sys_ReadFileAt(pack->file, inflater->buffer, r, packFile->offset + inflater->compressedRead);
+				if (r <= 0)
+					return -1;
+
+				inflater->stream.next_in = inflater->buffer;
+			}
+
+			inflater->stream.avail_in = r;
+			inflater->compressedRead += r;
+		}
+
+		status = inflate(&inflater->stream, Z_SYNC_FLUSH);
+		if (status == Z_STREAM_END)
+			break;
+
+		if (status != Z_OK)
+			return -1;
+	}
+
+	r = size - inflater->stream.avail_out;
+
+	handle->position += r;
+
+	return r;
 }
 
 /*
  =================
- FS_FOpenFileWrite
-
- Always returns 0 or -1 on error
+ FS_SeekPackFile
  =================
 */
-static int FS_FOpenFileWrite (fsHandle_t *handle){
+static void FS_SeekPackFile (fsHandle_t *handle, int position){
 
-	char	path[MAX_OSPATH];
+	byte	dummy[0x8000];
+	int		len;
 
-	FS_CreatePath(handle->name);
+	if (position < 0)
+		position = 0;
+	if (position > handle->packFile->size)
+		position = handle->packFile->size;
 
-	Q_snprintfz(path, sizeof(path), "%s/%s", fs_gameDir, handle->name);
+	if (!handle->inflate){
+		handle->position = position;
+		return;
+	}
 
-	handle->file = fopen(path, "wb");
-	if (handle->file){
-		if (fs_debug->integer)
-			Com_Printf("FS_FOpenFileWrite: %s\n", path);
+	// Compressed data can only be skipped forward
+	if (position < handle->position){
+		inflateReset(&handle->inflate->stream);
 
-		return 0;
+		handle->inflate->stream.avail_in = 0;
+		handle->inflate->compressedRead = 0;
+
+		handle->position = 0;
 	}
 
-	if (fs_debug->integer)
-		Com_Printf("FS_FOpenFileWrite: couldn't open %s\n", path);
+	while (handle->position < position){
+		len = position - handle->position;
+		if (len > sizeof(dummy))
+			len = sizeof(dummy);
 
-	return -1;
+		if (FS_ReadPackFile(handle, dummy, len) <= 0)
+			break;
+	}
 }
 
 /*
@@ -231,9 +869,37 @@ static int FS_FOpenFileRead (fsHandle_t *handle){
 	fsSearchPath_t	*search;
 	fsPackFile_t	*packFile;
 	fsPack_t		*pack;
+	fsIndexEntry_t	entry;
 	char			path[MAX_OSPATH];
 	unsigned		hashKey;
 
+	// Look it up in the index first
+	if (FS_FindIndexEntry(handle->name, &entry)){
+		if (!entry.search){
+			if (fs_debug->integer)
+				Com_Printf("FS_FOpenFileRead: couldn't find %s\n", handle->name);
+
+			return -1;
+		}
+
+		if (entry.packFile)
+			return FS_OpenPackFile(handle, entry.search->pack, entry.packFile);
+
+		Q_snprintfz(path, sizeof(path), "%s/%s", entry.search->path, handle->name);
+
+		handle->file = fopen(path, "rb");
+		if (handle->file){
+			if (fs_debug->integer)
+				Com_Printf("FS_FOpenFileRead: %s (found in %s)\n", handle->name, entry.search->path);
+
+			return FS_FileLength(handle->file);
+		}
+
+		// The file was removed behind our back, so search the hard way
+		if (fs_debug->integer)
+			Com_Printf("FS_FOpenFileRead: stale index entry for %s\n", handle->name);
+	}
+
 	// Search through the path, one element at a time
 	for (search = fs_searchPaths; search; search = search->next){
 		if (search->pack){
@@ -243,35 +909,8 @@ static int FS_FOpenFileRead (fsHandle_t *handle){
 			hashKey = Com_HashKey(handle->name, FILES_HASHSIZE);
 
 			for (packFile = pack->filesHash[hashKey]; packFile; packFile = packFile->nextHash){
-				if (!Q_stricmp(packFile->name, handle->name)){
-					// Found it!
-					if (fs_debug->integer)
-						Com_Printf("FS_FOpenFileRead: %s (found in %s)\n", handle->name, pack->name);
-
-					if (pack->pak){
-						// PAK
-						handle->file = fopen(pack->name, "rb");
-						if (handle->file){
-							fseek(handle->file, packFile->offset, SEEK_SET);
-
-							return packFile->size;
-						}
-					}
-					else if (pack->pk2){
-						// PK2
-						handle->zip = unzOpen(pack->name);
-						if (handle->zip){
-							if (unzLocateFile(handle->zip, handle->name, 2) == UNZ_OK){
-								if (unzOpenCurrentFile(handle->zip) == UNZ_OK)
-									return packFile->size;
-							}
-
-							unzClose(handle->zip);
-						}
-					}
-
-					Com_Error(ERR_FATAL, "Couldn't reopen %s", pack->name);
-				}
+				if (!Q_stricmp(packFile->name, handle->name))
+					return FS_OpenPackFile(handle, pack, packFile);
 			}
 		}
 		else {
@@ -332,7 +971,9 @@ int FS_FOpenFile (const char *name, fileHandle_t *f, fsMode_t mode){
 		return size;
 
 	// Couldn't open, so free the handle
+	Sys_LockMutex(fs_lock);
 	memset(handle, 0, sizeof(*handle));
+	Sys_UnlockMutex(fs_lock);
 
 	*f = 0;
 	return -1;
@@ -351,12 +992,12 @@ void FS_FCloseFile (fileHandle_t f){
 
 	if (handle->file)
 		fclose(handle->file);
-	else if (handle->zip){
-		unzCloseCurrentFile(handle->zip);
-		unzClose(handle->zip);
-	}
+	else if (handle->pack)
+		FS_ClosePackFile(handle);
 
+	Sys_LockMutex(fs_lock);
 	memset(handle, 0, sizeof(*handle));
+	Sys_UnlockMutex(fs_lock);
 }
 
 /*
@@ -385,8 +1026,8 @@ int FS_Read (void *buffer, int size, fileHandle_t f){
 	while (remaining){
 		if (handle->file)
 			r = fread(buf, 1, remaining, handle->file);
-		else if (handle->zip)
-			r = unzReadCurrentFile(handle->zip, buf, remaining);
+		else if (handle->pack)
+			r = FS_ReadPackFile(handle, buf, remaining);
 		else
 			return 0;
 
@@ -436,8 +1077,8 @@ int FS_Write (const void *buffer, int size, fileHandle_t f){
 	while (remaining){
 		if (handle->file)
 			w = fwrite(buf, 1, remaining, handle->file);
-		else if (handle->zip)
-			Com_Error(ERR_FATAL, "FS_Write: can't write to zip file %s", handle->name);
+		else if (handle->pack)
+			Com_Error(ERR_FATAL, "FS_Write: can't write to pack file %s", handle->name);
 		else
 			return 0;
 
@@ -474,8 +1115,8 @@ int FS_Printf (fileHandle_t f, const char *fmt, ...){
 		w = vfprintf(handle->file, fmt, argPtr);
 		va_end(argPtr);
 	}
-	else if (handle->zip)
-		Com_Error(ERR_FATAL, "FS_Printf: can't write to zip file %s", handle->name);
+	else if (handle->pack)
+		Com_Error(ERR_FATAL, "FS_Printf: can't write to pack file %s", handle->name);
 	else
 		return 0;
 
@@ -495,9 +1136,6 @@ int FS_Printf (fileHandle_t f, const char *fmt, ...){
 void FS_Seek (fileHandle_t f, int offset, fsOrigin_t origin){
 
 	fsHandle_t		*handle;
-	unz_file_info	info;
-	int				remaining, r, len;
-	byte			dummy[0x8000];
 
 	handle = FS_GetFileByHandle(f);
 
@@ -516,39 +1154,20 @@ void FS_Seek (fileHandle_t f, int offset, fsOrigin_t origin){
 			Com_Error(ERR_FATAL, "FS_Seek: bad origin (%i)", origin);
 		}
 	}
-	else if (handle->zip){
+	else if (handle->pack){
 		switch (origin){
 		case FS_SEEK_SET:
-			remaining = offset;
+			FS_SeekPackFile(handle, offset);
 			break;
 		case FS_SEEK_CUR:
-			remaining = offset + unztell(handle->zip);
+			FS_SeekPackFile(handle, handle->position + offset);
 			break;
 		case FS_SEEK_END:
-			unzGetCurrentFileInfo(handle->zip, &info, NULL, 0, NULL, 0, NULL, 0);
-
-			remaining = offset + info.uncompressed_size;
+			FS_SeekPackFile(handle, handle->packFile->size + offset);
 			break;
 		default:
 			Com_Error(ERR_FATAL, "FS_Seek: bad origin (%i)", origin);
 		}
-
-		// Reopen the file
-		unzCloseCurrentFile(handle->zip);
-		unzOpenCurrentFile(handle->zip);
-
-		// Skip until the desired offset is reached
-		while (remaining){
-			len = remaining;
-			if (len > sizeof(dummy))
-				len = sizeof(dummy);
-
-			r = unzReadCurrentFile(handle->zip, dummy, len);
-			if (r <= 0)
-				break;
-
-			remaining -= r;
-		}
 	}
 }
 
@@ -565,8 +1184,8 @@ int FS_Tell (fileHandle_t f){
 
 	if (handle->file)
 		return ftell(handle->file);
-	else if (handle->zip)
-		return unztell(handle->zip);
+	else if (handle->pack)
+		return handle->position;
 
 	return 0;
 }
@@ -584,8 +1203,8 @@ void FS_Flush (fileHandle_t f){
 
 	if (handle->file)
 		fflush(handle->file);
-	else if (handle->zip)
-		Com_Error(ERR_FATAL, "FS_Flush: can't flush zip file %s", handle->name);
+	else if (handle->pack)
+		Com_Error(ERR_FATAL, "FS_Flush: can't flush pack file %s", handle->name);
 }
 
 /*
@@ -650,6 +1269,9 @@ void FS_RenameFile (const char *oldName, const char *newName){
 	Q_snprintfz(newPath, sizeof(newPath), "%s/%s", fs_gameDir, newName);
 
 	rename(oldPath, newPath);
+
+	FS_UpdateIndexFile(oldName);
+	FS_UpdateIndexFile(newName);
 }
 		
 /*
@@ -667,6 +1289,8 @@ void FS_DeleteFile (const char *name){
 	Q_snprintfz(path, sizeof(path), "%s/%s", fs_gameDir, name);
 
 	remove(path);
+
+	FS_UpdateIndexFile(name);
 }
 
 /*
@@ -684,6 +1308,10 @@ int FS_LoadFile (const char *name, void **buffer){
 	fileHandle_t	f;
 	int				size;
 
+	// It may have been read in the background already
+	if (buffer && Com_FinishLoad(name, NULL, buffer, &size))
+		return size;
+
 	size = FS_FOpenFile(name, &f, FS_READ);
 	if (!f){
 		if (buffer)
@@ -718,6 +1346,153 @@ void FS_FreeFile (void *buffer){
 	Z_Free(buffer);
 }
 
+/*
+ =================
+ FS_MapPackFile
+ =================
+*/
+static int FS_MapPackFile (const char *name, fsPack_t *pack, fsPackFile_t *packFile, const void **buffer){
+
+	fsMappedFile_t	*mappedFile;
+	int				i;
+
+	Sys_LockMutex(fs_lock);
+
+	// Find a free slot, otherwise we can only load it
+	for (i = 0, mappedFile = fs_mappedFiles; i < MAX_MAPPED_FILES; i++, mappedFile++){
+		if (!mappedFile->data)
+			break;
+	}
+
+	if (i == MAX_MAPPED_FILES){
+		Sys_UnlockMutex(fs_lock);
+
+		return FS_LoadFile(name, (void **)buffer);
+	}
+
+	mappedFile->data = pack->mapBase + packFile->mapOffset;
+	mappedFile->pack = pack;
+
+	pack->mapRefs++;
+
+	*buffer = mappedFile->data;
+
+	Sys_UnlockMutex(fs_lock);
+
+	if (fs_debug->integer)
+		Com_Printf("FS_MapFile: %s (mapped from %s)\n", name, pack->name);
+
+	return packFile->size;
+}
+
+/*
+ =================
+ FS_MapFile
+
+ Like FS_LoadFile, but files stored uncompressed inside a mapped pack are
+ returned in place without being copied.
+ The data is read-only and not 0 terminated, and must be released with
+ FS_UnmapFile.
+ =================
+*/
+int FS_MapFile (const char *name, const void **buffer){
+
+	fsSearchPath_t	*search;
+	fsPackFile_t	*packFile;
+	fsPack_t		*pack;
+	fsIndexEntry_t	entry;
+	FILE			*f;
+	char			path[MAX_OSPATH];
+	unsigned		hashKey;
+
+	if (!buffer)
+		return FS_LoadFile(name, NULL);
+
+	// The index already knows which path wins
+	if (FS_FindIndexEntry(name, &entry)){
+		if (!entry.packFile)
+			return FS_LoadFile(name, (void **)buffer);
+
+		pack = entry.search->pack;
+		packFile = entry.packFile;
+
+		if (!pack->mapBase || packFile->mapOffset == -1)
+			return FS_LoadFile(name, (void **)buffer);
+
+		return FS_MapPackFile(name, pack, packFile, buffer);
+	}
+
+	// Search through the path the same way FS_FOpenFileRead does, so we
+	// never return a pack file that is overridden by an earlier path
+	hashKey = Com_HashKey(name, FILES_HASHSIZE);
+
+	for (search = fs_searchPaths; search; search = search->next){
+		if (search->pack){
+			pack = search->pack;
+
+			for (packFile = pack->filesHash[hashKey]; packFile; packFile = packFile->nextHash){
+				if (!Q_stricmp(packFile->name, name))
+					break;
+			}
+
+			if (!packFile)
+				continue;
+
+			if (!pack->mapBase || packFile->mapOffset == -1)
+				break;		// Compressed or not mapped
+
+			// Found it!
+			return FS_MapPackFile(name, pack, packFile, buffer);
+		}
+		else {
+			// Search in a directory tree
+			Q_snprintfz(path, sizeof(path), "%s/%s", search->path, name);
+
+			f = fopen(path, "rb");
+			if (f){
+				fclose(f);
+				break;
+			}
+		}
+	}
+
+	return FS_LoadFile(name, (void **)buffer);
+}
+
+/*
+ =================
+ FS_UnmapFile
+ =================
+*/
+void FS_UnmapFile (const void *buffer){
+
+	fsMappedFile_t	*mappedFile;
+	int				i;
+
+	if (!buffer)
+		Com_Error(ERR_FATAL, "FS_UnmapFile: NULL buffer");
+
+	Sys_LockMutex(fs_lock);
+
+	for (i = 0, mappedFile = fs_mappedFiles; i < MAX_MAPPED_FILES; i++, mappedFile++){
+		if (mappedFile->data != buffer)
+			continue;
+
+		mappedFile->pack->mapRefs--;
+
+		mappedFile->data = NULL;
+		mappedFile->pack = NULL;
+
+		Sys_UnlockMutex(fs_lock);
+		return;
+	}
+
+	Sys_UnlockMutex(fs_lock);
+
+	// It was loaded, not mapped
+	FS_FreeFile((void *)buffer);
+}
+
 /*
  =================
  FS_SaveFile
@@ -1074,7 +1849,7 @@ void FS_RemovePath (const char *path){
 
 	char	dir[MAX_OSPATH];
 	char	*dirFiles[MAX_FIND_FILES];
-	int		dirCount, i;
+	int		dirCount, length, i;
 
 	if (fs_debug->integer)
 		Com_Printf("FS_RemovePath( %s )\n", path);
@@ -1087,9 +1862,14 @@ void FS_RemovePath (const char *path){
 	Q_snprintfz(dir, sizeof(dir), "%s/%s", fs_gameDir, path);
 
 	// Remove any files in the directory tree
+	length = strlen(fs_gameDir) + 1;
+
 	dirCount = Sys_RecursiveFindFiles(dir, dirFiles, MAX_FIND_FILES, 0, true, false);
 	for (i = 0; i < dirCount; i++){
 		remove(dirFiles[i]);
+
+		FS_UpdateIndexFile(dirFiles[i] + length);
+
 		FreeString(dirFiles[i]);
 	}
 
@@ -1134,6 +1914,58 @@ char *FS_NextPath (char *prevPath){
 	return NULL;
 }
 
+/*
+ =================
+ FS_MapPack
+
+ Maps the whole pack file so stored files can be handed out in place
+ =================
+*/
+static void FS_MapPack (fsPack_t *pack){
+
+	pack->mapBase = NULL;
+	pack->mapLength = 0;
+	pack->mapRefs = 0;
+
+	if (!fs_mapPacks->integer)
+		return;
+
+	pack->mapBase = Sys_MapFile(pack->name, &pack->mapLength);
+	if (!pack->mapBase)
+		Com_DPrintf("FS_MapPack: couldn't map '%s'\n", pack->name);
+}
+
+/*
+ =================
+ FS_UnmapPack
+ =================
+*/
+static void FS_UnmapPack (fsPack_t *pack){
+
+	fsMappedFile_t	*mappedFile;
+	int				i;
+
+	if (!pack->mapBase)
+		return;
+
+	if (pack->mapRefs)
+		Com_Printf("WARNING: %i files still mapped from '%s'\n", pack->mapRefs, pack->name);
+
+	for (i = 0, mappedFile = fs_mappedFiles; i < MAX_MAPPED_FILES; i++, mappedFile++){
+		if (mappedFile->pack != pack)
+			continue;
+
+		mappedFile->data = NULL;
+		mappedFile->pack = NULL;
+	}
+
+	Sys_UnmapFile(pack->mapBase, pack->mapLength);
+
+	pack->mapBase = NULL;
+	pack->mapLength = 0;
+	pack->mapRefs = 0;
+}
+
 /*
  =================
  FS_LoadPAK
@@ -1178,11 +2010,12 @@ static fsPack_t *FS_LoadPAK (const char *packPath){
 	pack = Z_Malloc(sizeof(fsPack_t));
 
 	Q_strncpyz(pack->name, packPath, sizeof(pack->name));
-	pack->pak = handle;
-	pack->pk2 = NULL;
+	pack->file = handle;
 	pack->numFiles = numFiles;
 	pack->files = packFile;
 
+	FS_MapPack(pack);
+
 	// Parse the directory
 	fseek(handle, header.dirOfs, SEEK_SET);
 
@@ -1192,6 +2025,14 @@ static fsPack_t *FS_LoadPAK (const char *packPath){
 		Q_strncpyz(packFile->name, info.name, sizeof(packFile->name));
 		packFile->size = LittleLong(info.fileLen);
 		packFile->offset = LittleLong(info.filePos);
+		packFile->localOffset = -1;
+		packFile->compressedSize = packFile->size;
+		packFile->deflated = false;
+
+		if (pack->mapBase && packFile->offset >= 0 && packFile->size >= 0 && packFile->offset <= pack->mapLength - packFile->size)
+			packFile->mapOffset = packFile->offset;
+		else
+			packFile->mapOffset = -1;
 
 		// Add to hash table
 		hashKey = Com_HashKey(packFile->name, FILES_HASHSIZE);
@@ -1214,53 +2055,126 @@ static fsPack_t *FS_LoadPAK (const char *packPath){
 
  Loads the header and directory, adding the files at the beginning of
  the list so they override previous pack files.
+ Every file remembers where its local header is, so opening it later
+ doesn't need to search the directory again.
  =================
 */
 static fsPack_t *FS_LoadPK2 (const char *packPath){
 
-	int				numFiles;
+	int				numFiles, length, tailLength;
 	fsPackFile_t	*packFile;
 	fsPack_t		*pack;
-	unzFile			*handle;
-	unz_global_info	global;
-	unz_file_info	info;
-	int				status;
-	char			name[MAX_QPATH];
+	FILE			*handle;
+	byte			*tail, *directory, *end, *entry;
+	int				dirOffset, dirLength;
+	int				flags, method, nameLen;
 	unsigned		hashKey;
+	int				i;
 
-	handle = unzOpen(packPath);
+	handle = fopen(packPath, "rb");
 	if (!handle)
 		Com_Error(ERR_FATAL, "FS_LoadPK2: can't open '%s'", packPath);
 
-	if (unzGetGlobalInfo(handle, &global) != UNZ_OK){
-		unzClose(handle);
+	fseek(handle, 0, SEEK_END);
+	length = ftell(handle);
+
+	// Find the end of central directory record, which may be followed by
+	// a comment of up to 65535 bytes
+	tailLength = length;
+	if (tailLength > ZIP_END_SIZE + 65535)
+		tailLength = ZIP_END_SIZE + 65535;
+
+	if (tailLength < ZIP_END_SIZE){
+		fclose(handle);
+		Com_Error(ERR_FATAL, "FS_LoadPK2: '%s' is not a pack file", packPath);
+	}
+
+	tail = Z_Malloc(tailLength);
+
+	fseek(handle, length - tailLength, SEEK_SET);
+	fread(tail, 1, tailLength, handle);
+
+	for (i = tailLength - ZIP_END_SIZE; i >= 0; i--){
+		if (ZIP_LONG(tail + i) == ZIP_END_SIG)
+			break;
+	}
+
+	if (i < 0){
+		Z_Free(tail);
+		fclose(handle);
 		Com_Error(ERR_FATAL, "FS_LoadPK2: '%s' is not a pack file", packPath);
 	}
 
-	numFiles = global.number_entry;
+	numFiles = ZIP_SHORT(tail + i + 10);
+	dirLength = ZIP_LONG(tail + i + 12);
+	dirOffset = ZIP_LONG(tail + i + 16);
+
+	Z_Free(tail);
+
 	if (numFiles <= 0){
-		unzClose(handle);
+		fclose(handle);
 		Com_Error(ERR_FATAL, "FS_LoadPK2: '%s' is empty", packPath);
 	}
 
+	if (dirOffset < 0 || dirLength < 0 || dirOffset > length - dirLength){
+		fclose(handle);
+		Com_Error(ERR_FATAL, "FS_LoadPK2: '%s' has a bad directory", packPath);
+	}
+
+	// Load the central directory
+	directory = Z_Malloc(dirLength);
+
+	fseek(handle, dirOffset, SEEK_SET);
+	fread(directory, 1, dirLength, handle);
+
 	packFile = Z_Malloc(numFiles * sizeof(fsPackFile_t));
 	pack = Z_Malloc(sizeof(fsPack_t));
 
 	Q_strncpyz(pack->name, packPath, sizeof(pack->name));
-	pack->pak = NULL;
-	pack->pk2 = handle;
-	pack->numFiles = numFiles;
+	pack->file = handle;
+	pack->numFiles = 0;
 	pack->files = packFile;
 
+	FS_MapPack(pack);
+
 	// Parse the directory
-	status = unzGoToFirstFile(handle);
+	entry = directory;
+	end = directory + dirLength;
+
+	for (i = 0; i < numFiles; i++){
+		if (entry + ZIP_CENTRAL_SIZE > end || ZIP_LONG(entry) != ZIP_CENTRAL_SIG)
+			break;
+
+		flags = ZIP_SHORT(entry + 8);
+		method = ZIP_SHORT(entry + 10);
+		nameLen = ZIP_SHORT(entry + 28);
+
+		if (entry + ZIP_CENTRAL_SIZE + nameLen > end)
+			break;
+
+		// Skip anything we can't read
+		if (nameLen >= MAX_QPATH || (flags & 1) || (method != 0 && method != Z_DEFLATED)){
+			Com_DPrintf("FS_LoadPK2: skipping '%.*s' in '%s'\n", nameLen, entry + ZIP_CENTRAL_SIZE, packPath);
+
+			entry += ZIP_CENTRAL_SIZE + nameLen + ZIP_SHORT(entry + 30) + ZIP_SHORT(entry + 32);
+			continue;
+		}
+
+		memcpy(packFile->name, entry + ZIP_CENTRAL_SIZE, nameLen);
+		packFile->name[nameLen] = 0;
 
-	while (status == UNZ_OK){
-		unzGetCurrentFileInfo(handle, &info, name, MAX_QPATH, NULL, 0, NULL, 0);
+		packFile->size = ZIP_LONG(entry + 24);
+		packFile->compressedSize = ZIP_LONG(entry + 20);
+		packFile->deflated = (method == Z_DEFLATED);
+		packFile->offset = -1;
+		packFile->localOffset = ZIP_LONG(entry + 42);
+		packFile->mapOffset = -1;
 
-		Q_strncpyz(packFile->name, name, sizeof(packFile->name));
-		packFile->size = info.uncompressed_size;
-		packFile->offset = -1;		// Not used in ZIP files
+		// Stored files can be handed out from the mapping
+		if (pack->mapBase && !packFile->deflated && FS_PK2DataOffset(pack, packFile)){
+			if (packFile->offset >= 0 && packFile->size >= 0 && packFile->offset <= pack->mapLength - packFile->size)
+				packFile->mapOffset = packFile->offset;
+		}
 
 		// Add to hash table
 		hashKey = Com_HashKey(packFile->name, FILES_HASHSIZE);
@@ -1269,11 +2183,17 @@ static fsPack_t *FS_LoadPK2 (const char *packPath){
 		pack->filesHash[hashKey] = packFile;
 
 		// Go to next file
-		packFile++;
+		entry += ZIP_CENTRAL_SIZE + nameLen + ZIP_SHORT(entry + 30) + ZIP_SHORT(entry + 32);
 
-		status = unzGoToNextFile(handle);
+		packFile++;
+		pack->numFiles++;
 	}
 
+	Z_Free(directory);
+
+	if (i != numFiles)
+		Com_Printf("WARNING: '%s' has a truncated directory\n", packPath);
+
 	return pack;
 }
 
@@ -1409,13 +2329,18 @@ void FS_Path_f (void){
 
 	fsSearchPath_t	*search;
 	fsHandle_t		*handle;
+	qboolean		indexed;
+	int				numEntries, lookups, misses;
 	int				i, totalFiles = 0;
 
 	Com_Printf("Current search path:\n");
 	
 	for (search = fs_searchPaths; search; search = search->next){
 		if (search->pack){
-			Com_Printf("%s (%i files)\n", search->pack->name, search->pack->numFiles);
+			if (search->pack->mapBase)
+				Com_Printf("%s (%i files, mapped)\n", search->pack->name, search->pack->numFiles);
+			else
+				Com_Printf("%s (%i files)\n", search->pack->name, search->pack->numFiles);
 			totalFiles += search->pack->numFiles;
 		}
 		else
@@ -1447,6 +2372,18 @@ void FS_Path_f (void){
 
 	Com_Printf("----------------------\n");
 	Com_Printf("%i files in PAK/PK2 files\n", totalFiles);
+
+	Sys_LockMutex(fs_lock);
+	indexed = fs_index.valid;
+	numEntries = fs_index.numEntries;
+	lookups = fs_index.lookups;
+	misses = fs_index.misses;
+	Sys_UnlockMutex(fs_lock);
+
+	if (indexed)
+		Com_Printf("%i files indexed, %i lookups, %i misses\n", numEntries, lookups, misses);
+	else
+		Com_Printf("path index disabled\n");
 }
 
 /*
@@ -1458,6 +2395,9 @@ static void FS_Startup (void){
 
 	Com_Printf("----- FS_Startup -----\n");
 
+	// Don't let the loader threads read from the old search path
+	Com_FlushLoads();
+
 	// Add the directories
 	FS_AddGameDirectory(fs_cdPath->string);
 	FS_AddGameDirectory(fs_basePath->string);
@@ -1479,6 +2419,9 @@ static void FS_Startup (void){
 	// Set the current game
 	Q_strncpyz(fs_curGame, fs_game->string, sizeof(fs_curGame));
 
+	// Index everything in the new search path
+	FS_BuildIndex();
+
 	FS_Path_f();
 }
 
@@ -1514,10 +2457,16 @@ void FS_Init (void){
 	fs_baseGame = Cvar_Get("fs_baseGame", BASEDIRNAME, CVAR_INIT);
 	fs_game = Cvar_Get("fs_game", BASEDIRNAME, CVAR_SERVERINFO | CVAR_INIT);
 	fs_debug = Cvar_Get("fs_debug", "0", 0);
+	fs_mapPacks = Cvar_Get("fs_mapPacks", "1", CVAR_INIT);
+	fs_pathIndex = Cvar_Get("fs_pathIndex", "1", CVAR_INIT);
+
+	if (!fs_lock)
+		fs_lock = Sys_CreateMutex();
 
 	Cmd_AddCommand("dir", FS_Dir_f);
 	Cmd_AddCommand("fdir", FS_FDir_f);
 	Cmd_AddCommand("path", FS_Path_f);
+	Cmd_AddCommand("fs_rescan", FS_Rescan_f);
 
 	// Add the directories
 	FS_Startup();
@@ -1548,6 +2497,9 @@ void FS_Shutdown (void){
 	Cmd_RemoveCommand("dir");
 	Cmd_RemoveCommand("fdir");
 	Cmd_RemoveCommand("path");
+	Cmd_RemoveCommand("fs_rescan");
+
+	Com_FlushLoads();
 
 	// Close all files
 	for (i = 0, handle = fs_handles; i < MAX_HANDLES; i++, handle++){
@@ -1556,23 +2508,23 @@ void FS_Shutdown (void){
 
 		if (handle->file)
 			fclose(handle->file);
-		else if (handle->zip){
-			unzCloseCurrentFile(handle->zip);
-			unzClose(handle->zip);
-		}
+		else if (handle->pack)
+			FS_ClosePackFile(handle);
 
 		memset(handle, 0, sizeof(*handle));
 	}
 
+	// Free the path index before the pack files it points into
+	FS_FreeIndex();
+
 	// Free search paths
 	while (fs_searchPaths){
 		if (fs_searchPaths->pack){
 			pack = fs_searchPaths->pack;
 
-			if (pack->pak)
-				fclose(pack->pak);
-			else if (pack->pk2)
-				unzClose(pack->pk2);
+			FS_UnmapPack(pack);
+
+			fclose(pack->file);
 
 			Z_Free(pack->files);
 			Z_Free(pack);
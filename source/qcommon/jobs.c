@@ -0,0 +1,207 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+// jobs.c -- worker thread pool
+
+
+#include "qcommon.h"
+
+
+#define MAX_JOB_THREADS		15
+
+typedef struct {
+	jobFunc_t		function;
+	void			*data;
+	int				count;
+	volatile int	next;						// Next index to be claimed
+} jobBatch_t;
+
+static void			*com_jobThreadHandles[MAX_JOB_THREADS];
+static int			com_numJobThreadHandles;
+
+static void			*com_jobStart;				// Posted once per worker for every batch
+static void			*com_jobDone;				// Posted by every worker when it's done
+static qboolean		com_jobsActive;
+static volatile int	com_jobsQuit;
+
+static jobBatch_t	com_jobBatch;
+
+cvar_t				*com_jobThreads;
+
+
+/*
+ =================
+ Com_ProcessJobs
+
+ Claims indices from the current batch until there are none left
+ =================
+*/
+static void Com_ProcessJobs (void){
+
+	int		index;
+
+	while (1){
+		index = Sys_AtomicAdd(&com_jobBatch.next, 1) - 1;
+		if (index >= com_jobBatch.count)
+			break;
+
+		com_jobBatch.function(com_jobBatch.data, index);
+	}
+}
+
+/*
+ =================
+ Com_JobThread
+ =================
+*/
+static void Com_JobThread (void *data){
+
+	while (1){
+		Sys_WaitSemaphore(com_jobStart);
+
+		if (com_jobsQuit)
+			break;
+
+		Com_ProcessJobs();
+
+		Sys_PostSemaphore(com_jobDone, 1);
+	}
+}
+
+/*
+ =================
+ Com_RunJobs
+ =================
+*/
+void Com_RunJobs (jobFunc_t function, void *data, int count){
+
+	int		i, workers;
+
+	if (count <= 0)
+		return;
+
+	// Run it on this thread if there is nothing to gain, or if we were
+	// called from inside another job
+	if (!com_numJobThreadHandles || count == 1 || com_jobsActive){
+		for (i = 0; i < count; i++)
+			function(data, i);
+
+		return;
+	}
+
+	com_jobsActive = true;
+
+	com_jobBatch.function = function;
+	com_jobBatch.data = data;
+	com_jobBatch.count = count;
+	com_jobBatch.next = 0;
+
+	// Wake up as many workers as can be kept busy
+	workers = com_numJobThreadHandles;
+	if (workers > count - 1)
+		workers = count - 1;
+
+	Sys_PostSemaphore(com_jobStart, workers);
+
+	// Help out while waiting
+	Com_ProcessJobs();
+
+	for (i = 0; i < workers; i++)
+		Sys_WaitSemaphore(com_jobDone);
+
+	com_jobsActive = false;
+}
+
+/*
+ =================
+ Com_NumJobThreads
+ =================
+*/
+int Com_NumJobThreads (void){
+
+	return com_numJobThreadHandles + 1;
+}
+
+/*
+ =================
+ Com_InitJobs
+ =================
+*/
+void Com_InitJobs (void){
+
+	int		i, numThreads;
+
+	com_jobThreads = Cvar_Get("com_jobThreads", "-1", CVAR_ARCHIVE | CVAR_LATCH);
+
+	// A negative value means one worker for every additional processor
+	if (com_jobThreads->integer < 0)
+		numThreads = Sys_NumProcessors() - 1;
+	else
+		numThreads = com_jobThreads->integer;
+
+	if (numThreads > MAX_JOB_THREADS)
+		numThreads = MAX_JOB_THREADS;
+
+	com_numJobThreadHandles = 0;
+	com_jobsActive = false;
+	com_jobsQuit = 0;
+
+	if (numThreads <= 0)
+		return;
+
+	com_jobStart = Sys_CreateSemaphore(0);
+	com_jobDone = Sys_CreateSemaphore(0);
+
+	for (i = 0; i < numThreads; i++){
+		com_jobThreadHandles[i] = Sys_CreateThread(Com_JobThread, NULL);
+		if (!com_jobThreadHandles[i])
+			break;
+
+		com_numJobThreadHandles++;
+	}
+
+	Com_Printf("Using %i job threads\n", com_numJobThreadHandles + 1);
+}
+
+/*
+ =================
+ Com_ShutdownJobs
+ =================
+*/
+void Com_ShutdownJobs (void){
+
+	int		i;
+
+	if (!com_numJobThreadHandles)
+		return;
+
+	com_jobsQuit = 1;
+
+	Sys_PostSemaphore(com_jobStart, com_numJobThreadHandles);
+
+	for (i = 0; i < com_numJobThreadHandles; i++)
+		Sys_WaitForThread(com_jobThreadHandles[i]);
+
+	Sys_DestroySemaphore(com_jobStart);
+	Sys_DestroySemaphore(com_jobDone);
+
+	com_numJobThreadHandles = 0;
+}
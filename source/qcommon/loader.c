@@ -0,0 +1,424 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// loader.c -- background file loader
+
+
+#include "qcommon.h"
+
+
+#define MAX_LOADER_THREADS		4
+#define MAX_LOADS				1024
+#define LOADS_HASHSIZE			256
+
+typedef enum {
+	LOAD_FREE,
+	LOAD_QUEUED,
+	LOAD_RUNNING,
+	LOAD_DONE
+} loadState_t;
+
+typedef struct load_s {
+	loadState_t		state;
+	char			name[MAX_QPATH];
+	int				priority;
+	int				sequence;					// Keeps the queue order within a priority
+	loadFunc_t		load;
+	freeFunc_t		free;
+
+	void			*data;
+	int				size;
+
+	struct load_s	*nextHash;
+} load_t;
+
+static void			*com_loaderThreadHandles[MAX_LOADER_THREADS];
+static int			com_numLoaderThreadHandles;
+
+static void			*com_loadLock;				// Protects everything below
+static void			*com_loadQueued;			// Posted once for every queued load
+static void			*com_loadDone;				// Posted whenever a load finishes
+static volatile int	com_loaderQuit;
+
+static load_t		com_loads[MAX_LOADS];
+static load_t		*com_loadsHash[LOADS_HASHSIZE];
+static volatile int	com_numLoads;
+static int			com_loadSequence;
+
+static int			com_loadsFinished;			// Statistics for Com_FlushLoads
+static int			com_loadsClaimed;
+
+cvar_t				*com_loaderThreads;
+
+
+/*
+ =================
+ Com_FindLoad
+ =================
+*/
+static load_t *Com_FindLoad (const char *name, loadFunc_t load){
+
+	load_t		*l;
+	unsigned	hashKey;
+
+	hashKey = Com_HashKey(name, LOADS_HASHSIZE);
+
+	for (l = com_loadsHash[hashKey]; l; l = l->nextHash){
+		if (l->load == load && !Q_stricmp(l->name, name))
+			return l;
+	}
+
+	return NULL;
+}
+
+/*
+ =================
+ Com_FreeLoad
+
+ Releases the slot, but not the data
+ =================
+*/
+static void Com_FreeLoad (load_t *load){
+
+	load_t		**prev;
+	unsigned	hashKey;
+
+	hashKey = Com_HashKey(load->name, LOADS_HASHSIZE);
+
+	for (prev = &com_loadsHash[hashKey]; *prev; prev = &(*prev)->nextHash){
+		if (*prev == load){
+			*prev = load->nextHash;
+			break;
+		}
+	}
+
+	memset(load, 0, sizeof(load_t));
+
+	com_numLoads--;
+}
+
+/*
+ =================
+ Com_NextLoad
+
+ Returns the queued load with the highest priority, or NULL if the main
+ thread took all of them
+ =================
+*/
+static load_t *Com_NextLoad (void){
+
+	load_t	*l, *best = NULL;
+	int		i;
+
+	for (i = 0, l = com_loads; i < MAX_LOADS; i++, l++){
+		if (l->state != LOAD_QUEUED)
+			continue;
+
+		if (!best || l->priority > best->priority || (l->priority == best->priority && l->sequence < best->sequence))
+			best = l;
+	}
+
+	return best;
+}
+
+/*
+ =================
+ Com_LoaderThread
+ =================
+*/
+static void Com_LoaderThread (void *data){
+
+	load_t	*load;
+
+	while (1){
+		Sys_WaitSemaphore(com_loadQueued);
+
+		if (com_loaderQuit)
+			break;
+
+		Sys_LockMutex(com_loadLock);
+
+		load = Com_NextLoad();
+		if (load)
+			load->state = LOAD_RUNNING;
+
+		Sys_UnlockMutex(com_loadLock);
+
+		if (!load)
+			continue;
+
+		// Nobody else touches a running load, so this can be done
+		// without holding the lock
+		if (load->load)
+			load->data = load->load(load->name, &load->size);
+		else
+			load->size = FS_LoadFile(load->name, &load->data);
+
+		Sys_LockMutex(com_loadLock);
+
+		load->state = LOAD_DONE;
+		com_loadsFinished++;
+
+		Sys_UnlockMutex(com_loadLock);
+
+		Sys_PostSemaphore(com_loadDone, 1);
+	}
+}
+
+/*
+ =================
+ Com_QueueLoad
+ =================
+*/
+void Com_QueueLoad (const char *name, int priority, loadFunc_t load, freeFunc_t free){
+
+	load_t		*l;
+	unsigned	hashKey;
+	int			i;
+
+	if (!com_numLoaderThreadHandles)
+		return;
+
+	if (!name || !name[0] || strlen(name) >= MAX_QPATH)
+		return;
+
+	Sys_LockMutex(com_loadLock);
+
+	// Already queued, but it may be more urgent now
+	l = Com_FindLoad(name, load);
+	if (l){
+		if (l->priority < priority)
+			l->priority = priority;
+
+		Sys_UnlockMutex(com_loadLock);
+		return;
+	}
+
+	// Find a free slot, otherwise it will be loaded when it's needed
+	for (i = 0, l = com_loads; i < MAX_LOADS; i++, l++){
+		if (l->state == LOAD_FREE)
+			break;
+	}
+
+	if (i == MAX_LOADS){
+		Sys_UnlockMutex(com_loadLock);
+		return;
+	}
+
+	l->state = LOAD_QUEUED;
+	Q_strncpyz(l->name, name, sizeof(l->name));
+	l->priority = priority;
+	l->sequence = com_loadSequence++;
+	l->load = load;
+	l->free = free;
+	l->data = NULL;
+	l->size = -1;
+
+	// Add to hash table
+	hashKey = Com_HashKey(l->name, LOADS_HASHSIZE);
+
+	l->nextHash = com_loadsHash[hashKey];
+	com_loadsHash[hashKey] = l;
+
+	com_numLoads++;
+
+	Sys_UnlockMutex(com_loadLock);
+
+	Sys_PostSemaphore(com_loadQueued, 1);
+}
+
+/*
+ =================
+ Com_FinishLoad
+ =================
+*/
+qboolean Com_FinishLoad (const char *name, loadFunc_t load, void **data, int *size){
+
+	load_t	*l;
+
+	// Loader threads never wait for each other
+	if (!com_numLoads || !Sys_IsMainThread())
+		return false;
+
+	Sys_LockMutex(com_loadLock);
+
+	l = Com_FindLoad(name, load);
+	if (!l){
+		Sys_UnlockMutex(com_loadLock);
+		return false;
+	}
+
+	// If nobody started it yet, loading it right away is faster than
+	// waiting for a loader thread
+	if (l->state == LOAD_QUEUED){
+		Com_FreeLoad(l);
+
+		Sys_UnlockMutex(com_loadLock);
+		return false;
+	}
+
+	while (l->state == LOAD_RUNNING){
+		Sys_UnlockMutex(com_loadLock);
+		Sys_WaitSemaphore(com_loadDone);
+		Sys_LockMutex(com_loadLock);
+	}
+
+	*data = l->data;
+	if (size)
+		*size = l->size;
+
+	com_loadsClaimed++;
+
+	Com_FreeLoad(l);
+
+	Sys_UnlockMutex(com_loadLock);
+
+	return true;
+}
+
+/*
+ =================
+ Com_FlushLoads
+ =================
+*/
+void Com_FlushLoads (void){
+
+	load_t	*l;
+	int		i, running;
+
+	if (!com_numLoaderThreadHandles)
+		return;
+
+	Sys_LockMutex(com_loadLock);
+
+	while (1){
+		running = 0;
+
+		for (i = 0, l = com_loads; i < MAX_LOADS; i++, l++){
+			if (l->state == LOAD_FREE)
+				continue;
+
+			if (l->state == LOAD_RUNNING){
+				running++;
+				continue;
+			}
+
+			if (l->state == LOAD_DONE && l->data){
+				if (l->free)
+					l->free(l->data);
+				else
+					FS_FreeFile(l->data);
+			}
+
+			Com_FreeLoad(l);
+		}
+
+		if (!running)
+			break;
+
+		// Wait for the loads that are still running
+		Sys_UnlockMutex(com_loadLock);
+		Sys_WaitSemaphore(com_loadDone);
+		Sys_LockMutex(com_loadLock);
+	}
+
+	if (com_loadsFinished)
+		Com_DPrintf("Com_FlushLoads: %i files loaded in the background, %i used\n", com_loadsFinished, com_loadsClaimed);
+
+	com_loadsFinished = 0;
+	com_loadsClaimed = 0;
+
+	Sys_UnlockMutex(com_loadLock);
+}
+
+/*
+ =================
+ Com_InitLoader
+ =================
+*/
+void Com_InitLoader (void){
+
+	int		i, numThreads;
+
+	com_loaderThreads = Cvar_Get("com_loaderThreads", "-1", CVAR_ARCHIVE | CVAR_LATCH);
+
+	com_numLoaderThreadHandles = 0;
+	com_loaderQuit = 0;
+
+	// A dedicated server loads nothing worth the threads
+	if (dedicated->integer)
+		return;
+
+	// A negative value means one thread for every processor
+	if (com_loaderThreads->integer < 0)
+		numThreads = Sys_NumProcessors();
+	else
+		numThreads = com_loaderThreads->integer;
+
+	if (numThreads > MAX_LOADER_THREADS)
+		numThreads = MAX_LOADER_THREADS;
+
+	if (numThreads <= 0)
+		return;
+
+	com_loadLock = Sys_CreateMutex();
+	com_loadQueued = Sys_CreateSemaphore(0);
+	com_loadDone = Sys_CreateSemaphore(0);
+
+	for (i = 0; i < numThreads; i++){
+		com_loaderThreadHandles[i] = Sys_CreateThread(Com_LoaderThread, NULL);
+		if (!com_loaderThreadHandles[i])
+			break;
+
+		com_numLoaderThreadHandles++;
+	}
+
+	Com_Printf("Using %i loader threads\n", com_numLoaderThreadHandles);
+}
+
+/*
+ =================
+ Com_ShutdownLoader
+ =================
+*/
+void Com_ShutdownLoader (void){
+
+	int		i;
+
+	if (!com_numLoaderThreadHandles)
+		return;
+
+	Com_FlushLoads();
+
+	com_loaderQuit = 1;
+
+	Sys_PostSemaphore(com_loadQueued, com_numLoaderThreadHandles);
+
+	for (i = 0; i < com_numLoaderThreadHandles; i++)
+		Sys_WaitForThread(com_loaderThreadHandles[i]);
+
+	Sys_DestroySemaphore(com_loadQueued);
+	Sys_DestroySemaphore(com_loadDone);
+	Sys_DestroyMutex(com_loadLock);
+
+	com_numLoaderThreadHandles = 0;
+}
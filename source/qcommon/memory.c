@@ -34,36 +34,70 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
  The zone calls are pretty much only used for small strings and 
  structures, all big things are allocated on the hunk.
+
+ Small allocations don't go through the rover. They are served from
+ slabs of fixed size blocks, one free list per size class, which are
+ carved out of zone blocks and never given back to the zone.
+
+ Every allocated block is also linked into a list by tag, so Z_FreeTags
+ doesn't have to walk the whole zone.
  =======================================================================
 */
 
-#define MIN_ZONE_MEGS	16
-#define MIN_ZONE_SIZE	16 << 20
+#define MIN_ZONE_MEGS		16
+#define MIN_ZONE_SIZE		16 << 20
+
+#define SMALLZONE_SIZE		0x400000
 
-#define SMALLZONE_SIZE	0x400000
+#define ZONEID				0x1d4a11
+#define SLABID				0x1d4a12
+#define MINFRAGMENT			64
 
-#define ZONEID			0x1d4a11
-#define MINFRAGMENT		64
+#define SLAB_TAG			0x7fffffff	// Zone tag of the slab pages
+#define SLAB_PAGE_SIZE		16384
+#define NUM_SLAB_CLASSES	8
+
+#define TAG_HASH_SIZE		64
 
 typedef struct memBlock_s {
-	struct		memBlock_s *next, *prev;
-	int			size;				// Including the header and possibly tiny fragments
-	int			tag;				// A tag of 0 is a free block
-	int			id;					// Should be ZONEID
-	struct		memZone_s *zone;	// Zone containing this block
+	struct		memBlock_s *next, *prev;		// Zone order, or the free list for slab blocks
+	struct		memBlock_s *tagNext, *tagPrev;	// Blocks in the same tag list
+	struct		memZone_s *zone;				// Zone containing this block
+	int			size;							// Including the header and possibly tiny fragments
+	int			tag;							// A tag of 0 is a free block
+	int			id;								// Should be ZONEID or SLABID
+	int			slabClass;						// -1 if not a slab block
 } memBlock_t;
 
+typedef struct {
+	memBlock_t	*freeList;
+	int			pages;
+} memSlab_t;
+
 typedef struct memZone_s {
 	int			size;				// Total bytes malloced, including header
 	int			bytes;				// Total bytes in use
 	int			blocks;				// Total blocks in use
 	memBlock_t	blockList;			// Start/end cap for linked list
 	memBlock_t	*rover;
+
+	memSlab_t	slabs[NUM_SLAB_CLASSES];
+	int			slabBytes;			// Total bytes in use by slab blocks
+	int			slabBlocks;			// Total slab blocks in use
+	int			slabPageBytes;		// Total bytes taken from the zone by slabs
 } memZone_t;
 
+// Usable bytes of the size classes. The blocks are bigger by the header
+// and trash tester, which would take most of a small class otherwise
+static const int	z_slabSizes[NUM_SLAB_CLASSES] = {16, 32, 64, 96, 128, 256, 512, 960};
+
+static memBlock_t	z_tagLists[TAG_HASH_SIZE];	// Start/end caps for the tag lists
+
 static memZone_t	*smallZone;
 static memZone_t	*mainZone;
 
+static void			*z_lock;					// The loader threads allocate too
+
 
 /*
  =================
@@ -90,6 +124,56 @@ void Z_ClearZone (memZone_t *zone, int size){
 	block->tag = 0;				// Free block
 	block->id = ZONEID;
 	block->zone = zone;
+	block->slabClass = -1;
+
+	memset(zone->slabs, 0, sizeof(zone->slabs));
+	zone->slabBytes = 0;
+	zone->slabBlocks = 0;
+	zone->slabPageBytes = 0;
+}
+
+/*
+ =================
+ Z_InitTagLists
+ =================
+*/
+static void Z_InitTagLists (void){
+
+	int		i;
+
+	for (i = 0; i < TAG_HASH_SIZE; i++)
+		z_tagLists[i].tagNext = z_tagLists[i].tagPrev = &z_tagLists[i];
+}
+
+/*
+ =================
+ Z_LinkTag
+ =================
+*/
+static void Z_LinkTag (memBlock_t *block){
+
+	memBlock_t	*list;
+
+	list = &z_tagLists[block->tag & (TAG_HASH_SIZE-1)];
+
+	block->tagNext = list->tagNext;
+	block->tagPrev = list;
+
+	list->tagNext->tagPrev = block;
+	list->tagNext = block;
+}
+
+/*
+ =================
+ Z_UnlinkTag
+ =================
+*/
+static void Z_UnlinkTag (memBlock_t *block){
+
+	block->tagPrev->tagNext = block->tagNext;
+	block->tagNext->tagPrev = block->tagPrev;
+
+	block->tagNext = block->tagPrev = NULL;
 }
 
 /*
@@ -137,49 +221,26 @@ void *Z_MallocSmall (int size){
 
 /*
  =================
- Z_TagMalloc
+ Z_ZoneAlloc
+
+ Finds a free block of the given total size with the rover, returns NULL
+ if there is none. The caller must hold z_lock, so it has to release it
+ before reporting the error
  =================
 */
-void *Z_TagMalloc (int size, int tag){
+static memBlock_t *Z_ZoneAlloc (memZone_t *zone, int size, int tag){
 
-	memZone_t	*zone;
 	memBlock_t	*start, *rover, *block, *fragment;
-	void		*ptr;
 	int			extra;
 
-	// If main zone is not initialized or tag is -1 use the small zone
-	if (mainZone == NULL || tag == -1)
-		zone = smallZone;
-	else
-		zone = mainZone;
-
-	// Debug tool for memory integrity checking
-	if (com_debugMemory && com_debugMemory->integer)
-		Z_CheckHeap(zone);
-
-	if (size < 0)
-		Com_Error(ERR_FATAL, "Z_TagMalloc: size < 0");
-
-	if (!tag)
-		Com_Error(ERR_FATAL, "Z_TagMalloc: tried to use a 0 tag");
-
-	size += sizeof(memBlock_t);		// Account for size of block header
-	size += sizeof(int);			// Space for memory trash tester
-	size = (size + 7) & ~7;			// Align to 8-byte boundary
-
 	// Scan through the block list looking for the first free block of
 	// sufficient size
 	block = rover = zone->rover;
 	start = block->prev;
 
 	do {
-		if (rover == start){
-			// Scanned all the way around the list
-			if (zone == smallZone)
-				Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %i bytes from the small zone", size);
-			else
-				Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %i bytes from the main zone", size);
-		}
+		if (rover == start)
+			return NULL;	// Scanned all the way around the list
 
 		if (rover->tag)
 			block = rover = rover->next;
@@ -196,6 +257,7 @@ void *Z_TagMalloc (int size, int tag){
 		fragment->tag = 0;
 		fragment->id = ZONEID;
 		fragment->zone = zone;
+		fragment->slabClass = -1;
 		fragment->prev = block;
 		fragment->next = block->next;
 		fragment->next->prev = fragment;
@@ -214,10 +276,134 @@ void *Z_TagMalloc (int size, int tag){
 	block->tag = tag;		// No longer a free block
 	block->id = ZONEID;
 	block->zone = zone;
+	block->slabClass = -1;
 
 	// Marker for memory trash testing
 	*(int *)((byte *)block + block->size - sizeof(int)) = ZONEID;
 
+	return block;
+}
+
+/*
+ =================
+ Z_SlabAlloc
+
+ Takes a block from the free list of the given size class, carving a new
+ page out of the zone if the list is empty. Returns NULL if the zone is
+ out of memory
+ =================
+*/
+static memBlock_t *Z_SlabAlloc (memZone_t *zone, int slabClass, int tag){
+
+	memSlab_t	*slab = &zone->slabs[slabClass];
+	memBlock_t	*page, *block;
+	byte		*data;
+	int			i, size, count;
+
+	if (!slab->freeList){
+		page = Z_ZoneAlloc(zone, SLAB_PAGE_SIZE, SLAB_TAG);
+		if (!page)
+			return NULL;
+
+		slab->pages++;
+		zone->slabPageBytes += page->size;
+
+		size = (z_slabSizes[slabClass] + sizeof(memBlock_t) + sizeof(int) + 7) & ~7;
+		count = (page->size - sizeof(memBlock_t) - sizeof(int)) / size;
+
+		data = (byte *)page + sizeof(memBlock_t);
+
+		for (i = count - 1; i >= 0; i--){
+			block = (memBlock_t *)(data + i * size);
+
+			block->size = size;
+			block->tag = 0;
+			block->id = SLABID;
+			block->zone = zone;
+			block->slabClass = slabClass;
+			block->prev = NULL;
+			block->tagNext = block->tagPrev = NULL;
+
+			block->next = slab->freeList;
+			slab->freeList = block;
+		}
+	}
+
+	block = slab->freeList;
+	slab->freeList = block->next;
+
+	block->next = NULL;
+	block->tag = tag;
+
+	// Increment counters
+	zone->slabBytes += block->size;
+	zone->slabBlocks++;
+
+	// Marker for memory trash testing
+	*(int *)((byte *)block + block->size - sizeof(int)) = SLABID;
+
+	return block;
+}
+
+/*
+ =================
+ Z_TagMalloc
+ =================
+*/
+void *Z_TagMalloc (int size, int tag){
+
+	memZone_t	*zone;
+	memBlock_t	*block;
+	void		*ptr;
+	int			i;
+
+	// If main zone is not initialized or tag is -1 use the small zone
+	if (mainZone == NULL || tag == -1)
+		zone = smallZone;
+	else
+		zone = mainZone;
+
+	// Debug tool for memory integrity checking
+	if (com_debugMemory && com_debugMemory->integer)
+		Z_CheckHeap(zone);
+
+	if (size < 0)
+		Com_Error(ERR_FATAL, "Z_TagMalloc: size < 0");
+
+	if (!tag || tag == SLAB_TAG)
+		Com_Error(ERR_FATAL, "Z_TagMalloc: tried to use a %i tag", tag);
+
+	// Find the smallest size class that fits, if any
+	for (i = 0; i < NUM_SLAB_CLASSES; i++){
+		if (size <= z_slabSizes[i])
+			break;
+	}
+
+	size += sizeof(memBlock_t);		// Account for size of block header
+	size += sizeof(int);			// Space for memory trash tester
+	size = (size + 7) & ~7;			// Align to 8-byte boundary
+
+	if (z_lock)
+		Sys_LockMutex(z_lock);
+
+	if (i != NUM_SLAB_CLASSES)
+		block = Z_SlabAlloc(zone, i, tag);
+	else
+		block = Z_ZoneAlloc(zone, size, tag);
+
+	if (block)
+		Z_LinkTag(block);
+
+	if (z_lock)
+		Sys_UnlockMutex(z_lock);
+
+	if (!block){
+		if (zone == smallZone)
+			Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %i bytes from the small zone", size);
+		else
+			Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %i bytes from the main zone", size);
+	}
+
 	// Return 0 filled memory
 	ptr = (void *)((byte *)block + sizeof(memBlock_t));
 	memset(ptr, 0, block->size - sizeof(memBlock_t) - sizeof(int));
@@ -227,31 +413,33 @@ void *Z_TagMalloc (int size, int tag){
 
 /*
  =================
- Z_Free
+ Z_FreeBlock
+
+ The caller must hold z_lock
  =================
 */
-void Z_Free (void *ptr){
+static void Z_FreeBlock (memBlock_t *block){
 
 	memZone_t	*zone;
-	memBlock_t	*block, *other;
+	memBlock_t	*other;
 
-	if (!ptr)
-		Com_Error(ERR_FATAL, "Z_Free: NULL pointer");
+	zone = block->zone;
 
-	block = (memBlock_t *)((byte *)ptr - sizeof(memBlock_t));
+	Z_UnlinkTag(block);
 
-	// Memory trash test
-	if (*(int *)((byte *)block + block->size - sizeof(int)) != ZONEID)
-		Com_Error(ERR_FATAL, "Z_Free: trashed memory block");
+	if (block->id == SLABID){
+		// Decrement counters
+		zone->slabBytes -= block->size;
+		zone->slabBlocks--;
 
-	if (block->zone != smallZone && block->zone != mainZone)
-		Com_Error(ERR_FATAL, "Z_Free: freed a pointer with invalid zone");
-	if (block->id != ZONEID)
-		Com_Error(ERR_FATAL, "Z_Free: freed a pointer without ZONEID");
-	if (!block->tag)
-		Com_Error(ERR_FATAL, "Z_Free: freed a freed pointer");
+		block->tag = 0;			// Mark as free
 
-	zone = block->zone;
+		// Back on the free list of the size class
+		block->next = zone->slabs[block->slabClass].freeList;
+		zone->slabs[block->slabClass].freeList = block;
+
+		return;
+	}
 
 	// Decrement counters
 	zone->bytes -= block->size;
@@ -284,6 +472,43 @@ void Z_Free (void *ptr){
 	}
 }
 
+/*
+ =================
+ Z_Free
+ =================
+*/
+void Z_Free (void *ptr){
+
+	memBlock_t	*block;
+
+	if (!ptr)
+		Com_Error(ERR_FATAL, "Z_Free: NULL pointer");
+
+	block = (memBlock_t *)((byte *)ptr - sizeof(memBlock_t));
+
+	if (block->id != ZONEID && block->id != SLABID)
+		Com_Error(ERR_FATAL, "Z_Free: freed a pointer without ZONEID");
+
+	// Memory trash test
+	if (*(int *)((byte *)block + block->size - sizeof(int)) != block->id)
+		Com_Error(ERR_FATAL, "Z_Free: trashed memory block");
+
+	if (block->zone != smallZone && block->zone != mainZone)
+		Com_Error(ERR_FATAL, "Z_Free: freed a pointer with invalid zone");
+	if (!block->tag)
+		Com_Error(ERR_FATAL, "Z_Free: freed a freed pointer");
+	if (block->tag == SLAB_TAG)
+		Com_Error(ERR_FATAL, "Z_Free: freed a slab page");
+
+	if (z_lock)
+		Sys_LockMutex(z_lock);
+
+	Z_FreeBlock(block);
+
+	if (z_lock)
+		Sys_UnlockMutex(z_lock);
+}
+
 /*
  =================
  Z_FreeTags
@@ -291,23 +516,23 @@ void Z_Free (void *ptr){
 */
 void Z_FreeTags (int tag){
 
-	memBlock_t	*block, *next;
+	memBlock_t	*list, *block, *next;
 
-	for (block = smallZone->blockList.next; block->next != &smallZone->blockList; block = next){
-		// Grab next now, so if the block is freed we still have it
-		next = block->next;
+	list = &z_tagLists[tag & (TAG_HASH_SIZE-1)];
 
-		if (block->tag == tag)
-			Z_Free((void *)((byte *)block + sizeof(memBlock_t)));
-	}
+	if (z_lock)
+		Sys_LockMutex(z_lock);
 
-	for (block = mainZone->blockList.next; block->next != &mainZone->blockList; block = next){
+	for (block = list->tagNext; block != list; block = next){
 		// Grab next now, so if the block is freed we still have it
-		next = block->next;
+		next = block->tagNext;
 
 		if (block->tag == tag)
-			Z_Free((void *)((byte *)block + sizeof(memBlock_t)));
+			Z_FreeBlock(block);
 	}
+
+	if (z_lock)
+		Sys_UnlockMutex(z_lock);
 }
 
 
@@ -595,9 +820,13 @@ void Com_MemInfo_f (void){
 	Com_Printf("\n");
 	Com_Printf("%9i bytes (%6.2f MB) in %i main zone blocks\n", mainZone->bytes, mainZone->bytes * MEGS_DIV, mainZone->blocks);
 	Com_Printf("%9i bytes (%6.2f MB) free main zone\n", mainZone->size - mainZone->bytes, (mainZone->size - mainZone->bytes) * MEGS_DIV);
+	Com_Printf("%9i bytes (%6.2f MB) main zone slab pages\n", mainZone->slabPageBytes, mainZone->slabPageBytes * MEGS_DIV);
+	Com_Printf("%9i bytes (%6.2f MB) in %i main zone slab blocks\n", mainZone->slabBytes, mainZone->slabBytes * MEGS_DIV, mainZone->slabBlocks);
 	Com_Printf("\n");
 	Com_Printf("%9i bytes (%6.2f MB) in %i small zone blocks\n", smallZone->bytes, smallZone->bytes * MEGS_DIV, smallZone->blocks);
 	Com_Printf("%9i bytes (%6.2f MB) free small zone\n", smallZone->size - smallZone->bytes, (smallZone->size - smallZone->bytes) * MEGS_DIV);
+	Com_Printf("%9i bytes (%6.2f MB) small zone slab pages\n", smallZone->slabPageBytes, smallZone->slabPageBytes * MEGS_DIV);
+	Com_Printf("%9i bytes (%6.2f MB) in %i small zone slab blocks\n", smallZone->slabBytes, smallZone->slabBytes * MEGS_DIV, smallZone->slabBlocks);
 	Com_Printf("\n");
 }
 
@@ -666,6 +895,9 @@ void Com_InitMemory (void){
 			Com_Error(ERR_FATAL, "Com_InitMemory: insufficient memory");
 
 		Z_ClearZone(smallZone, SMALLZONE_SIZE);
+		Z_InitTagLists();
+
+		z_lock = Sys_CreateMutex();
 		return;
 	}
 
@@ -723,6 +955,11 @@ void Com_InitMemory (void){
 */
 void Com_ShutdownMemory (void){
 
+	if (z_lock){
+		Sys_DestroyMutex(z_lock);
+		z_lock = NULL;
+	}
+
 	if (smallZone)
 		free(smallZone);
 	
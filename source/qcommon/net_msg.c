@@ -508,6 +508,169 @@ void MSG_WriteDeltaEntity (msg_t *msg, const entity_state_t *from, const entity_
 		MSG_WriteShort(msg, to->solid);
 }
 
+/*
+ =================
+ MSG_WriteDeltaPlayerState
+
+ Writes a delta update of a player_state_t. A NULL from means a
+ non-delta update.
+ =================
+*/
+void MSG_WriteDeltaPlayerState (msg_t *msg, const player_state_t *from, const player_state_t *to){
+
+	const player_state_t	*newPS, *oldPS;
+	player_state_t			dummy;
+	int						i, flags, statBits;
+
+	newPS = to;
+	if (!from){
+		memset(&dummy, 0, sizeof(dummy));
+		oldPS = &dummy;
+	}
+	else
+		oldPS = from;
+
+	// Determine what needs to be sent
+	flags = 0;
+
+	if (newPS->pmove.pm_type != oldPS->pmove.pm_type)
+		flags |= PS_M_TYPE;
+
+	if (newPS->pmove.origin[0] != oldPS->pmove.origin[0] || newPS->pmove.origin[1] != oldPS->pmove.origin[1] || newPS->pmove.origin[2] != oldPS->pmove.origin[2])
+		flags |= PS_M_ORIGIN;
+
+	if (newPS->pmove.velocity[0] != oldPS->pmove.velocity[0] || newPS->pmove.velocity[1] != oldPS->pmove.velocity[1] || newPS->pmove.velocity[2] != oldPS->pmove.velocity[2])
+		flags |= PS_M_VELOCITY;
+
+	if (newPS->pmove.pm_time != oldPS->pmove.pm_time)
+		flags |= PS_M_TIME;
+
+	if (newPS->pmove.pm_flags != oldPS->pmove.pm_flags)
+		flags |= PS_M_FLAGS;
+
+	if (newPS->pmove.gravity != oldPS->pmove.gravity)
+		flags |= PS_M_GRAVITY;
+
+	if (newPS->pmove.delta_angles[0] != oldPS->pmove.delta_angles[0] || newPS->pmove.delta_angles[1] != oldPS->pmove.delta_angles[1] || newPS->pmove.delta_angles[2] != oldPS->pmove.delta_angles[2])
+		flags |= PS_M_DELTA_ANGLES;
+
+	if (newPS->viewoffset[0] != oldPS->viewoffset[0] || newPS->viewoffset[1] != oldPS->viewoffset[1] || newPS->viewoffset[2] != oldPS->viewoffset[2])
+		flags |= PS_VIEWOFFSET;
+
+	if (newPS->viewangles[0] != oldPS->viewangles[0] || newPS->viewangles[1] != oldPS->viewangles[1] || newPS->viewangles[2] != oldPS->viewangles[2])
+		flags |= PS_VIEWANGLES;
+
+	if (newPS->kick_angles[0] != oldPS->kick_angles[0] || newPS->kick_angles[1] != oldPS->kick_angles[1] || newPS->kick_angles[2] != oldPS->kick_angles[2])
+		flags |= PS_KICKANGLES;
+
+	if (newPS->blend[0] != oldPS->blend[0] || newPS->blend[1] != oldPS->blend[1] || newPS->blend[2] != oldPS->blend[2] || newPS->blend[3] != oldPS->blend[3])
+		flags |= PS_BLEND;
+
+	if (newPS->fov != oldPS->fov)
+		flags |= PS_FOV;
+
+	if (newPS->rdflags != oldPS->rdflags)
+		flags |= PS_RDFLAGS;
+
+	if (newPS->gunframe != oldPS->gunframe)
+		flags |= PS_WEAPONFRAME;
+
+	flags |= PS_WEAPONINDEX;
+
+	// Write it
+	MSG_WriteShort(msg, flags);
+
+	// Write the pmove_state_t
+	if (flags & PS_M_TYPE)
+		MSG_WriteByte(msg, newPS->pmove.pm_type);
+
+	if (flags & PS_M_ORIGIN){
+		MSG_WriteShort(msg, newPS->pmove.origin[0]);
+		MSG_WriteShort(msg, newPS->pmove.origin[1]);
+		MSG_WriteShort(msg, newPS->pmove.origin[2]);
+	}
+
+	if (flags & PS_M_VELOCITY){
+		MSG_WriteShort(msg, newPS->pmove.velocity[0]);
+		MSG_WriteShort(msg, newPS->pmove.velocity[1]);
+		MSG_WriteShort(msg, newPS->pmove.velocity[2]);
+	}
+
+	if (flags & PS_M_TIME)
+		MSG_WriteByte(msg, newPS->pmove.pm_time);
+
+	if (flags & PS_M_FLAGS)
+		MSG_WriteByte(msg, newPS->pmove.pm_flags);
+
+	if (flags & PS_M_GRAVITY)
+		MSG_WriteShort(msg, newPS->pmove.gravity);
+
+	if (flags & PS_M_DELTA_ANGLES){
+		MSG_WriteShort(msg, newPS->pmove.delta_angles[0]);
+		MSG_WriteShort(msg, newPS->pmove.delta_angles[1]);
+		MSG_WriteShort(msg, newPS->pmove.delta_angles[2]);
+	}
+
+	// Write the rest of the player_state_t
+	if (flags & PS_VIEWOFFSET){
+		MSG_WriteChar(msg, newPS->viewoffset[0]*4);
+		MSG_WriteChar(msg, newPS->viewoffset[1]*4);
+		MSG_WriteChar(msg, newPS->viewoffset[2]*4);
+	}
+
+	if (flags & PS_VIEWANGLES){
+		MSG_WriteAngle16(msg, newPS->viewangles[0]);
+		MSG_WriteAngle16(msg, newPS->viewangles[1]);
+		MSG_WriteAngle16(msg, newPS->viewangles[2]);
+	}
+
+	if (flags & PS_KICKANGLES){
+		MSG_WriteChar(msg, newPS->kick_angles[0]*4);
+		MSG_WriteChar(msg, newPS->kick_angles[1]*4);
+		MSG_WriteChar(msg, newPS->kick_angles[2]*4);
+	}
+
+	if (flags & PS_WEAPONINDEX)
+		MSG_WriteByte(msg, newPS->gunindex);
+
+	if (flags & PS_WEAPONFRAME){
+		MSG_WriteByte(msg, newPS->gunframe);
+		MSG_WriteChar(msg, newPS->gunoffset[0]*4);
+		MSG_WriteChar(msg, newPS->gunoffset[1]*4);
+		MSG_WriteChar(msg, newPS->gunoffset[2]*4);
+		MSG_WriteChar(msg, newPS->gunangles[0]*4);
+		MSG_WriteChar(msg, newPS->gunangles[1]*4);
+		MSG_WriteChar(msg, newPS->gunangles[2]*4);
+	}
+
+	if (flags & PS_BLEND){
+		MSG_WriteByte(msg, newPS->blend[0]*255);
+		MSG_WriteByte(msg, newPS->blend[1]*255);
+		MSG_WriteByte(msg, newPS->blend[2]*255);
+		MSG_WriteByte(msg, newPS->blend[3]*255);
+	}
+
+	if (flags & PS_FOV)
+		MSG_WriteByte(msg, newPS->fov);
+
+	if (flags & PS_RDFLAGS)
+		MSG_WriteByte(msg, newPS->rdflags);
+	
+	// Send stats
+	statBits = 0;
+	for (i = 0; i < MAX_STATS; i++){
+		if (newPS->stats[i] != oldPS->stats[i])
+			statBits |= 1<<i;
+	}
+
+	MSG_WriteLong(msg, statBits);
+
+	for (i = 0; i < MAX_STATS; i++){
+		if (statBits & (1<<i))
+			MSG_WriteShort(msg, newPS->stats[i]);
+	}
+}
+
 
 // =====================================================================
 
@@ -44,7 +44,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define	UPDATE_MASK			(UPDATE_BACKUP-1)
 
 // Server to client
-enum {
+typedef enum {
 	SVC_BAD,
 
 	// These ops are known to the game library
@@ -73,7 +73,7 @@ enum {
 } svcOps_t;
 
 // Client to server
-enum {
+typedef enum {
 	CLC_BAD,
 	CLC_NOP, 		
 	CLC_MOVE,					// [usercmd_t]
@@ -233,6 +233,76 @@ void		Com_TouchMemory (void);
 void		Com_InitMemory (void);
 void		Com_ShutdownMemory (void);
 
+/*
+ =======================================================================
+
+ JOBS
+
+ A pool of worker threads for running independent pieces of work in 
+ parallel. Job functions must not call Com_Error or touch any other
+ shared state that isn't protected. Text they print is held back until
+ the main thread prints again.
+ =======================================================================
+*/
+
+typedef void (*jobFunc_t)(void *data, int index);
+
+extern cvar_t	*com_jobThreads;
+
+// Runs function(data, index) for every index from 0 to count-1 and 
+// returns when all of them have completed. The calling thread takes 
+// part in the work, so this works even if no worker threads exist.
+void		Com_RunJobs (jobFunc_t function, void *data, int count);
+
+// Returns the number of threads that take part in Com_RunJobs, 
+// including the calling thread
+int			Com_NumJobThreads (void);
+
+void		Com_InitJobs (void);
+void		Com_ShutdownJobs (void);
+
+/*
+ =======================================================================
+
+ LOADER
+
+ Reads (and optionally decodes) files on background threads while the
+ main thread does something else, usually loading the rest of a level.
+ Requests are served in order of priority. Results stay in the loader
+ until the main thread claims them with Com_FinishLoad.
+ Load functions run on a loader thread, so they may only use the file
+ system, Z_Malloc and Com_Printf. The search path must not change while
+ loads are pending.
+ =======================================================================
+*/
+
+// Higher priorities are loaded first
+#define LOAD_PRIORITY_SOUND		1
+#define LOAD_PRIORITY_SKIN		2
+#define LOAD_PRIORITY_MODEL		3
+#define LOAD_PRIORITY_WORLD		4
+
+// A NULL load function reads the file with FS_LoadFile
+typedef void *(*loadFunc_t)(const char *name, int *size);
+typedef void (*freeFunc_t)(void *data);
+
+extern cvar_t	*com_loaderThreads;
+
+// Queues a load. Nothing happens if there are no loader threads, and
+// free is used for results that are never claimed.
+void		Com_QueueLoad (const char *name, int priority, loadFunc_t load, freeFunc_t free);
+
+// Returns false if name was never queued with load, or if it wasn't
+// started yet, in which case the caller should load it itself. Waits if
+// a loader thread is busy with it.
+qboolean	Com_FinishLoad (const char *name, loadFunc_t load, void **data, int *size);
+
+// Throws away everything that wasn't claimed
+void		Com_FlushLoads (void);
+
+void		Com_InitLoader (void);
+void		Com_ShutdownLoader (void);
+
 /*
  =======================================================================
 
@@ -268,6 +338,12 @@ void		FS_RenameFile (const char *oldName, const char *newName);
 void		FS_DeleteFile (const char *name);
 int			FS_LoadFile (const char *name, void **buffer);
 void		FS_FreeFile (void *buffer);
+
+// Like FS_LoadFile, but returns a read-only pointer straight into a pack
+// file mapping when possible, otherwise a copy. The data is not 0
+// terminated. Must be released with FS_UnmapFile.
+int			FS_MapFile (const char *name, const void **buffer);
+void		FS_UnmapFile (const void *buffer);
 qboolean	FS_SaveFile (const char *name, const void *buffer, int size);
 
 int			FS_GetFileList (const char *path, const char *extension, char *buffer, int size);
@@ -276,10 +352,63 @@ void		FS_CreatePath (const char *path);
 void		FS_RemovePath (const char *path);
 char		*FS_NextPath (char *prevPath);
 
+// Must be called for files written to the game directory without going
+// through the file system, or lookups won't find them
+void		FS_IndexFile (const char *name);
+
 void		FS_Restart (void);
 void		FS_Init (void);
 void		FS_Shutdown (void);
 
+/*
+ =======================================================================
+
+ DEMOS
+
+ Demo files are a header followed by blocks of length-prefixed messages,
+ each block optionally compressed. Keyframe blocks hold everything
+ needed to start playback from their position and are skipped during
+ normal playback. A trailing index lists the keyframes for seeking.
+ Files written before this format are still played back, but can't be
+ seeked.
+ =======================================================================
+*/
+
+typedef struct demo_s	demo_t;
+
+extern cvar_t	*com_demoCompress;
+extern cvar_t	*com_demoKeyframes;
+
+// Takes ownership of the file, which is closed by Com_CloseDemo
+demo_t		*Com_RecordDemo (fileHandle_t f);
+demo_t		*Com_PlayDemo (fileHandle_t f);
+void		Com_CloseDemo (demo_t *demo);
+
+void		Com_WriteDemoMessage (demo_t *demo, int frameNum, const void *data, int length);
+
+// Messages written between these calls go to a keyframe for frameNum
+qboolean	Com_DemoKeyframeDue (demo_t *demo, int frameNum);
+void		Com_BeginDemoKeyframe (demo_t *demo, int frameNum);
+void		Com_EndDemoKeyframe (demo_t *demo);
+
+// Returns the length of the message, or -1 at the end of the demo
+int			Com_ReadDemoMessage (demo_t *demo, void *data, int maxLength);
+
+// Continues playback from the last keyframe at or before frameNum.
+// Returns false if the demo has no index.
+qboolean	Com_SeekDemo (demo_t *demo, int frameNum);
+
+// Returns the frame of the last message read or written
+int			Com_DemoFrame (demo_t *demo);
+
+// Returns false if the demo has no index
+qboolean	Com_DemoFrameRange (demo_t *demo, int *firstFrame, int *lastFrame);
+
+// Returns the number of bytes written so far
+int			Com_DemoLength (demo_t *demo);
+
+void		Com_InitDemos (void);
+
 /*
  =======================================================================
 
@@ -475,6 +604,7 @@ void	MSG_WriteAngle16 (msg_t *msg, float a);
 void	MSG_WriteDir (msg_t *msg, const vec3_t dir);
 void	MSG_WriteDeltaUserCmd (msg_t *msg, const struct usercmd_s *from, const struct usercmd_s *to);
 void	MSG_WriteDeltaEntity (msg_t *msg, const struct entity_state_s *from, const struct entity_state_s *to, qboolean force, qboolean newEntity);
+void	MSG_WriteDeltaPlayerState (msg_t *msg, const player_state_t *from, const player_state_t *to);
 
 void	MSG_BeginReading (msg_t *msg);
 int		MSG_ReadChar (msg_t *msg);
@@ -533,6 +663,13 @@ qboolean	NET_StringToAdr (const char *s, netAdr_t *adr);
 qboolean	NET_GetPacket (netSrc_t sock, netAdr_t *from, msg_t *message);
 void		NET_SendPacket (netSrc_t sock, const netAdr_t to, const void *data, int length);
 
+// Sends the packets NET_SendPacket queued up, if the backend batches them
+void		NET_Flush (netSrc_t sock);
+
+// Waits up to msec milliseconds for a packet on the server socket or
+// console input. Only the dedicated server main loop uses this.
+void		NET_Sleep (int msec);
+
 void		NET_Init (void);
 void		NET_Shutdown (void);
 
@@ -612,19 +749,39 @@ int			CM_HeadNodeForBox (const vec3_t mins, const vec3_t maxs);
 int			CM_BoxLeafNums (const vec3_t mins, const vec3_t maxs, int *list, int listSize, int *topNode);
 
 int			CM_PointLeafNum (const vec3_t p);
+void		CM_PointLeafNums (const vec3_t *points, int numPoints, int *leafNums);
 
 // Returns an ORed contents mask
 int			CM_PointContents (const vec3_t p, int headNode);
 int			CM_TransformedPointContents (const vec3_t p, int headNode, const vec3_t origin, const vec3_t angles);
 
 trace_t		CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask);
+void		CM_BoxTraceMany (const vec3_t *starts, const vec3_t *ends, int count, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, trace_t *traces);
 trace_t		CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const vec3_t origin, const vec3_t angles);
 
-byte		*CM_ClusterPVS (int cluster);
-byte		*CM_ClusterPHS (int cluster);
+// Reentrant versions of the box, leaf, contents and trace queries. Every
+// thread doing collision queries at the same time needs a context of its
+// own. Only CM_PointLeafNum and CM_PointLeafNums never touch the box hull
+// and can be called from any thread without one.
+typedef struct cmTraceContext_s	cmTraceContext_t;
+
+cmTraceContext_t	*CM_AllocTraceContext (void);
+void		CM_FreeTraceContext (cmTraceContext_t *ctx);
+
+int			CM_ContextHeadNodeForBox (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs);
+int			CM_ContextBoxLeafNums (cmTraceContext_t *ctx, const vec3_t mins, const vec3_t maxs, int *list, int listSize, int *topNode);
+int			CM_ContextPointContents (cmTraceContext_t *ctx, const vec3_t p, int headNode);
+int			CM_ContextTransformedPointContents (cmTraceContext_t *ctx, const vec3_t p, int headNode, const vec3_t origin, const vec3_t angles);
+trace_t		CM_ContextBoxTrace (cmTraceContext_t *ctx, const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask);
+void		CM_ContextBoxTraceMany (cmTraceContext_t *ctx, const vec3_t *starts, const vec3_t *ends, int count, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, trace_t *traces);
+trace_t		CM_ContextTransformedBoxTrace (cmTraceContext_t *ctx, const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const vec3_t origin, const vec3_t angles);
+
+const byte	*CM_ClusterPVS (int cluster);
+const byte	*CM_ClusterPHS (int cluster);
 
 void		CM_SetAreaPortalState (int portalNum, qboolean open);
 qboolean	CM_AreasConnected (int area1, int area2);
+const byte	*CM_AreaConnections (int area);
 int			CM_WriteAreaBits (byte *buffer, int area);
 void		CM_WritePortalState (fileHandle_t f);
 void		CM_ReadPortalState (fileHandle_t f);
@@ -660,6 +817,10 @@ typedef enum {
 char	*Sys_GetCommand (void);
 void	Sys_Print (const char *text);
 void	Sys_Error (const char *fmt, ...);
+
+// Fatal errors on other threads can't shut anything down, so this just
+// reports the error and terminates the process
+void	Sys_ThreadError (const char *text);
 void	Sys_ShowConsole (qboolean show);
 
 int		Sys_FindFiles (const char *path, const char *pattern, char **fileList, int maxFiles, qboolean addFiles, qboolean addDirs);
@@ -669,9 +830,20 @@ void	Sys_RemoveDirectory (const char *path);
 char	*Sys_GetCurrentDirectory (void);
 char	*Sys_ScanForCD (void);
 
+// Maps a whole file read-only, returns NULL if it can't be mapped
+void	*Sys_MapFile (const char *path, int *length);
+void	Sys_UnmapFile (void *data, int length);
+
+// Reads from an absolute offset without moving the file position, so
+// several readers can share one open file
+int		Sys_ReadFileAt (FILE *f, void *buffer, int size, int offset);
+
 char	*Sys_GetClipboardText (void);
 void	Sys_ShellExecute (const char *path, const char *parms, qboolean exit);
 int		Sys_Milliseconds (void);
+
+// Only for measuring short intervals, wraps around about every 71 minutes
+unsigned	Sys_Microseconds (void);
 void	Sys_PumpMessages (void);
 
 void	Sys_Init (void);
@@ -680,6 +852,22 @@ void	Sys_Quit (void);
 void	*Sys_LoadLibrary (sysLib_t lib, void *import);
 void	Sys_FreeLibrary (sysLib_t lib);
 
+// Thread functions must never call Com_Error or anything else that is
+// not thread safe
+int		Sys_NumProcessors (void);
+void	*Sys_CreateThread (void (*function)(void *data), void *data);
+void	Sys_WaitForThread (void *thread);
+void	*Sys_CreateMutex (void);
+void	Sys_DestroyMutex (void *mutex);
+void	Sys_LockMutex (void *mutex);
+void	Sys_UnlockMutex (void *mutex);
+void	*Sys_CreateSemaphore (int count);
+void	Sys_DestroySemaphore (void *semaphore);
+void	Sys_PostSemaphore (void *semaphore, int count);
+void	Sys_WaitSemaphore (void *semaphore);
+int		Sys_AtomicAdd (volatile int *value, int add);
+qboolean	Sys_IsMainThread (void);
+
 /*
  =======================================================================
 
@@ -704,6 +892,7 @@ void	CL_Init (void);
 void	CL_Shutdown (void);
 
 void	SV_Frame (int msec);
+int		SV_FrameTimeLeft (void);
 void	SV_Init (void);
 void	SV_Shutdown (const char *message, qboolean reconnect);
 
@@ -499,5 +499,141 @@ typedef struct {
 	int				gridPoints;
 } lightGridHeader_t;
 
+/*
+ =======================================================================
+
+ .SCN scene recording file format
+
+ Everything the client hands to the refresh, so the renderer can be run
+ again without a client. A header is followed by records, each of them
+ a sceneRecord_t and then length bytes of data. Models and shaders are
+ written once by name, and referred to by index afterwards (-1 is none).
+
+ =======================================================================
+*/
+
+#define SCN_IDENT			(('N'<<24)+('C'<<16)+('S'<<8)+'Q')
+#define SCN_VERSION			1
+
+typedef enum {
+	SCN_WORLD,				// sceneWorld_t, a new map was loaded
+	SCN_MODEL,				// sceneModel_t
+	SCN_SHADER,				// sceneShader_t
+	SCN_FRAME,				// sceneFrame_t, R_BeginFrame was called
+	SCN_VIEW				// sceneView_t and the scene, R_RenderScene was called
+} sceneRecordType_t;
+
+typedef enum {
+	SCN_SHADER_GENERIC,		// R_RegisterShader
+	SCN_SHADER_SKIN,		// R_RegisterShaderSkin
+	SCN_SHADER_NOMIP		// R_RegisterShaderNoMip
+} sceneShaderType_t;
+
+typedef struct {
+	int				ident;
+	int				version;
+} sceneHeader_t;
+
+typedef struct {
+	int				type;
+	int				length;
+} sceneRecord_t;
+
+typedef struct {
+	char			mapName[MAX_QPATH];
+	char			skyName[MAX_QPATH];
+	float			skyRotate;
+	vec3_t			skyAxis;
+} sceneWorld_t;
+
+typedef struct {
+	int				index;
+	char			name[MAX_QPATH];	// Inline models are "*<number>"
+} sceneModel_t;
+
+typedef struct {
+	int				index;
+	int				type;
+	char			name[MAX_QPATH];
+} sceneShader_t;
+
+typedef struct {
+	int				realTime;
+} sceneFrame_t;
+
+// The view is followed by the entities, dynamic lights, particles, polys
+// and finally the vertices of all the polys
+typedef struct {
+	int				x;
+	int				y;
+	int				width;
+	int				height;
+	float			fovX;
+	float			fovY;
+	vec3_t			viewOrigin;
+	vec3_t			viewAxis[3];
+	float			time;
+	int				rdFlags;
+
+	int				hasAreaBits;
+	byte			areaBits[MAX_MAP_AREAS/8];
+
+	vec3_t			lightStyles[MAX_LIGHTSTYLES];
+
+	int				numEntities;
+	int				numDLights;
+	int				numParticles;
+	int				numPolys;
+	int				numPolyVerts;
+} sceneView_t;
+
+typedef struct {
+	int				entityType;
+	int				renderFX;
+	int				flags;
+	int				model;
+	vec3_t			axis[3];
+	vec3_t			origin;
+	int				frame;
+	vec3_t			oldOrigin;
+	int				oldFrame;
+	float			backLerp;
+	int				ammoValue;
+	float			radius;
+	float			rotation;
+	int				skinNum;
+	int				customShader;
+	byte			shaderRGBA[4];
+	float			shaderTime;
+} sceneEntity_t;
+
+typedef struct {
+	vec3_t			origin;
+	vec3_t			color;
+	float			intensity;
+} sceneDLight_t;
+
+typedef struct {
+	int				shader;
+	vec3_t			origin;
+	vec3_t			oldOrigin;
+	float			radius;
+	float			length;
+	float			rotation;
+	byte			modulate[4];
+	int				flags;
+} sceneParticle_t;
+
+typedef struct {
+	int				shader;
+	int				numVerts;
+} scenePoly_t;
+
+typedef struct {
+	vec3_t			xyz;
+	vec2_t			st;
+	byte			modulate[4];
+} scenePolyVert_t;
+
 
 #endif	// __QFILES_H__
@@ -428,7 +428,7 @@ extern BOOL				(WINAPI   * qwglSwapIntervalEXT)(int interval);
 
 #endif
 
-#ifdef __linux__
+#if defined(__linux__) && defined(GLX_VERSION_1_0)
 
 extern void				*qglXGetProcAddress (char *symbol);
 
@@ -25,6 +25,33 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "r_local.h"
 #include "normals.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ALIAS_SIMD
+#include <xmmintrin.h>
+#endif
+
+
+typedef struct {
+	entity_t		*entity;
+	mdl_t			*alias;
+	qboolean		lerpVectors;
+
+	int				offset;
+	float			*vertices;
+} aliasCache_t;
+
+static aliasCache_t	r_aliasCache[MAX_ENTITIES];
+static int			r_numAliasCache;
+
+static int			r_aliasCacheIndex[MAX_ENTITIES];
+static int			r_aliasCacheStamp[MAX_ENTITIES];
+static int			r_aliasCacheCount;
+
+static float		*r_aliasCacheBuffer;
+static int			r_aliasCacheSize;
+
+static float		r_aliasScratch[MAX_VERTICES * 12];
+
 
 /*
  =================
@@ -236,6 +263,372 @@ static qboolean R_CullAliasModel (entity_t *entity, mdl_t *alias){
 	return false;
 }
 
+/*
+ =================
+ R_LerpAliasPositions
+ =================
+*/
+static void R_LerpAliasPositions (const float *curXyz, const float *oldXyz, const vec3_t move, float backLerp, int stride, float *xyz){
+
+	int		i, j;
+#ifdef ALIAS_SIMD
+	__m128	lerp, delta, cur, old;
+
+	lerp = _mm_set1_ps(backLerp);
+
+	for (j = 0; j < 3; j++, curXyz += stride, oldXyz += stride, xyz += stride){
+		delta = _mm_set1_ps(move[j]);
+
+		for (i = 0; i < stride; i += 4){
+			cur = _mm_loadu_ps(curXyz + i);
+			old = _mm_loadu_ps(oldXyz + i);
+
+			_mm_storeu_ps(xyz + i, _mm_add_ps(cur, _mm_mul_ps(_mm_sub_ps(_mm_add_ps(old, delta), cur), lerp)));
+		}
+	}
+#else
+	for (j = 0; j < 3; j++, curXyz += stride, oldXyz += stride, xyz += stride){
+		for (i = 0; i < stride; i++)
+			xyz[i] = curXyz[i] + (oldXyz[i] + move[j] - curXyz[i]) * backLerp;
+	}
+#endif
+}
+
+/*
+ =================
+ R_DecodeAliasVector
+ =================
+*/
+static void R_DecodeAliasVector (const byte *latLong, float *vector, int stride){
+
+	vector[0] = r_sinTable[latLong[0]] * r_cosTable[latLong[1]];
+	vector[stride] = r_sinTable[latLong[0]] * r_sinTable[latLong[1]];
+	vector[stride * 2] = r_cosTable[latLong[0]];
+}
+
+#ifdef ALIAS_SIMD
+
+/*
+ =================
+ R_LookupAliasTable
+
+ Looks up four consecutive vertices of an encoded vector
+ =================
+*/
+static __m128 R_LookupAliasTable (const float *table, const byte *latLong){
+
+	return _mm_setr_ps(table[latLong[0]], table[latLong[sizeof(mdlXyzNormal_t)]], table[latLong[sizeof(mdlXyzNormal_t) * 2]], table[latLong[sizeof(mdlXyzNormal_t) * 3]]);
+}
+
+#endif
+
+/*
+ =================
+ R_LerpAliasVectors
+
+ Decodes, interpolates and normalizes one of the encoded vectors of every
+ vertex. The given pointers point into the first mdlXyzNormal_t of each
+ frame.
+ =================
+*/
+static void R_LerpAliasVectors (const byte *curLatLong, const byte *oldLatLong, int numVertices, float backLerp, int stride, float *vectors){
+
+	float	*x = vectors, *y = vectors + stride, *z = vectors + stride * 2;
+	vec3_t	cur, old;
+	float	scale;
+	int		i = 0;
+#ifdef ALIAS_SIMD
+	__m128	lerp, sinLat, curX, curY, curZ, oldX, oldY, oldZ, length;
+
+	lerp = _mm_set1_ps(backLerp);
+
+	for ( ; i + 4 <= numVertices; i += 4, curLatLong += sizeof(mdlXyzNormal_t) * 4, oldLatLong += sizeof(mdlXyzNormal_t) * 4){
+		sinLat = R_LookupAliasTable(r_sinTable, curLatLong);
+		curX = _mm_mul_ps(sinLat, R_LookupAliasTable(r_cosTable, curLatLong + 1));
+		curY = _mm_mul_ps(sinLat, R_LookupAliasTable(r_sinTable, curLatLong + 1));
+		curZ = R_LookupAliasTable(r_cosTable, curLatLong);
+
+		sinLat = R_LookupAliasTable(r_sinTable, oldLatLong);
+		oldX = _mm_mul_ps(sinLat, R_LookupAliasTable(r_cosTable, oldLatLong + 1));
+		oldY = _mm_mul_ps(sinLat, R_LookupAliasTable(r_sinTable, oldLatLong + 1));
+		oldZ = R_LookupAliasTable(r_cosTable, oldLatLong);
+
+		curX = _mm_add_ps(curX, _mm_mul_ps(_mm_sub_ps(oldX, curX), lerp));
+		curY = _mm_add_ps(curY, _mm_mul_ps(_mm_sub_ps(oldY, curY), lerp));
+		curZ = _mm_add_ps(curZ, _mm_mul_ps(_mm_sub_ps(oldZ, curZ), lerp));
+
+		length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(curX, curX), _mm_mul_ps(curY, curY)), _mm_mul_ps(curZ, curZ));
+		length = _mm_rsqrt_ps(_mm_max_ps(length, _mm_set1_ps(1e-12f)));
+
+		_mm_storeu_ps(x + i, _mm_mul_ps(curX, length));
+		_mm_storeu_ps(y + i, _mm_mul_ps(curY, length));
+		_mm_storeu_ps(z + i, _mm_mul_ps(curZ, length));
+	}
+#endif
+
+	// Do the remaining vertices one at a time
+	for ( ; i < numVertices; i++, curLatLong += sizeof(mdlXyzNormal_t), oldLatLong += sizeof(mdlXyzNormal_t)){
+		R_DecodeAliasVector(curLatLong, cur, 1);
+		R_DecodeAliasVector(oldLatLong, old, 1);
+
+		cur[0] += (old[0] - cur[0]) * backLerp;
+		cur[1] += (old[1] - cur[1]) * backLerp;
+		cur[2] += (old[2] - cur[2]) * backLerp;
+
+		scale = Q_rsqrt(DotProduct(cur, cur));
+
+		x[i] = cur[0] * scale;
+		y[i] = cur[1] * scale;
+		z[i] = cur[2] * scale;
+	}
+}
+
+/*
+ =================
+ R_InterpolateAliasSurface
+
+ Writes the interpolated vertices, and optionally the tangents, binormals
+ and normals, of the given surface as x, y and z arrays of stride floats
+ each. This is called from the job threads, so it must not touch any
+ shared state.
+ =================
+*/
+static void R_InterpolateAliasSurface (mdlSurface_t *surface, int frame, int oldFrame, float backLerp, const vec3_t move, qboolean lerpVectors, float *vertices){
+
+	mdlXyzNormal_t	*curXyzNormal, *oldXyzNormal;
+	float			*tangents, *binormals, *normals;
+	int				stride;
+	int				i, j;
+
+	stride = MDL_VERTEX_STRIDE(surface->numVertices);
+
+	// Interpolate vertices
+	R_LerpAliasPositions(surface->frameXyz + stride * 3 * frame, surface->frameXyz + stride * 3 * oldFrame, move, backLerp, stride, vertices);
+
+	if (!lerpVectors)
+		return;
+
+	tangents = vertices + stride * 3;
+	binormals = vertices + stride * 6;
+	normals = vertices + stride * 9;
+
+	// Clear the padding
+	for (i = surface->numVertices; i < stride; i++){
+		for (j = 0; j < 9; j++)
+			tangents[stride * j + i] = 0.0;
+	}
+
+	curXyzNormal = surface->xyzNormals + surface->numVertices * frame;
+	oldXyzNormal = surface->xyzNormals + surface->numVertices * oldFrame;
+
+	// If not interpolating, the decoded vectors are already normalized
+	if (frame == oldFrame || backLerp == 0.0){
+		for (i = 0; i < surface->numVertices; i++, curXyzNormal++){
+			R_DecodeAliasVector(curXyzNormal->tangent, tangents + i, stride);
+			R_DecodeAliasVector(curXyzNormal->binormal, binormals + i, stride);
+			R_DecodeAliasVector(curXyzNormal->normal, normals + i, stride);
+		}
+
+		return;
+	}
+
+	// Decode, interpolate and normalize tangents, binormals and normals
+	R_LerpAliasVectors(curXyzNormal->tangent, oldXyzNormal->tangent, surface->numVertices, backLerp, stride, tangents);
+	R_LerpAliasVectors(curXyzNormal->binormal, oldXyzNormal->binormal, surface->numVertices, backLerp, stride, binormals);
+	R_LerpAliasVectors(curXyzNormal->normal, oldXyzNormal->normal, surface->numVertices, backLerp, stride, normals);
+}
+
+/*
+ =================
+ R_AliasSurfaceSize
+ =================
+*/
+static int R_AliasSurfaceSize (mdlSurface_t *surface, qboolean lerpVectors){
+
+	if (lerpVectors)
+		return MDL_VERTEX_STRIDE(surface->numVertices) * 12;
+
+	return MDL_VERTEX_STRIDE(surface->numVertices) * 3;
+}
+
+/*
+ =================
+ R_InterpolateAliasModelJob
+ =================
+*/
+static void R_InterpolateAliasModelJob (void *data, int index){
+
+	aliasCache_t	*cache = &r_aliasCache[index];
+	entity_t		*entity = cache->entity;
+	mdlSurface_t	*surface;
+	float			*vertices;
+	vec3_t			delta, move;
+	int				i;
+
+	VectorSubtract(entity->oldOrigin, entity->origin, delta);
+	VectorRotate(delta, entity->axis, move);
+
+	vertices = cache->vertices;
+
+	for (i = 0, surface = cache->alias->surfaces; i < cache->alias->numSurfaces; i++, surface++){
+		R_InterpolateAliasSurface(surface, entity->frame, entity->oldFrame, entity->backLerp, move, cache->lerpVectors, vertices);
+
+		vertices += R_AliasSurfaceSize(surface, cache->lerpVectors);
+	}
+}
+
+/*
+ =================
+ R_AddAliasModelToCache
+ =================
+*/
+static void R_AddAliasModelToCache (entity_t *entity, mdl_t *alias, qboolean lerpVectors){
+
+	aliasCache_t	*cache;
+	int				index;
+
+	index = entity - r_entities;
+	if (index < 0 || index >= MAX_ENTITIES)
+		return;
+
+	// Already added
+	if (r_aliasCacheStamp[index] == r_aliasCacheCount){
+		cache = &r_aliasCache[r_aliasCacheIndex[index]];
+
+		if (cache->alias == alias && lerpVectors)
+			cache->lerpVectors = true;
+
+		return;
+	}
+
+	if (r_numAliasCache >= MAX_ENTITIES)
+		return;
+
+	r_aliasCacheStamp[index] = r_aliasCacheCount;
+	r_aliasCacheIndex[index] = r_numAliasCache;
+
+	cache = &r_aliasCache[r_numAliasCache++];
+
+	cache->entity = entity;
+	cache->alias = alias;
+	cache->lerpVectors = lerpVectors;
+	cache->offset = 0;
+	cache->vertices = NULL;
+}
+
+/*
+ =================
+ R_ClearAliasModelCache
+ =================
+*/
+void R_ClearAliasModelCache (void){
+
+	r_numAliasCache = 0;
+
+	r_aliasCacheCount++;
+}
+
+/*
+ =================
+ R_InterpolateAliasModels
+
+ Interpolates all the alias models added to the current view on the job
+ threads, so the back end and shadows only have to copy the results
+ =================
+*/
+void R_InterpolateAliasModels (void){
+
+	aliasCache_t	*cache;
+	mdlSurface_t	*surface;
+	int				size = 0;
+	int				i, j;
+
+	if (!r_numAliasCache)
+		return;
+
+	// Find out how much space is needed
+	for (i = 0, cache = r_aliasCache; i < r_numAliasCache; i++, cache++){
+		cache->offset = size;
+
+		for (j = 0, surface = cache->alias->surfaces; j < cache->alias->numSurfaces; j++, surface++)
+			size += R_AliasSurfaceSize(surface, cache->lerpVectors);
+	}
+
+	// Grow the buffer if needed
+	if (size > r_aliasCacheSize){
+		if (r_aliasCacheBuffer)
+			Z_Free(r_aliasCacheBuffer);
+
+		r_aliasCacheSize = size + (size >> 1);
+		r_aliasCacheBuffer = Z_Malloc(r_aliasCacheSize * sizeof(float));
+	}
+
+	for (i = 0, cache = r_aliasCache; i < r_numAliasCache; i++, cache++)
+		cache->vertices = r_aliasCacheBuffer + cache->offset;
+
+	// Interpolate all of them
+	Com_RunJobs(R_InterpolateAliasModelJob, NULL, r_numAliasCache);
+}
+
+/*
+ =================
+ R_GetAliasModelVertices
+
+ Returns the interpolated vertices of the given surface, laid out as
+ described in R_InterpolateAliasSurface. If the entity was not cached for
+ this view, the surface is interpolated into a scratch buffer that is only
+ valid until the next call.
+ =================
+*/
+const float *R_GetAliasModelVertices (entity_t *entity, mdl_t *alias, int surfaceNum, qboolean lerpVectors){
+
+	aliasCache_t	*cache;
+	mdlSurface_t	*surface;
+	float			*vertices;
+	vec3_t			delta, move;
+	int				index;
+	int				i;
+
+	index = entity - r_entities;
+
+	if (index >= 0 && index < MAX_ENTITIES && r_aliasCacheStamp[index] == r_aliasCacheCount){
+		cache = &r_aliasCache[r_aliasCacheIndex[index]];
+
+		if (cache->alias == alias && cache->vertices && (cache->lerpVectors || !lerpVectors)){
+			vertices = cache->vertices;
+
+			for (i = 0, surface = alias->surfaces; i < surfaceNum; i++, surface++)
+				vertices += R_AliasSurfaceSize(surface, cache->lerpVectors);
+
+			return vertices;
+		}
+	}
+
+	// Not in the cache, so interpolate it now
+	VectorSubtract(entity->oldOrigin, entity->origin, delta);
+	VectorRotate(delta, entity->axis, move);
+
+	R_InterpolateAliasSurface(alias->surfaces + surfaceNum, entity->frame, entity->oldFrame, entity->backLerp, move, lerpVectors, r_aliasScratch);
+
+	return r_aliasScratch;
+}
+
+/*
+ =================
+ R_ShutdownAliasModelCache
+ =================
+*/
+void R_ShutdownAliasModelCache (void){
+
+	if (r_aliasCacheBuffer)
+		Z_Free(r_aliasCacheBuffer);
+
+	r_aliasCacheBuffer = NULL;
+	r_aliasCacheSize = 0;
+
+	r_numAliasCache = 0;
+}
+
 /*
  =================
  R_DrawAliasModel
@@ -247,34 +640,17 @@ void R_DrawAliasModel (void){
 	mdlSurface_t	*surface;
 	mdlTriangle_t	*triangle;
 	mdlSt_t			*st;
-	mdlFrame_t		*curFrame, *oldFrame;
-	mdlXyzNormal_t	*curXyzNormal, *oldXyzNormal;
-	vec3_t			curScale, oldScale;
-	vec3_t			curTangent, oldTangent;
-	vec3_t			curBinormal, oldBinormal;
-	vec3_t			curNormal, oldNormal;
-	vec3_t			delta, move;
+	const float		*vertices;
+	int				stride;
 	int				i;
 
 	// Draw all the triangles
 	surface = alias->surfaces + rb_infoKey;
 
-	curFrame = alias->frames + rb_entity->frame;
-	oldFrame = alias->frames + rb_entity->oldFrame;
-
-	curXyzNormal = surface->xyzNormals + surface->numVertices * rb_entity->frame;
-	oldXyzNormal = surface->xyzNormals + surface->numVertices * rb_entity->oldFrame;
-
-	// Interpolate frames
-	VectorSubtract(rb_entity->oldOrigin, rb_entity->origin, delta);
-	VectorRotate(delta, rb_entity->axis, move);
+	// Get the interpolated vertices, tangents, binormals and normals
+	vertices = R_GetAliasModelVertices(rb_entity, alias, rb_infoKey, true);
 
-	move[0] = curFrame->translate[0] + (move[0] + oldFrame->translate[0] - curFrame->translate[0]) * rb_entity->backLerp;
-	move[1] = curFrame->translate[1] + (move[1] + oldFrame->translate[1] - curFrame->translate[1]) * rb_entity->backLerp;
-	move[2] = curFrame->translate[2] + (move[2] + oldFrame->translate[2] - curFrame->translate[2]) * rb_entity->backLerp;
-
-	VectorScale(curFrame->scale, 1.0 - rb_entity->backLerp, curScale);
-	VectorScale(oldFrame->scale, rb_entity->backLerp, oldScale);
+	stride = MDL_VERTEX_STRIDE(surface->numVertices);
 
 	// Draw it
 	RB_CheckMeshOverflow(surface->numTriangles * 3, surface->numVertices);
@@ -285,45 +661,19 @@ void R_DrawAliasModel (void){
 		indexArray[numIndex++] = numVertex + triangle->index[2];
 	}
 
-	for (i = 0, st = surface->st; i < surface->numVertices; i++, curXyzNormal++, oldXyzNormal++, st++){
-		// Decode tangents, binormals and normals
-		curTangent[0] = r_sinTable[curXyzNormal->tangent[0]] * r_cosTable[curXyzNormal->tangent[1]];
-		curTangent[1] = r_sinTable[curXyzNormal->tangent[0]] * r_sinTable[curXyzNormal->tangent[1]];
-		curTangent[2] = r_cosTable[curXyzNormal->tangent[0]];
-
-		oldTangent[0] = r_sinTable[oldXyzNormal->tangent[0]] * r_cosTable[oldXyzNormal->tangent[1]];
-		oldTangent[1] = r_sinTable[oldXyzNormal->tangent[0]] * r_sinTable[oldXyzNormal->tangent[1]];
-		oldTangent[2] = r_cosTable[oldXyzNormal->tangent[0]];
-
-		curBinormal[0] = r_sinTable[curXyzNormal->binormal[0]] * r_cosTable[curXyzNormal->binormal[1]];
-		curBinormal[1] = r_sinTable[curXyzNormal->binormal[0]] * r_sinTable[curXyzNormal->binormal[1]];
-		curBinormal[2] = r_cosTable[curXyzNormal->binormal[0]];
-
-		oldBinormal[0] = r_sinTable[oldXyzNormal->binormal[0]] * r_cosTable[oldXyzNormal->binormal[1]];
-		oldBinormal[1] = r_sinTable[oldXyzNormal->binormal[0]] * r_sinTable[oldXyzNormal->binormal[1]];
-		oldBinormal[2] = r_cosTable[oldXyzNormal->binormal[0]];
-
-		curNormal[0] = r_sinTable[curXyzNormal->normal[0]] * r_cosTable[curXyzNormal->normal[1]];
-		curNormal[1] = r_sinTable[curXyzNormal->normal[0]] * r_sinTable[curXyzNormal->normal[1]];
-		curNormal[2] = r_cosTable[curXyzNormal->normal[0]];
-
-		oldNormal[0] = r_sinTable[oldXyzNormal->normal[0]] * r_cosTable[oldXyzNormal->normal[1]];
-		oldNormal[1] = r_sinTable[oldXyzNormal->normal[0]] * r_sinTable[oldXyzNormal->normal[1]];
-		oldNormal[2] = r_cosTable[oldXyzNormal->normal[0]];
-
-		// Interpolate vertices, tangents, binormals and normals
-		vertexArray[numVertex][0] = move[0] + curXyzNormal->xyz[0]*curScale[0] + oldXyzNormal->xyz[0]*oldScale[0];
-		vertexArray[numVertex][1] = move[1] + curXyzNormal->xyz[1]*curScale[1] + oldXyzNormal->xyz[1]*oldScale[1];
-		vertexArray[numVertex][2] = move[2] + curXyzNormal->xyz[2]*curScale[2] + oldXyzNormal->xyz[2]*oldScale[2];
-		tangentArray[numVertex][0] = curTangent[0] + (oldTangent[0] - curTangent[0]) * rb_entity->backLerp;
-		tangentArray[numVertex][1] = curTangent[1] + (oldTangent[1] - curTangent[1]) * rb_entity->backLerp;
-		tangentArray[numVertex][2] = curTangent[2] + (oldTangent[2] - curTangent[2]) * rb_entity->backLerp;
-		binormalArray[numVertex][0] = curBinormal[0] + (oldBinormal[0] - curBinormal[0]) * rb_entity->backLerp;
-		binormalArray[numVertex][1] = curBinormal[1] + (oldBinormal[1] - curBinormal[1]) * rb_entity->backLerp;
-		binormalArray[numVertex][2] = curBinormal[2] + (oldBinormal[2] - curBinormal[2]) * rb_entity->backLerp;
-		normalArray[numVertex][0] = curNormal[0] + (oldNormal[0] - curNormal[0]) * rb_entity->backLerp;
-		normalArray[numVertex][1] = curNormal[1] + (oldNormal[1] - curNormal[1]) * rb_entity->backLerp;
-		normalArray[numVertex][2] = curNormal[2] + (oldNormal[2] - curNormal[2]) * rb_entity->backLerp;
+	for (i = 0, st = surface->st; i < surface->numVertices; i++, st++){
+		vertexArray[numVertex][0] = vertices[i];
+		vertexArray[numVertex][1] = vertices[stride + i];
+		vertexArray[numVertex][2] = vertices[stride * 2 + i];
+		tangentArray[numVertex][0] = vertices[stride * 3 + i];
+		tangentArray[numVertex][1] = vertices[stride * 4 + i];
+		tangentArray[numVertex][2] = vertices[stride * 5 + i];
+		binormalArray[numVertex][0] = vertices[stride * 6 + i];
+		binormalArray[numVertex][1] = vertices[stride * 7 + i];
+		binormalArray[numVertex][2] = vertices[stride * 8 + i];
+		normalArray[numVertex][0] = vertices[stride * 9 + i];
+		normalArray[numVertex][1] = vertices[stride * 10 + i];
+		normalArray[numVertex][2] = vertices[stride * 11 + i];
 		inTexCoordArray[numVertex][0] = st->st[0];
 		inTexCoordArray[numVertex][1] = st->st[1];
 		inColorArray[numVertex][0] = 255;
@@ -331,10 +681,6 @@ void R_DrawAliasModel (void){
 		inColorArray[numVertex][2] = 255;
 		inColorArray[numVertex][3] = 255;
 
-		VectorNormalizeFast(tangentArray[numVertex]);
-		VectorNormalizeFast(binormalArray[numVertex]);
-		VectorNormalizeFast(normalArray[numVertex]);
-
 		numVertex++;
 	}
 
@@ -385,8 +731,16 @@ void R_AddAliasModelToList (entity_t *entity){
 	R_AddShadowToList(entity, alias);
 
 	// Cull
-	if (R_CullAliasModel(entity, alias))
+	if (R_CullAliasModel(entity, alias)){
+		// Shadows may still be visible, and need the vertices
+		if (r_shadows->integer && !(r_refDef.rdFlags & RDF_NOWORLDMODEL) && !(entity->renderFX & (RF_VIEWERMODEL | RF_WEAPONMODEL)))
+			R_AddAliasModelToCache(entity, alias, false);
+
 		return;
+	}
+
+	// Add it to the cache so it gets interpolated before drawing
+	R_AddAliasModelToCache(entity, alias, true);
 
 	// Add all the surfaces
 	for (i = 0, surface = alias->surfaces; i < alias->numSurfaces; i++, surface++){
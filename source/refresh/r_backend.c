@@ -52,6 +52,7 @@ shader_t		*rb_shader;
 float			rb_shaderTime;
 entity_t		*rb_entity;
 int				rb_infoKey;
+qboolean		rb_staticGeometry;
 
 unsigned		indexArray[MAX_INDICES * 4];
 vec3_t			vertexArray[MAX_VERTICES * 2];
@@ -1009,12 +1010,12 @@ static void RB_SetupTextureUnit (stageBundle_t *bundle, unsigned unit){
 
 		break;
 	case TEX_LIGHTMAP:
-		if (rb_infoKey != 255){
-			GL_BindTexture(r_lightmapTextures[rb_infoKey]);
+		if (rb_infoKey & INFOKEY_DYNAMIC){
+			GL_BindTexture(r_dlightTexture);
 			break;
 		}
 
-		R_UpdateSurfaceLightmap(rb_mesh->mesh);
+		GL_BindTexture(r_lightmapTextures[rb_infoKey]);
 
 		break;
 	case TEX_CINEMATIC:
@@ -1155,6 +1156,96 @@ static void RB_RenderShaderARB (void){
 		QGL_LogPrintf("-----------------------------\n");
 }
 
+/*
+ =================
+ RB_RenderStaticShaderARB
+
+ Draws world surfaces from the static vertex buffer. Only the indices are
+ uploaded.
+ =================
+*/
+static void RB_RenderStaticShaderARB (void){
+
+	shaderStage_t	*stage;
+	stageBundle_t	*bundle;
+	int				i, j, count;
+
+	if (r_logFile->integer)
+		QGL_LogPrintf("--- RB_RenderStaticShaderARB( %s ) ---\n", rb_shader->name);
+
+	qglBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, rb_vbo.indexBuffer);
+	qglBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, numIndex * sizeof(unsigned), indexArray, GL_STREAM_DRAW_ARB);
+
+	RB_SetShaderState();
+
+	qglBindBufferARB(GL_ARRAY_BUFFER_ARB, r_worldModel->vertexBuffer);
+	qglEnableClientState(GL_VERTEX_ARRAY);
+	qglVertexPointer(3, GL_FLOAT, sizeof(surfBufferVert_t), VBO_OFFSET(0));
+
+	qglEnableClientState(GL_NORMAL_ARRAY);
+	qglNormalPointer(GL_FLOAT, sizeof(surfBufferVert_t), VBO_OFFSET(12));
+
+	for (i = 0; i < rb_shader->numStages; i++){
+		stage = rb_shader->stages[i];
+
+		RB_SetShaderStageState(stage);
+
+		if (stage->rgbGen.type == RGBGEN_VERTEX){
+			qglEnableClientState(GL_COLOR_ARRAY);
+			qglColorPointer(4, GL_UNSIGNED_BYTE, sizeof(surfBufferVert_t), VBO_OFFSET(40));
+		}
+		else {
+			// The color is the same for all the vertices, so compute it
+			// only once
+			count = numVertex;
+			numVertex = 1;
+
+			RB_CalcVertexColors(stage);
+
+			numVertex = count;
+
+			qglDisableClientState(GL_COLOR_ARRAY);
+			qglColor4ubv(colorArray[0]);
+		}
+
+		for (j = 0; j < stage->numBundles; j++){
+			bundle = stage->bundles[j];
+
+			RB_SetupTextureUnit(bundle, j);
+
+			switch (bundle->tcGen.type){
+			case TCGEN_BASE:
+				qglEnableClientState(GL_TEXTURE_COORD_ARRAY);
+				qglTexCoordPointer(2, GL_FLOAT, sizeof(surfBufferVert_t), VBO_OFFSET(24));
+				break;
+			case TCGEN_LIGHTMAP:
+				qglEnableClientState(GL_TEXTURE_COORD_ARRAY);
+				qglTexCoordPointer(2, GL_FLOAT, sizeof(surfBufferVert_t), VBO_OFFSET(32));
+				break;
+			default:
+				RB_CalcTextureCoords(bundle, j);
+				break;
+			}
+		}
+
+		if (glConfig.drawRangeElements)
+			qglDrawRangeElementsEXT(GL_TRIANGLES, 0, r_worldModel->numBufferVertices, numIndex, GL_UNSIGNED_INT, VBO_OFFSET(0));
+		else
+			qglDrawElements(GL_TRIANGLES, numIndex, GL_UNSIGNED_INT, VBO_OFFSET(0));
+
+		for (j = stage->numBundles - 1; j >= 0; j--){
+			bundle = stage->bundles[j];
+
+			RB_CleanupTextureUnit(bundle, j);
+
+			qglDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		}
+	}
+
+	if (r_logFile->integer)
+		QGL_LogPrintf("-----------------------------\n");
+}
+
 /*
  =================
  RB_RenderShader
@@ -1500,7 +1591,9 @@ void RB_RenderMesh (void){
 	r_stats.totalIndices += numIndex * rb_shader->numStages;
 
 	// Render the shader
-	if (glConfig.vertexBufferObject)
+	if (rb_staticGeometry)
+		RB_RenderStaticShaderARB();
+	else if (glConfig.vertexBufferObject)
 		RB_RenderShaderARB();
 	else
 		RB_RenderShader();
@@ -1517,19 +1610,56 @@ void RB_RenderMesh (void){
 	numIndex = numVertex = 0;
 }
 
+/*
+ =================
+ RB_EntityHasTransform
+ =================
+*/
+static qboolean RB_EntityHasTransform (entity_t *entity){
+
+	if (entity == r_worldEntity || entity->entityType != ET_MODEL)
+		return false;
+
+	return true;
+}
+
+/*
+ =================
+ RB_UseStaticGeometry
+ =================
+*/
+static qboolean RB_UseStaticGeometry (void){
+
+	if (rb_mesh->meshType != MESH_SURFACE)
+		return false;
+
+	if (!(rb_shader->flags & SHADER_STATICGEOMETRY))
+		return false;
+
+	if (!r_worldModel || !r_worldModel->vertexBuffer)
+		return false;
+
+	// Debug tools need the vertices in the arrays
+	if (r_showTris->integer || r_showNormals->integer || r_showTangentSpace->integer || r_showModelBounds->integer)
+		return false;
+
+	return true;
+}
+
 /*
  =================
  RB_RenderMeshes
  =================
 */
-void RB_RenderMeshes (mesh_t *meshes, int numMeshes){
+void RB_RenderMeshes (mesh_t *meshes, const int *sorted, int numMeshes){
 
 	int			i;
 	mesh_t		*mesh;
 	shader_t	*shader;
 	entity_t	*entity;
 	int			infoKey;
-	unsigned	sortKey = 0;
+	qboolean	staticGeometry;
+	unsigned long long	sortKey = 0;
 
 	if (r_skipBackEnd->integer || !numMeshes)
 		return;
@@ -1542,17 +1672,20 @@ void RB_RenderMeshes (mesh_t *meshes, int numMeshes){
 	rb_shaderTime = 0;
 	rb_entity = NULL;
 	rb_infoKey = -1;
+	rb_staticGeometry = false;
 
 	// Draw everything
-	for (i = 0, mesh = meshes; i < numMeshes; i++, mesh++){
+	for (i = 0; i < numMeshes; i++){
+		mesh = &meshes[sorted[i]];
+
 		// Check for changes
-		if (sortKey != mesh->sortKey || (mesh->sortKey & 255) == 255){
+		if (sortKey != mesh->sortKey){
 			sortKey = mesh->sortKey;
 
 			// Unpack sort key
-			shader = r_shaders[(sortKey >> 18) & 1023];
-			entity = &r_entities[(sortKey >> 8) & 1023];
-			infoKey = sortKey & 255;
+			shader = r_shaders[(sortKey >> SORTKEY_SHADER_SHIFT) & SORTKEY_FIELD_MASK];
+			entity = &r_entities[(sortKey >> SORTKEY_ENTITY_SHIFT) & SORTKEY_FIELD_MASK];
+			infoKey = (sortKey >> SORTKEY_INFO_SHIFT) & SORTKEY_FIELD_MASK;
 
 			// Development tool
 			if (r_debugSort->integer){
@@ -1560,17 +1693,22 @@ void RB_RenderMeshes (mesh_t *meshes, int numMeshes){
 					continue;
 			}
 
-			// Check if the rendering state changed
-			if ((rb_shader != shader) || (rb_entity != entity && !(shader->flags & SHADER_ENTITYMERGABLE)) || (rb_infoKey != infoKey || infoKey == 255)){
+			// Check if the rendering state changed. Entities can only share
+			// a batch if the shader allows it and they don't need their own
+			// transformation.
+			if (rb_shader != shader || rb_infoKey != infoKey)
 				RB_RenderMesh();
-
-				rb_shader = shader;
-				rb_infoKey = infoKey;
+			else if (rb_entity != entity){
+				if (!(shader->flags & SHADER_ENTITYMERGABLE) || RB_EntityHasTransform(entity) || RB_EntityHasTransform(rb_entity))
+					RB_RenderMesh();
 			}
 
+			rb_shader = shader;
+			rb_infoKey = infoKey;
+
 			// Check if the entity changed
 			if (rb_entity != entity){
-				if (entity == r_worldEntity || entity->entityType != ET_MODEL)
+				if (!RB_EntityHasTransform(entity))
 					qglLoadMatrixf(r_worldMatrix);
 				else
 					R_RotateForEntity(entity);
@@ -1583,6 +1721,15 @@ void RB_RenderMeshes (mesh_t *meshes, int numMeshes){
 		// Set the current mesh
 		rb_mesh = mesh;
 
+		// Static and streamed geometry can't share a batch
+		staticGeometry = RB_UseStaticGeometry();
+
+		if (rb_staticGeometry != staticGeometry){
+			RB_RenderMesh();
+
+			rb_staticGeometry = staticGeometry;
+		}
+
 		// Feed arrays
 		switch (rb_mesh->meshType){
 		case MESH_SKY:
@@ -1613,6 +1760,8 @@ void RB_RenderMeshes (mesh_t *meshes, int numMeshes){
 
 	// Make sure everything is flushed
 	RB_RenderMesh();
+
+	rb_staticGeometry = false;
 }
 
 /*
@@ -1888,6 +2037,7 @@ void RB_InitBackend (void){
 	rb_shaderTime = 0;
 	rb_entity = NULL;
 	rb_infoKey = -1;
+	rb_staticGeometry = false;
 
 	// Clear arrays
 	numIndex = numVertex = 0;
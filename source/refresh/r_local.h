@@ -189,6 +189,7 @@ typedef enum {
 #define SHADER_TESSSIZE					0x00004000
 #define SHADER_SKYPARMS					0x00008000
 #define SHADER_DEFORMVERTEXES			0x00010000
+#define SHADER_STATICGEOMETRY			0x00020000
 
 // Shader stage flags
 #define SHADERSTAGE_NEXTBUNDLE			0x00000001
@@ -504,12 +505,23 @@ typedef struct {
 	color_t				color;
 } surfPolyVert_t;
 
+// Vertex layout of the world static vertex buffer
+typedef struct {
+	vec3_t				xyz;
+	vec3_t				normal;
+	vec2_t				st;
+	vec2_t				lightmap;
+	color_t				color;
+} surfBufferVert_t;
+
 typedef struct surfPoly_s {
 	struct surfPoly_s	*next;
 
 	int					numIndices;
 	int					numVertices;
 
+	int					firstBufferVertex;	// In the world static vertex buffer
+
 	unsigned			*indices;
 	surfPolyVert_t		*vertices;
 } surfPoly_t;
@@ -601,6 +613,16 @@ typedef struct leaf_s {
 	int					numMarkSurfaces;
 } leaf_t;
 
+// Copy of a node with its plane inlined, so R_PointInLeaf touches a single
+// 32 byte block per level
+typedef struct {
+	vec3_t				normal;
+	float				dist;
+	int					type;
+	int					children[2];	// Negative numbers are leafs
+	int					pad;
+} pointNode_t;
+
 typedef struct {
 	int					numClusters;
 	int					bitOfs[8][2];
@@ -673,6 +695,10 @@ typedef struct {
 	byte				normal[2];
 } mdlXyzNormal_t;
 
+// Decoded frame positions are stored as x, y and z arrays, each padded to
+// a multiple of four vertices so they can be processed four at a time
+#define MDL_VERTEX_STRIDE(numVertices)	(((numVertices) + 3) & ~3)
+
 typedef struct {
 	vec2_t				st;
 } mdlSt_t;
@@ -710,6 +736,7 @@ typedef struct {
 	mdlTriangle_t		*triangles;
 	mdlNeighbor_t		*neighbors;
 	mdlXyzNormal_t		*xyzNormals;
+	float				*frameXyz;
 	mdlSt_t				*st;
 	mdlShader_t			*shaders;
 } mdlSurface_t;
@@ -786,6 +813,7 @@ typedef struct model_s {
 	int					numNodes;
 	int					firstNode;
 	node_t				*nodes;
+	pointNode_t			*pointNodes;
 
 	int					numLeafs;
 	leaf_t				*leafs;
@@ -794,6 +822,9 @@ typedef struct model_s {
 
 	vis_t				*vis;
 
+	unsigned			vertexBuffer;		// Static buffer with all the surfaces
+	int					numBufferVertices;
+
 	byte				*lightData;
 
 	vec3_t				gridMins;
@@ -812,6 +843,7 @@ typedef struct model_s {
 
 leaf_t		*R_PointInLeaf (const vec3_t p);
 byte		*R_ClusterPVS (int cluster);
+int			R_InlineModelNumber (model_t *model);
 void		R_ModelList_f (void);
 void		R_InitModels (void);
 void		R_ShutdownModels (void);
@@ -908,8 +940,21 @@ typedef enum {
 	MESH_POLY
 } meshType_t;
 
+// Mesh sort keys hold, from the most significant bits down, the shader
+// sort value, the shader, the info key and the entity. Meshes that end up
+// next to each other differ only in the fields further down the key.
+#define SORTKEY_SORT_SHIFT			60
+#define SORTKEY_SHADER_SHIFT		44
+#define SORTKEY_INFO_SHIFT			28
+#define SORTKEY_ENTITY_SHIFT		12
+#define SORTKEY_FIELD_MASK			0xFFFF
+
+// The info key of a surface is its lightmap, with this flag set if it is
+// dynamically lit this frame
+#define INFOKEY_DYNAMIC				0x8000
+
 typedef struct {
-	unsigned		sortKey;
+	unsigned long long	sortKey;
 	meshType_t		meshType;
 	void			*mesh;
 } mesh_t;
@@ -921,6 +966,7 @@ extern shader_t		*rb_shader;
 extern float		rb_shaderTime;
 extern entity_t		*rb_entity;
 extern int			rb_infoKey;
+extern qboolean		rb_staticGeometry;
 
 extern unsigned		indexArray[MAX_INDICES * 4];
 extern vec3_t		vertexArray[MAX_VERTICES * 2];
@@ -937,7 +983,7 @@ extern int			numVertex;
 
 void		RB_CheckMeshOverflow (int numIndices, int numVertices);
 void		RB_RenderMesh (void);
-void		RB_RenderMeshes (mesh_t *meshes, int numMeshes);
+void		RB_RenderMeshes (mesh_t *meshes, const int *sorted, int numMeshes);
 void		RB_DrawStretchPic (float x, float y, float w, float h, float sl, float tl, float sh, float th, const color_t modulate, shader_t *shader);
 void		RB_DrawRotatedPic (float x, float y, float w, float h, float sl, float tl, float sh, float th, float angle, const color_t modulate, shader_t *shader);
 void		RB_DrawOffsetPic (float x, float y, float w, float h, float sl, float tl, float sh, float th, float offsetX, float offsetY, const color_t modulate, shader_t *shader);
@@ -951,21 +997,6 @@ void		RB_ShutdownBackend (void);
 
 // =====================================================================
 
-typedef struct {
-	int				numShaders;
-	int				numStages;
-	int				numMeshes;
-	int				numLeafs;
-	int				numVertices;
-	int				numIndices;
-	int				totalIndices;
-
-	int				numEntities;
-	int				numDLights;
-	int				numParticles;
-	int				numPolys;
-} refStats_t;
-
 extern model_t		*r_worldModel;
 extern entity_t		*r_worldEntity;
 
@@ -1017,6 +1048,10 @@ extern refStats_t	r_stats;
 
 void		R_DrawAliasModel (void);
 void		R_AddAliasModelToList (entity_t *entity);
+void		R_ClearAliasModelCache (void);
+void		R_InterpolateAliasModels (void);
+const float	*R_GetAliasModelVertices (entity_t *entity, mdl_t *alias, int surfaceNum, qboolean lerpVectors);
+void		R_ShutdownAliasModelCache (void);
 
 void		R_MarkLights (void);
 void		R_LightDir (const vec3_t origin, vec3_t lightDir);
@@ -1064,6 +1099,21 @@ void		R_DrawSurface (void);
 void		R_AddBrushModelToList (entity_t *entity);
 void		R_AddWorldToList (void);
 
+/*
+ =======================================================================
+
+ SCENE RECORDING
+
+ =======================================================================
+*/
+
+void		R_RecordWorldMap (const char *mapName, const char *skyName, float skyRotate, const vec3_t skyAxis);
+void		R_RecordFrame (int realTime);
+void		R_RecordScene (void);
+void		R_RecordScenes_f (void);
+void		R_StopScenes_f (void);
+void		R_ShutdownRecording (qboolean all);
+
 /*
  =======================================================================
 
@@ -1086,7 +1136,17 @@ extern glConfig_t		glConfig;
 
 #else
 
-#error "GLimp_* not available for this platform"
+// Other platforms only have the null driver in null/glw_null.c and
+// null/qgl_null.c, which draws nothing. Everything the renderer does on
+// the CPU still runs, so it can be measured on machines without a GPU.
+
+#define GL_DRIVER_OPENGL	"null"
+
+void		GLimp_SetDeviceGammaRamp (unsigned short *gammaRamp);
+void		GLimp_SwapBuffers (void);
+void		GLimp_Activate (qboolean active);
+void		GLimp_Init (void);
+void		GLimp_Shutdown (void);
 
 #endif
 
@@ -37,6 +37,13 @@ int				r_numSolidMeshes;
 mesh_t			r_transMeshes[MAX_MESHES];
 int				r_numTransMeshes;
 
+// The order the meshes are drawn in, and the keys that decide it
+static unsigned long long	r_solidSortKeys[MAX_MESHES];
+static int		r_solidSorted[MAX_MESHES];
+
+static unsigned long long	r_transSortKeys[MAX_MESHES];
+static int		r_transSorted[MAX_MESHES];
+
 entity_t		r_entities[MAX_ENTITIES];
 int				r_numEntities;
 
@@ -698,98 +705,135 @@ static void R_AddPolysToList (void){
 
 /*
  =================
- R_QSortMeshes
+ R_SortMeshes
+
+ Stable radix sort, 8 bits of the 64 bit key at a time. Only the keys and the
+ mesh indices move, and passes where all keys share the same digit are
+ skipped, so a list with few distinct keys costs little more than a
+ copy.
  =================
 */
-static void R_QSortMeshes (mesh_t *meshes, int numMeshes){
-
-	static mesh_t	tmp;
-	static int		stack[4096];
-	int				depth = 0;
-	int				L, R, l, r, median;
-	unsigned		pivot;
+static void R_SortMeshes (const unsigned long long *keys, int numMeshes, int *sorted){
+
+	static unsigned long long	tmpKeys[2][MAX_MESHES];
+	static int					tmpIndices[2][MAX_MESHES];
+	int							counts[8][256];
+	const unsigned long long	*inKeys;
+	const int					*inIndices;
+	unsigned long long			*outKeys;
+	int							*outIndices;
+	int							offsets[256];
+	unsigned					lo, hi;
+	int							pass, shift, buffer;
+	int							i, digit, total;
 
 	if (!numMeshes)
 		return;
 
-	L = 0;
-	R = numMeshes - 1;
-
-start:
-	l = L;
-	r = R;
+	// Count the digits of all passes at once
+	memset(counts, 0, sizeof(counts));
+
+	for (i = 0; i < numMeshes; i++){
+		lo = (unsigned)keys[i];
+		hi = (unsigned)(keys[i] >> 32);
+
+		counts[0][lo & 255]++;
+		counts[1][(lo >> 8) & 255]++;
+		counts[2][(lo >> 16) & 255]++;
+		counts[3][lo >> 24]++;
+		counts[4][hi & 255]++;
+		counts[5][(hi >> 8) & 255]++;
+		counts[6][(hi >> 16) & 255]++;
+		counts[7][hi >> 24]++;
+	}
 
-	median = (L + R) >> 1;
+	inKeys = keys;
+	inIndices = NULL;
 
-	if (meshes[L].sortKey > meshes[median].sortKey){
-		if (meshes[L].sortKey < meshes[R].sortKey) 
-			median = L;
-	} 
-	else if (meshes[R].sortKey < meshes[median].sortKey)
-		median = R;
+	for (pass = 0, shift = 0, buffer = 0; pass < 8; pass++, shift += 8){
+		if (counts[pass][(keys[0] >> shift) & 255] == numMeshes)
+			continue;
 
-	pivot = meshes[median].sortKey;
+		for (digit = 0, total = 0; digit < 256; digit++){
+			offsets[digit] = total;
+			total += counts[pass][digit];
+		}
 
-	while (l < r){
-		while (meshes[l].sortKey < pivot)
-			l++;
-		while (meshes[r].sortKey > pivot)
-			r--;
+		outKeys = tmpKeys[buffer];
+		outIndices = tmpIndices[buffer];
 
-		if (l <= r){
-			tmp = meshes[r];
-			meshes[r] = meshes[l];
-			meshes[l] = tmp;
+		for (i = 0; i < numMeshes; i++){
+			digit = (inKeys[i] >> shift) & 255;
 
-			l++;
-			r--;
+			outKeys[offsets[digit]] = inKeys[i];
+			outIndices[offsets[digit]++] = (inIndices) ? inIndices[i] : i;
 		}
-	}
 
-	if ((L < r) && (depth < 4096)){
-		stack[depth++] = l;
-		stack[depth++] = R;
-		R = r;
-		goto start;
-	}
+		inKeys = outKeys;
+		inIndices = outIndices;
 
-	if (l < R){
-		L = l;
-		goto start;
+		buffer ^= 1;
 	}
 
-	if (depth){
-		R = stack[--depth];
-		L = stack[--depth];
-		goto start;
+	if (inIndices){
+		memcpy(sorted, inIndices, numMeshes * sizeof(int));
+		return;
 	}
+
+	// Already in order
+	for (i = 0; i < numMeshes; i++)
+		sorted[i] = i;
 }
 
 /*
  =================
- R_ISortMeshes
+ R_MeshDepth
+
+ Distance of a mesh along the view direction, used to draw translucent
+ meshes back to front
  =================
 */
-static void R_ISortMeshes (mesh_t *meshes, int numMeshes){
+static float R_MeshDepth (meshType_t meshType, void *mesh, entity_t *entity){
 
-	static mesh_t	tmp;
-	int				i, j;
+	surface_t	*surf;
+	vec3_t		origin, center;
 
-	if (!numMeshes)
-		return;
+	switch (meshType){
+	case MESH_SURFACE:
+		surf = mesh;
 
-	for (i = 1; i < numMeshes; i++){
-		tmp = meshes[i];
-		j = i - 1;
+		VectorAdd(surf->mins, surf->maxs, center);
+		VectorScale(center, 0.5, center);
 
-		while ((j >= 0) && (meshes[j].sortKey > tmp.sortKey)){
-			meshes[j+1] = meshes[j];
-			j--;
+		if (entity == r_worldEntity){
+			VectorCopy(center, origin);
+			break;
 		}
 
-		if (i != j+1)
-			meshes[j+1] = tmp;
+		VectorCopy(entity->origin, origin);
+		VectorMA(origin, center[0], entity->axis[0], origin);
+		VectorMA(origin, center[1], entity->axis[1], origin);
+		VectorMA(origin, center[2], entity->axis[2], origin);
+
+		break;
+	case MESH_ALIASMODEL:
+	case MESH_SPRITE:
+	case MESH_BEAM:
+		VectorCopy(entity->origin, origin);
+		break;
+	case MESH_PARTICLE:
+		VectorCopy(((particle_t *)mesh)->origin, origin);
+		break;
+	case MESH_POLY:
+		VectorCopy(((poly_t *)mesh)->verts[0].xyz, origin);
+		break;
+	default:
+		return 1e30;
 	}
+
+	VectorSubtract(origin, r_refDef.viewOrigin, origin);
+
+	return DotProduct(origin, r_refDef.viewAxis[0]);
 }
 
 /*
@@ -802,22 +846,46 @@ static void R_ISortMeshes (mesh_t *meshes, int numMeshes){
 */
 void R_AddMeshToList (meshType_t meshType, void *mesh, shader_t *shader, entity_t *entity, int infoKey){
 
-	mesh_t	*m;
+	mesh_t				*m;
+	unsigned long long	sortKey;
+	float				depth;
+	unsigned			bits;
+
+	sortKey = ((unsigned long long)shader->sort << SORTKEY_SORT_SHIFT);
+	sortKey |= ((unsigned long long)shader->shaderNum << SORTKEY_SHADER_SHIFT);
+	sortKey |= ((unsigned long long)infoKey << SORTKEY_INFO_SHIFT);
+	sortKey |= ((unsigned long long)(entity - r_entities) << SORTKEY_ENTITY_SHIFT);
 
 	if (shader->sort <= SORT_DECAL){
 		if (r_numSolidMeshes == MAX_MESHES)
 			Com_Error(ERR_DROP, "R_AddMeshToList: MAX_MESHES hit");
 
-		m = &r_solidMeshes[r_numSolidMeshes++];
+		m = &r_solidMeshes[r_numSolidMeshes];
+
+		m->sortKey = sortKey;
+
+		// Solid meshes are drawn grouped by state
+		r_solidSortKeys[r_numSolidMeshes++] = m->sortKey;
 	}
 	else {
 		if (r_numTransMeshes == MAX_MESHES)
 			Com_Error(ERR_DROP, "R_AddMeshToList: MAX_MESHES hit");
 
-		m = &r_transMeshes[r_numTransMeshes++];
-	}
+		m = &r_transMeshes[r_numTransMeshes];
+
+		m->sortKey = sortKey;
+
+		// Translucent meshes are drawn back to front within each sort
+		// value. The bits of a positive float compare like an integer,
+		// so the farther the mesh the smaller the key.
+		depth = R_MeshDepth(meshType, mesh, entity);
+		if (depth < 0.0)
+			depth = 0.0;
 
-	m->sortKey = (shader->sort << 28) | (shader->shaderNum << 18) | ((entity - r_entities) << 8) | (infoKey);
+		bits = *(unsigned *)&depth;
+
+		r_transSortKeys[r_numTransMeshes++] = ((unsigned long long)shader->sort << SORTKEY_SORT_SHIFT) | ((unsigned long long)((0x7FFFFFFF - bits) >> 3) << 32);
+	}
 
 	m->meshType = meshType;
 	m->mesh = mesh;
@@ -992,24 +1060,43 @@ static void R_SetGammaRamp (void){
 */
 void R_RenderView (void){
 
+	unsigned	time[6];
+
 	if (r_skipFrontEnd->integer)
 		return;
 
 	r_numSolidMeshes = 0;
 	r_numTransMeshes = 0;
 
+	R_ClearAliasModelCache();
+
+	time[0] = Sys_Microseconds();
+
 	// Set up frustum
 	R_SetFrustum();
 
 	// Build mesh lists
 	R_AddWorldToList();
+
+	time[1] = Sys_Microseconds();
+
 	R_AddEntitiesToList();
+
+	// Interpolate alias models on the job threads
+	R_InterpolateAliasModels();
+
+	time[2] = Sys_Microseconds();
+
 	R_AddParticlesToList();
 	R_AddPolysToList();
 
+	time[3] = Sys_Microseconds();
+
 	// Sort mesh lists
-	R_QSortMeshes(r_solidMeshes, r_numSolidMeshes);
-	R_ISortMeshes(r_transMeshes, r_numTransMeshes);
+	R_SortMeshes(r_solidSortKeys, r_numSolidMeshes, r_solidSorted);
+	R_SortMeshes(r_transSortKeys, r_numTransMeshes, r_transSorted);
+
+	time[4] = Sys_Microseconds();
 
 	// Set up matrices
 	R_SetMatrices();
@@ -1018,14 +1105,23 @@ void R_RenderView (void){
 	GL_Setup3D();
 
 	// Render everything
-	RB_RenderMeshes(r_solidMeshes, r_numSolidMeshes);
+	RB_RenderMeshes(r_solidMeshes, r_solidSorted, r_numSolidMeshes);
 
 	R_RenderShadows();
 
-	RB_RenderMeshes(r_transMeshes, r_numTransMeshes);
+	RB_RenderMeshes(r_transMeshes, r_transSorted, r_numTransMeshes);
 
 	// Finish up
 	R_DrawNullModels();
+
+	time[5] = Sys_Microseconds();
+
+	// Update r_speeds statistics
+	r_stats.timeWorld += time[1] - time[0];
+	r_stats.timeEntities += time[2] - time[1];
+	r_stats.timeParticles += time[3] - time[2];
+	r_stats.timeSort += time[4] - time[3];
+	r_stats.timeBackEnd += time[5] - time[4];
 }
 
 /*
@@ -1137,6 +1233,8 @@ void R_RenderScene (const refDef_t *rd){
 			Com_Error(ERR_DROP, "R_RenderScene: NULL worldmodel");
 	}
 
+	R_RecordScene();
+
 	// Make sure all 2D stuff is flushed
 	RB_RenderMesh();
 
@@ -1239,6 +1337,21 @@ void R_GetGLConfig (glConfig_t *config){
 	*config = glConfig;
 }
 
+/*
+ =================
+ R_GetStats
+
+ Used by the renderer benchmark to get the r_speeds statistics
+ =================
+*/
+void R_GetStats (refStats_t *stats){
+
+	if (!stats)
+		return;
+
+	*stats = r_stats;
+}
+
 /*
  =================
  R_GetModeInfo
@@ -1274,6 +1387,8 @@ void R_BeginFrame (int realTime, float stereoSeparation){
 	// Set frame time
 	r_frameTime = realTime * 0.001;
 
+	R_RecordFrame(realTime);
+
 	// Clear r_speeds statistics
 	memset(&r_stats, 0, sizeof(refStats_t));
 
@@ -1362,6 +1477,9 @@ void R_EndFrame (void){
 		case 2:
 			Com_Printf("%i entities %i dlights %i particles %i polys\n", r_stats.numEntities, r_stats.numDLights, r_stats.numParticles, r_stats.numPolys);
 			break;
+		case 3:
+			Com_Printf("%u world %u entities %u particles %u sort %u backend usec\n", r_stats.timeWorld, r_stats.timeEntities, r_stats.timeParticles, r_stats.timeSort, r_stats.timeBackEnd);
+			break;
 		}
 	}
 
@@ -1417,6 +1535,9 @@ void R_Shutdown (qboolean all){
 
 	Com_Printf("R_Shutdown( %i )\n", all);
 
+	R_ShutdownRecording(all);
+
+	R_ShutdownAliasModelCache();
 	R_ShutdownModels();
 	R_ShutdownShaders();
 	R_ShutdownPrograms();
@@ -36,6 +36,8 @@ static model_t	r_inlineModels[MAX_MODELS];
 
 static byte		r_noMapVis[MAX_MAP_LEAFS/8];
 
+static const byte	*r_worldMapData;		// Still mapped if R_LoadWorldMap failed
+
 
 /*
  =================
@@ -44,31 +46,26 @@ static byte		r_noMapVis[MAX_MAP_LEAFS/8];
 */
 leaf_t *R_PointInLeaf (const vec3_t p){
 
-	node_t		*node;
-	cplane_t	*plane;
+	pointNode_t	*node;
+	int			nodeNum;
 	float		d;
 
 	if (!r_worldModel || !r_worldModel->nodes)
 		Com_Error(ERR_DROP, "R_PointInLeaf: NULL worldmodel");
 
-	node = r_worldModel->nodes;
-	while (1){
-		if (node->contents != -1)
-			return (leaf_t *)node;
+	nodeNum = 0;
+	while (nodeNum >= 0){
+		node = &r_worldModel->pointNodes[nodeNum];
 
-		plane = node->plane;
-		if (plane->type < 3)
-			d = p[plane->type] - plane->dist;
+		if (node->type < 3)
+			d = p[node->type] - node->dist;
 		else
-			d = DotProduct(p, plane->normal) - plane->dist;
+			d = DotProduct(p, node->normal) - node->dist;
 
-		if (d > 0)
-			node = node->children[0];
-		else
-			node = node->children[1];
+		nodeNum = node->children[d <= 0];
 	}
-	
-	return NULL;	// Never reached
+
+	return r_worldModel->leafs + (-1 - nodeNum);
 }
 
 /*
@@ -339,6 +336,18 @@ static void R_LoadTexInfo (const byte *data, const lump_t *l){
 	r_worldModel->texInfo = out = Hunk_Alloc(r_worldModel->numTexInfo * sizeof(texInfo_t));
 	r_worldModel->size += r_worldModel->numTexInfo * sizeof(texInfo_t);
 
+	// Let the loader threads decode the textures while the shaders are
+	// being set up
+	if (!r_singleShader->integer){
+		for (i = 0; i < r_worldModel->numTexInfo; i++){
+			if (LittleLong(in[i].flags) & (SURF_SKY | SURF_NODRAW))
+				continue;
+
+			Q_snprintfz(name, sizeof(name), "textures/%s", in[i].texture);
+			R_QueueTexture(name, LOAD_PRIORITY_WORLD);
+		}
+	}
+
 	for (i = 0; i < r_worldModel->numTexInfo; i++, in++, out++){
 		for (j = 0; j < 4; j++){
 			out->vecs[0][j] = LittleFloat(in->vecs[0][j]);
@@ -949,9 +958,10 @@ static void R_SetParent (node_t *node, node_t *parent){
 */
 static void R_LoadNodes (const byte *data, const lump_t *l){
 
-	dnode_t	*in;
-	node_t	*out;
-	int		i, j, p;
+	dnode_t		*in;
+	node_t		*out;
+	pointNode_t	*pointNode;
+	int			i, j, p;
 
 	in = (dnode_t *)(data + l->fileOfs);
 	if (l->fileLen % sizeof(dnode_t))
@@ -961,6 +971,9 @@ static void R_LoadNodes (const byte *data, const lump_t *l){
 	r_worldModel->nodes = out = Hunk_Alloc(r_worldModel->numNodes * sizeof(node_t));
 	r_worldModel->size += r_worldModel->numNodes * sizeof(node_t);
 
+	r_worldModel->pointNodes = pointNode = Hunk_Alloc(r_worldModel->numNodes * sizeof(pointNode_t));
+	r_worldModel->size += r_worldModel->numNodes * sizeof(pointNode_t);
+
 	for (i = 0; i < r_worldModel->numNodes; i++, in++, out++){
 		for (j = 0; j < 3; j++){
 			out->mins[j] = LittleShort(in->mins[j]);
@@ -979,7 +992,17 @@ static void R_LoadNodes (const byte *data, const lump_t *l){
 				out->children[j] = r_worldModel->nodes + p;
 			else
 				out->children[j] = (node_t *)(r_worldModel->leafs + (-1 - p));
+
+			pointNode->children[j] = p;
 		}
+
+		// Flatten the node for point queries
+		VectorCopy(out->plane->normal, pointNode->normal);
+		pointNode->dist = out->plane->dist;
+		pointNode->type = out->plane->type;
+		pointNode->pad = 0;
+
+		pointNode++;
 	}
 
 	// Set nodes and leafs
@@ -1120,6 +1143,73 @@ static void R_LoadLightgridFile (void){
 	FS_FreeFile(data);
 }
 
+/*
+ =================
+ R_BuildVertexBuffer
+
+ If VBO is enabled, put the vertices of all the surfaces in a static
+ buffer, so surfaces with simple shaders are drawn by index only
+ =================
+*/
+static void R_BuildVertexBuffer (void){
+
+	surface_t			*surf;
+	surfPoly_t			*p;
+	surfPolyVert_t		*v;
+	surfBufferVert_t	*out;
+	int					numVertices;
+	int					i, j;
+
+	if (!glConfig.vertexBufferObject)
+		return;
+
+	numVertices = 0;
+
+	for (i = 0, surf = r_worldModel->surfaces; i < r_worldModel->numSurfaces; i++, surf++){
+		for (p = surf->poly; p; p = p->next)
+			numVertices += p->numVertices;
+	}
+
+	if (!numVertices)
+		return;
+
+	r_worldModel->vertexBuffer = RB_AllocStaticBuffer(GL_ARRAY_BUFFER_ARB, numVertices * sizeof(surfBufferVert_t));
+
+	// Fill it in
+	out = qglMapBufferARB(GL_ARRAY_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+	if (!out){
+		r_worldModel->vertexBuffer = 0;
+		return;
+	}
+
+	r_worldModel->numBufferVertices = numVertices;
+
+	numVertices = 0;
+
+	for (i = 0, surf = r_worldModel->surfaces; i < r_worldModel->numSurfaces; i++, surf++){
+		for (p = surf->poly; p; p = p->next){
+			p->firstBufferVertex = numVertices;
+
+			for (j = 0, v = p->vertices; j < p->numVertices; j++, v++, out++){
+				VectorCopy(v->xyz, out->xyz);
+				VectorCopy(surf->normal, out->normal);
+				out->st[0] = v->st[0];
+				out->st[1] = v->st[1];
+				out->lightmap[0] = v->lightmap[0];
+				out->lightmap[1] = v->lightmap[1];
+				out->color[0] = v->color[0];
+				out->color[1] = v->color[1];
+				out->color[2] = v->color[2];
+				out->color[3] = v->color[3];
+			}
+
+			numVertices += p->numVertices;
+		}
+	}
+
+	qglUnmapBufferARB(GL_ARRAY_BUFFER_ARB);
+}
+
 /*
  =================
  R_LoadWorldMap
@@ -1127,19 +1217,22 @@ static void R_LoadLightgridFile (void){
 */
 void R_LoadWorldMap (const char *mapName, const char *skyName, float skyRotate, const vec3_t skyAxis){
 
-	int			i;
-	byte		*data;
-	dheader_t	*header;
+	int			i, length;
+	const byte	*data;
+	dheader_t	header;
 	unsigned	hashKey;
 
 	if (r_worldModel)
 		Com_Error(ERR_DROP, "R_LoadWorldMap: attempted to redundantly load world map");
 
 	// Load the file
-	FS_LoadFile(mapName, (void **)&data);
+	length = FS_MapFile(mapName, (const void **)&data);
 	if (!data)
 		Com_Error(ERR_DROP, "R_LoadWorldMap: '%s' not found", mapName);
 
+	// Any error below leaves the file mapped until R_ShutdownModels
+	r_worldMapData = data;
+
 	r_models[r_numModels++] = r_worldModel = Hunk_Alloc(sizeof(model_t));
 
 	// Fill it in
@@ -1147,33 +1240,40 @@ void R_LoadWorldMap (const char *mapName, const char *skyName, float skyRotate,
 	Q_strncpyz(r_worldModel->realName, mapName, sizeof(r_worldModel->realName));
 	r_worldModel->modelType = MODEL_BSP;
 
-	header = (dheader_t *)data;
+	if (length < sizeof(dheader_t))
+		Com_Error(ERR_DROP, "R_LoadWorldMap: '%s' is too short", r_worldModel->realName);
+
+	// The file data may be mapped read-only, so swap a copy of the header
+	memcpy(&header, data, sizeof(dheader_t));
 
 	// Byte swap the header fields and sanity check
 	for (i = 0; i < sizeof(dheader_t) / 4; i++)
-		((int *)header)[i] = LittleLong(((int *)header)[i]);
+		((int *)&header)[i] = LittleLong(((int *)&header)[i]);
 
-	if (header->ident != BSP_IDENT)
+	if (header.ident != BSP_IDENT)
 		Com_Error(ERR_DROP, "R_LoadWorldMap: '%s' has wrong file id", r_worldModel->realName);
 
-	if (header->version != BSP_VERSION)
-		Com_Error(ERR_DROP, "R_LoadWorldMap: '%s' has wrong version number (%i should be %i)", r_worldModel->realName, header->version, BSP_VERSION);
+	if (header.version != BSP_VERSION)
+		Com_Error(ERR_DROP, "R_LoadWorldMap: '%s' has wrong version number (%i should be %i)", r_worldModel->realName, header.version, BSP_VERSION);
 
 	// Load into heap
-	R_LoadVertexes(data, &header->lumps[LUMP_VERTEXES]);
-	R_LoadEdges(data, &header->lumps[LUMP_EDGES]);
-	R_LoadSurfEdges(data, &header->lumps[LUMP_SURFEDGES]);
-	R_LoadLighting(data, &header->lumps[LUMP_LIGHTING]);
-	R_LoadPlanes(data, &header->lumps[LUMP_PLANES]);
-	R_LoadTexInfo(data, &header->lumps[LUMP_TEXINFO]);
-	R_LoadFaces(data, &header->lumps[LUMP_FACES]);
-	R_LoadMarkSurfaces(data, &header->lumps[LUMP_LEAFFACES]);
-	R_LoadVisibility(data, &header->lumps[LUMP_VISIBILITY]);
-	R_LoadLeafs(data, &header->lumps[LUMP_LEAFS]);
-	R_LoadNodes(data, &header->lumps[LUMP_NODES]);
-	R_LoadSubmodels(data, &header->lumps[LUMP_MODELS]);
-
-	FS_FreeFile(data);
+	R_LoadVertexes(data, &header.lumps[LUMP_VERTEXES]);
+	R_LoadEdges(data, &header.lumps[LUMP_EDGES]);
+	R_LoadSurfEdges(data, &header.lumps[LUMP_SURFEDGES]);
+	R_LoadLighting(data, &header.lumps[LUMP_LIGHTING]);
+	R_LoadPlanes(data, &header.lumps[LUMP_PLANES]);
+	R_LoadTexInfo(data, &header.lumps[LUMP_TEXINFO]);
+	R_LoadFaces(data, &header.lumps[LUMP_FACES]);
+	R_LoadMarkSurfaces(data, &header.lumps[LUMP_LEAFFACES]);
+	R_LoadVisibility(data, &header.lumps[LUMP_VISIBILITY]);
+	R_LoadLeafs(data, &header.lumps[LUMP_LEAFS]);
+	R_LoadNodes(data, &header.lumps[LUMP_NODES]);
+	R_LoadSubmodels(data, &header.lumps[LUMP_MODELS]);
+
+	FS_UnmapFile(data);
+	r_worldMapData = NULL;
+
+	R_BuildVertexBuffer();
 
 	// Set up some needed things
 	r_worldEntity->model = r_worldModel;
@@ -1192,6 +1292,8 @@ void R_LoadWorldMap (const char *mapName, const char *skyName, float skyRotate,
 
 	r_worldModel->nextHash = r_modelsHash[hashKey];
 	r_modelsHash[hashKey] = r_worldModel;
+
+	R_RecordWorldMap(mapName, skyName, skyRotate, skyAxis);
 }
 
 
@@ -1309,6 +1411,42 @@ static int R_FindTriangleWithEdge (int numTriangles, mdlTriangle_t *triangles, u
 	return match;
 }
 
+/*
+ =================
+ R_DecodeFrameVertices
+
+ Decodes the compressed vertex positions of every frame to floats, so
+ interpolation doesn't need to scale and translate them every time
+ =================
+*/
+static void R_DecodeFrameVertices (model_t *model, mdl_t *alias, mdlSurface_t *surface){
+
+	mdlFrame_t		*frame;
+	mdlXyzNormal_t	*xyzNormal;
+	float			*xyz;
+	int				stride;
+	int				i, j, k;
+
+	stride = MDL_VERTEX_STRIDE(surface->numVertices);
+
+	surface->frameXyz = xyz = Hunk_Alloc(alias->numFrames * stride * 3 * sizeof(float));
+
+	model->size += alias->numFrames * stride * 3 * sizeof(float);
+
+	for (i = 0, frame = alias->frames; i < alias->numFrames; i++, frame++){
+		xyzNormal = surface->xyzNormals + surface->numVertices * i;
+
+		for (j = 0; j < 3; j++, xyz += stride){
+			for (k = 0; k < surface->numVertices; k++)
+				xyz[k] = frame->translate[j] + xyzNormal[k].xyz[j] * frame->scale[j];
+
+			// Clear the padding
+			for ( ; k < stride; k++)
+				xyz[k] = 0.0;
+		}
+	}
+}
+
 /*
  =================
  R_BuildTriangleNeighbors
@@ -1518,6 +1656,9 @@ static void R_LoadMD2 (model_t *model, const byte *data){
 		R_CalcTangentSpace(outSurface->numTriangles, outSurface->triangles, outSurface->numVertices, outSurface->xyzNormals, outSurface->st, i);
 	}
 
+	// Decode vertices
+	R_DecodeFrameVertices(model, outModel, outSurface);
+
 	// Build triangle neighbors
 	outSurface->neighbors = Hunk_Alloc(outSurface->numTriangles * sizeof(mdlNeighbor_t));
 	model->size += outSurface->numTriangles * sizeof(mdlNeighbor_t);
@@ -1760,6 +1901,9 @@ static void R_LoadMD3 (model_t *model, const byte *data){
 			R_CalcTangentSpace(outSurface->numTriangles, outSurface->triangles, outSurface->numVertices, outSurface->xyzNormals, outSurface->st, j);
 		}
 
+		// Decode vertices
+		R_DecodeFrameVertices(model, outModel, outSurface);
+
 		// Build triangle neighbors
 		outSurface->neighbors = Hunk_Alloc(outSurface->numTriangles * sizeof(mdlNeighbor_t));
 		model->size += outSurface->numTriangles * sizeof(mdlNeighbor_t);
@@ -1982,6 +2126,21 @@ model_t *R_RegisterModel (const char *name){
 	return R_FindModel(name);
 }
 
+/*
+ =================
+ R_InlineModelNumber
+
+ Returns -1 if the model was not loaded from the world map
+ =================
+*/
+int R_InlineModelNumber (model_t *model){
+
+	if (model < r_inlineModels || model >= r_inlineModels + MAX_MODELS)
+		return -1;
+
+	return model - r_inlineModels;
+}
+
 /*
  =================
  R_ModelBounds
@@ -2056,6 +2215,11 @@ void R_InitModels (void){
 */
 void R_ShutdownModels (void){
 
+	if (r_worldMapData){
+		FS_UnmapFile(r_worldMapData);
+		r_worldMapData = NULL;
+	}
+
 	r_worldModel = NULL;
 	r_worldEntity = NULL;
 
@@ -0,0 +1,417 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+// r_record.c -- scene recording
+//
+// Writes everything the client hands to the refresh into a .scn file, so
+// the same frames can be rendered again without a client or a server.
+// The renderer benchmark plays these back.
+
+
+#include "r_local.h"
+
+
+typedef struct {
+	fileHandle_t	file;
+	char			name[MAX_OSPATH];
+
+	byte			*buffer;
+
+	// Models and shaders already written to the file
+	model_t			*models[MAX_MODELS * 2];
+	int				numModels;
+
+	qboolean		shaders[MAX_SHADERS];
+
+	// The current world map, so a recording can start in the middle of
+	// a level
+	qboolean		worldLoaded;
+	sceneWorld_t	world;
+} sceneRecording_t;
+
+static sceneRecording_t	r_recording;
+
+
+/*
+ =================
+ R_WriteSceneRecord
+ =================
+*/
+static void R_WriteSceneRecord (sceneRecordType_t type, const void *data, int length){
+
+	sceneRecord_t	record;
+
+	record.type = type;
+	record.length = length;
+
+	FS_Write(&record, sizeof(sceneRecord_t), r_recording.file);
+	FS_Write(data, length, r_recording.file);
+}
+
+/*
+ =================
+ R_RecordModel
+ =================
+*/
+static int R_RecordModel (model_t *model){
+
+	sceneModel_t	out;
+	int				i;
+
+	if (!model)
+		return -1;
+
+	for (i = 0; i < r_recording.numModels; i++){
+		if (r_recording.models[i] == model)
+			return i;
+	}
+
+	if (r_recording.numModels == MAX_MODELS * 2)
+		Com_Error(ERR_DROP, "R_RecordModel: MAX_MODELS hit");
+
+	r_recording.models[r_recording.numModels] = model;
+
+	out.index = r_recording.numModels++;
+
+	i = R_InlineModelNumber(model);
+	if (i != -1)
+		Q_snprintfz(out.name, sizeof(out.name), "*%i", i);
+	else
+		Q_strncpyz(out.name, model->realName, sizeof(out.name));
+
+	R_WriteSceneRecord(SCN_MODEL, &out, sizeof(sceneModel_t));
+
+	return out.index;
+}
+
+/*
+ =================
+ R_RecordShader
+ =================
+*/
+static int R_RecordShader (shader_t *shader){
+
+	sceneShader_t	out;
+
+	if (!shader)
+		return -1;
+
+	if (r_recording.shaders[shader->shaderNum])
+		return shader->shaderNum;
+
+	r_recording.shaders[shader->shaderNum] = true;
+
+	out.index = shader->shaderNum;
+
+	switch (shader->shaderType){
+	case SHADER_SKIN:
+		out.type = SCN_SHADER_SKIN;
+		break;
+	case SHADER_NOMIP:
+		out.type = SCN_SHADER_NOMIP;
+		break;
+	default:
+		out.type = SCN_SHADER_GENERIC;
+		break;
+	}
+
+	Q_strncpyz(out.name, shader->name, sizeof(out.name));
+
+	R_WriteSceneRecord(SCN_SHADER, &out, sizeof(sceneShader_t));
+
+	return out.index;
+}
+
+/*
+ =================
+ R_RecordWorldMap
+
+ Called for every map load, recording or not
+ =================
+*/
+void R_RecordWorldMap (const char *mapName, const char *skyName, float skyRotate, const vec3_t skyAxis){
+
+	// Everything registered so far belonged to the previous map
+	r_recording.numModels = 0;
+	memset(r_recording.shaders, 0, sizeof(r_recording.shaders));
+
+	r_recording.worldLoaded = true;
+
+	memset(&r_recording.world, 0, sizeof(sceneWorld_t));
+	Q_strncpyz(r_recording.world.mapName, mapName, sizeof(r_recording.world.mapName));
+	Q_strncpyz(r_recording.world.skyName, skyName, sizeof(r_recording.world.skyName));
+	r_recording.world.skyRotate = skyRotate;
+	VectorCopy(skyAxis, r_recording.world.skyAxis);
+
+	if (!r_recording.file)
+		return;
+
+	R_WriteSceneRecord(SCN_WORLD, &r_recording.world, sizeof(sceneWorld_t));
+}
+
+/*
+ =================
+ R_RecordFrame
+ =================
+*/
+void R_RecordFrame (int realTime){
+
+	sceneFrame_t	out;
+
+	if (!r_recording.file)
+		return;
+
+	out.realTime = realTime;
+
+	R_WriteSceneRecord(SCN_FRAME, &out, sizeof(sceneFrame_t));
+}
+
+/*
+ =================
+ R_RecordScene
+
+ Writes r_refDef and the scene that was built for it
+ =================
+*/
+void R_RecordScene (void){
+
+	sceneView_t		*view;
+	sceneEntity_t	*entity;
+	sceneDLight_t	*dlight;
+	sceneParticle_t	*particle;
+	scenePoly_t		*poly;
+	scenePolyVert_t	*polyVert;
+	entity_t		*e;
+	dlight_t		*dl;
+	particle_t		*p;
+	poly_t			*pl;
+	polyVert_t		*pv;
+	int				i;
+
+	if (!r_recording.file)
+		return;
+
+	// View
+	view = (sceneView_t *)r_recording.buffer;
+
+	view->x = r_refDef.x;
+	view->y = r_refDef.y;
+	view->width = r_refDef.width;
+	view->height = r_refDef.height;
+	view->fovX = r_refDef.fovX;
+	view->fovY = r_refDef.fovY;
+	VectorCopy(r_refDef.viewOrigin, view->viewOrigin);
+	AxisCopy(r_refDef.viewAxis, view->viewAxis);
+	view->time = r_refDef.time;
+	view->rdFlags = r_refDef.rdFlags;
+
+	if (r_refDef.areaBits){
+		view->hasAreaBits = true;
+		memcpy(view->areaBits, r_refDef.areaBits, sizeof(view->areaBits));
+	}
+	else {
+		view->hasAreaBits = false;
+		memset(view->areaBits, 0, sizeof(view->areaBits));
+	}
+
+	for (i = 0; i < MAX_LIGHTSTYLES; i++)
+		VectorCopy(r_lightStyles[i].rgb, view->lightStyles[i]);
+
+	view->numEntities = r_numEntities - 1;
+	view->numDLights = r_numDLights;
+	view->numParticles = r_numParticles;
+	view->numPolys = r_numPolys;
+	view->numPolyVerts = r_numPolyVerts;
+
+	// Entities, skipping the world entity
+	entity = (sceneEntity_t *)(view + 1);
+
+	for (i = 1, e = &r_entities[1]; i < r_numEntities; i++, e++, entity++){
+		entity->entityType = e->entityType;
+		entity->renderFX = e->renderFX;
+		entity->flags = e->flags;
+		entity->model = R_RecordModel(e->model);
+		AxisCopy(e->axis, entity->axis);
+		VectorCopy(e->origin, entity->origin);
+		entity->frame = e->frame;
+		VectorCopy(e->oldOrigin, entity->oldOrigin);
+		entity->oldFrame = e->oldFrame;
+		entity->backLerp = e->backLerp;
+		entity->ammoValue = e->ammoValue;
+		entity->radius = e->radius;
+		entity->rotation = e->rotation;
+		entity->skinNum = e->skinNum;
+		entity->customShader = R_RecordShader(e->customShader);
+		*(unsigned *)entity->shaderRGBA = *(unsigned *)e->shaderRGBA;
+		entity->shaderTime = e->shaderTime;
+	}
+
+	// Dynamic lights
+	dlight = (sceneDLight_t *)entity;
+
+	for (i = 0, dl = r_dlights; i < r_numDLights; i++, dl++, dlight++){
+		VectorCopy(dl->origin, dlight->origin);
+		VectorCopy(dl->color, dlight->color);
+		dlight->intensity = dl->intensity;
+	}
+
+	// Particles
+	particle = (sceneParticle_t *)dlight;
+
+	for (i = 0, p = r_particles; i < r_numParticles; i++, p++, particle++){
+		particle->shader = R_RecordShader(p->shader);
+		VectorCopy(p->origin, particle->origin);
+		VectorCopy(p->oldOrigin, particle->oldOrigin);
+		particle->radius = p->radius;
+		particle->length = p->length;
+		particle->rotation = p->rotation;
+		*(unsigned *)particle->modulate = *(unsigned *)p->modulate;
+		particle->flags = p->flags;
+	}
+
+	// Polys
+	poly = (scenePoly_t *)particle;
+
+	for (i = 0, pl = r_polys; i < r_numPolys; i++, pl++, poly++){
+		poly->shader = R_RecordShader(pl->shader);
+		poly->numVerts = pl->numVerts;
+	}
+
+	// The vertices of all the polys are stored one after the other
+	polyVert = (scenePolyVert_t *)poly;
+
+	for (i = 0, pv = r_polyVerts; i < r_numPolyVerts; i++, pv++, polyVert++){
+		VectorCopy(pv->xyz, polyVert->xyz);
+		polyVert->st[0] = pv->st[0];
+		polyVert->st[1] = pv->st[1];
+		*(unsigned *)polyVert->modulate = *(unsigned *)pv->modulate;
+	}
+
+	R_WriteSceneRecord(SCN_VIEW, r_recording.buffer, (byte *)polyVert - r_recording.buffer);
+}
+
+/*
+ =================
+ R_StopRecordingScenes
+ =================
+*/
+static void R_StopRecordingScenes (void){
+
+	if (!r_recording.file)
+		return;
+
+	FS_FCloseFile(r_recording.file);
+	r_recording.file = 0;
+
+	Z_Free(r_recording.buffer);
+	r_recording.buffer = NULL;
+
+	Com_Printf("Stopped recording %s\n", r_recording.name);
+}
+
+/*
+ =================
+ R_RecordScenes_f
+ =================
+*/
+void R_RecordScenes_f (void){
+
+	sceneHeader_t	header;
+	int				size;
+
+	if (Cmd_Argc() != 2){
+		Com_Printf("Usage: recordscenes <name>\n");
+		return;
+	}
+
+	if (r_recording.file){
+		Com_Printf("Already recording scenes\n");
+		return;
+	}
+
+	Q_snprintfz(r_recording.name, sizeof(r_recording.name), "scenes/%s", Cmd_Argv(1));
+	Com_DefaultExtension(r_recording.name, sizeof(r_recording.name), ".scn");
+
+	FS_FOpenFile(r_recording.name, &r_recording.file, FS_WRITE);
+	if (!r_recording.file){
+		Com_Printf("Couldn't open %s\n", r_recording.name);
+		return;
+	}
+
+	Com_Printf("Recording scenes to %s\n", r_recording.name);
+
+	// Large enough for the biggest scene the refresh can be given
+	size = sizeof(sceneView_t);
+	size += (MAX_ENTITIES - 1) * sizeof(sceneEntity_t);
+	size += MAX_DLIGHTS * sizeof(sceneDLight_t);
+	size += MAX_PARTICLES * sizeof(sceneParticle_t);
+	size += MAX_POLYS * sizeof(scenePoly_t);
+	size += MAX_POLY_VERTS * sizeof(scenePolyVert_t);
+
+	r_recording.buffer = Z_Malloc(size);
+
+	header.ident = SCN_IDENT;
+	header.version = SCN_VERSION;
+
+	FS_Write(&header, sizeof(sceneHeader_t), r_recording.file);
+
+	// Models and shaders are written again the first time they are used
+	r_recording.numModels = 0;
+	memset(r_recording.shaders, 0, sizeof(r_recording.shaders));
+
+	if (r_recording.worldLoaded && r_worldModel)
+		R_WriteSceneRecord(SCN_WORLD, &r_recording.world, sizeof(sceneWorld_t));
+}
+
+/*
+ =================
+ R_StopScenes_f
+ =================
+*/
+void R_StopScenes_f (void){
+
+	if (!r_recording.file){
+		Com_Printf("Not recording scenes\n");
+		return;
+	}
+
+	R_StopRecordingScenes();
+}
+
+/*
+ =================
+ R_ShutdownRecording
+
+ Registered models and shaders are about to be freed, so they will have
+ to be written again if they are used after the refresh restarts
+ =================
+*/
+void R_ShutdownRecording (qboolean all){
+
+	r_recording.numModels = 0;
+	memset(r_recording.shaders, 0, sizeof(r_recording.shaders));
+
+	r_recording.worldLoaded = false;
+
+	if (all)
+		R_StopRecordingScenes();
+}
@@ -3530,6 +3530,91 @@ static void R_OptimizeShader (shader_t *shader){
 	}
 }
 
+/*
+ =================
+ R_IsStaticGeometryShader
+
+ Checks if the shader can draw world surfaces straight from the static
+ vertex buffer, that is if no vertex data is computed per frame
+ =================
+*/
+static qboolean R_IsStaticGeometryShader (shader_t *shader){
+
+	shaderStage_t	*stage;
+	stageBundle_t	*bundle;
+	int				i, j;
+
+	if (shader->shaderType != SHADER_BSP)
+		return false;
+
+	if (shader->flags & SHADER_DEFORMVERTEXES)
+		return false;
+
+	for (i = 0; i < shader->numStages; i++){
+		stage = shader->stages[i];
+
+		if (stage->ignore)
+			continue;
+
+		if (stage->flags & SHADERSTAGE_VERTEXPROGRAM)
+			return false;
+
+		// Colors must either come from the vertices or be the same for
+		// all of them
+		if (stage->rgbGen.type == RGBGEN_VERTEX){
+			if (stage->alphaGen.type != ALPHAGEN_VERTEX)
+				return false;
+		}
+		else {
+			switch (stage->rgbGen.type){
+			case RGBGEN_IDENTITY:
+			case RGBGEN_IDENTITYLIGHTING:
+			case RGBGEN_WAVE:
+			case RGBGEN_COLORWAVE:
+			case RGBGEN_ENTITY:
+			case RGBGEN_ONEMINUSENTITY:
+			case RGBGEN_CONST:
+				break;
+			default:
+				return false;
+			}
+
+			switch (stage->alphaGen.type){
+			case ALPHAGEN_IDENTITY:
+			case ALPHAGEN_WAVE:
+			case ALPHAGEN_ALPHAWAVE:
+			case ALPHAGEN_ENTITY:
+			case ALPHAGEN_ONEMINUSENTITY:
+			case ALPHAGEN_CONST:
+				break;
+			default:
+				return false;
+			}
+		}
+
+		// Texture coordinates must come from the vertices or be generated
+		// by GL
+		for (j = 0; j < stage->numBundles; j++){
+			bundle = stage->bundles[j];
+
+			if (bundle->tcModNum)
+				return false;
+
+			switch (bundle->tcGen.type){
+			case TCGEN_BASE:
+			case TCGEN_LIGHTMAP:
+			case TCGEN_REFLECTION:
+			case TCGEN_NORMAL:
+				break;
+			default:
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 /*
  =================
  R_LoadShader
@@ -3552,6 +3637,10 @@ shader_t *R_LoadShader (shader_t *newShader){
 	// Try to merge multiple stages for multitexturing
 	R_OptimizeShader(newShader);
 
+	// Check if the shader can use static vertex buffers
+	if (R_IsStaticGeometryShader(newShader))
+		newShader->flags |= SHADER_STATICGEOMETRY;
+
 	// Copy the shader
 	memcpy(shader, newShader, sizeof(shader_t));
 	shader->numStages = 0;
@@ -42,35 +42,19 @@ static qboolean	r_triangleFacingLight[MAX_INDICES / 3];
 */
 static void R_LerpShadowVertices (entity_t *entity, mdl_t *alias, mdlSurface_t *surface){
 
-	mdlFrame_t		*curFrame, *oldFrame;
-	mdlXyzNormal_t	*curXyzNormal, *oldXyzNormal;
-	vec3_t			curScale, oldScale;
-	vec3_t			delta, move;
-	int				i;
-
-	// Draw all the triangles
-	curFrame = alias->frames + entity->frame;
-	oldFrame = alias->frames + entity->oldFrame;
-
-	curXyzNormal = surface->xyzNormals + surface->numVertices * entity->frame;
-	oldXyzNormal = surface->xyzNormals + surface->numVertices * entity->oldFrame;
-
-	// Interpolate frames
-	VectorSubtract(entity->oldOrigin, entity->origin, delta);
-	VectorRotate(delta, entity->axis, move);
+	const float	*vertices;
+	int			stride;
+	int			i;
 
-	move[0] = curFrame->translate[0] + (move[0] + oldFrame->translate[0] - curFrame->translate[0]) * entity->backLerp;
-	move[1] = curFrame->translate[1] + (move[1] + oldFrame->translate[1] - curFrame->translate[1]) * entity->backLerp;
-	move[2] = curFrame->translate[2] + (move[2] + oldFrame->translate[2] - curFrame->translate[2]) * entity->backLerp;
+	// Get the interpolated vertices
+	vertices = R_GetAliasModelVertices(entity, alias, surface - alias->surfaces, false);
 
-	VectorScale(curFrame->scale, 1.0 - entity->backLerp, curScale);
-	VectorScale(oldFrame->scale, entity->backLerp, oldScale);
+	stride = MDL_VERTEX_STRIDE(surface->numVertices);
 
-	// Interpolate vertices
-	for (i = 0; i < surface->numVertices; i++, curXyzNormal++, oldXyzNormal++){
-		vertexArray[numVertex][0] = move[0] + curXyzNormal->xyz[0]*curScale[0] + oldXyzNormal->xyz[0]*oldScale[0];
-		vertexArray[numVertex][1] = move[1] + curXyzNormal->xyz[1]*curScale[1] + oldXyzNormal->xyz[1]*oldScale[1];
-		vertexArray[numVertex][2] = move[2] + curXyzNormal->xyz[2]*curScale[2] + oldXyzNormal->xyz[2]*oldScale[2];
+	for (i = 0; i < surface->numVertices; i++){
+		vertexArray[numVertex][0] = vertices[i];
+		vertexArray[numVertex][1] = vertices[stride + i];
+		vertexArray[numVertex][2] = vertices[stride * 2 + i];
 
 		numVertex++;
 	}
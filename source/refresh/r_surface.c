@@ -48,6 +48,29 @@ void R_DrawSurface (void){
 	surfPolyVert_t	*v;
 	int				i;
 
+	// Upload the dynamic lightmap. All the surfaces in a batch share the
+	// same lightmap, so their blocks don't overlap.
+	if (rb_infoKey & INFOKEY_DYNAMIC)
+		R_UpdateSurfaceLightmap(surf);
+
+	// The vertices are already in the static buffer, so only add the
+	// indices
+	if (rb_staticGeometry){
+		for (p = surf->poly; p; p = p->next){
+			RB_CheckMeshOverflow(p->numIndices, p->numVertices);
+
+			for (i = 0; i < p->numIndices; i += 3){
+				indexArray[numIndex++] = p->firstBufferVertex + p->indices[i+0];
+				indexArray[numIndex++] = p->firstBufferVertex + p->indices[i+1];
+				indexArray[numIndex++] = p->firstBufferVertex + p->indices[i+2];
+			}
+
+			numVertex += p->numVertices;
+		}
+
+		return;
+	}
+
 	for (p = surf->poly; p; p = p->next){
 		RB_CheckMeshOverflow(p->numIndices, p->numVertices);
 
@@ -112,14 +135,17 @@ static void R_AddSurfaceToList (surface_t *surf, entity_t *entity){
 	// Select lightmap
 	lmNum = surf->lmNum;
 
-	// Check for lightmap modification
+	// Check for lightmap modification. Changed light styles are written
+	// back to the static lightmap right away, so the surface still batches
+	// with the others on the same lightmap. Dynamically lit surfaces are
+	// uploaded to the dynamic lightmap as they are drawn.
 	if (gl_dynamic->integer && (shader->flags & SHADER_HASLIGHTMAP)){
 		if (surf->dlightFrame == r_frameCount)
-			lmNum = 255;
+			lmNum |= INFOKEY_DYNAMIC;
 		else {
 			for (map = 0; map < surf->numStyles; map++){
 				if (surf->cachedLight[map] != r_lightStyles[surf->styles[map]].white){
-					lmNum = 255;
+					R_UpdateSurfaceLightmap(surf);
 					break;
 				}
 			}
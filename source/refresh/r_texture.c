@@ -19,6 +19,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 
+#include <setjmp.h>
+
 #include "r_local.h"
 
 
@@ -32,6 +34,13 @@ typedef struct {
 	int			mag;
 } textureFilter_t;
 
+typedef struct {
+	char		realName[MAX_QPATH];
+	byte		*pic;
+	int			width;
+	int			height;
+} imageData_t;
+
 static texture_t		*r_texturesHash[TEXTURES_HASHSIZE];
 static texture_t		*r_textures[MAX_TEXTURES];
 static int				r_numTextures;
@@ -672,16 +681,26 @@ static qboolean R_LoadWAL (const char *name, byte **pic, int *width, int *height
  =======================================================================
 */
 
-static char		jpegName[MAX_QPATH];
-static qboolean	jpegFailed;
+// Textures may be decoded on the loader threads, so the error state
+// belongs to each decompressor instead of being global
+typedef struct {
+	struct jpeg_error_mgr	pub;
+
+	const char				*name;
+	qboolean				failed;
+	jmp_buf					abort;
+} jpegError_t;
 
 
 static void jpeg_d_error_exit (j_common_ptr cinfo){
 
-	char	msg[1024];
+	jpegError_t	*jErr = (jpegError_t *)cinfo->err;
+	char		msg[1024];
 
 	(cinfo->err->format_message)(cinfo, msg);
-	Com_Error(ERR_DROP, "JPEG Lib Error: %s", msg);
+	Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: %s (%s)\n", msg, jErr->name);
+
+	longjmp(jErr->abort, 1);
 }
 
 static void jpeg_null_src (j_decompress_ptr cinfo){
@@ -690,24 +709,28 @@ static void jpeg_null_src (j_decompress_ptr cinfo){
 
 static unsigned char jpeg_fill_input_buffer (j_decompress_ptr cinfo){
 
-	Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: premature end of JPG file (%s)\n", jpegName);
-	jpegFailed = true;
+	jpegError_t	*jErr = (jpegError_t *)cinfo->err;
+
+	Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: premature end of JPG file (%s)\n", jErr->name);
+	jErr->failed = true;
 
     return 1;
 }
 
 static void jpeg_skip_input_data (j_decompress_ptr cinfo, long num_bytes){
-        
+
+	jpegError_t	*jErr = (jpegError_t *)cinfo->err;
+
     cinfo->src->next_input_byte += (size_t)num_bytes;
     cinfo->src->bytes_in_buffer -= (size_t)num_bytes;
 
 	if (cinfo->src->bytes_in_buffer < 0){
-		Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: premature end of JPG file (%s)\n", jpegName);
-		jpegFailed = true;
+		Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: premature end of JPG file (%s)\n", jErr->name);
+		jErr->failed = true;
 	}
 }
 
-static void jpeg_mem_src (j_decompress_ptr cinfo, byte *indata, int size){
+static void jpeg_mem_src (j_decompress_ptr cinfo, const byte *indata, int size){
 
     cinfo->src = (struct jpeg_source_mgr *)(*cinfo->mem->alloc_small)((j_common_ptr)cinfo, JPOOL_PERMANENT, sizeof(struct jpeg_source_mgr));
     cinfo->src->init_source = jpeg_null_src;
@@ -727,30 +750,47 @@ static void jpeg_mem_src (j_decompress_ptr cinfo, byte *indata, int size){
 static qboolean R_LoadJPG (const char *name, byte **pic, int *width, int *height){
 
 	struct	jpeg_decompress_struct jDec;
-	struct	jpeg_error_mgr jErr;
-	byte	*buffer;
-	byte	*in, *out;
+	jpegError_t	jErr;
+	const byte	*buffer;
+	byte	* volatile in = NULL;
+	byte	*out;
 	byte	*scanLine;
 	int		len, i;
 
 	// Load the file
-	len = FS_LoadFile(name, (void **)&buffer);
+	len = FS_MapFile(name, (const void **)&buffer);
 	if (!buffer)
 		return false;
 
 	// Parse the JPG file
 	if (buffer[6] != 'J' || buffer[7] != 'F' || buffer[8] != 'I' || buffer[9] != 'F'){
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: missing 'JFIF' signature (%s)\n", name);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 
 	// Initialize
-	Q_strncpyz(jpegName, name, sizeof(jpegName));
-	jpegFailed = false;
+	jDec.err = jpeg_std_error(&jErr.pub);
+	jErr.pub.error_exit = jpeg_d_error_exit;
+	jErr.name = name;
+	jErr.failed = false;
+
+	*pic = NULL;
 
-	jDec.err = jpeg_std_error(&jErr);
-	jErr.error_exit = jpeg_d_error_exit;
+	// A corrupt file only fails this load
+	if (setjmp(jErr.abort)){
+		if (in)
+			Z_Free(in);
+
+		if (*pic){
+			Z_Free(*pic);
+			*pic = NULL;
+		}
+
+		jpeg_destroy_decompress(&jDec);
+		FS_UnmapFile(buffer);
+		return false;
+	}
 
 	jpeg_create_decompress(&jDec);
 
@@ -763,7 +803,7 @@ static qboolean R_LoadJPG (const char *name, byte **pic, int *width, int *height
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: bad number of output components (%i) (%s)\n", jDec.output_components, name);
 		jpeg_finish_decompress(&jDec);
 		jpeg_destroy_decompress(&jDec);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 
@@ -771,7 +811,7 @@ static qboolean R_LoadJPG (const char *name, byte **pic, int *width, int *height
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadJPG: bad JPG file (%i x %i) (%s)\n", jDec.output_width, jDec.output_height, name);
 		jpeg_finish_decompress(&jDec);
 		jpeg_destroy_decompress(&jDec);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 
@@ -824,8 +864,15 @@ static qboolean R_LoadJPG (const char *name, byte **pic, int *width, int *height
 	jpeg_finish_decompress(&jDec);
 	jpeg_destroy_decompress(&jDec);
 
-	FS_FreeFile(buffer);
-	return (!jpegFailed);
+	FS_UnmapFile(buffer);
+
+	if (jErr.failed){
+		Z_Free(*pic);
+		*pic = NULL;
+		return false;
+	}
+
+	return true;
 }
 
 
@@ -845,15 +892,16 @@ static qboolean R_LoadJPG (const char *name, byte **pic, int *width, int *height
 */
 static qboolean R_LoadTGA (const char *name, byte **pic, int *width, int *height){
 
-	byte			*buffer;
-	byte			*in, *out;
+	const byte		*buffer;
+	const byte		*in;
+	byte			*out;
 	targaHeader_t	tga;
 	int				w, h, stride = 0;
 	byte			r, g, b, a;
 	byte			packetHeader, packetSize, i;
 
 	// Load the file
-	FS_LoadFile(name, (void **)&buffer);
+	FS_MapFile(name, (const void **)&buffer);
 	if (!buffer)
 		return false;
 
@@ -881,25 +929,25 @@ static qboolean R_LoadTGA (const char *name, byte **pic, int *width, int *height
 
 	if (tga.imageType != 2 && tga.imageType != 3 && tga.imageType != 10){
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadTGA: only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported (%s)\n", name);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 
 	if (tga.colormapType != 0){
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadTGA: colormaps not supported (%s)\n", name);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 		
 	if (tga.pixelSize != 32 && tga.pixelSize != 24 && tga.pixelSize != 8){
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadTGA: only 32 (RGBA), 24 (RGB), and 8 (gray) bit images supported (%s)\n", name);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 
 	if (tga.width <= 0 || tga.height <= 0){
 		Com_DPrintf(S_COLOR_YELLOW "R_LoadTGA: bad TGA file (%i x %i) (%s)\n", tga.width, tga.height, name);
-		FS_FreeFile(buffer);
+		FS_UnmapFile(buffer);
 		return false;
 	}
 
@@ -1045,7 +1093,7 @@ breakOut:
 		}
 	}
 
-	FS_FreeFile(buffer);
+	FS_UnmapFile(buffer);
 	return true;
 }
 
@@ -1436,6 +1484,91 @@ texture_t *R_LoadCubeMapTexture (const char *name, byte *data[6], int width, int
 	return texture;
 }
 
+/*
+ =================
+ R_LoadImage
+
+ Tries every supported format in order of preference
+ =================
+*/
+static qboolean R_LoadImage (const char *checkName, char *loadName, byte **pic, int *width, int *height){
+
+	Q_snprintfz(loadName, MAX_QPATH, "%s.tga", checkName);
+	if (R_LoadTGA(loadName, pic, width, height))
+		return true;
+
+	Q_snprintfz(loadName, MAX_QPATH, "%s.jpg", checkName);
+	if (R_LoadJPG(loadName, pic, width, height))
+		return true;
+
+	Q_snprintfz(loadName, MAX_QPATH, "%s.pcx", checkName);
+	if (R_LoadPCX(loadName, pic, NULL, width, height))
+		return true;
+
+	Q_snprintfz(loadName, MAX_QPATH, "%s.wal", checkName);
+	if (R_LoadWAL(loadName, pic, width, height))
+		return true;
+
+	return false;
+}
+
+/*
+ =================
+ R_LoadImageData
+
+ Runs on a loader thread, so it must not touch GL
+ =================
+*/
+static void *R_LoadImageData (const char *name, int *size){
+
+	imageData_t	*image;
+
+	image = Z_Malloc(sizeof(imageData_t));
+
+	if (!R_LoadImage(name, image->realName, &image->pic, &image->width, &image->height)){
+		Z_Free(image);
+
+		*size = -1;
+		return NULL;
+	}
+
+	*size = image->width * image->height * 4;
+
+	return image;
+}
+
+/*
+ =================
+ R_FreeImageData
+ =================
+*/
+static void R_FreeImageData (void *data){
+
+	imageData_t	*image = data;
+
+	Z_Free(image->pic);
+	Z_Free(image);
+}
+
+/*
+ =================
+ R_QueueTexture
+
+ Asks the loader threads to decode the texture before it's needed
+ =================
+*/
+void R_QueueTexture (const char *name, int priority){
+
+	char	checkName[MAX_QPATH];
+
+	if (!name || !name[0] || strlen(name) >= MAX_QPATH)
+		return;
+
+	Com_StripExtension(name, checkName, sizeof(checkName));
+
+	Com_QueueLoad(checkName, priority, R_LoadImageData, R_FreeImageData);
+}
+
 /*
  =================
  R_FindTexture
@@ -1444,6 +1577,7 @@ texture_t *R_LoadCubeMapTexture (const char *name, byte *data[6], int width, int
 texture_t *R_FindTexture (const char *name, unsigned flags, float bumpScale){
 
 	texture_t	*texture;
+	imageData_t	*image;
 	byte		*pic;
 	int			width, height;
 	char		checkName[MAX_QPATH], loadName[MAX_QPATH];
@@ -1468,49 +1602,31 @@ texture_t *R_FindTexture (const char *name, unsigned flags, float bumpScale){
 		}
 	}
 
-	// Load it from disk
-	Q_snprintfz(loadName, sizeof(loadName), "%s.tga", checkName);
-	if (R_LoadTGA(loadName, &pic, &width, &height)){
-		if (flags & TF_HEIGHTMAP)
-			pic = R_HeightToNormal(pic, width, height, bumpScale);
-
-		texture = R_LoadTexture(loadName, pic, width, height, flags, bumpScale);
-		Z_Free(pic);
-		return texture;
-	}
+	// See if a loader thread already decoded it, otherwise load it from
+	// disk
+	if (Com_FinishLoad(checkName, R_LoadImageData, (void **)&image, NULL)){
+		if (!image)
+			return NULL;	// Not found or invalid
 
-	Q_snprintfz(loadName, sizeof(loadName), "%s.jpg", checkName);
-	if (R_LoadJPG(loadName, &pic, &width, &height)){
-		if (flags & TF_HEIGHTMAP)
-			pic = R_HeightToNormal(pic, width, height, bumpScale);
+		Q_strncpyz(loadName, image->realName, sizeof(loadName));
+		pic = image->pic;
+		width = image->width;
+		height = image->height;
 
-		texture = R_LoadTexture(loadName, pic, width, height, flags, bumpScale);
-		Z_Free(pic);
-		return texture;
+		Z_Free(image);
 	}
-
-	Q_snprintfz(loadName, sizeof(loadName), "%s.pcx", checkName);
-	if (R_LoadPCX(loadName, &pic, NULL, &width, &height)){
-		if (flags & TF_HEIGHTMAP)
-			pic = R_HeightToNormal(pic, width, height, bumpScale);
-
-		texture = R_LoadTexture(loadName, pic, width, height, flags, bumpScale);
-		Z_Free(pic);
-		return texture;
+	else {
+		if (!R_LoadImage(checkName, loadName, &pic, &width, &height))
+			return NULL;	// Not found or invalid
 	}
-	
-	Q_snprintfz(loadName, sizeof(loadName), "%s.wal", checkName);
-	if (R_LoadWAL(loadName, &pic, &width, &height)){
-		if (flags & TF_HEIGHTMAP)
-			pic = R_HeightToNormal(pic, width, height, bumpScale);
 
-		texture = R_LoadTexture(loadName, pic, width, height, flags, bumpScale);
-		Z_Free(pic);
-		return texture;
-	}
+	if (flags & TF_HEIGHTMAP)
+		pic = R_HeightToNormal(pic, width, height, bumpScale);
 
-	// Not found or invalid
-	return NULL;
+	texture = R_LoadTexture(loadName, pic, width, height, flags, bumpScale);
+	Z_Free(pic);
+
+	return texture;
 }
 
 /*
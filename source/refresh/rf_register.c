@@ -283,6 +283,8 @@ void R_RegisterConfig ()
 	Cmd_AddCommand ("programlist",         R_ProgramList_f);
 	Cmd_AddCommand ("shaderlist",          R_ShaderList_f);
 	Cmd_AddCommand ("modellist",           R_ModelList_f);
+	Cmd_AddCommand ("recordscenes",        R_RecordScenes_f);
+	Cmd_AddCommand ("stopscenes",          R_StopScenes_f);
 
 	// Range check some cvars
 	if (r_gamma->value > 3.0)
@@ -319,4 +321,6 @@ void R_UnRegisterConfig ()
 	Cmd_RemoveCommand ("programlist");
 	Cmd_RemoveCommand ("shaderlist");
 	Cmd_RemoveCommand ("modellist");
-}
\ No newline at end of file
+	Cmd_RemoveCommand ("recordscenes");
+	Cmd_RemoveCommand ("stopscenes");
+}
\ No newline at end of file
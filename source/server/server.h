@@ -30,6 +30,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define	LATENCY_COUNTS		16
 #define	RATE_MESSAGES		10
 
+#define	MAX_PACKET_ENTITIES	64
+
+// Every client has its own slice of svs.clientEntities, so client frames
+// can be built independently of each other
+#define	CLIENT_ENTITIES		(UPDATE_BACKUP*MAX_PACKET_ENTITIES)
+
 // MAX_CHALLENGES is made large to prevent a denial of service attack 
 // that could cycle all of them out before legitimate users connected
 #define	MAX_CHALLENGES		1024
@@ -64,8 +70,26 @@ typedef struct {
 	msg_t			multicast;
 	byte			multicastBuffer[MAX_MSGLEN];
 
+	// Cluster and area of every client for SV_Multicast, refreshed once
+	// per frame and whenever a client is found to have moved
+	qboolean		clientCacheValid;
+	vec3_t			clientOrigins[MAX_CLIENTS];
+	int				clientClusters[MAX_CLIENTS];
+	int				clientAreas[MAX_CLIENTS];
+
+	// Entity states as of the last two times client frames were built.
+	// The change from one to the other is encoded once for all the 
+	// clients that have the older frame, which is most of them.
+	// An encoded entity delta is never more than 43 bytes.
+	entity_state_t	entityStates[2][MAX_EDICTS];
+	int				entityStatesFrame[2];
+	int				currentEntityStates;
+	byte			entityDeltas[MAX_EDICTS*48];
+	int				entityDeltaOffsets[MAX_EDICTS];
+	short			entityDeltaLengths[MAX_EDICTS];	// -1 if not encoded
+
 	// Demo server information
-	fileHandle_t	demoFile;
+	demo_t			*demoFile;
 } server_t;
 
 typedef enum {
@@ -80,7 +104,7 @@ typedef struct {
 	byte			areaBits[MAX_MAP_AREAS/8];	// portalarea visibility bits
 	player_state_t	ps;
 	int				numEntities;
-	int				firstEntity;		// Into the circular sv_packet_entities[]
+	int				firstEntity;		// Into the client's circular slice of svs.clientEntities
 	int				sentTime;			// For ping calculations
 } clientFrame_t;
 
@@ -118,6 +142,19 @@ typedef struct client_s {
 	byte			datagramBuffer[MAX_MSGLEN];
 
 	clientFrame_t	frames[UPDATE_BACKUP];	// Updates can be delta'ed from here
+	int				nextEntities;		// Next entity to use in this client's slice
+
+	// Visibility for the frame being built. This is gathered before the
+	// frames of all the clients are built in parallel.
+	vec3_t			frameOrigin;
+	int				frameArea;
+	byte			framePVS[MAX_MAP_LEAFS/8];	// Fat PVS
+	byte			framePHS[MAX_MAP_LEAFS/8];
+
+	// The frame is encoded here in parallel with other clients and then
+	// copied to the datagram
+	msg_t			frameMsg;
+	byte			frameMsgBuffer[MAX_MSGLEN*2];
 
 	int				lastMessage;		// sv.frameNum when packet was last received
 	int				lastConnect;
@@ -147,8 +184,7 @@ typedef struct {
 	int				spawnCount;					// Incremented each server start. Used to check late spawns
 
 	client_t		*clients;					// [maxclients]
-	int				nextClientEntities;			// Next client entity to use
-	int				numClientEntities;			// maxclients*UPDATE_BACKUP*MAX_PACKET_ENTITIES
+	int				numClientEntities;			// maxclients*CLIENT_ENTITIES
 	entity_state_t	*clientEntities;			// [numClientEntities]
 
 	int				lastHeartbeat;
@@ -156,9 +192,11 @@ typedef struct {
 	challenge_t		challenges[MAX_CHALLENGES];	// To prevent invalid IPs from connecting
 
 	// Server record values
-	fileHandle_t	demoFile;
+	demo_t			*demoFile;
 	msg_t			demoMulticast;
 	byte			demoMulticastBuffer[MAX_MSGLEN];
+	int				demoFrameNum;				// Last recorded frame, frames are delta'ed from it
+	entity_state_t	demoEntities[MAX_EDICTS];	// As of the last recorded frame, unused if number is 0
 } serverStatic_t;
 
 // =====================================================================
@@ -166,6 +204,9 @@ typedef struct {
 #define EDICT_NUM(n)		((edict_t *)((byte *)ge->edicts + ge->edict_size*(n)))
 #define NUM_FOR_EDICT(e)	(((byte *)(e)-(byte *)ge->edicts) / ge->edict_size)
 
+// Ents without visible models are never sent unless they have an effect
+#define SV_EdictSendable(e)	(!((e)->svflags & SVF_NOCLIENT) && ((e)->s.modelindex || (e)->s.effects || (e)->s.sound || (e)->s.event))
+
 #define	OUTPUTBUF_LENGTH	(MAX_MSGLEN - 16)
 
 typedef enum {
@@ -201,6 +242,7 @@ extern cvar_t	*sv_enforceTime;
 extern cvar_t	*sv_allowDownload;
 extern cvar_t	*sv_publicServer;
 extern cvar_t	*sv_rconPassword;
+extern cvar_t	*sv_parallelFrames;
 
 int		SV_ModelIndex (const char *name);
 int		SV_SoundIndex (const char *name);
@@ -215,6 +257,7 @@ void	SV_DeleteGame_f (void);
 void	SV_GameMap_f (void);
 void	SV_Map_f (void);
 void	SV_Demo_f (void);
+void	SV_SeekDemo_f (void);
 void	SV_Kick_f (void);
 void	SV_Status_f (void);
 void	SV_Heartbeat_f (void);
@@ -234,6 +277,7 @@ void	SV_FlushRedirect (redirect_t redirect, char *outputBuf);
 void	SV_SendClientMessages (void);
 void	SV_ParseClientMessage (client_t *cl);
 
+void	SV_UpdateClientClusters (void);
 void	SV_Multicast (vec3_t origin, multicast_t to);
 void	SV_StartSound (vec3_t origin, edict_t *entity, int channel, int sound, float volume, float attenuation, float timeOfs);
 void	SV_ClientPrintf (client_t *cl, int level, const char *fmt, ...);
@@ -244,9 +288,11 @@ void	SV_NextServer (void);
 
 void	SV_ReadLevelFile (void);
 
-void	SV_WriteFrameToClient (client_t *cl, msg_t *msg);
 void	SV_RecordDemoMessage (void);
-void	SV_BuildClientFrame (client_t *cl);
+
+// Builds and encodes the frames for the given clients into their 
+// frameMsg, in parallel if sv_parallelFrames is set
+void	SV_BuildClientFrames (client_t **clients, int numClients);
 
 void	SV_InitGameProgs (void);
 void	SV_ShutdownGameProgs (void);
@@ -265,6 +311,18 @@ void	SV_UnlinkEdict (edict_t *ent);
 // not solid.
 void	SV_LinkEdict (edict_t *ent);
 
+// Sorts all the edicts that may be sent to clients by the PVS clusters
+// they touch. Called once per frame before the client frames are built.
+void	SV_BuildClusterEdicts (void);
+
+// Returns the numbers of the edicts touching the given cluster, as found
+// by the last SV_BuildClusterEdicts
+const int	*SV_ClusterEdicts (int cluster, int *count);
+
+// Returns the numbers of the edicts that must be checked individually,
+// either because they touch too many leafs or because they are beams
+const int	*SV_UnclusteredEdicts (int *count);
+
 // Fills in a table of edict pointers with edicts that have bounding 
 // boxes that intersect the given area. It is possible for a non-axial 
 // brush model to be returned that doesn't actually intersect the area
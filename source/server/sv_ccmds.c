@@ -176,6 +176,8 @@ static void SV_WriteServerFile (qboolean autoSave){
 	// Write game state
 	Q_snprintfz(name, sizeof(name), "%s/%s/save/current/game.ssv", Cvar_VariableString("fs_homePath"), Cvar_VariableString("fs_game"));
 	ge->WriteGame(name, autoSave);
+
+	FS_IndexFile("save/current/game.ssv");
 }
 
 /*
@@ -252,6 +254,8 @@ void SV_WriteLevelFile (void){
 
 	Q_snprintfz(name, sizeof(name), "%s/%s/save/current/%s.sav", Cvar_VariableString("fs_homePath"), Cvar_VariableString("fs_game"), sv.name);
 	ge->WriteLevel(name);
+
+	FS_IndexFile(va("save/current/%s.sav", sv.name));
 }
 
 /*
@@ -573,6 +577,52 @@ void SV_Demo_f (void){
 	SV_Map(map, true, false);
 }
 
+/*
+ =================
+ SV_SeekDemo_f
+
+ Continues demo playback from the given number of seconds into the demo,
+ or from the given number of seconds before or after the current 
+ position if a sign is given. Playback actually continues from the
+ nearest keyframe before that.
+ =================
+*/
+void SV_SeekDemo_f (void){
+
+	const char	*arg;
+	int			firstFrame, lastFrame;
+	int			frameNum;
+
+	if (Cmd_Argc() != 2){
+		Com_Printf("Usage: seekdemo [+|-]<seconds>\n");
+		return;
+	}
+
+	if (sv.state != SS_DEMO || !sv.demoFile){
+		Com_Printf("Not playing a demo\n");
+		return;
+	}
+
+	if (!Com_DemoFrameRange(sv.demoFile, &firstFrame, &lastFrame)){
+		Com_Printf("This demo can't be seeked\n");
+		return;
+	}
+
+	// Server frames are 100 msec apart
+	arg = Cmd_Argv(1);
+	if (arg[0] == '+' || arg[0] == '-')
+		frameNum = Com_DemoFrame(sv.demoFile) + atof(arg) * 10;
+	else
+		frameNum = firstFrame + atof(arg) * 10;
+
+	if (frameNum > lastFrame)
+		frameNum = lastFrame;
+
+	Com_SeekDemo(sv.demoFile, frameNum);
+
+	Com_Printf("Playing from %i seconds\n", (Com_DemoFrame(sv.demoFile) - firstFrame) / 10);
+}
+
 
 // =====================================================================
 
@@ -785,10 +835,11 @@ void SV_DumpUser_f (void){
 */
 void SV_ServerRecord_f (void){
 
-	char	name[MAX_QPATH];
-	char	data[32768];
-	msg_t	msg;
-	int		i, len;
+	char			name[MAX_QPATH];
+	char			data[32768];
+	msg_t			msg;
+	fileHandle_t	f;
+	int				i;
 
 	if (Cmd_Argc() > 2){
 		Com_Printf("Usage: serverrecord [demoname]\n");
@@ -824,12 +875,18 @@ void SV_ServerRecord_f (void){
 	}
 
 	// Open the demo file
-	FS_FOpenFile(name, &svs.demoFile, FS_WRITE);
-	if (!svs.demoFile){
+	FS_FOpenFile(name, &f, FS_WRITE);
+	if (!f){
 		Com_Printf("Couldn't open %s\n", name);
 		return;
 	}
 
+	svs.demoFile = Com_RecordDemo(f);
+
+	// The first frame is written from scratch
+	svs.demoFrameNum = -1;
+	memset(svs.demoEntities, 0, sizeof(svs.demoEntities));
+
 	Com_Printf("Recording to %s\n", name);
 
 	// Setup a buffer to catch all multicasts
@@ -857,9 +914,7 @@ void SV_ServerRecord_f (void){
 	// Write it to the demo file
 	Com_DPrintf("Signon message length: %i\n", msg.curSize);
 
-	len = LittleLong(msg.curSize);
-	FS_Write(&len, sizeof(len), svs.demoFile);
-	FS_Write(msg.data, msg.curSize, svs.demoFile);
+	Com_WriteDemoMessage(svs.demoFile, sv.frameNum, msg.data, msg.curSize);
 
 	// The rest of the demo file will be individual frames
 }
@@ -878,8 +933,8 @@ void SV_ServerStopRecord_f (void){
 		return;
 	}
 
-	FS_FCloseFile(svs.demoFile);
-	svs.demoFile = 0;
+	Com_CloseDemo(svs.demoFile);
+	svs.demoFile = NULL;
 
 	Com_Printf("Stopped recording\n");
 }
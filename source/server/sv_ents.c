@@ -31,6 +31,60 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 
+/*
+ =================
+ SV_EncodeEntityDeltas
+
+ Finds what changed in every sendable entity since client frames were 
+ last built, and encodes it the way SV_EmitPacketEntities would
+ =================
+*/
+static void SV_EncodeEntityDeltas (void){
+
+	entity_state_t	*oldStates, *newStates;
+	edict_t			*edict;
+	msg_t			msg;
+	int				e;
+
+	sv.currentEntityStates ^= 1;
+
+	oldStates = sv.entityStates[sv.currentEntityStates^1];
+	newStates = sv.entityStates[sv.currentEntityStates];
+
+	sv.entityStatesFrame[sv.currentEntityStates] = sv.frameNum;
+
+	MSG_Init(&msg, sv.entityDeltas, sizeof(sv.entityDeltas), false);
+
+	sv.entityDeltaLengths[0] = -1;
+
+	for (e = 1; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
+
+		newStates[e] = edict->s;
+
+		if (!SV_EdictSendable(edict)){
+			sv.entityDeltaLengths[e] = -1;
+			continue;
+		}
+
+		sv.entityDeltaOffsets[e] = msg.curSize;
+
+		// Nothing is sent for an entity that didn't change, unless it
+		// has an event, always sends its old origin, or needs a 16 bit 
+		// number
+		if (!memcmp(&oldStates[e], &newStates[e], sizeof(entity_state_t)) && !newStates[e].event){
+			if (e > sv_maxClients->integer && e < 256 && !(newStates[e].renderfx & RF_BEAM)){
+				sv.entityDeltaLengths[e] = 0;
+				continue;
+			}
+		}
+
+		MSG_WriteDeltaEntity(&msg, &oldStates[e], &newStates[e], false, e <= sv_maxClients->integer);
+
+		sv.entityDeltaLengths[e] = msg.curSize - sv.entityDeltaOffsets[e];
+	}
+}
+
 /*
  =================
  SV_EmitPacketEntities
@@ -38,14 +92,26 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
  Writes a delta update of an entity_state_t list to the message
  =================
 */
-static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t *msg){
+static void SV_EmitPacketEntities (client_t *cl, clientFrame_t *from, int fromFrameNum, clientFrame_t *to, msg_t *msg){
 
+	entity_state_t	*entities;
 	entity_state_t	*oldState, *newState;
+	entity_state_t	*oldStates, *newStates;
+	qboolean		encoded;
 	int				oldIndex, newIndex;
 	int				oldNum, newNum;
 	int				fromNumEntities;
 	int				bits;
 
+	entities = svs.clientEntities + (cl - svs.clients) * CLIENT_ENTITIES;
+
+	// If the client has the frame that was built last time, the deltas 
+	// from SV_EncodeEntityDeltas can be used
+	oldStates = sv.entityStates[sv.currentEntityStates^1];
+	newStates = sv.entityStates[sv.currentEntityStates];
+
+	encoded = (from && fromFrameNum > 0 && fromFrameNum == sv.entityStatesFrame[sv.currentEntityStates^1]);
+
 	MSG_WriteByte(msg, SVC_PACKETENTITIES);
 
 	if (!from)
@@ -56,21 +122,36 @@ static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t
 	newIndex = 0;
 	oldIndex = 0;
 	while (newIndex < to->numEntities || oldIndex < fromNumEntities){
+		// If it won't fit in a datagram anyway, don't bother writing the
+		// rest. This keeps msg from overflowing.
+		if (msg->curSize > MAX_MSGLEN)
+			break;
+
 		if (newIndex >= to->numEntities)
 			newNum = 9999;
 		else {
-			newState = &svs.clientEntities[(to->firstEntity+newIndex)%svs.numClientEntities];
+			newState = &entities[(to->firstEntity+newIndex)%CLIENT_ENTITIES];
 			newNum = newState->number;
 		}
 
 		if (oldIndex >= fromNumEntities)
 			oldNum = 9999;
 		else {
-			oldState = &svs.clientEntities[(from->firstEntity+oldIndex)%svs.numClientEntities];
+			oldState = &entities[(from->firstEntity+oldIndex)%CLIENT_ENTITIES];
 			oldNum = oldState->number;
 		}
 
 		if (newNum == oldNum){
+			// Use the shared delta unless the solid of a missile was
+			// cleared for this client
+			if (encoded && sv.entityDeltaLengths[newNum] != -1 && oldState->solid == oldStates[newNum].solid && newState->solid == newStates[newNum].solid){
+				MSG_Write(msg, sv.entityDeltas + sv.entityDeltaOffsets[newNum], sv.entityDeltaLengths[newNum]);
+
+				oldIndex++;
+				newIndex++;
+				continue;
+			}
+
 			// Delta update from old position.
 			// Because the force parm is false, this will not result in
 			// any bytes being emited if the entity has not changed at 
@@ -115,172 +196,12 @@ static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t
 	MSG_WriteShort(msg, 0);	// End of packet entities
 }
 
-/*
- =================
- SV_WritePlayerStateToClient
- =================
-*/
-static void SV_WritePlayerStateToClient (clientFrame_t *from, clientFrame_t *to, msg_t *msg){
-
-	player_state_t	*newPS, *oldPS, dummy;
-	int				i, flags, statBits;
-
-	newPS = &to->ps;
-	if (!from){
-		memset(&dummy, 0, sizeof(dummy));
-		oldPS = &dummy;
-	}
-	else
-		oldPS = &from->ps;
-
-	// Determine what needs to be sent
-	flags = 0;
-
-	if (newPS->pmove.pm_type != oldPS->pmove.pm_type)
-		flags |= PS_M_TYPE;
-
-	if (newPS->pmove.origin[0] != oldPS->pmove.origin[0] || newPS->pmove.origin[1] != oldPS->pmove.origin[1] || newPS->pmove.origin[2] != oldPS->pmove.origin[2])
-		flags |= PS_M_ORIGIN;
-
-	if (newPS->pmove.velocity[0] != oldPS->pmove.velocity[0] || newPS->pmove.velocity[1] != oldPS->pmove.velocity[1] || newPS->pmove.velocity[2] != oldPS->pmove.velocity[2])
-		flags |= PS_M_VELOCITY;
-
-	if (newPS->pmove.pm_time != oldPS->pmove.pm_time)
-		flags |= PS_M_TIME;
-
-	if (newPS->pmove.pm_flags != oldPS->pmove.pm_flags)
-		flags |= PS_M_FLAGS;
-
-	if (newPS->pmove.gravity != oldPS->pmove.gravity)
-		flags |= PS_M_GRAVITY;
-
-	if (newPS->pmove.delta_angles[0] != oldPS->pmove.delta_angles[0] || newPS->pmove.delta_angles[1] != oldPS->pmove.delta_angles[1] || newPS->pmove.delta_angles[2] != oldPS->pmove.delta_angles[2])
-		flags |= PS_M_DELTA_ANGLES;
-
-	if (newPS->viewoffset[0] != oldPS->viewoffset[0] || newPS->viewoffset[1] != oldPS->viewoffset[1] || newPS->viewoffset[2] != oldPS->viewoffset[2])
-		flags |= PS_VIEWOFFSET;
-
-	if (newPS->viewangles[0] != oldPS->viewangles[0] || newPS->viewangles[1] != oldPS->viewangles[1] || newPS->viewangles[2] != oldPS->viewangles[2])
-		flags |= PS_VIEWANGLES;
-
-	if (newPS->kick_angles[0] != oldPS->kick_angles[0] || newPS->kick_angles[1] != oldPS->kick_angles[1] || newPS->kick_angles[2] != oldPS->kick_angles[2])
-		flags |= PS_KICKANGLES;
-
-	if (newPS->blend[0] != oldPS->blend[0] || newPS->blend[1] != oldPS->blend[1] || newPS->blend[2] != oldPS->blend[2] || newPS->blend[3] != oldPS->blend[3])
-		flags |= PS_BLEND;
-
-	if (newPS->fov != oldPS->fov)
-		flags |= PS_FOV;
-
-	if (newPS->rdflags != oldPS->rdflags)
-		flags |= PS_RDFLAGS;
-
-	if (newPS->gunframe != oldPS->gunframe)
-		flags |= PS_WEAPONFRAME;
-
-	flags |= PS_WEAPONINDEX;
-
-	// Write it
-	MSG_WriteByte(msg, SVC_PLAYERINFO);
-	MSG_WriteShort(msg, flags);
-
-	// Write the pmove_state_t
-	if (flags & PS_M_TYPE)
-		MSG_WriteByte(msg, newPS->pmove.pm_type);
-
-	if (flags & PS_M_ORIGIN){
-		MSG_WriteShort(msg, newPS->pmove.origin[0]);
-		MSG_WriteShort(msg, newPS->pmove.origin[1]);
-		MSG_WriteShort(msg, newPS->pmove.origin[2]);
-	}
-
-	if (flags & PS_M_VELOCITY){
-		MSG_WriteShort(msg, newPS->pmove.velocity[0]);
-		MSG_WriteShort(msg, newPS->pmove.velocity[1]);
-		MSG_WriteShort(msg, newPS->pmove.velocity[2]);
-	}
-
-	if (flags & PS_M_TIME)
-		MSG_WriteByte(msg, newPS->pmove.pm_time);
-
-	if (flags & PS_M_FLAGS)
-		MSG_WriteByte(msg, newPS->pmove.pm_flags);
-
-	if (flags & PS_M_GRAVITY)
-		MSG_WriteShort(msg, newPS->pmove.gravity);
-
-	if (flags & PS_M_DELTA_ANGLES){
-		MSG_WriteShort(msg, newPS->pmove.delta_angles[0]);
-		MSG_WriteShort(msg, newPS->pmove.delta_angles[1]);
-		MSG_WriteShort(msg, newPS->pmove.delta_angles[2]);
-	}
-
-	// Write the rest of the player_state_t
-	if (flags & PS_VIEWOFFSET){
-		MSG_WriteChar(msg, newPS->viewoffset[0]*4);
-		MSG_WriteChar(msg, newPS->viewoffset[1]*4);
-		MSG_WriteChar(msg, newPS->viewoffset[2]*4);
-	}
-
-	if (flags & PS_VIEWANGLES){
-		MSG_WriteAngle16(msg, newPS->viewangles[0]);
-		MSG_WriteAngle16(msg, newPS->viewangles[1]);
-		MSG_WriteAngle16(msg, newPS->viewangles[2]);
-	}
-
-	if (flags & PS_KICKANGLES){
-		MSG_WriteChar(msg, newPS->kick_angles[0]*4);
-		MSG_WriteChar(msg, newPS->kick_angles[1]*4);
-		MSG_WriteChar(msg, newPS->kick_angles[2]*4);
-	}
-
-	if (flags & PS_WEAPONINDEX)
-		MSG_WriteByte(msg, newPS->gunindex);
-
-	if (flags & PS_WEAPONFRAME){
-		MSG_WriteByte(msg, newPS->gunframe);
-		MSG_WriteChar(msg, newPS->gunoffset[0]*4);
-		MSG_WriteChar(msg, newPS->gunoffset[1]*4);
-		MSG_WriteChar(msg, newPS->gunoffset[2]*4);
-		MSG_WriteChar(msg, newPS->gunangles[0]*4);
-		MSG_WriteChar(msg, newPS->gunangles[1]*4);
-		MSG_WriteChar(msg, newPS->gunangles[2]*4);
-	}
-
-	if (flags & PS_BLEND){
-		MSG_WriteByte(msg, newPS->blend[0]*255);
-		MSG_WriteByte(msg, newPS->blend[1]*255);
-		MSG_WriteByte(msg, newPS->blend[2]*255);
-		MSG_WriteByte(msg, newPS->blend[3]*255);
-	}
-
-	if (flags & PS_FOV)
-		MSG_WriteByte(msg, newPS->fov);
-
-	if (flags & PS_RDFLAGS)
-		MSG_WriteByte(msg, newPS->rdflags);
-	
-	// Send stats
-	statBits = 0;
-	for (i = 0; i < MAX_STATS; i++){
-		if (newPS->stats[i] != oldPS->stats[i])
-			statBits |= 1<<i;
-	}
-
-	MSG_WriteLong(msg, statBits);
-
-	for (i = 0; i < MAX_STATS; i++){
-		if (statBits & (1<<i))
-			MSG_WriteShort(msg, newPS->stats[i]);
-	}
-}
-
 /*
  =================
  SV_WriteFrameToClient
  =================
 */
-void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
+static void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
 
 	clientFrame_t	*frame, *oldFrame;
 	int				lastFrame;
@@ -298,6 +219,11 @@ void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
 		oldFrame = NULL;
 		lastFrame = -1;
 	}
+	else if (cl->nextEntities - cl->frames[cl->lastFrame & UPDATE_MASK].firstEntity > CLIENT_ENTITIES){
+		// The entities of the frame have been overwritten in the ring
+		oldFrame = NULL;
+		lastFrame = -1;
+	}
 	else {
 		// We have a valid message to delta from
 		oldFrame = &cl->frames[cl->lastFrame & UPDATE_MASK];
@@ -315,10 +241,15 @@ void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
 	MSG_Write(msg, frame->areaBits, frame->areaBytes);
 
 	// Delta encode the player state
-	SV_WritePlayerStateToClient(oldFrame, frame, msg);
+	MSG_WriteByte(msg, SVC_PLAYERINFO);
+
+	if (!oldFrame)
+		MSG_WriteDeltaPlayerState(msg, NULL, &frame->ps);
+	else
+		MSG_WriteDeltaPlayerState(msg, &oldFrame->ps, &frame->ps);
 
 	// Delta encode the entities
-	SV_EmitPacketEntities(oldFrame, frame, msg);
+	SV_EmitPacketEntities(cl, oldFrame, lastFrame, frame, msg);
 }
 
 
@@ -330,9 +261,6 @@ void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
  =======================================================================
 */
 
-static byte		sv_fatPVS[65536/8];		// 32767 is MAX_MAP_LEAFS
-
-
 /*
  =================
  SV_FatPVS
@@ -341,12 +269,12 @@ static byte		sv_fatPVS[65536/8];		// 32767 is MAX_MAP_LEAFS
  PVS point
  =================
 */
-static void SV_FatPVS (vec3_t org){
+static void SV_FatPVS (const vec3_t org, byte *fatPVS){
 
-	int		leafs[64];
-	int		i, j, count, longs;
-	byte	*src;
-	vec3_t	mins, maxs;
+	int			leafs[64];
+	int			i, j, count, longs;
+	const byte	*src;
+	vec3_t		mins, maxs;
 
 	for (i = 0; i < 3; i++){
 		mins[i] = org[i] - 8;
@@ -363,7 +291,7 @@ static void SV_FatPVS (vec3_t org){
 	for (i = 0; i < count; i++)
 		leafs[i] = CM_LeafCluster(leafs[i]);
 
-	memcpy(sv_fatPVS, CM_ClusterPVS(leafs[0]), longs<<2);
+	memcpy(fatPVS, CM_ClusterPVS(leafs[0]), longs<<2);
 
 	// Or in all the other leaf bits
 	for (i = 1; i < count; i++){
@@ -377,26 +305,24 @@ static void SV_FatPVS (vec3_t org){
 
 		src = CM_ClusterPVS(leafs[i]);
 		for (j = 0; j < longs; j++)
-			((long *)sv_fatPVS)[j] |= ((long *)src)[j];
+			((unsigned *)fatPVS)[j] |= ((const unsigned *)src)[j];
 	}
 }
 
 /*
  =================
- SV_BuildClientFrame
+ SV_SetupClientFrame
 
- Decides which entities are going to be visible to the client
+ Gathers everything SV_BuildClientFrame needs from the collision model.
+ This is not thread safe, so it is done for all the clients before the
+ frames are built.
  =================
 */
-void SV_BuildClientFrame (client_t *cl){
+static void SV_SetupClientFrame (client_t *cl){
 
-	int				i, e;
-	vec3_t			org, delta;
-	edict_t			*edict, *clEdict;
+	edict_t			*clEdict;
 	clientFrame_t	*frame;
-	entity_state_t	*state;
-	int				l, leafNum, area, cluster;
-	byte			*phs, *bitVector;
+	int				leafNum, cluster;
 
 	clEdict = cl->edict;
 	if (!clEdict->client)
@@ -408,108 +334,333 @@ void SV_BuildClientFrame (client_t *cl){
 	frame->sentTime = svs.realTime; // Save it for ping calc later
 
 	// Find the client's PVS
-	org[0] = clEdict->client->ps.pmove.origin[0] * 0.125 + clEdict->client->ps.viewoffset[0];
-	org[1] = clEdict->client->ps.pmove.origin[1] * 0.125 + clEdict->client->ps.viewoffset[1];
-	org[2] = clEdict->client->ps.pmove.origin[2] * 0.125 + clEdict->client->ps.viewoffset[2];
+	cl->frameOrigin[0] = clEdict->client->ps.pmove.origin[0] * 0.125 + clEdict->client->ps.viewoffset[0];
+	cl->frameOrigin[1] = clEdict->client->ps.pmove.origin[1] * 0.125 + clEdict->client->ps.viewoffset[1];
+	cl->frameOrigin[2] = clEdict->client->ps.pmove.origin[2] * 0.125 + clEdict->client->ps.viewoffset[2];
 
-	leafNum = CM_PointLeafNum(org);
-	area = CM_LeafArea(leafNum);
+	leafNum = CM_PointLeafNum(cl->frameOrigin);
+	cl->frameArea = CM_LeafArea(leafNum);
 	cluster = CM_LeafCluster(leafNum);
 
 	// Calculate the visible areas
-	frame->areaBytes = CM_WriteAreaBits(frame->areaBits, area);
+	frame->areaBytes = CM_WriteAreaBits(frame->areaBits, cl->frameArea);
 
 	// Grab the current player_state_t
 	frame->ps = clEdict->client->ps;
 
-	SV_FatPVS(org);
-	phs = CM_ClusterPHS(cluster);
+	SV_FatPVS(cl->frameOrigin, cl->framePVS);
+	memcpy(cl->framePHS, CM_ClusterPHS(cluster), (CM_NumClusters()+7)>>3);
+}
 
-	// Build up the list of visible entities
-	frame->numEntities = 0;
-	frame->firstEntity = svs.nextClientEntities;
+/*
+ =================
+ SV_BuildClientFrame
 
-	for (e = 1; e < ge->num_edicts; e++){
-		edict = EDICT_NUM(e);
+ Decides which entities are going to be visible to the client.
+ Only the edicts in the clusters of the fat PVS are looked at, using the
+ index built by SV_BuildClusterEdicts.
+ This only reads shared data, so it can run in parallel for several
+ clients.
+ =================
+*/
+static void SV_BuildClientFrame (client_t *cl){
 
-		// Ignore ents without visible models
-		if (edict->svflags & SVF_NOCLIENT)
-			continue;
+	unsigned		visible[MAX_EDICTS/32];
+	int				i, j, e, l;
+	int				longs, count;
+	unsigned		bits;
+	vec3_t			delta;
+	edict_t			*edict, *clEdict;
+	clientFrame_t	*frame;
+	entity_state_t	*entities, *state;
+	const int		*list;
+	const byte		*areaBits;
 
-		// Ignore ents without visible models unless they have an effect
-		if (!edict->s.modelindex && !edict->s.effects && !edict->s.sound && !edict->s.event)
+	clEdict = cl->edict;
+	if (!clEdict->client)
+		return;		// Not in game yet
+
+	// This is the frame we are creating
+	frame = &cl->frames[sv.frameNum & UPDATE_MASK];
+
+	memset(visible, 0, sizeof(visible));
+
+	// The client's own edict doesn't need to be in the PVS
+	e = NUM_FOR_EDICT(clEdict);
+	if (SV_EdictSendable(clEdict))
+		visible[e >> 5] |= 1U << (e&31);
+
+	// Mark everything touching a cluster in the fat PVS
+	longs = (CM_NumClusters()+31)>>5;
+
+	for (i = 0; i < longs; i++){
+		bits = ((const unsigned *)cl->framePVS)[i];
+		if (!bits)
 			continue;
 
-		// Ignore if not touching a PV leaf
-		if (edict != clEdict){
-			// Check area
-			if (!CM_AreasConnected(area, edict->areanum)){
-				// Doors can legally straddle two areas, so we may need 
-				// to check another one
-				if (!edict->areanum2 || !CM_AreasConnected(area, edict->areanum2))
-					continue;		// Blocked by a door
-			}
+		for (j = 0; j < 32; j++){
+			if (!(bits & (1U << j)))
+				continue;
 
-			// Beams just check one point for PHS
-			if (edict->s.renderfx & RF_BEAM){
-				l = edict->clusternums[0];
-				if (!(phs[l >> 3] & (1 << (l&7))))
-					continue;
-			}
-			else {
-				// FIXME: if an entity has a model and a sound, but
-				// isn't in the PVS, only the PHS, clear the model
-				bitVector = sv_fatPVS;
-
-				if (edict->num_clusters == -1){
-					// Too many leafs for individual check, go by headnode
-					if (!CM_HeadNodeVisible(edict->headnode, bitVector))
-						continue;
-				}
-				else {
-					// Check individual leafs
-					for (i = 0; i < edict->num_clusters; i++){
-						l = edict->clusternums[i];
-						if (bitVector[l >> 3] & (1 << (l&7)))
-							break;
-					}
-
-					if (i == edict->num_clusters)
-						continue;		// Not visible
+			list = SV_ClusterEdicts((i<<5) + j, &count);
+			for (l = 0; l < count; l++)
+				visible[list[l] >> 5] |= 1U << (list[l]&31);
+		}
+	}
+
+	// Check the edicts that can't be found by cluster
+	list = SV_UnclusteredEdicts(&count);
+
+	for (i = 0; i < count; i++){
+		edict = EDICT_NUM(list[i]);
+
+		// Beams just check one point for PHS
+		if (edict->s.renderfx & RF_BEAM){
+			l = edict->clusternums[0];
+			if (!(cl->framePHS[l >> 3] & (1 << (l&7))))
+				continue;
+		}
+		else {
+			// Too many leafs for individual check, go by headnode
+			if (!CM_HeadNodeVisible(edict->headnode, cl->framePVS))
+				continue;
+		}
+
+		visible[list[i] >> 5] |= 1U << (list[i]&31);
+	}
+
+	// Build up the list of visible entities, sorted by number
+	areaBits = CM_AreaConnections(cl->frameArea);
+
+	entities = svs.clientEntities + (cl - svs.clients) * CLIENT_ENTITIES;
+
+	frame->numEntities = 0;
+	frame->firstEntity = cl->nextEntities;
+
+	for (i = 0; i < (ge->num_edicts+31)>>5; i++){
+		bits = visible[i];
+		if (!bits)
+			continue;
+
+		for (j = 0; j < 32; j++){
+			if (!(bits & (1U << j)))
+				continue;
+
+			e = (i<<5) + j;
+			edict = EDICT_NUM(e);
+
+			if (edict != clEdict){
+				// Check area
+				l = edict->areanum;
+				if (!(areaBits[l >> 3] & (1 << (l&7)))){
+					// Doors can legally straddle two areas, so we may
+					// need to check another one
+					l = edict->areanum2;
+					if (!l || !(areaBits[l >> 3] & (1 << (l&7))))
+						continue;		// Blocked by a door
 				}
 
-				if (!edict->s.modelindex){
+				// FIXME: if an entity has a model and a sound, but isn't
+				// in the PVS, only the PHS, clear the model
+				if (!(edict->s.renderfx & RF_BEAM) && !edict->s.modelindex){
 					// Don't send sounds if they will be attenuated away
-					VectorSubtract(org, edict->s.origin, delta);
+					VectorSubtract(cl->frameOrigin, edict->s.origin, delta);
 					if (VectorLength(delta) > 400)
 						continue;
 				}
 			}
+
+			// Add it to the client's circular entities array
+			state = &entities[cl->nextEntities%CLIENT_ENTITIES];
+			*state = edict->s;
+
+			// Don't mark players missiles as solid
+			if (edict->owner == cl->edict)
+				state->solid = 0;
+
+			cl->nextEntities++;
+			frame->numEntities++;
 		}
+	}
+}
+
+/*
+ =================
+ SV_ClientFrameJob
+
+ Can run on a job thread, where errors can't be raised, so an overflow
+ only sets frameMsg.overflowed
+ =================
+*/
+static void SV_ClientFrameJob (void *data, int index){
+
+	client_t	*cl = ((client_t **)data)[index];
+
+	MSG_Init(&cl->frameMsg, cl->frameMsgBuffer, sizeof(cl->frameMsgBuffer), true);
+
+	// Send over all the relevant entity_state_t and the player_state_t
+	SV_BuildClientFrame(cl);
+	SV_WriteFrameToClient(cl, &cl->frameMsg);
+}
+
+/*
+ =================
+ SV_BuildClientFrames
+ =================
+*/
+void SV_BuildClientFrames (client_t **clients, int numClients){
+
+	edict_t	*edict;
+	int		i, e;
+
+	if (!numClients)
+		return;
+
+	// Make sure entity numbers are valid before anything is copied
+	for (e = 1; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
 
-		// Add it to the circular clientEntities array
 		if (edict->s.number != e){
 			Com_DPrintf(S_COLOR_YELLOW "FIXING EDICT->S.NUMBER != E!!!\n");
 			edict->s.number = e;
 		}
+	}
 
-		state = &svs.clientEntities[svs.nextClientEntities%svs.numClientEntities];
-		*state = edict->s;
+	// Sort the edicts by cluster for SV_BuildClientFrame
+	SV_BuildClusterEdicts();
 
-		// Don't mark players missiles as solid
-		if (edict->owner == cl->edict)
-			state->solid = 0;
+	// Encode what changed since the last frames once for all clients
+	SV_EncodeEntityDeltas();
 
-		svs.nextClientEntities++;
-		frame->numEntities++;
+	// Find what every client can see
+	for (i = 0; i < numClients; i++)
+		SV_SetupClientFrame(clients[i]);
+
+	// Build and encode the frames
+	if (sv_parallelFrames->integer)
+		Com_RunJobs(SV_ClientFrameJob, clients, numClients);
+	else {
+		for (i = 0; i < numClients; i++)
+			SV_ClientFrameJob(clients, i);
+	}
+
+	// Drop the frames that didn't fit, the clients will get the next ones
+	// as a delta from what they acknowledged
+	for (i = 0; i < numClients; i++){
+		if (!clients[i]->frameMsg.overflowed)
+			continue;
+
+		Com_Printf(S_COLOR_YELLOW "WARNING: frame overflowed for %s\n", clients[i]->name);
+
+		MSG_Clear(&clients[i]->frameMsg);
 	}
 }
 
+/*
+ =================
+ SV_WriteDemoFrame
+
+ Writes everything in the world, either as a delta from the last
+ recorded frame or from scratch
+ =================
+*/
+static void SV_WriteDemoFrame (msg_t *msg, qboolean delta){
+
+	edict_t			*edict;
+	entity_state_t	*oldState, nullState;
+	int				e, bits;
+
+	memset(&nullState, 0, sizeof(nullState));
+
+	// Write a frame message that doesn't contain a player_state_t
+	MSG_WriteByte(msg, SVC_FRAME);
+	MSG_WriteLong(msg, sv.frameNum);
+	MSG_WriteLong(msg, (delta) ? svs.demoFrameNum : -1);
+
+	MSG_WriteByte(msg, SVC_PACKETENTITIES);
+
+	for (e = 1; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
+
+		if (delta && svs.demoEntities[e].number)
+			oldState = &svs.demoEntities[e];
+		else
+			oldState = NULL;
+
+		// Ignore ents without visible models unless they have an effect
+		if (edict->inuse && edict->s.number && SV_EdictSendable(edict)){
+			if (oldState)
+				MSG_WriteDeltaEntity(msg, oldState, &edict->s, false, false);
+			else
+				MSG_WriteDeltaEntity(msg, &nullState, &edict->s, false, true);
+
+			continue;
+		}
+
+		if (!oldState)
+			continue;
+
+		// The entity was in the last recorded frame, but isn't now
+		bits = U_REMOVE;
+		if (e >= 256)
+			bits |= U_NUMBER16 | U_MOREBITS1;
+
+		MSG_WriteByte(msg, bits&255);
+		if (bits & 0x0000ff00)
+			MSG_WriteByte(msg, (bits>>8)&255);
+
+		if (bits & U_NUMBER16)
+			MSG_WriteShort(msg, e);
+		else
+			MSG_WriteByte(msg, e);
+	}
+
+	MSG_WriteShort(msg, 0);		// End of packet entities
+}
+
+/*
+ =================
+ SV_WriteDemoKeyframe
+
+ Writes everything a player needs to start watching from this frame
+ =================
+*/
+static void SV_WriteDemoKeyframe (void){
+
+	byte	data[32768];
+	msg_t	msg;
+	int		i;
+
+	Com_BeginDemoKeyframe(svs.demoFile, sv.frameNum);
+
+	MSG_Init(&msg, data, sizeof(data), false);
+
+	for (i = 0; i < MAX_CONFIGSTRINGS; i++){
+		if (!sv.configStrings[i][0])
+			continue;
+
+		MSG_WriteByte(&msg, SVC_CONFIGSTRING);
+		MSG_WriteShort(&msg, i);
+		MSG_WriteString(&msg, sv.configStrings[i]);
+	}
+
+	Com_WriteDemoMessage(svs.demoFile, sv.frameNum, msg.data, msg.curSize);
+
+	MSG_Clear(&msg);
+
+	SV_WriteDemoFrame(&msg, false);
+
+	Com_WriteDemoMessage(svs.demoFile, sv.frameNum, msg.data, msg.curSize);
+
+	Com_EndDemoKeyframe(svs.demoFile);
+}
+
 /*
  =================
  SV_RecordDemoMessage
 
- Save everything in the world out without deltas. 
+ Save everything in the world out, delta compressed from the last 
+ recorded frame. A full copy is saved in a keyframe every now and then.
  Used for recording footage for merged or assembled demos.
  =================
 */
@@ -518,41 +669,35 @@ void SV_RecordDemoMessage (void){
 	byte			data[32768];
 	msg_t			msg;
 	edict_t			*edict;
-	entity_state_t	nullState;
-	int				e, len;
+	int				e;
 
 	if (!svs.demoFile)
 		return;
 
-	memset(&nullState, 0, sizeof(nullState));
-
 	MSG_Init(&msg, data, sizeof(data), false);
 
-	// Write a frame message that doesn't contain a player_state_t
-	MSG_WriteByte(&msg, SVC_FRAME);
-	MSG_WriteLong(&msg, sv.frameNum);
+	SV_WriteDemoFrame(&msg, svs.demoFrameNum != -1);
 
-	MSG_WriteByte(&msg, SVC_PACKETENTITIES);
+	// Now add the accumulated multicast information
+	MSG_Write(&msg, svs.demoMulticast.data, svs.demoMulticast.curSize);
+	MSG_Clear(&svs.demoMulticast);
 
-	e = 1;
-	edict = EDICT_NUM(e);
-	while (e < ge->num_edicts){
-		// Ignore ents without visible models unless they have an effect
-		if (edict->inuse && edict->s.number && (edict->s.modelindex || edict->s.effects || edict->s.sound || edict->s.event) && !(edict->svflags & SVF_NOCLIENT))
-			MSG_WriteDeltaEntity(&msg, &nullState, &edict->s, false, true);
+	Com_WriteDemoMessage(svs.demoFile, sv.frameNum, msg.data, msg.curSize);
 
-		e++;
-		edict = EDICT_NUM(e);
-	}
+	// Playback continues with the next frame after a seek, so the 
+	// keyframe goes after this one
+	if (Com_DemoKeyframeDue(svs.demoFile, sv.frameNum))
+		SV_WriteDemoKeyframe();
 
-	MSG_WriteShort(&msg, 0);		// End of packet entities
+	// Remember what was written for the next delta
+	for (e = 1; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
 
-	// Now add the accumulated multicast information
-	MSG_Write(&msg, svs.demoMulticast.data, svs.demoMulticast.curSize);
-	MSG_Clear(&svs.demoMulticast);
+		if (edict->inuse && edict->s.number && SV_EdictSendable(edict))
+			svs.demoEntities[e] = edict->s;
+		else
+			svs.demoEntities[e].number = 0;
+	}
 
-	// Now write the entire message to the file, prefixed by the length
-	len = LittleLong(msg.curSize);
-	FS_Write(&len, sizeof(len), svs.demoFile);
-	FS_Write(msg.data, msg.curSize, svs.demoFile);
+	svs.demoFrameNum = sv.frameNum;
 }
@@ -300,10 +300,10 @@ static void SVG_WriteAngle (float a){
 */
 static qboolean SVG_InPVS (vec3_t p1, vec3_t p2){
 
-	int		leafNum;
-	int		cluster;
-	int		area1, area2;
-	byte	*mask;
+	int			leafNum;
+	int			cluster;
+	int			area1, area2;
+	const byte	*mask;
 
 	leafNum = CM_PointLeafNum(p1);
 	cluster = CM_LeafCluster(leafNum);
@@ -332,10 +332,10 @@ static qboolean SVG_InPVS (vec3_t p1, vec3_t p2){
 */
 static qboolean SVG_InPHS (vec3_t p1, vec3_t p2){
 
-	int		leafNum;
-	int		cluster;
-	int		area1, area2;
-	byte	*mask;
+	int			leafNum;
+	int			cluster;
+	int			area1, area2;
+	const byte	*mask;
 
 	leafNum = CM_PointLeafNum(p1);
 	cluster = CM_LeafCluster(leafNum);
@@ -199,7 +199,7 @@ static void SV_SpawnServer (const char *server, const char *spawnPoint, qboolean
 	Com_SetServerState(sv.state);
 
 	if (sv.demoFile)
-		FS_FCloseFile(sv.demoFile);
+		Com_CloseDemo(sv.demoFile);
 
 	// Wipe the entire per-level structure
 	memset(&sv, 0, sizeof(sv));
@@ -352,7 +352,7 @@ void SV_InitGame (void){
 	svs.initialized = true;
 	svs.spawnCount = rand();
 	svs.clients = Z_Malloc(sv_maxClients->integer * sizeof(client_t));
-	svs.numClientEntities = sv_maxClients->integer * UPDATE_BACKUP*64;
+	svs.numClientEntities = sv_maxClients->integer * CLIENT_ENTITIES;
 	svs.clientEntities = Z_Malloc(svs.numClientEntities * sizeof(entity_state_t));
 
 	// Send a heartbeat immediately
@@ -49,6 +49,7 @@ cvar_t	*sv_enforceTime;
 cvar_t	*sv_allowDownload;
 cvar_t	*sv_publicServer;
 cvar_t	*sv_rconPassword;
+cvar_t	*sv_parallelFrames;
 
 
 /*
@@ -807,6 +808,8 @@ static void SV_RunGameFrame (void){
 	if (com_speeds->integer)
 		com_timeBeforeGame = Sys_Milliseconds();
 
+	SV_UpdateClientClusters();
+
 	ge->RunFrame();
 
 	if (com_speeds->integer)
@@ -882,6 +885,26 @@ void SV_Frame (int msec){
 	}
 }
 
+/*
+ =================
+ SV_FrameTimeLeft
+
+ Returns how many milliseconds are left until the next game frame has
+ to run, so a dedicated server can sleep in the meantime
+ =================
+*/
+int SV_FrameTimeLeft (void){
+
+	// If server is not active, only packets and commands can wake us up
+	if (!svs.initialized)
+		return 100;
+
+	if (timedemo->integer || svs.realTime >= sv.time)
+		return 0;
+
+	return sv.time - svs.realTime;
+}
+
 /*
  =================
  SV_Init
@@ -919,6 +942,7 @@ void SV_Init (void){
 	sv_allowDownload = Cvar_Get("sv_allowDownload", "1", CVAR_ARCHIVE);
 	sv_publicServer = Cvar_Get("sv_publicServer", "1", 0);
 	sv_rconPassword = Cvar_Get("rconPassword", "", 0);
+	sv_parallelFrames = Cvar_Get("sv_parallelFrames", "1", 0);
 
 	Cmd_AddCommand("loadgame", SV_LoadGame_f);
 	Cmd_AddCommand("savegame", SV_SaveGame_f);
@@ -926,6 +950,7 @@ void SV_Init (void){
 	Cmd_AddCommand("gamemap", SV_GameMap_f);
 	Cmd_AddCommand("map", SV_Map_f);
 	Cmd_AddCommand("demo", SV_Demo_f);
+	Cmd_AddCommand("seekdemo", SV_SeekDemo_f);
 	Cmd_AddCommand("kick", SV_Kick_f);
 	Cmd_AddCommand("status", SV_Status_f);
 	Cmd_AddCommand("heartbeat", SV_Heartbeat_f);
@@ -1009,13 +1034,13 @@ void SV_Shutdown (const char *message, qboolean reconnect){
 
 	// Free server data
 	if (sv.demoFile)
-		FS_FCloseFile(sv.demoFile);
+		Com_CloseDemo(sv.demoFile);
 
 	memset(&sv, 0, sizeof(sv));
 
 	// Free server static data
 	if (svs.demoFile)
-		FS_FCloseFile(svs.demoFile);
+		Com_CloseDemo(svs.demoFile);
 
 	if (svs.clients){
 		for (i = 0, cl = svs.clients; i < sv_maxClients->integer; i++, cl++){
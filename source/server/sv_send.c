@@ -145,6 +145,38 @@ void SV_BroadcastCommand (const char *fmt, ...){
 	SV_Multicast(NULL, MULTICAST_ALL_R);
 }
 
+/*
+ =================
+ SV_UpdateClientClusters
+
+ Finds the cluster and area of every client in one batch
+ =================
+*/
+void SV_UpdateClientClusters (void){
+
+	vec3_t		origins[MAX_CLIENTS];
+	int			leafNums[MAX_CLIENTS];
+	client_t	*cl;
+	int			i;
+
+	for (i = 0, cl = svs.clients; i < sv_maxClients->integer; i++, cl++){
+		if (cl->state == CS_FREE || cl->state == CS_ZOMBIE || !cl->edict)
+			VectorClear(origins[i]);
+		else
+			VectorCopy(cl->edict->s.origin, origins[i]);
+	}
+
+	CM_PointLeafNums((const vec3_t *)origins, sv_maxClients->integer, leafNums);
+
+	for (i = 0; i < sv_maxClients->integer; i++){
+		VectorCopy(origins[i], sv.clientOrigins[i]);
+		sv.clientClusters[i] = CM_LeafCluster(leafNums[i]);
+		sv.clientAreas[i] = CM_LeafArea(leafNums[i]);
+	}
+
+	sv.clientCacheValid = true;
+}
+
 /*
  =================
  SV_Multicast
@@ -160,7 +192,8 @@ void SV_BroadcastCommand (const char *fmt, ...){
 void SV_Multicast (vec3_t origin, multicast_t to){
 
 	client_t	*cl;
-	byte		*mask;
+	const byte	*mask = NULL, *areaBits = NULL;
+	byte		send[MAX_CLIENTS];
 	int			leafNum, cluster, area1, area2;
 	int			i;
 	qboolean	reliable = false;
@@ -185,6 +218,7 @@ void SV_Multicast (vec3_t origin, multicast_t to){
 	case MULTICAST_ALL:
 		leafNum = 0;
 		mask = NULL;
+		areaBits = NULL;
 
 		break;
 	case MULTICAST_PHS_R:
@@ -194,6 +228,7 @@ void SV_Multicast (vec3_t origin, multicast_t to){
 		leafNum = CM_PointLeafNum(origin);
 		cluster = CM_LeafCluster(leafNum);
 		mask = CM_ClusterPHS(cluster);
+		areaBits = CM_AreaConnections(area1);
 
 		break;
 	case MULTICAST_PVS_R:
@@ -203,12 +238,46 @@ void SV_Multicast (vec3_t origin, multicast_t to){
 		leafNum = CM_PointLeafNum(origin);
 		cluster = CM_LeafCluster(leafNum);
 		mask = CM_ClusterPVS(cluster);
+		areaBits = CM_AreaConnections(area1);
 
 		break;
 	default:
 		Com_Error(ERR_DROP, "SV_Multicast: bad to");
 	}
 
+	if (mask){
+		if (!sv.clientCacheValid)
+			SV_UpdateClientClusters();
+
+		// Clients may have moved since the cache was updated
+		for (i = 0, cl = svs.clients; i < sv_maxClients->integer; i++, cl++){
+			if (cl->state == CS_FREE || cl->state == CS_ZOMBIE || !cl->edict)
+				continue;
+
+			if (VectorCompare(cl->edict->s.origin, sv.clientOrigins[i]))
+				continue;
+
+			leafNum = CM_PointLeafNum(cl->edict->s.origin);
+
+			VectorCopy(cl->edict->s.origin, sv.clientOrigins[i]);
+			sv.clientClusters[i] = CM_LeafCluster(leafNum);
+			sv.clientAreas[i] = CM_LeafArea(leafNum);
+		}
+
+		// Test all the clients against the mask and area bits in one pass
+		for (i = 0; i < sv_maxClients->integer; i++){
+			cluster = sv.clientClusters[i];
+			area2 = sv.clientAreas[i];
+
+			if (cluster < 0){
+				send[i] = 0;
+				continue;
+			}
+
+			send[i] = (mask[cluster>>3] >> (cluster&7)) & (areaBits[area2>>3] >> (area2&7)) & 1;
+		}
+	}
+
 	// Send the data to all relevant clients
 	for (i = 0, cl = svs.clients; i < sv_maxClients->integer; i++, cl++){
 		if (cl->state == CS_FREE || cl->state == CS_ZOMBIE)
@@ -217,17 +286,8 @@ void SV_Multicast (vec3_t origin, multicast_t to){
 		if (cl->state != CS_SPAWNED && !reliable)
 			continue;
 
-		if (mask){
-			leafNum = CM_PointLeafNum(cl->edict->s.origin);
-			cluster = CM_LeafCluster(leafNum);
-			area2 = CM_LeafArea(leafNum);
-
-			if (!CM_AreasConnected(area1, area2))
-				continue;
-
-			if (!(mask[cluster>>3] & (1<<(cluster&7))))
-				continue;
-		}
+		if (mask && !send[i])
+			continue;
 
 		if (reliable)
 			MSG_Write(&cl->netChan.message, sv.multicast.data, sv.multicast.curSize);
@@ -367,6 +427,8 @@ void SV_StartSound (vec3_t origin, edict_t *entity, int channel, int sound, floa
 /*
  =================
  SV_SendClientDatagram
+
+ The frame must have been built with SV_BuildClientFrames
  =================
 */
 static void SV_SendClientDatagram (client_t *cl){
@@ -377,13 +439,15 @@ static void SV_SendClientDatagram (client_t *cl){
 	MSG_Init(&msg, data, sizeof(data), true);
 
 	// Send over all the relevant entity_state_t and the player_state_t
-	SV_BuildClientFrame(cl);
-	SV_WriteFrameToClient(cl, &msg);
+	if (cl->frameMsg.curSize > msg.maxSize)
+		msg.overflowed = true;
+	else
+		MSG_Write(&msg, cl->frameMsg.data, cl->frameMsg.curSize);
 
 	// Copy the accumulated multicast datagram for this client out to 
 	// the message.
-	// It is necessary for this to be after the SV_WriteFrameToClient so
-	// that entity references will be current.
+	// It is necessary for this to be after the frame so that entity
+	// references will be current.
 	if (cl->datagram.overflowed)
 		Com_Printf(S_COLOR_YELLOW "WARNING: datagram overflowed for %s\n", cl->name);
 	else
@@ -412,8 +476,8 @@ static void SV_SendClientDatagram (client_t *cl){
 static void SV_DemoCompleted (void){
 
 	if (sv.demoFile){
-		FS_FCloseFile(sv.demoFile);
-		sv.demoFile = 0;
+		Com_CloseDemo(sv.demoFile);
+		sv.demoFile = NULL;
 	}
 
 	SV_NextServer();
@@ -455,31 +519,18 @@ static qboolean SV_RateDrop (client_t *cl){
 void SV_SendClientMessages (void){
 
 	client_t	*cl;
+	client_t	*sendClients[MAX_CLIENTS];
 	byte		data[MAX_MSGLEN];
-	int			i, r, len = 0;
+	int			i, len = 0;
+	int			numSendClients = 0;
 
 	// Read the next demo message if needed
 	if ((sv.state == SS_DEMO && sv.demoFile) && !paused->integer){
-		r = FS_Read(&len, sizeof(len), sv.demoFile);
-		if (r != 4){
-			SV_DemoCompleted();
-			return;
-		}
-
-		len = LittleLong(len);
+		len = Com_ReadDemoMessage(sv.demoFile, data, sizeof(data));
 		if (len == -1){
 			SV_DemoCompleted();
 			return;
 		}
-
-		if (len > MAX_MSGLEN)
-			Com_Error(ERR_DROP, "SV_SendClientMessages: len > MAX_MSGLEN");
-
-		r = FS_Read(data, len, sv.demoFile);
-		if (r != len){
-			SV_DemoCompleted();
-			return;
-		}
 	}
 
 	// Send a message to each connected client
@@ -502,7 +553,8 @@ void SV_SendClientMessages (void){
 			if (SV_RateDrop(cl))
 				continue;
 
-			SV_SendClientDatagram(cl);
+			// The datagram is sent after all the frames are built
+			sendClients[numSendClients++] = cl;
 		}
 		else {
 			// Just update reliable	if needed
@@ -510,4 +562,14 @@ void SV_SendClientMessages (void){
 				NetChan_Transmit(&cl->netChan, NULL, 0);
 		}
 	}
+
+	if (!numSendClients)
+		return;
+
+	// Build the frames of all the clients, possibly in parallel, then
+	// send them out in client order
+	SV_BuildClientFrames(sendClients, numSendClients);
+
+	for (i = 0; i < numSendClients; i++)
+		SV_SendClientDatagram(sendClients[i]);
 }
@@ -35,9 +35,10 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 static void SV_New_f (void){
 
-	char		name[MAX_QPATH];
-	int			playerNum;
-	edict_t		*ent;
+	char			name[MAX_QPATH];
+	fileHandle_t	f;
+	int				playerNum;
+	edict_t			*ent;
 
 	Com_DPrintf("SV_New_f() from %s\n", sv_client->name);
 
@@ -49,10 +50,12 @@ static void SV_New_f (void){
 	// Demo servers just dump the file message
 	if (sv.state == SS_DEMO){
 		Q_snprintfz(name, sizeof(name), "demos/%s", sv.name);
-		FS_FOpenFile(name, &sv.demoFile, FS_READ);
-		if (!sv.demoFile)
+		FS_FOpenFile(name, &f, FS_READ);
+		if (!f)
 			Com_Error(ERR_DROP, "Couldn't open demo %s", name);
 
+		sv.demoFile = Com_PlayDemo(f);
+
 		return;
 	}
 
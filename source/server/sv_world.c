@@ -35,7 +35,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 // FIXME: remove this mess!
-#define	STRUCT_FROM_LINK(l,t,m) ((t *)((byte *)l - (int)&(((t *)0)->m)))
+#define	STRUCT_FROM_LINK(l,t,m) ((t *)((byte *)l - (size_t)&(((t *)0)->m)))
 #define	EDICT_FROM_AREA(l)		STRUCT_FROM_LINK(l, edict_t, area)
 
 #define	AREA_DEPTH				4
@@ -412,6 +412,124 @@ int SV_AreaEdicts (vec3_t mins, vec3_t maxs, edict_t **list, int maxCount, int a
 }
 
 
+/*
+ =======================================================================
+
+ CLUSTER EDICT INDEX
+
+ Every frame, the edicts that may be sent to clients are sorted by the
+ PVS clusters they touch, so client frames only need to look at the
+ edicts in the clusters they can see instead of all of them.
+ =======================================================================
+*/
+
+static int		sv_numIndexedClusters;
+static int		sv_clusterFirstEdict[MAX_MAP_LEAFS+1];	// Into sv_clusterEdicts
+static int		sv_clusterEdicts[MAX_EDICTS*MAX_ENT_CLUSTERS];
+
+// Edicts that can't be found by cluster (too many leafs or beams)
+static int		sv_numUnclusteredEdicts;
+static int		sv_unclusteredEdicts[MAX_EDICTS];
+
+
+/*
+ =================
+ SV_BuildClusterEdicts
+ =================
+*/
+void SV_BuildClusterEdicts (void){
+
+	edict_t	*edict;
+	int		*first;
+	int		e, i, c, cluster;
+
+	sv_numIndexedClusters = CM_NumClusters();
+	sv_numUnclusteredEdicts = 0;
+
+	first = sv_clusterFirstEdict;
+	memset(first, 0, (sv_numIndexedClusters+1) * sizeof(int));
+
+	// Count the edicts in each cluster
+	for (e = 1; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
+
+		if (!SV_EdictSendable(edict))
+			continue;
+
+		if (edict->num_clusters == -1 || (edict->s.renderfx & RF_BEAM)){
+			sv_unclusteredEdicts[sv_numUnclusteredEdicts++] = e;
+			continue;
+		}
+
+		for (i = 0; i < edict->num_clusters; i++){
+			cluster = edict->clusternums[i];
+			if (cluster < 0 || cluster >= sv_numIndexedClusters)
+				continue;
+
+			first[cluster+1]++;
+		}
+	}
+
+	// Turn the counts into offsets
+	for (c = 1; c <= sv_numIndexedClusters; c++)
+		first[c] += first[c-1];
+
+	// Fill in the lists, using first[cluster] as the insertion point
+	for (e = 1; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
+
+		if (!SV_EdictSendable(edict))
+			continue;
+
+		if (edict->num_clusters == -1 || (edict->s.renderfx & RF_BEAM))
+			continue;
+
+		for (i = 0; i < edict->num_clusters; i++){
+			cluster = edict->clusternums[i];
+			if (cluster < 0 || cluster >= sv_numIndexedClusters)
+				continue;
+
+			sv_clusterEdicts[first[cluster]++] = e;
+		}
+	}
+
+	// Filling in moved every offset to the start of the next cluster
+	for (c = sv_numIndexedClusters; c > 0; c--)
+		first[c] = first[c-1];
+
+	first[0] = 0;
+}
+
+/*
+ =================
+ SV_ClusterEdicts
+ =================
+*/
+const int *SV_ClusterEdicts (int cluster, int *count){
+
+	if (cluster < 0 || cluster >= sv_numIndexedClusters){
+		*count = 0;
+		return sv_clusterEdicts;
+	}
+
+	*count = sv_clusterFirstEdict[cluster+1] - sv_clusterFirstEdict[cluster];
+
+	return sv_clusterEdicts + sv_clusterFirstEdict[cluster];
+}
+
+/*
+ =================
+ SV_UnclusteredEdicts
+ =================
+*/
+const int *SV_UnclusteredEdicts (int *count){
+
+	*count = sv_numUnclusteredEdicts;
+
+	return sv_unclusteredEdicts;
+}
+
+
 // =====================================================================
 
 typedef struct {
@@ -870,9 +870,9 @@ char *Q_CleanStr (char *string){
  Q_SortStrcmp
  =================
 */
-int Q_SortStrcmp (const char **arg1, const char **arg2){
+int Q_SortStrcmp (const void *arg1, const void *arg2){
 
-	return Q_strcmp(*arg1, *arg2);
+	return Q_strcmp(*(const char **)arg1, *(const char **)arg2);
 }
 
 /*
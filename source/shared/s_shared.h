@@ -99,6 +99,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #if defined __i386__
 #define BUILDSTRING		"Linux-i386"
+#elif defined __x86_64__
+#define BUILDSTRING		"Linux-x86_64"
 #elif defined __axp__
 #define BUILDSTRING		"Linux-AXP"
 #else
@@ -367,6 +369,9 @@ void		AddPointToBounds (const vec3_t v, vec3_t mins, vec3_t maxs);
 float		RadiusFromBounds (const vec3_t mins, const vec3_t maxs);
 qboolean	BoundsIntersect (const vec3_t mins1, const vec3_t maxs1, const vec3_t mins2, const vec3_t maxs2);
 qboolean	BoundsAndSphereIntersect (const vec3_t mins, const vec3_t maxs, const vec3_t origin, float radius);
+
+struct cplane_s;
+
 qboolean	PlaneFromPoints (struct cplane_s *plane, const vec3_t a, const vec3_t b, const vec3_t c);
 void		SetPlaneSignbits (struct cplane_s *plane);
 int			PlaneTypeForNormal (const vec3_t normal);
@@ -463,7 +468,7 @@ int			Q_PrintStrlen (const char *string);
 char		*Q_CleanStr (char *string);
 
 // String compare used for qsort calls
-int			Q_SortStrcmp (const char **arg1, const char **arg2);
+int			Q_SortStrcmp (const void *arg1, const void *arg2);
 
 // Portable string compare
 int			Q_strnicmp (const char *string1, const char *string2, int n);
@@ -0,0 +1,856 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+#ifdef __linux__
+#define _GNU_SOURCE						// For recvmmsg and sendmmsg
+#endif
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "../qcommon/qcommon.h"
+
+
+// Packets are received and sent in batches. On Linux each batch is a
+// single recvmmsg or sendmmsg call, elsewhere we loop on recvfrom and
+// sendto so the rest of the code doesn't need to care.
+#ifdef __linux__
+#define USE_MMSG
+#endif
+
+#define	MAX_LOOPBACK	4
+
+#define MAX_RECV_QUEUE	32
+#define MAX_SEND_QUEUE	64
+
+typedef struct {
+	byte		data[MAX_MSGLEN];
+	int			dataLen;
+} loopMsg_t;
+
+typedef struct {
+	loopMsg_t	msgs[MAX_LOOPBACK];
+	int			get;
+	int			send;
+} loopback_t;
+
+typedef struct {
+	byte				data[MAX_MSGLEN];
+	int					dataLen;
+	struct sockaddr_in	addr;
+	int					flags;
+} netPacket_t;
+
+typedef struct {
+	netPacket_t			recvPackets[MAX_RECV_QUEUE];
+	int					recvCount;
+	int					recvCurrent;
+
+	netPacket_t			sendPackets[MAX_SEND_QUEUE];
+	int					sendCount;
+
+	int					recvCalls;		// Syscalls made, for net_stats
+	int					sendCalls;
+	int					recvTotal;		// Packets moved
+	int					sendTotal;
+} netQueue_t;
+
+static loopback_t	net_loopbacks[2];
+static int			net_sockets[2];
+static netQueue_t	net_queues[2];
+
+extern qboolean		sys_stdinActive;
+
+cvar_t	*net_ip;
+cvar_t	*net_port;
+cvar_t	*net_clientPort;
+
+
+/*
+ =================
+ NET_ErrorString
+ =================
+*/
+static const char *NET_ErrorString (void){
+
+	return strerror(errno);
+}
+
+/*
+ =================
+ NET_NetadrToSockadr
+ =================
+*/
+static void NET_NetadrToSockadr (const netAdr_t *adr, struct sockaddr_in *s){
+
+	memset(s, 0, sizeof(*s));
+
+	if (adr->type == NA_BROADCAST){
+		s->sin_family = AF_INET;
+		s->sin_port = adr->port;
+		s->sin_addr.s_addr = INADDR_BROADCAST;
+	}
+	else if (adr->type == NA_IP){
+		s->sin_family = AF_INET;
+		s->sin_addr.s_addr = *(int *)&adr->ip;
+		s->sin_port = adr->port;
+	}
+}
+
+/*
+ =================
+ NET_SockadrToNetadr
+ =================
+*/
+static void NET_SockadrToNetadr (const struct sockaddr_in *s, netAdr_t *adr){
+
+	memset(adr, 0, sizeof(netAdr_t));
+
+	if (s->sin_family == AF_INET){
+		adr->type = NA_IP;
+		*(int *)&adr->ip = s->sin_addr.s_addr;
+		adr->port = s->sin_port;
+	}
+}
+
+/*
+ =================
+ NET_StringToSockaddr
+
+ localhost
+ idnewt
+ idnewt:28000
+ 192.246.40.70
+ 192.246.40.70:28000
+ =================
+*/
+static qboolean NET_StringToSockaddr (const char *string, struct sockaddr_in *s){
+
+	struct hostent	*h;
+	char			*colon;
+	char			copy[128];
+	
+	memset(s, 0, sizeof(*s));
+
+	s->sin_family = AF_INET;
+	s->sin_port = 0;
+
+	Q_strncpyz(copy, string, sizeof(copy));
+
+	// Strip off a trailing :port if present
+	for (colon = copy; *colon; colon++){
+		if (*colon == ':'){
+			*colon = 0;
+			s->sin_port = htons((short)atoi(colon+1));	
+		}
+	}
+		
+	if (copy[0] >= '0' && copy[0] <= '9')
+		s->sin_addr.s_addr = inet_addr(copy);
+	else {
+		if (!(h = gethostbyname(copy)))
+			return false;
+
+		s->sin_addr.s_addr = *(int *)h->h_addr_list[0];
+	}
+	
+	return true;
+}
+
+/*
+ =================
+ NET_CompareAdr
+ =================
+*/
+qboolean NET_CompareAdr (const netAdr_t a, const netAdr_t b){
+
+	if (a.type != b.type)
+		return false;
+
+	if (a.type == NA_LOOPBACK)
+		return true;
+	else if (a.type == NA_IP){
+		if (!memcmp(a.ip, b.ip, 4) && a.port == b.port)
+			return true;
+
+		return false;
+	}
+	else {
+		Com_Printf(S_COLOR_RED "NET_CompareAdr: bad address type\n");
+		return false;
+	}
+}
+
+/*
+ =================
+ NET_CompareBaseAdr
+
+ Compare without the port
+ =================
+*/
+qboolean NET_CompareBaseAdr (const netAdr_t a, const netAdr_t b){
+
+	if (a.type != b.type)
+		return false;
+
+	if (a.type == NA_LOOPBACK)
+		return true;
+	else if (a.type == NA_IP){
+		if (!memcmp(a.ip, b.ip, 4))
+			return true;
+
+		return false;
+	}
+	else {
+		Com_Printf(S_COLOR_RED "NET_CompareBaseAdr: bad address type\n");
+		return false;
+	}
+}
+
+/*
+ =================
+ NET_IsLocalAddress
+ =================
+*/
+qboolean NET_IsLocalAddress (const netAdr_t adr){
+
+	return (adr.type == NA_LOOPBACK);
+}
+
+/*
+ =================
+ NET_AdrToString
+ =================
+*/
+char *NET_AdrToString (const netAdr_t adr){
+
+	static char	string[64];
+
+	if (adr.type == NA_LOOPBACK)
+		Q_snprintfz(string, sizeof(string), "loopback");
+	else if (adr.type == NA_IP)
+		Q_snprintfz(string, sizeof(string), "%i.%i.%i.%i:%i", adr.ip[0], adr.ip[1], adr.ip[2], adr.ip[3], ntohs(adr.port));
+	else
+		string[0] = 0;
+
+	return string;
+}
+
+/*
+ =================
+ NET_StringToAdr
+
+ localhost
+ idnewt
+ idnewt:28000
+ 192.246.40.70
+ 192.246.40.70:28000
+ =================
+*/
+qboolean NET_StringToAdr (const char *string, netAdr_t *adr){
+
+	struct sockaddr_in	s;
+	
+	if (!Q_stricmp(string, "localhost")){
+		memset(adr, 0, sizeof(netAdr_t));
+		adr->type = NA_LOOPBACK;
+		return true;
+	}
+
+	if (!NET_StringToSockaddr(string, &s))
+		return false;
+	
+	NET_SockadrToNetadr(&s, adr);
+
+	return true;
+}
+
+
+/*
+ =======================================================================
+
+ LOOPBACK BUFFERS FOR LOCAL PLAYER
+
+ =======================================================================
+*/
+
+
+/*
+ =================
+ NET_GetLoopPacket
+ =================
+*/
+static qboolean NET_GetLoopPacket (netSrc_t sock, netAdr_t *from, msg_t *msg){
+
+	int			i;
+	loopback_t	*loop;
+
+	loop = &net_loopbacks[sock];
+
+	if (loop->send - loop->get > MAX_LOOPBACK)
+		loop->get = loop->send - MAX_LOOPBACK;
+
+	if (loop->get >= loop->send)
+		return false;
+
+	i = loop->get & (MAX_LOOPBACK-1);
+	loop->get++;
+
+	memcpy(msg->data, loop->msgs[i].data, loop->msgs[i].dataLen);
+	msg->curSize = loop->msgs[i].dataLen;
+
+	memset(from, 0, sizeof(netAdr_t));
+	from->type = NA_LOOPBACK;
+
+	return true;
+}
+
+/*
+ =================
+ NET_SendLoopPacket
+ =================
+*/
+static qboolean NET_SendLoopPacket (netSrc_t sock, const netAdr_t to, const void *data, int length){
+
+	int			i;
+	loopback_t	*loop;
+
+	if (to.type != NA_LOOPBACK)
+		return false;
+
+	loop = &net_loopbacks[sock^1];
+
+	i = loop->send & (MAX_LOOPBACK-1);
+	loop->send++;
+
+	memcpy(loop->msgs[i].data, data, length);
+	loop->msgs[i].dataLen = length;
+
+	return true;
+}
+
+
+/*
+ =======================================================================
+
+ BATCHED PACKET QUEUES
+
+ =======================================================================
+*/
+
+
+/*
+ =================
+ NET_ReceivePackets
+
+ Fills the receive queue with as many pending packets as we can get in
+ one go. Returns false if nothing is waiting.
+ =================
+*/
+static qboolean NET_ReceivePackets (netSrc_t sock){
+
+	netQueue_t			*queue = &net_queues[sock];
+	netPacket_t			*packet;
+#ifdef USE_MMSG
+	struct mmsghdr		msgs[MAX_RECV_QUEUE];
+	struct iovec		iovecs[MAX_RECV_QUEUE];
+#else
+	socklen_t			addrLen;
+#endif
+	int					i, ret;
+
+	queue->recvCount = 0;
+	queue->recvCurrent = 0;
+
+#ifdef USE_MMSG
+	memset(msgs, 0, sizeof(msgs));
+
+	for (i = 0, packet = queue->recvPackets; i < MAX_RECV_QUEUE; i++, packet++){
+		iovecs[i].iov_base = packet->data;
+		iovecs[i].iov_len = sizeof(packet->data);
+
+		msgs[i].msg_hdr.msg_name = &packet->addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(packet->addr);
+		msgs[i].msg_hdr.msg_iov = &iovecs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	ret = recvmmsg(net_sockets[sock], msgs, MAX_RECV_QUEUE, MSG_DONTWAIT, NULL);
+
+	queue->recvCalls++;
+
+	if (ret == -1){
+		// EAGAIN and ECONNREFUSED are silent
+		if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNREFUSED)
+			Com_Printf(S_COLOR_RED "NET_GetPacket: %s\n", NET_ErrorString());
+
+		return false;
+	}
+
+	for (i = 0, packet = queue->recvPackets; i < ret; i++, packet++){
+		packet->dataLen = msgs[i].msg_len;
+		packet->flags = msgs[i].msg_hdr.msg_flags;
+	}
+
+	queue->recvCount = ret;
+#else
+	for (i = 0, packet = queue->recvPackets; i < MAX_RECV_QUEUE; i++, packet++){
+		addrLen = sizeof(packet->addr);
+
+		ret = recvfrom(net_sockets[sock], packet->data, sizeof(packet->data), MSG_DONTWAIT, (struct sockaddr *)&packet->addr, &addrLen);
+
+		queue->recvCalls++;
+
+		if (ret == -1){
+			// EAGAIN and ECONNREFUSED are silent
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNREFUSED)
+				Com_Printf(S_COLOR_RED "NET_GetPacket: %s\n", NET_ErrorString());
+
+			break;
+		}
+
+		packet->dataLen = ret;
+		packet->flags = 0;
+	}
+
+	queue->recvCount = i;
+#endif
+
+	queue->recvTotal += queue->recvCount;
+
+	return (queue->recvCount != 0);
+}
+
+/*
+ =================
+ NET_SendPackets
+
+ Sends everything in the send queue
+ =================
+*/
+static void NET_SendPackets (netSrc_t sock){
+
+	netQueue_t			*queue = &net_queues[sock];
+	netPacket_t			*packet;
+	netAdr_t			to;
+#ifdef USE_MMSG
+	struct mmsghdr		msgs[MAX_SEND_QUEUE];
+	struct iovec		iovecs[MAX_SEND_QUEUE];
+#endif
+	int					i, sent, ret;
+
+	if (!queue->sendCount)
+		return;
+
+	if (!net_sockets[sock]){
+		queue->sendCount = 0;
+		return;
+	}
+
+#ifdef USE_MMSG
+	memset(msgs, 0, queue->sendCount * sizeof(struct mmsghdr));
+
+	for (i = 0, packet = queue->sendPackets; i < queue->sendCount; i++, packet++){
+		iovecs[i].iov_base = packet->data;
+		iovecs[i].iov_len = packet->dataLen;
+
+		msgs[i].msg_hdr.msg_name = &packet->addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(packet->addr);
+		msgs[i].msg_hdr.msg_iov = &iovecs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+#endif
+
+	for (sent = 0; sent < queue->sendCount; sent++){
+#ifdef USE_MMSG
+		ret = sendmmsg(net_sockets[sock], msgs + sent, queue->sendCount - sent, 0);
+#else
+		packet = &queue->sendPackets[sent];
+
+		ret = sendto(net_sockets[sock], packet->data, packet->dataLen, 0, (struct sockaddr *)&packet->addr, sizeof(packet->addr));
+#endif
+
+		queue->sendCalls++;
+
+		if (ret != -1){
+#ifdef USE_MMSG
+			// Skip what went out and retry from the first one that didn't
+			sent += ret - 1;
+#endif
+			continue;
+		}
+
+		// The packet at sent failed, drop it and carry on with the rest
+		packet = &queue->sendPackets[sent];
+
+		// EAGAIN is silent
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			continue;
+
+		// Some PPP links don't allow broadcasts
+		if (errno == EADDRNOTAVAIL && packet->addr.sin_addr.s_addr == INADDR_BROADCAST)
+			continue;
+
+		NET_SockadrToNetadr(&packet->addr, &to);
+
+		Com_Printf(S_COLOR_RED "NET_SendPacket: %s to %s\n", NET_ErrorString(), NET_AdrToString(to));
+	}
+
+	queue->sendTotal += queue->sendCount;
+	queue->sendCount = 0;
+}
+
+
+// =====================================================================
+
+
+/*
+ =================
+ NET_GetPacket
+ =================
+*/
+qboolean NET_GetPacket (netSrc_t sock, netAdr_t *from, msg_t *msg){
+
+	netQueue_t	*queue = &net_queues[sock];
+	netPacket_t	*packet;
+
+	if (NET_GetLoopPacket(sock, from, msg))
+		return true;
+
+	if (!net_sockets[sock])
+		return false;
+
+	while (1){
+		// Refill the queue when everything in it has been handed out
+		if (queue->recvCurrent == queue->recvCount){
+			if (!NET_ReceivePackets(sock))
+				return false;
+		}
+
+		packet = &queue->recvPackets[queue->recvCurrent++];
+
+		NET_SockadrToNetadr(&packet->addr, from);
+
+		if ((packet->flags & MSG_TRUNC) || packet->dataLen >= msg->maxSize){
+			Com_Printf(S_COLOR_RED "NET_GetPacket: oversize packet from %s\n", NET_AdrToString(*from));
+			continue;
+		}
+
+		memcpy(msg->data, packet->data, packet->dataLen);
+		msg->curSize = packet->dataLen;
+
+		return true;
+	}
+}
+
+/*
+ =================
+ NET_SendPacket
+
+ Packets are queued until NET_Flush is called or the queue is full
+ =================
+*/
+void NET_SendPacket (netSrc_t sock, const netAdr_t to, const void *data, int length){
+
+	netQueue_t	*queue = &net_queues[sock];
+	netPacket_t	*packet;
+
+	if (NET_SendLoopPacket(sock, to, data, length))
+		return;
+
+	if (to.type != NA_BROADCAST && to.type != NA_IP)
+		Com_Error(ERR_FATAL, "NET_SendPacket: bad address type");
+
+	if (!net_sockets[sock])
+		return;
+
+	if (length > MAX_MSGLEN)
+		Com_Error(ERR_FATAL, "NET_SendPacket: oversize packet (%i)", length);
+
+	if (queue->sendCount == MAX_SEND_QUEUE)
+		NET_SendPackets(sock);
+
+	packet = &queue->sendPackets[queue->sendCount++];
+
+	memcpy(packet->data, data, length);
+	packet->dataLen = length;
+
+	NET_NetadrToSockadr(&to, &packet->addr);
+}
+
+/*
+ =================
+ NET_Flush
+
+ Sends all the packets queued by NET_SendPacket
+ =================
+*/
+void NET_Flush (netSrc_t sock){
+
+	NET_SendPackets(sock);
+}
+
+/*
+ =================
+ NET_Sleep
+
+ Blocks until a packet arrives on the server socket, there is console
+ input or msec milliseconds have passed
+ =================
+*/
+void NET_Sleep (int msec){
+
+	struct timeval	timeout;
+	fd_set			readSet;
+	int				maxFd = -1;
+
+	// Packets already in the queue don't need to wait
+	if (net_queues[NS_SERVER].recvCurrent != net_queues[NS_SERVER].recvCount)
+		return;
+
+	if (msec <= 0)
+		return;
+
+	FD_ZERO(&readSet);
+
+	if (sys_stdinActive){
+		FD_SET(0, &readSet);
+		maxFd = 0;
+	}
+
+	if (net_sockets[NS_SERVER]){
+		FD_SET(net_sockets[NS_SERVER], &readSet);
+
+		if (net_sockets[NS_SERVER] > maxFd)
+			maxFd = net_sockets[NS_SERVER];
+	}
+
+	timeout.tv_sec = msec / 1000;
+	timeout.tv_usec = (msec % 1000) * 1000;
+
+	select(maxFd + 1, &readSet, NULL, NULL, &timeout);
+}
+
+
+// =====================================================================
+
+
+/*
+ =================
+ NET_UDPSocket
+ =================
+*/
+static int NET_UDPSocket (const char *netInterface, int port){
+
+	struct sockaddr_in	addr;
+	int					_true = 1;
+	int					net_socket;
+
+	Com_DPrintf("NET_UDPSocket( %s, %i )\n", netInterface, port);
+
+	if ((net_socket = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1){
+		if (errno != EAFNOSUPPORT)
+			Com_DPrintf(S_COLOR_YELLOW "NET_UDPSocket: socket = %s\n", NET_ErrorString());
+
+		return 0;
+	}
+
+	// Make it non-blocking
+	if (ioctl(net_socket, FIONBIO, &_true) == -1){
+		Com_DPrintf(S_COLOR_YELLOW "NET_UDPSocket: ioctl FIONBIO = %s\n", NET_ErrorString());
+		close(net_socket);
+		return 0;
+	}
+
+	// Make it broadcast capable
+	if (setsockopt(net_socket, SOL_SOCKET, SO_BROADCAST, &_true, sizeof(_true)) == -1){
+		Com_DPrintf(S_COLOR_YELLOW "NET_UDPSocket: setsockopt SO_BROADCAST = %s\n", NET_ErrorString());
+		close(net_socket);
+		return 0;
+	}
+
+	if (!netInterface[0] || !Q_stricmp(netInterface, "localhost")){
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_addr.s_addr = INADDR_ANY;
+	}
+	else
+		NET_StringToSockaddr(netInterface, &addr);
+
+	if (port == PORT_ANY)
+		addr.sin_port = 0;
+	else
+		addr.sin_port = htons((short)port);
+
+	addr.sin_family = AF_INET;
+
+	if (bind(net_socket, (struct sockaddr *)&addr, sizeof(addr)) == -1){
+		Com_DPrintf(S_COLOR_YELLOW "NET_UDPSocket: bind = %s\n", NET_ErrorString());
+		close(net_socket);
+		return 0;
+	}
+
+	return net_socket;
+}
+
+/*
+ =================
+ NET_OpenUDP
+ =================
+*/
+static void NET_OpenUDP (void){
+
+	memset(net_queues, 0, sizeof(net_queues));
+
+	net_sockets[NS_SERVER] = NET_UDPSocket(net_ip->string, net_port->integer);
+	if (!net_sockets[NS_SERVER])
+		Com_Printf(S_COLOR_YELLOW "WARNING: failed to open server UDP socket\n");
+
+	// Dedicated servers don't need client ports
+	if (dedicated->integer)
+		return;
+
+	net_sockets[NS_CLIENT] = NET_UDPSocket(net_ip->string, net_clientPort->integer);
+	if (!net_sockets[NS_CLIENT]){
+		net_sockets[NS_CLIENT] = NET_UDPSocket(net_ip->string, PORT_ANY);
+		if (net_sockets[NS_CLIENT])
+			Com_Printf(S_COLOR_YELLOW "WARNING: failed to open client UDP socket\n");
+	}
+}
+
+/*
+ =================
+ NET_CloseUDP
+ =================
+*/
+static void NET_CloseUDP (void){
+
+	// Get out anything still queued, like disconnect messages
+	NET_SendPackets(NS_SERVER);
+	NET_SendPackets(NS_CLIENT);
+
+	if (net_sockets[NS_SERVER]){
+		close(net_sockets[NS_SERVER]);
+		net_sockets[NS_SERVER] = 0;
+	}
+
+	if (net_sockets[NS_CLIENT]){
+		close(net_sockets[NS_CLIENT]);
+		net_sockets[NS_CLIENT] = 0;
+	}
+}
+
+/*
+ =================
+ NET_ShowIP_f
+ =================
+*/
+void NET_ShowIP_f (void){
+
+	char			s[256];
+	int				i;
+	struct hostent	*h;
+	struct in_addr	in;
+
+	gethostname(s, sizeof(s));
+	if (!(h = gethostbyname(s))){
+		Com_Printf("Can't get host\n");
+		return;
+	}
+
+	Com_Printf("HostName: %s\n", h->h_name);
+
+	for (i = 0; h->h_addr_list[i]; i++){
+		in.s_addr = *(int *)h->h_addr_list[i];
+		Com_Printf("IP: %s\n", inet_ntoa(in));
+	}
+}
+
+/*
+ =================
+ NET_Stats_f
+ =================
+*/
+void NET_Stats_f (void){
+
+	netQueue_t	*queue;
+	int			i;
+
+	for (i = 0, queue = net_queues; i < 2; i++, queue++){
+		Com_Printf("%s: %i packets in %i receive calls, %i packets in %i send calls\n", (i == NS_SERVER) ? "server" : "client", queue->recvTotal, queue->recvCalls, queue->sendTotal, queue->sendCalls);
+	}
+}
+
+/*
+ =================
+ NET_Restart_f
+ =================
+*/
+void NET_Restart_f (void){
+
+	NET_Shutdown();
+	NET_Init();
+}
+
+/*
+ =================
+ NET_Init
+ =================
+*/
+void NET_Init (void){
+
+	// Register our cvars and commands
+	net_ip = Cvar_Get("net_ip", "localhost", CVAR_LATCH);
+	net_port = Cvar_Get("net_port", va("%i", PORT_SERVER), CVAR_LATCH);
+	net_clientPort = Cvar_Get("net_clientPort", va("%i", PORT_CLIENT), CVAR_LATCH);
+
+	Cmd_AddCommand("showip", NET_ShowIP_f);
+	Cmd_AddCommand("net_stats", NET_Stats_f);
+	Cmd_AddCommand("net_restart", NET_Restart_f);
+
+	// Open sockets
+	NET_OpenUDP();
+
+	NET_ShowIP_f();
+}
+
+/*
+ =================
+ NET_Shutdown
+ =================
+*/
+void NET_Shutdown (void){
+
+	Cmd_RemoveCommand("showip");
+	Cmd_RemoveCommand("net_stats");
+	Cmd_RemoveCommand("net_restart");
+
+	// Close sockets
+	NET_CloseUDP();
+}
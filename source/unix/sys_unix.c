@@ -0,0 +1,1077 @@
+/*
+Copyright (C) 1997-2001 Id Software, Inc.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <dlfcn.h>
+
+#include "../qcommon/qcommon.h"
+
+
+#define MAX_CONSOLE_INPUT			256
+#define	MAX_PRINTMSG				8192
+
+typedef struct {
+	char		cmdBuffer[MAX_CONSOLE_INPUT];	// Buffered input from stdin
+	int			cmdLen;
+	int			stdinFlags;				// To restore on exit
+} sysConsole_t;
+
+static sysConsole_t		sys_console;
+
+static volatile int		sys_quitSignal;
+
+static pthread_t		sys_mainThread;
+
+qboolean				sys_stdinActive;	// Cleared when stdin is closed
+
+
+/*
+ =======================================================================
+
+ DEDICATED CONSOLE
+
+ =======================================================================
+*/
+
+
+/*
+ =================
+ Sys_GetCommand
+ =================
+*/
+char *Sys_GetCommand (void){
+
+	static char buffer[MAX_CONSOLE_INPUT];
+	char		c;
+	int			ret;
+
+	if (!sys_stdinActive)
+		return NULL;
+
+	while (1){
+		ret = read(0, &c, 1);
+
+		if (ret == 0){
+			// stdin was closed, so stop watching it
+			sys_stdinActive = false;
+			return NULL;
+		}
+
+		if (ret == -1){
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				sys_stdinActive = false;
+
+			return NULL;
+		}
+
+		if (c == '\r')
+			continue;
+
+		if (c == '\n')
+			break;
+
+		if (sys_console.cmdLen < MAX_CONSOLE_INPUT - 1)
+			sys_console.cmdBuffer[sys_console.cmdLen++] = c;
+	}
+
+	sys_console.cmdBuffer[sys_console.cmdLen] = 0;
+	sys_console.cmdLen = 0;
+
+	Q_strncpyz(buffer, sys_console.cmdBuffer, sizeof(buffer));
+
+	return buffer;
+}
+
+/*
+ =================
+ Sys_Print
+ =================
+*/
+void Sys_Print (const char *text){
+
+	char	buffer[MAX_PRINTMSG];
+	int		len = 0;
+
+	// Remove color escapes
+	while (*text && len < MAX_PRINTMSG - 1){
+		if (Q_IsColorString(text))
+			text++;
+		else
+			buffer[len++] = *text;
+
+		text++;
+	}
+	buffer[len] = 0;
+
+	fputs(buffer, stdout);
+	fflush(stdout);
+}
+
+/*
+ =================
+ Sys_Error
+ =================
+*/
+void Sys_Error (const char *fmt, ...){
+
+	char	string[MAX_PRINTMSG];
+	va_list	argPtr;
+
+	// Make sure all subsystems are down
+	Com_Shutdown();
+
+	va_start(argPtr, fmt);
+	vsnprintf(string, sizeof(string), fmt, argPtr);
+	va_end(argPtr);
+
+	fcntl(0, F_SETFL, sys_console.stdinFlags);
+
+	fprintf(stderr, "\nError: %s\n", string);
+
+	exit(1);
+}
+
+/*
+ =================
+ Sys_ThreadError
+ =================
+*/
+void Sys_ThreadError (const char *text){
+
+	fcntl(0, F_SETFL, sys_console.stdinFlags);
+
+	fprintf(stderr, "\nError: %s\n", text);
+
+	_exit(1);
+}
+
+/*
+ =================
+ Sys_ShowConsole
+
+ There is no console window, output always goes to stdout
+ =================
+*/
+void Sys_ShowConsole (qboolean show){
+
+}
+
+/*
+ =================
+ Sys_InitConsole
+ =================
+*/
+static void Sys_InitConsole (void){
+
+	// Make stdin non-blocking so Sys_GetCommand can poll it
+	sys_console.stdinFlags = fcntl(0, F_GETFL, 0);
+
+	if (sys_console.stdinFlags == -1){
+		sys_console.stdinFlags = 0;
+		sys_stdinActive = false;
+		return;
+	}
+
+	fcntl(0, F_SETFL, sys_console.stdinFlags | O_NONBLOCK);
+
+	sys_stdinActive = true;
+}
+
+
+// =====================================================================
+
+
+/*
+ =================
+ Sys_FindFiles
+
+ Walks a directory adding every file and/or subdirectory whose name
+ matches the specified pattern.
+ The file list is sorted alphabetically.
+ =================
+*/
+int Sys_FindFiles (const char *path, const char *pattern, char **fileList, int maxFiles, qboolean addFiles, qboolean addDirs){
+
+	DIR				*dir;
+	struct dirent	*entry;
+	struct stat		st;
+	char			findPath[MAX_OSPATH];
+	int				fileCount = 0;
+
+	dir = opendir(path);
+	if (!dir)
+		return 0;
+
+	while ((entry = readdir(dir)) != NULL){
+		// Check for invalid file name
+		if (entry->d_name[strlen(entry->d_name)-1] == '.')
+			continue;
+
+		// Match pattern
+		if (!Q_GlobMatch(pattern, entry->d_name, false))
+			continue;
+
+		Q_snprintfz(findPath, sizeof(findPath), "%s/%s", path, entry->d_name);
+
+		if (stat(findPath, &st) == -1)
+			continue;
+
+		if (S_ISDIR(st.st_mode)){
+			// Add a directory
+			if (addDirs && (fileCount < maxFiles))
+				fileList[fileCount++] = CopyString(findPath);
+		}
+		else {
+			// Add a file
+			if (addFiles && (fileCount < maxFiles))
+				fileList[fileCount++] = CopyString(findPath);
+		}
+	}
+
+	closedir(dir);
+
+	// Sort the list
+	qsort(fileList, fileCount, sizeof(char *), Q_SortStrcmp);
+
+	return fileCount;
+}
+
+/*
+ =================
+ Sys_RecursiveFindFiles
+
+ Walks a directory adding every file and/or subdirectory in the tree.
+ The file list is sorted alphabetically.
+ =================
+*/
+int Sys_RecursiveFindFiles (const char *path, char **fileList, int maxFiles, int fileCount, qboolean addFiles, qboolean addDirs){
+
+	DIR				*dir;
+	struct dirent	*entry;
+	struct stat		st;
+	char			findPath[MAX_OSPATH];
+
+	dir = opendir(path);
+	if (!dir)
+		return fileCount;
+
+	while ((entry = readdir(dir)) != NULL){
+		// Check for invalid file name
+		if (entry->d_name[strlen(entry->d_name)-1] == '.')
+			continue;
+
+		Q_snprintfz(findPath, sizeof(findPath), "%s/%s", path, entry->d_name);
+
+		if (stat(findPath, &st) == -1)
+			continue;
+
+		if (S_ISDIR(st.st_mode)){
+			// Add a directory
+			if (addDirs && (fileCount < maxFiles))
+				fileList[fileCount++] = CopyString(findPath);
+		}
+		else {
+			// Add a file
+			if (addFiles && (fileCount < maxFiles))
+				fileList[fileCount++] = CopyString(findPath);
+		}
+
+		// If a directory, recurse into it
+		if (S_ISDIR(st.st_mode))
+			fileCount = Sys_RecursiveFindFiles(findPath, fileList, maxFiles, fileCount, addFiles, addDirs);
+	}
+
+	closedir(dir);
+
+	// Sort the list
+	qsort(fileList, fileCount, sizeof(char *), Q_SortStrcmp);
+
+	return fileCount;
+}
+
+/*
+ =================
+ Sys_CreateDirectory
+ =================
+*/
+void Sys_CreateDirectory (const char *path){
+
+	mkdir(path, 0777);
+}
+
+/*
+ =================
+ Sys_RemoveDirectory
+ =================
+*/
+void Sys_RemoveDirectory (const char *path){
+
+	rmdir(path);
+}
+
+/*
+ =================
+ Sys_GetCurrentDirectory
+ =================
+*/
+char *Sys_GetCurrentDirectory (void){
+
+	static char	curDir[MAX_OSPATH];
+
+	if (!getcwd(curDir, sizeof(curDir)))
+		Com_Error(ERR_FATAL, "Couldn't get current working directory");
+
+	return curDir;
+}
+
+/*
+ =================
+ Sys_MapFile
+ =================
+*/
+void *Sys_MapFile (const char *path, int *length){
+
+	struct stat	st;
+	void		*data;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return NULL;
+
+	if (fstat(fd, &st) == -1 || st.st_size == 0 || st.st_size > 0x7fffffff){
+		close(fd);
+		return NULL;
+	}
+
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	// The mapping keeps the file open
+	close(fd);
+
+	if (data == MAP_FAILED)
+		return NULL;
+
+	*length = st.st_size;
+
+	return data;
+}
+
+/*
+ =================
+ Sys_UnmapFile
+ =================
+*/
+void Sys_UnmapFile (void *data, int length){
+
+	munmap(data, length);
+}
+
+/*
+ =================
+ Sys_ReadFileAt
+ =================
+*/
+int Sys_ReadFileAt (FILE *f, void *buffer, int size, int offset){
+
+	ssize_t	r;
+
+	do {
+		r = pread(fileno(f), buffer, size, offset);
+	} while (r == -1 && errno == EINTR);
+
+	return r;
+}
+
+/*
+ =================
+ Sys_ScanForCD
+
+ Dedicated servers never look for the CD
+ =================
+*/
+char *Sys_ScanForCD (void){
+
+	static char	cdDir[MAX_OSPATH];
+
+	cdDir[0] = 0;
+	return cdDir;
+}
+
+/*
+ =================
+ Sys_GetClipboardText
+ =================
+*/
+char *Sys_GetClipboardText (void){
+
+	return NULL;
+}
+
+/*
+ =================
+ Sys_ShellExecute
+ =================
+*/
+void Sys_ShellExecute (const char *path, const char *parms, qboolean exit){
+
+	Com_Printf("Sys_ShellExecute: not supported on this platform\n");
+
+	if (exit)
+		Sys_Quit();
+}
+
+/*
+ =================
+ Sys_Milliseconds
+ =================
+*/
+int Sys_Milliseconds (void){
+
+	static qboolean	initialized;
+	static time_t	base;
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	if (!initialized){
+		base = ts.tv_sec;
+		initialized = true;
+	}
+
+	return (ts.tv_sec - base) * 1000 + ts.tv_nsec / 1000000;
+}
+
+/*
+ =================
+ Sys_Microseconds
+ =================
+*/
+unsigned Sys_Microseconds (void){
+
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*
+ =================
+ Sys_PumpMessages
+
+ No window messages to pump
+ =================
+*/
+void Sys_PumpMessages (void){
+
+}
+
+/*
+ =================
+ Sys_DetectCPU
+ =================
+*/
+static qboolean Sys_DetectCPU (char *cpuString, int maxSize){
+
+	FILE	*f;
+	char	line[256], *value;
+	int		len;
+
+	f = fopen("/proc/cpuinfo", "r");
+	if (!f)
+		return false;
+
+	while (fgets(line, sizeof(line), f)){
+		if (Q_strnicmp(line, "model name", 10))
+			continue;
+
+		value = strchr(line, ':');
+		if (!value)
+			continue;
+
+		value++;
+		while (*value == ' ' || *value == '\t')
+			value++;
+
+		len = strlen(value);
+		while (len && (value[len-1] == '\n' || value[len-1] == ' '))
+			value[--len] = 0;
+
+		Q_strncpyz(cpuString, value, maxSize);
+
+		fclose(f);
+		return true;
+	}
+
+	fclose(f);
+	return false;
+}
+
+/*
+ =================
+ Sys_Init
+ =================
+*/
+void Sys_Init (void){
+
+	struct utsname	info;
+	char			string[64];
+	long			pages, pageSize;
+
+	// Get OS version info
+	if (uname(&info) == -1)
+		Com_Error(ERR_FATAL, "Couldn't get OS version info");
+
+	Q_snprintfz(string, sizeof(string), "%s %s", info.sysname, info.release);
+
+	Com_Printf("OS: %s\n", string);
+	Cvar_Get("sys_osVersion", string, CVAR_ROM);
+
+	// Get physical memory
+	pages = sysconf(_SC_PHYS_PAGES);
+	pageSize = sysconf(_SC_PAGESIZE);
+
+	if (pages > 0 && pageSize > 0)
+		Q_snprintfz(string, sizeof(string), "%u", (unsigned)(((double)pages * pageSize) / (1 << 20)));
+	else
+		Q_strncpyz(string, "0", sizeof(string));
+
+	Com_Printf("RAM: %s MB\n", string);
+	Cvar_Get("sys_ramMegs", string, CVAR_ROM);
+
+	// Detect CPU
+	Com_Printf("Detecting CPU... ");
+
+	if (Sys_DetectCPU(string, sizeof(string))){
+		Com_Printf("Found %s\n", string);
+		Cvar_Get("sys_cpuString", string, CVAR_ROM);
+	}
+	else {
+		Com_Printf("Forcing to 'Unknown'\n");
+		Cvar_Get("sys_cpuString", "Unknown", CVAR_ROM);
+	}
+
+	// Get user name
+	if (getenv("USER"))
+		Cvar_Get("sys_userName", getenv("USER"), CVAR_ROM);
+	else
+		Cvar_Get("sys_userName", "", CVAR_ROM);
+}
+
+/*
+ =================
+ Sys_Quit
+ =================
+*/
+void Sys_Quit (void){
+
+	Com_Shutdown();
+
+	fcntl(0, F_SETFL, sys_console.stdinFlags);
+
+	exit(0);
+}
+
+
+/*
+ =======================================================================
+
+ THREADS
+
+ =======================================================================
+*/
+
+typedef struct {
+	void		(*function)(void *data);
+	void		*data;
+} sysThreadParms_t;
+
+typedef struct {
+	pthread_mutex_t	mutex;
+	pthread_cond_t	cond;
+	int				count;
+} sysSemaphore_t;
+
+
+/*
+ =================
+ Sys_NumProcessors
+ =================
+*/
+int Sys_NumProcessors (void){
+
+	long	count;
+
+	count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (count < 1)
+		return 1;
+
+	return count;
+}
+
+/*
+ =================
+ Sys_ThreadProc
+ =================
+*/
+static void *Sys_ThreadProc (void *parm){
+
+	sysThreadParms_t	parms;
+
+	parms = *(sysThreadParms_t *)parm;
+	free(parm);
+
+	parms.function(parms.data);
+
+	return NULL;
+}
+
+/*
+ =================
+ Sys_CreateThread
+ =================
+*/
+void *Sys_CreateThread (void (*function)(void *data), void *data){
+
+	sysThreadParms_t	*parms;
+	pthread_t			*thread;
+
+	parms = malloc(sizeof(sysThreadParms_t));
+	if (!parms)
+		return NULL;
+
+	thread = malloc(sizeof(pthread_t));
+	if (!thread){
+		free(parms);
+		return NULL;
+	}
+
+	parms->function = function;
+	parms->data = data;
+
+	if (pthread_create(thread, NULL, Sys_ThreadProc, parms)){
+		free(parms);
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+/*
+ =================
+ Sys_WaitForThread
+
+ Waits for the thread to exit and releases it
+ =================
+*/
+void Sys_WaitForThread (void *thread){
+
+	pthread_join(*(pthread_t *)thread, NULL);
+	free(thread);
+}
+
+/*
+ =================
+ Sys_CreateMutex
+ =================
+*/
+void *Sys_CreateMutex (void){
+
+	pthread_mutex_t	*mutex;
+
+	mutex = malloc(sizeof(pthread_mutex_t));
+	if (!mutex)
+		Com_Error(ERR_FATAL, "Sys_CreateMutex: out of memory");
+
+	pthread_mutex_init(mutex, NULL);
+
+	return mutex;
+}
+
+/*
+ =================
+ Sys_DestroyMutex
+ =================
+*/
+void Sys_DestroyMutex (void *mutex){
+
+	pthread_mutex_destroy((pthread_mutex_t *)mutex);
+	free(mutex);
+}
+
+/*
+ =================
+ Sys_LockMutex
+ =================
+*/
+void Sys_LockMutex (void *mutex){
+
+	pthread_mutex_lock((pthread_mutex_t *)mutex);
+}
+
+/*
+ =================
+ Sys_UnlockMutex
+ =================
+*/
+void Sys_UnlockMutex (void *mutex){
+
+	pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+/*
+ =================
+ Sys_CreateSemaphore
+
+ Built on a mutex and condition variable, because unnamed POSIX
+ semaphores aren't available everywhere
+ =================
+*/
+void *Sys_CreateSemaphore (int count){
+
+	sysSemaphore_t	*semaphore;
+
+	semaphore = malloc(sizeof(sysSemaphore_t));
+	if (!semaphore)
+		Com_Error(ERR_FATAL, "Sys_CreateSemaphore: out of memory");
+
+	pthread_mutex_init(&semaphore->mutex, NULL);
+	pthread_cond_init(&semaphore->cond, NULL);
+	semaphore->count = count;
+
+	return semaphore;
+}
+
+/*
+ =================
+ Sys_DestroySemaphore
+ =================
+*/
+void Sys_DestroySemaphore (void *semaphore){
+
+	sysSemaphore_t	*s = semaphore;
+
+	pthread_cond_destroy(&s->cond);
+	pthread_mutex_destroy(&s->mutex);
+	free(s);
+}
+
+/*
+ =================
+ Sys_PostSemaphore
+ =================
+*/
+void Sys_PostSemaphore (void *semaphore, int count){
+
+	sysSemaphore_t	*s = semaphore;
+
+	pthread_mutex_lock(&s->mutex);
+	s->count += count;
+
+	if (count == 1)
+		pthread_cond_signal(&s->cond);
+	else
+		pthread_cond_broadcast(&s->cond);
+
+	pthread_mutex_unlock(&s->mutex);
+}
+
+/*
+ =================
+ Sys_WaitSemaphore
+ =================
+*/
+void Sys_WaitSemaphore (void *semaphore){
+
+	sysSemaphore_t	*s = semaphore;
+
+	pthread_mutex_lock(&s->mutex);
+
+	while (s->count <= 0)
+		pthread_cond_wait(&s->cond, &s->mutex);
+
+	s->count--;
+
+	pthread_mutex_unlock(&s->mutex);
+}
+
+/*
+ =================
+ Sys_AtomicAdd
+
+ Returns the new value
+ =================
+*/
+int Sys_AtomicAdd (volatile int *value, int add){
+
+	return __sync_add_and_fetch(value, add);
+}
+
+/*
+ =================
+ Sys_IsMainThread
+ =================
+*/
+qboolean Sys_IsMainThread (void){
+
+	return pthread_equal(pthread_self(), sys_mainThread);
+}
+
+
+/*
+ =======================================================================
+
+ SHARED LIBRARY LOADING
+
+ =======================================================================
+*/
+
+#if defined __x86_64__
+#define GAMENAME		"q2e_gamex86_64.so"
+#define CGAMENAME		"q2e_cgamex86_64.so"
+#define UINAME			"q2e_uix86_64.so"
+#define OLDGAMENAME		"gamex86_64.so"		// For compatibility
+#elif defined __i386__
+#define GAMENAME		"q2e_gamei386.so"
+#define CGAMENAME		"q2e_cgamei386.so"
+#define UINAME			"q2e_uii386.so"
+#define OLDGAMENAME		"gamei386.so"		// For compatibility
+#else
+#define GAMENAME		"q2e_game.so"
+#define CGAMENAME		"q2e_cgame.so"
+#define UINAME			"q2e_ui.so"
+#define OLDGAMENAME		"game.so"			// For compatibility
+#endif
+
+static void		*sys_libGame;
+static void		*sys_libCGame;
+static void		*sys_libUI;
+
+
+/*
+ =================
+ Sys_FreeLibrary
+ =================
+*/
+void Sys_FreeLibrary (sysLib_t lib){
+
+	void	**libHandle;
+	char	*libName;
+
+	switch (lib){
+	case LIB_GAME:
+		libHandle = &sys_libGame;
+		libName = GAMENAME;
+
+		break;
+	case LIB_CGAME:
+		libHandle = &sys_libCGame;
+		libName = CGAMENAME;
+
+		break;
+	case LIB_UI:
+		libHandle = &sys_libUI;
+		libName = UINAME;
+
+		break;
+	default:
+		Com_Error(ERR_FATAL, "Sys_FreeLibrary: bad lib (%i)", lib);
+		return;
+	}
+
+	Com_Printf("Unloading shared library '%s'...\n", libName);
+
+	if (!*libHandle)
+		Com_Error(ERR_FATAL, "Sys_FreeLibrary: '%s' not loaded", libName);
+
+	if (dlclose(*libHandle))
+		Com_Error(ERR_FATAL, "Sys_FreeLibrary: dlclose() failed for '%s'", libName);
+
+	*libHandle = NULL;
+}
+
+/*
+ =================
+ Sys_LoadLibrary
+ =================
+*/
+void *Sys_LoadLibrary (sysLib_t lib, void *import){
+
+	void	**libHandle;
+	char	*libName;
+	char	*apiName;
+	void	*(*GetAPI) (void *);
+	char	name[MAX_OSPATH];
+	char	*path = NULL;
+
+	switch (lib){
+	case LIB_GAME:
+		libHandle = &sys_libGame;
+		libName = GAMENAME;
+		apiName = "GetGameAPI";
+
+		break;
+	case LIB_CGAME:
+		libHandle = &sys_libCGame;
+		libName = CGAMENAME;
+		apiName = "GetCGameAPI";
+
+		break;
+	case LIB_UI:
+		libHandle = &sys_libUI;
+		libName = UINAME;
+		apiName = "GetUIAPI";
+
+		break;
+	default:
+		Com_Error(ERR_FATAL, "Sys_LoadLibrary: bad lib (%i)", lib);
+		return NULL;
+	}
+
+	Com_Printf("Loading shared library %s...\n", libName);
+
+	if (*libHandle)
+		Com_Error(ERR_FATAL, "Sys_LoadLibrary: '%s' already loaded", libName);
+
+	// Run through the search paths
+	while (1){
+		path = FS_NextPath(path);
+		if (!path)	// Couldn't find one anywhere
+			Com_Error(ERR_FATAL, "Sys_LoadLibrary: dlopen() failed for '%s'", libName);
+
+		Q_snprintfz(name, sizeof(name), "%s/%s", path, libName);
+		if ((*libHandle = dlopen(name, RTLD_NOW)) == NULL){
+			Com_DPrintf("Sys_LoadLibrary: %s\n", dlerror());
+
+			if (lib == LIB_GAME){
+				// For compatibility with the original game library
+				Q_snprintfz(name, sizeof(name), "%s/%s", path, OLDGAMENAME);
+				if ((*libHandle = dlopen(name, RTLD_NOW)) == NULL)
+					continue;
+
+				break;
+			}
+
+			continue;
+		}
+
+		break;
+	}
+
+	if ((GetAPI = (void *)dlsym(*libHandle, apiName)) == NULL){
+		dlclose(*libHandle);
+		*libHandle = NULL;
+		Com_Error(ERR_FATAL, "Sys_LoadLibrary: dlsym() failed for '%s'", apiName);
+	}
+
+	return GetAPI(import);
+}
+
+
+// =====================================================================
+
+
+/*
+ =================
+ Sys_SignalHandler
+ =================
+*/
+static void Sys_SignalHandler (int sig){
+
+	sys_quitSignal = sig;
+}
+
+/*
+ =================
+ main
+ =================
+*/
+int main (int argc, char **argv){
+
+	static char	cmdLine[MAX_STRING_CHARS];
+	int			time, oldTime, newTime;
+	int			i;
+
+	sys_mainThread = pthread_self();
+
+	// Rebuild the command line Com_Init expects
+	for (i = 1; i < argc; i++){
+		if (i > 1)
+			Q_strncatz(cmdLine, " ", sizeof(cmdLine));
+
+		Q_strncatz(cmdLine, argv[i], sizeof(cmdLine));
+	}
+
+	// Quit cleanly when the container or the user asks us to
+	signal(SIGINT, Sys_SignalHandler);
+	signal(SIGTERM, Sys_SignalHandler);
+	signal(SIGHUP, SIG_IGN);
+
+	// Initialize the dedicated console
+	Sys_InitConsole();
+
+	// Initialize all the subsystems
+	Com_Init(cmdLine);
+
+	// Main loop
+	oldTime = Sys_Milliseconds();
+
+	while (1){
+		if (sys_quitSignal){
+			Com_Printf("Received signal %i, quitting...\n", sys_quitSignal);
+			Sys_Quit();
+		}
+
+		// Sleep until a packet or console input arrives, or the server
+		// has to run its next frame
+		NET_Sleep(SV_FrameTimeLeft());
+
+		newTime = Sys_Milliseconds();
+		time = newTime - oldTime;
+
+		// Wait for at least a millisecond to pass, so we don't run
+		// frames that don't advance the clock
+		if (time < 1){
+			usleep(1000);
+			continue;
+		}
+
+		Com_Frame(time);
+
+		oldTime = newTime;
+	}
+
+	// Never gets here
+	return 0;
+}
@@ -443,6 +443,17 @@ void NET_SendPacket (netSrc_t sock, const netAdr_t to, const void *data, int len
 	}
 }
 
+/*
+ =================
+ NET_Flush
+
+ Packets are sent right away by NET_SendPacket, so there is nothing to do
+ =================
+*/
+void NET_Flush (netSrc_t sock){
+
+}
+
 
 // =====================================================================
 
@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "winquake.h"
 #include "../qcommon/qcommon.h"
 #include <float.h>
+#include <io.h>
 
 
 #define CONSOLE_WINDOW_CLASS_NAME	"Q2E Console"
@@ -57,6 +58,8 @@ typedef struct {
 
 static sysConsole_t	sys_console;
 
+static DWORD		sys_mainThreadId;
+
 HINSTANCE			sys_hInstance;
 
 unsigned			sys_msgTime;
@@ -178,6 +181,18 @@ void Sys_Error (const char *fmt, ...){
 	}
 }
 
+/*
+ =================
+ Sys_ThreadError
+ =================
+*/
+void Sys_ThreadError (const char *text){
+
+	MessageBox(NULL, text, "Error", MB_OK | MB_ICONERROR | MB_TOPMOST);
+
+	TerminateProcess(GetCurrentProcess(), 1);
+}
+
 /*
  =================
  Sys_ShowConsole
@@ -592,6 +607,88 @@ char *Sys_GetCurrentDirectory (void){
 	return curDir;
 }
 
+/*
+ =================
+ Sys_MapFile
+ =================
+*/
+void *Sys_MapFile (const char *path, int *length){
+
+	HANDLE	file, mapping;
+	void	*data;
+	DWORD	size;
+
+	file = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	size = GetFileSize(file, NULL);
+	if (size == INVALID_FILE_SIZE || size == 0){
+		CloseHandle(file);
+		return NULL;
+	}
+
+	mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping){
+		CloseHandle(file);
+		return NULL;
+	}
+
+	data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	// The view keeps the file open
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	if (!data)
+		return NULL;
+
+	*length = size;
+
+	return data;
+}
+
+/*
+ =================
+ Sys_UnmapFile
+ =================
+*/
+void Sys_UnmapFile (void *data, int length){
+
+	UnmapViewOfFile(data);
+}
+
+/*
+ =================
+ Sys_ReadFileAt
+
+ ReadFile moves the file pointer even with an offset, but nobody reads
+ the shared pack files sequentially
+ =================
+*/
+int Sys_ReadFileAt (FILE *f, void *buffer, int size, int offset){
+
+	HANDLE		file;
+	OVERLAPPED	overlapped;
+	DWORD		r;
+
+	file = (HANDLE)_get_osfhandle(_fileno(f));
+	if (file == INVALID_HANDLE_VALUE)
+		return -1;
+
+	memset(&overlapped, 0, sizeof(overlapped));
+	overlapped.Offset = offset;
+
+	if (!ReadFile(file, buffer, size, &r, &overlapped)){
+		if (GetLastError() == ERROR_HANDLE_EOF)
+			return 0;
+
+		return -1;
+	}
+
+	return r;
+}
+
 /*
  =================
  Sys_ScanForCD
@@ -698,6 +795,28 @@ int Sys_Milliseconds (void){
 	return timeGetTime() - base;
 }
 
+/*
+ =================
+ Sys_Microseconds
+ =================
+*/
+unsigned Sys_Microseconds (void){
+
+	static qboolean	initialized;
+	static __int64	frequency, base;
+	__int64			counter;
+
+	if (!initialized){
+		QueryPerformanceFrequency((LARGE_INTEGER *)&frequency);
+		QueryPerformanceCounter((LARGE_INTEGER *)&base);
+		initialized = true;
+	}
+
+	QueryPerformanceCounter((LARGE_INTEGER *)&counter);
+
+	return (unsigned)((counter - base) * 1000000 / frequency);
+}
+
 /*
  =================
  Sys_PumpMessages
@@ -1060,6 +1179,212 @@ void Sys_Quit (void){
 }
 
 
+/*
+ =======================================================================
+
+ THREADS
+
+ =======================================================================
+*/
+
+typedef struct {
+	void		(*function)(void *data);
+	void		*data;
+} sysThreadParms_t;
+
+
+/*
+ =================
+ Sys_NumProcessors
+ =================
+*/
+int Sys_NumProcessors (void){
+
+	SYSTEM_INFO	sysInfo;
+
+	GetSystemInfo(&sysInfo);
+
+	if (sysInfo.dwNumberOfProcessors < 1)
+		return 1;
+
+	return sysInfo.dwNumberOfProcessors;
+}
+
+/*
+ =================
+ Sys_ThreadProc
+ =================
+*/
+static DWORD WINAPI Sys_ThreadProc (LPVOID parm){
+
+	sysThreadParms_t	parms;
+
+	parms = *(sysThreadParms_t *)parm;
+	free(parm);
+
+	parms.function(parms.data);
+
+	return 0;
+}
+
+/*
+ =================
+ Sys_CreateThread
+ =================
+*/
+void *Sys_CreateThread (void (*function)(void *data), void *data){
+
+	sysThreadParms_t	*parms;
+	HANDLE				hThread;
+	DWORD				threadId;
+
+	parms = malloc(sizeof(sysThreadParms_t));
+	if (!parms)
+		return NULL;
+
+	parms->function = function;
+	parms->data = data;
+
+	hThread = CreateThread(NULL, 0, Sys_ThreadProc, parms, 0, &threadId);
+	if (!hThread){
+		free(parms);
+		return NULL;
+	}
+
+	return hThread;
+}
+
+/*
+ =================
+ Sys_WaitForThread
+
+ Waits for the thread to exit and releases it
+ =================
+*/
+void Sys_WaitForThread (void *thread){
+
+	WaitForSingleObject((HANDLE)thread, INFINITE);
+	CloseHandle((HANDLE)thread);
+}
+
+/*
+ =================
+ Sys_CreateMutex
+ =================
+*/
+void *Sys_CreateMutex (void){
+
+	CRITICAL_SECTION	*cs;
+
+	cs = malloc(sizeof(CRITICAL_SECTION));
+	if (!cs)
+		Com_Error(ERR_FATAL, "Sys_CreateMutex: out of memory");
+
+	InitializeCriticalSection(cs);
+
+	return cs;
+}
+
+/*
+ =================
+ Sys_DestroyMutex
+ =================
+*/
+void Sys_DestroyMutex (void *mutex){
+
+	DeleteCriticalSection((CRITICAL_SECTION *)mutex);
+	free(mutex);
+}
+
+/*
+ =================
+ Sys_LockMutex
+ =================
+*/
+void Sys_LockMutex (void *mutex){
+
+	EnterCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+/*
+ =================
+ Sys_UnlockMutex
+ =================
+*/
+void Sys_UnlockMutex (void *mutex){
+
+	LeaveCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+/*
+ =================
+ Sys_CreateSemaphore
+ =================
+*/
+void *Sys_CreateSemaphore (int count){
+
+	HANDLE	hSemaphore;
+
+	hSemaphore = CreateSemaphore(NULL, count, 0x7fffffff, NULL);
+	if (!hSemaphore)
+		Com_Error(ERR_FATAL, "Sys_CreateSemaphore: CreateSemaphore() failed");
+
+	return hSemaphore;
+}
+
+/*
+ =================
+ Sys_DestroySemaphore
+ =================
+*/
+void Sys_DestroySemaphore (void *semaphore){
+
+	CloseHandle((HANDLE)semaphore);
+}
+
+/*
+ =================
+ Sys_PostSemaphore
+ =================
+*/
+void Sys_PostSemaphore (void *semaphore, int count){
+
+	ReleaseSemaphore((HANDLE)semaphore, count, NULL);
+}
+
+/*
+ =================
+ Sys_WaitSemaphore
+ =================
+*/
+void Sys_WaitSemaphore (void *semaphore){
+
+	WaitForSingleObject((HANDLE)semaphore, INFINITE);
+}
+
+/*
+ =================
+ Sys_AtomicAdd
+
+ Returns the new value
+ =================
+*/
+int Sys_AtomicAdd (volatile int *value, int add){
+
+	return InterlockedExchangeAdd((volatile LONG *)value, add) + add;
+}
+
+/*
+ =================
+ Sys_IsMainThread
+ =================
+*/
+qboolean Sys_IsMainThread (void){
+
+	return (GetCurrentThreadId() == sys_mainThreadId);
+}
+
+
 /*
  =======================================================================
 
@@ -1233,6 +1558,7 @@ int WINAPI WinMain (HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLin
 		return FALSE;
 
 	sys_hInstance = hInstance;
+	sys_mainThreadId = GetCurrentThreadId();
 
 	// No abort/retry/fail errors
 	SetErrorMode(SEM_FAILCRITICALERRORS);